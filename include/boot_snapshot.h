@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ui_model.h"
+
+static constexpr uint32_t kBootSnapshotMagic = 0x46504C53;  // "FPLS"
+static constexpr uint16_t kBootSnapshotVersion = 1;
+
+// Raw image of the last good UI state. The size/version fields reject images written
+// by a firmware with a different struct layout; the CRC rejects torn writes.
+struct BootSnapshot {
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t size = 0;
+    SharedUiState ui;
+    UiSquadRow squadRows[kMaxSquadRows];
+    uint32_t squadCount = 0;
+    uint32_t crc = 0;
+};
+
+// CRC-32 (IEEE, reflected); pass 0 to start and the previous result to continue.
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len);
+
+void encodeBootSnapshot(const SharedUiState &state, const UiRuntimeState &runtime, BootSnapshot &out);
+bool decodeBootSnapshot(const BootSnapshot &snap);
+// Validates `len` bytes read back from storage; a short read is rejected
+// before the header is looked at. `out` is only meaningful on true.
+bool decodeBootSnapshot(const uint8_t *data, size_t len, BootSnapshot &out);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fpl_config.h"
+
+// Download stage of the FPL poll. fplTask submits jobs to a bounded pending
+// table; FPL_FETCH_WORKERS tasks download each URL into a PSRAM buffer and post
+// it on a bounded result queue, so fplTask parses one response while the next
+// ones are still downloading. With FPL_FETCH_WORKERS=0 a submit downloads
+// inline and queues the result, i.e. the old serial poll.
+//
+// Workers take the most urgent job first (class, then deadline, then age).
+// A running download is never interrupted; instead metadata may occupy at most
+// all but one worker, so live points never wait behind a bootstrap download.
+// Submitting a job for a URL that is still queued merges the two, and a job
+// still queued at its deadline is dropped and reported as failed.
+enum class FetchEndpoint : uint8_t {
+    Bootstrap,  // bootstrap-static: gameweek state and player names
+    Entry,      // entry summary: current GW, rank, total points
+    History,    // entry history: previous overall rank
+    Picks,      // picks for the current GW
+    Live,       // live points for the current GW
+    Count
+};
+
+static constexpr size_t kFetchEndpointCount = static_cast<size_t>(FetchEndpoint::Count);
+
+// Scheduling classes, most urgent first.
+enum class FetchClass : uint8_t {
+    Live,      // live points: drives goal notifications
+    Entry,     // entry summary and picks: gate the live merge
+    Metadata,  // bootstrap names, history, previous rank
+    Count
+};
+
+struct FetchJob {
+    FetchEndpoint endpoint;
+    uint32_t pollId;      // lets the poll drop results of an abandoned earlier poll
+    uint32_t deadlineMs;  // must start within this long of submit; 0 = FPL_FETCH_JOB_DEADLINE_MS
+    size_t maxBytes;
+    char url[96];
+};
+
+struct FetchResult {
+    FetchEndpoint endpoint;
+    uint32_t pollId;
+    bool ok;
+    char *body;  // PSRAM, NUL-terminated; hand back with fetchRelease()
+    size_t length;
+    uint32_t queuedMs;  // submitted
+    uint32_t startMs;   // picked up by a worker
+    uint32_t doneMs;    // body complete
+};
+
+// Downloads one job on the calling worker. On success the body is
+// heap_caps-allocated and NUL-terminated; fetchRelease() frees it.
+typedef bool (*FetchTransport)(const FetchJob &job, char *&bodyOut, size_t &lengthOut);
+
+const char *fetchEndpointName(FetchEndpoint endpoint);
+FetchClass fetchEndpointClass(FetchEndpoint endpoint);
+// fetchHttpTransport on the device; the host tests pass a mock.
+void fetchPipelineInit(FetchTransport transport);
+// Never blocks. False if the pending table is full or init failed.
+bool fetchSubmit(const FetchJob &job);
+bool fetchWaitResult(FetchResult &out, uint32_t timeoutMs);
+void fetchRelease(FetchResult &result);
+// Per-class job counts, queue/run times and each worker's unused stack
+// (`fetch` serial command).
+void fetchPrintStats();
+
+// src/fetch_http.cpp: fetchUrlToPsram() when WiFi is up.
+bool fetchHttpTransport(const FetchJob &job, char *&bodyOut, size_t &lengthOut);
+// Blocking download of job.url (capped at job.maxBytes) on the calling task;
+// used by the workers and the serial console. Each attempt feeds net_stats.
+bool fetchUrlToPsram(const FetchJob &job, char *&bufferOut, size_t &lengthOut);
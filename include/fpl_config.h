@@ -32,6 +32,34 @@
 #define FPL_LIVE_JSON_DOC_CAPACITY 700000UL
 #endif
 
+// deserializeJson() of the multi-MB live/bootstrap bodies sleeps a tick whenever
+// it has run this long, checked every FPL_JSON_SLICE_BYTES. 0 = never yield.
+#ifndef FPL_JSON_SLICE_BUDGET_US
+#define FPL_JSON_SLICE_BUDGET_US 20000U
+#endif
+
+#ifndef FPL_JSON_SLICE_BYTES
+#define FPL_JSON_SLICE_BYTES 2048U
+#endif
+
+// Upper bound for the small entry / history / picks payloads.
+#ifndef FPL_SMALL_PSRAM_MAX_BYTES
+#define FPL_SMALL_PSRAM_MAX_BYTES (256UL * 1024UL)
+#endif
+
+// Download tasks for the poll pipeline: this many FPL requests are in flight
+// while fplTask parses earlier responses. Each holds a TLS session while it
+// downloads. 0 = download inline on fplTask, one request at a time.
+#ifndef FPL_FETCH_WORKERS
+#define FPL_FETCH_WORKERS 2
+#endif
+
+// A download job not started within this long is dropped; by then the next
+// poll has asked for fresher data.
+#ifndef FPL_FETCH_JOB_DEADLINE_MS
+#define FPL_FETCH_JOB_DEADLINE_MS FPL_POLL_INTERVAL_MS
+#endif
+
 // Notification source:
 // 1 = use server event breakdown (`/event/{gw}/live` -> `explain`)
 // 0 = use inferred local logic from stat deltas
@@ -39,6 +67,120 @@
 #define FPL_USE_SERVER_EVENT_BREAKDOWN 1
 #endif
 
+// Persist the last good UI state (points, rank, deadline, squad) so the screen
+// shows cached data, marked stale, before WiFi/NTP/first poll complete.
+// RTC memory is refreshed after every poll; flash at most once per interval.
+#ifndef FPL_BOOT_SNAPSHOT_ENABLED
+#define FPL_BOOT_SNAPSHOT_ENABLED 1
+#endif
+
+#ifndef FPL_BOOT_SNAPSHOT_FLASH_INTERVAL_MS
+#define FPL_BOOT_SNAPSHOT_FLASH_INTERVAL_MS (5UL * 60UL * 1000UL)
+#endif
+
+// Kit images cached in PSRAM (~17 KB each as decoded I8); the squad's kits are prefetched
+// after every snapshot. Negative entries remember teams with no kit file.
+#ifndef FPL_KIT_CACHE_ENTRIES
+#define FPL_KIT_CACHE_ENTRIES 24
+#endif
+
+#ifndef FPL_KIT_CACHE_NEGATIVE_ENTRIES
+#define FPL_KIT_CACHE_NEGATIVE_ENTRIES 16
+#endif
+
+// Kits packed by tools/kit_atlas.py into this partition (`pio run -t uploadkits`)
+// are drawn straight from memory-mapped flash; LittleFS is the fallback.
+#ifndef FPL_KIT_ATLAS_ENABLED
+#define FPL_KIT_ATLAS_ENABLED 1
+#endif
+
+#ifndef FPL_KIT_ATLAS_PARTITION
+#define FPL_KIT_ATLAS_PARTITION "kits"
+#endif
+
+// Start LVGL renders on the panel's tearing-effect edge instead of LVGL's own
+// refresh timer. Falls back to a timer of LV_DEF_REFR_PERIOD if TE stays silent.
+#ifndef FPL_FRAME_SCHEDULER_ENABLED
+#define FPL_FRAME_SCHEDULER_ENABLED 1
+#endif
+
+#ifndef FPL_FRAME_SCHEDULER_TE_PIN
+#define FPL_FRAME_SCHEDULER_TE_PIN 18
+#endif
+
+#ifndef FPL_FRAME_SCHEDULER_VSYNC_TIMEOUT_MS
+#define FPL_FRAME_SCHEDULER_VSYNC_TIMEOUT_MS 500UL
+#endif
+
+#ifndef FPL_FRAME_SCHEDULER_REPORT_INTERVAL_MS
+#define FPL_FRAME_SCHEDULER_REPORT_INTERVAL_MS 10000UL
+#endif
+
+// `shots` serial command: render each screen from fixed data, stream the frames
+// for tools/ui_shots.py and log per-frame render cost. Needs ~340 KB PSRAM on use.
+#ifndef FPL_UI_CAPTURE_ENABLED
+#define FPL_UI_CAPTURE_ENABLED 1
+#endif
+
+// uiTask sleeps until LVGL's next timer, a data change, a touch, a pending frame
+// or the next on-screen clock tick. 0 = wake every 10 ms (for comparison).
+#ifndef FPL_UI_EVENT_DRIVEN
+#define FPL_UI_EVENT_DRIVEN 1
+#endif
+
+// Upper bound on one uiTask sleep; bounds how late periodic reports can run.
+#ifndef FPL_UI_MAX_SLEEP_MS
+#define FPL_UI_MAX_SLEEP_MS 5000U
+#endif
+
+// Cycle-counter histograms of the render/flush path, read with the `perf` command.
+#ifndef FPL_PERF_ENABLED
+#define FPL_PERF_ENABLED 1
+#endif
+
+// CPU load, task stacks and heap sampled into a ring, read with the `stats`
+// command. 64 samples at 10 s cover the last ~10 minutes.
+#ifndef FPL_TELEMETRY_ENABLED
+#define FPL_TELEMETRY_ENABLED 1
+#endif
+
+#ifndef FPL_TELEMETRY_INTERVAL_MS
+#define FPL_TELEMETRY_INTERVAL_MS 10000UL
+#endif
+
+#ifndef FPL_TELEMETRY_SAMPLES
+#define FPL_TELEMETRY_SAMPLES 64
+#endif
+
+// Warn when the largest free block is below this share of the free heap.
+#ifndef FPL_TELEMETRY_FRAG_WARN_PCT
+#define FPL_TELEMETRY_FRAG_WARN_PCT 25U
+#endif
+
+#ifndef FPL_TELEMETRY_LOW_HEAP_BYTES
+#define FPL_TELEMETRY_LOW_HEAP_BYTES (24UL * 1024UL)
+#endif
+
+// Per-endpoint request/latency/size counters, read with the `netstats` command
+// and summarised in the log this often while there is traffic.
+#ifndef FPL_NETSTATS_ENABLED
+#define FPL_NETSTATS_ENABLED 1
+#endif
+
+#ifndef FPL_NETSTATS_LOG_INTERVAL_MS
+#define FPL_NETSTATS_LOG_INTERVAL_MS (15UL * 60UL * 1000UL)
+#endif
+
+// Span tracer (fetch, parse, diff, popup, render, flush), dumped with the
+// `trace` command. 8 bytes per event; 32768 events = 256 KB of PSRAM.
+#ifndef FPL_TRACE_ENABLED
+#define FPL_TRACE_ENABLED 1
+#endif
+
+#ifndef FPL_TRACE_EVENTS
+#define FPL_TRACE_EVENTS 32768U
+#endif
+
 // 16-LED WS2812/NeoPixel status ring.
 #ifndef FPL_LED_RING_ENABLED
 #define FPL_LED_RING_ENABLED 1
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <lvgl.h>
+
+// A vsync source calls frameSchedulerVsync() once per panel scan, from an ISR
+// or a task. Anything that can do that (the panel TE pin, a timer, a test
+// harness driving a simulated TE signal) can pace the display.
+struct FrameVsyncSource {
+    const char *name;
+    bool (*start)();
+    void (*stop)();
+};
+
+const FrameVsyncSource *frameSchedulerPanelTeSource();
+const FrameVsyncSource *frameSchedulerTimerSource();
+
+// Must be called from the task that runs lv_timer_handler(); that task is the
+// one woken on each vsync. Pauses LVGL's own refresh timer.
+void frameSchedulerInit(lv_display_t *disp, const FrameVsyncSource *source);
+void frameSchedulerVsync();
+// Called whenever LVGL invalidates an area. Vsync edges only wake the UI task
+// while a frame is pending, so a static screen costs no wakeups.
+void frameSchedulerRequestFrame();
+// Blocks until the next vsync or maxWait, whichever comes first.
+void frameSchedulerWait(TickType_t maxWait);
+// Renders and flushes pending invalidations if a vsync edge has arrived.
+void frameSchedulerTick(uint32_t nowMs);
+// Called from the flush callback when the last area of a frame is queued.
+void frameSchedulerFramePresented();
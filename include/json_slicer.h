@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fpl_config.h"
+
+// ArduinoJson custom reader over an in-memory body that cuts a long
+// deserializeJson() into time slices. Every FPL_JSON_SLICE_BYTES it checks the
+// clock; once the slice has run for the budget it sleeps one tick, so the idle
+// task (watchdog) and anything else on the core get to run mid-parse. The
+// parser sees an ordinary stream and copies the strings it keeps.
+class JsonSliceReader {
+   public:
+    JsonSliceReader(const char *data, size_t length, uint32_t budgetUs = FPL_JSON_SLICE_BUDGET_US);
+
+    int read() {
+        if (pos_ >= length_) {
+            return -1;
+        }
+        if (pos_ >= nextCheck_) {
+            checkSlice();
+        }
+        return static_cast<uint8_t>(data_[pos_++]);
+    }
+
+    size_t readBytes(char *buffer, size_t length);
+
+    // Ends the last slice; call once the parse has returned.
+    void finish();
+    uint32_t yields() const { return yields_; }
+    // Longest stretch the parse ran without yielding.
+    uint32_t maxSliceUs() const { return maxSliceUs_; }
+    uint32_t elapsedUs() const { return elapsedUs_; }
+
+   private:
+    void checkSlice();
+
+    const char *data_;
+    size_t length_;
+    size_t pos_ = 0;
+    size_t nextCheck_ = 0;
+    uint32_t budgetUs_;
+    uint32_t startUs_;
+    uint32_t sliceStartUs_;
+    uint32_t yields_ = 0;
+    uint32_t maxSliceUs_ = 0;
+    uint32_t elapsedUs_ = 0;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Read-only kit atlas (tools/kit_atlas.py) memory-mapped from the `kits`
+// partition. Descriptors point straight into mapped flash, so a hit needs no
+// file system access, no copy and no PSRAM.
+bool kitAtlasInit();
+// Slug is "<team>_<type>", e.g. "arsenal_gk". Returns nullptr if absent.
+const lv_image_dsc_t *kitAtlasFind(const char *slug);
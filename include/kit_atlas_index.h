@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// On-flash layout of the kit atlas; must match tools/kit_atlas.py. Pure data
+// handling, so the host tests check it against a blob packed from data/kits.
+static constexpr uint32_t kKitAtlasMagic = 0x4C54414B;  // "KATL"
+static constexpr uint16_t kKitAtlasVersion = 1;
+static constexpr size_t kKitAtlasSlugBytes = 32;
+
+struct KitAtlasHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t totalBytes;
+    uint32_t indexOffset;
+};
+
+struct KitAtlasEntry {
+    char slug[kKitAtlasSlugBytes];
+    uint32_t offset;
+    uint32_t size;
+    uint16_t width;
+    uint16_t height;
+    uint8_t bpp;
+    uint8_t pad[3];
+};
+
+static_assert(sizeof(KitAtlasHeader) == 16, "atlas header layout");
+static_assert(sizeof(KitAtlasEntry) == 48, "atlas entry layout");
+
+// Checks the header, every entry (bounds, alignment, kitWidth x kitHeight
+// I4/I8 layout, terminated slug) and the slug order the lookup relies on.
+// `size` is what is readable at `blob`, which must be 4-byte aligned.
+// Returns the entry count, or -1 if anything is off.
+int kitAtlasValidate(const uint8_t *blob, size_t size, uint16_t kitWidth, uint16_t kitHeight);
+// Binary search of a validated atlas' index. Returns the entry index or -1.
+int kitAtlasIndexOf(const uint8_t *blob, const char *slug);
+const KitAtlasEntry &kitAtlasEntry(const uint8_t *blob, int index);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#include "kit_file.h"
+
+// Kit images (palette-indexed `.kit` assets, decoded to LVGL I4/I8 with a
+// transparent background) kept in PSRAM, LRU-evicted, keyed by team slug + GK/outfield.
+// Teams with no kit file are remembered so a miss only touches flash once.
+void kitCacheInit();
+// UI task: returns the kit descriptor (loading it on a miss) or nullptr. The
+// returned entry is pinned until the next acquire so it can stay on screen.
+const lv_image_dsc_t *kitCacheAcquire(const char *team, bool isGk);
+// Background task: loads the kit if it is not cached yet. Never pins.
+void kitCachePrefetch(const char *team, bool isGk);
+void kitCachePrintStats();
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+static constexpr int kKitWidth = 110;
+static constexpr int kKitHeight = 145;
+
+// `.kit` assets (see tools/kit_encode.py): 16-byte header, ARGB8888 palette, then
+// PackBits-style runs of I4/I8 indices. Decoding yields LVGL's indexed layout:
+// the palette padded to 16/256 entries followed by the index rows. Pure data
+// handling, so the host tests decode data/kits with it.
+static constexpr uint32_t kKitMagic = 0x3154494B;  // "KIT1"
+static constexpr size_t kKitHeaderBytes = 16;
+static constexpr uint8_t kKitFlagRle = 0x01;
+static constexpr size_t kKitMaxIndexBytes = kKitWidth * kKitHeight;
+static constexpr size_t kKitMaxDecodedBytes = 256 * 4 + kKitMaxIndexBytes;
+
+struct KitFileHeader {
+    uint8_t bpp;
+    uint8_t flags;
+    uint16_t paletteEntries;
+    uint32_t payloadBytes;
+    // Derived from bpp: where the indices start in the decoded buffer, and how many there are.
+    size_t paletteBytes;
+    size_t indexBytes;
+};
+
+// Parses the first kKitHeaderBytes of a file. False unless it is a kitWidth x
+// kitHeight I4/I8 kit whose palette and payload fit the decoded layout.
+bool kitParseHeader(const uint8_t *raw, uint16_t kitWidth, uint16_t kitHeight, KitFileHeader &out);
+// Expands exactly dstLen bytes; false on a truncated or overlong stream.
+bool kitRleDecode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen);
+// Writes the index rows for `payload` (header.payloadBytes long) to `indices`,
+// which holds header.indexBytes. The caller fills the palette in front of them.
+bool kitDecodeIndices(const KitFileHeader &header, const uint8_t *payload, uint8_t *indices);
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// LED ring animation engine. Effects are rows in a table (src/led_anim.cpp):
+// a pattern, a keyframed level envelope and per-pattern factors. A scene holds
+// one active effect per layer; layers are composited bottom-up into a plain
+// RGB buffer. No Arduino or NeoPixel dependency, so frames render identically
+// on the host.
+
+struct LedPixel {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+enum class LedLayer : uint8_t {
+    Base = 0,   // rank trend
+    Overlay,    // deadline progress
+    Transient,  // notification flash
+    Count,
+};
+
+enum class LedEffectId : uint8_t {
+    None = 0,
+    RankBreathing,
+    RankDimNotch,
+    RankComet,
+    DeadlineProgress,
+    NotificationFlash,
+    Count,
+};
+
+struct LedLayerState {
+    LedEffectId effect = LedEffectId::None;
+    LedPixel color = {0, 0, 0};
+    uint32_t startMs = 0;   // envelope phase and head position are measured from here
+    uint32_t periodMs = 1;  // one pass through the level envelope
+    uint32_t stepMs = 1;    // head advances one LED per step (Notch, Comet)
+    uint8_t progress = 0;   // lit LEDs (Progress)
+};
+
+struct LedScene {
+    LedLayerState layers[static_cast<size_t>(LedLayer::Count)];
+};
+
+LedLayerState &ledAnimLayer(LedScene &scene, LedLayer layer);
+const char *ledAnimEffectName(LedEffectId effect);
+// Renders the scene at nowMs into out[0..count).
+void ledAnimRender(const LedScene &scene, uint32_t nowMs, LedPixel *out, uint16_t count);
+
+static constexpr uint32_t kLedAnimStatic = UINT32_MAX;
+// How far ahead a smooth (curve) envelope is probed for its next level step.
+// A level that holds longer than this reports the horizon itself, so a slow
+// breathing curve costs at most one wakeup per 100 ms on its flat stretches.
+static constexpr uint32_t kLedAnimEnvelopeProbeMs = 100;
+// Floor between frames (the old fixed tick) and ceiling on a single sleep, so
+// a wall-clock jump is picked up within a minute.
+static constexpr uint32_t kLedAnimMinFrameMs = 10;
+static constexpr uint32_t kLedAnimMaxSleepMs = 60000;
+
+// Milliseconds from nowMs until the rendered frame can next differ, or
+// kLedAnimStatic if it never will. Layers hidden under an opaque layer are
+// ignored. Stepped envelopes and moving heads give the exact time; smooth
+// envelopes answer within kLedAnimEnvelopeProbeMs. The answer may be early but
+// is never late.
+uint32_t ledAnimMsUntilChange(const LedScene &scene, uint32_t nowMs);
+// How long the LED task may sleep after rendering the scene at nowMs: until
+// the frame or something outside it (stateWaitMs) changes, clamped to
+// [kLedAnimMinFrameMs, kLedAnimMaxSleepMs].
+uint32_t ledAnimSleepMs(const LedScene &scene, uint32_t nowMs, uint32_t stateWaitMs);
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <Arduino.h>
-#include <time.h>
 
 static constexpr uint8_t kLedRingAnimBreathing = 0;
 static constexpr uint8_t kLedRingAnimDimNotch = 1;
 static constexpr uint8_t kLedRingAnimComet = 2;
 
+// Subscribes the ring to the bus (rank trend and deadline come from the
+// UiRank/UiGameweek topics). Call in setup() before anything publishes.
 void ledRingInit();
-void ledRingTick(uint32_t nowMs);
-void ledRingSetRankTrend(int rankDiff, bool hasRankData);
-void ledRingSetDeadlineCountdown(bool enabled, time_t deadlineUtc);
+// Applies queued bus messages, renders the ring if it changed and returns how
+// many ms the caller may sleep before the next tick (UINT32_MAX: ring
+// disabled). A new message notifies the task that calls this.
+uint32_t ledRingTick(uint32_t nowMs);
+// The setters below publish on the bus and return immediately.
 void ledRingSetPulsePeriodMs(uint32_t periodMs);
 void ledRingSetAnimationMode(uint8_t mode);
 void ledRingTriggerNotificationForMs(uint32_t durationMs);
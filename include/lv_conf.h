@@ -40,7 +40,12 @@
  * - LV_STDLIB_RTTHREAD:    RT-Thread implementation
  * - LV_STDLIB_CUSTOM:      Implement the functions externally
  */
+#ifdef FPL_HOST_BUILD
+/* Host tests use LVGL's own heap so lv_mem_monitor() can count allocations. */
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#else
 #define LV_USE_STDLIB_MALLOC    LV_STDLIB_CLIB
+#endif
 
 /** Possible values
  * - LV_STDLIB_BUILTIN:     LVGL's built in implementation
@@ -69,7 +74,11 @@
 
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
     /** Size of memory available for `lv_malloc()` in bytes (>= 2kB) */
+#ifdef FPL_HOST_BUILD
+#define LV_MEM_SIZE (4 * 1024 * 1024U)
+#else
 #define LV_MEM_SIZE (64 * 1024U)          /**< unused when LV_USE_STDLIB_MALLOC == LV_STDLIB_CLIB */
+#endif
 
     /** Size of the memory expand for `lv_malloc()` in bytes */
     #define LV_MEM_POOL_EXPAND_SIZE 0
@@ -107,7 +116,12 @@
  * - LV_OS_MQX
  * - LV_OS_SDL2
  * - LV_OS_CUSTOM */
+#ifdef FPL_HOST_BUILD
+/* Host tests (`pio test -e native`) render synchronously on the test thread. */
 #define LV_USE_OS   LV_OS_NONE
+#else
+#define LV_USE_OS   LV_OS_FREERTOS
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -117,8 +131,11 @@
      * Unblocking an RTOS task with a direct notification is 45% faster and uses less RAM
      * than unblocking a task using an intermediary object such as a binary semaphore.
      * RTOS task notifications can only be used when there is only one task that can be the recipient of the event.
+     *
+     * Disabled: uiTask's notification slot carries vsync edges from the frame
+     * scheduler, and LVGL's draw sync would consume or be woken by them.
      */
-    #define LV_USE_FREERTOS_TASK_NOTIFY 1
+    #define LV_USE_FREERTOS_TASK_NOTIFY 0
 #endif
 
 /*========================
@@ -154,7 +171,7 @@
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
-#define LV_DRAW_THREAD_STACK_SIZE    (4 * 1024)         /**< [bytes]*/
+#define LV_DRAW_THREAD_STACK_SIZE    (8 * 1024)         /**< [bytes]*/
 
 /** Thread priority of the drawing task.
  *  Higher values mean higher priority.
@@ -163,7 +180,8 @@
  *  Make sure the priority value aligns with the OS-specific priority levels.
  *  On systems with limited priority levels (e.g., FreeRTOS), a higher value can improve
  *  rendering performance but might cause other tasks to starve. */
-#define LV_DRAW_THREAD_PRIO LV_THREAD_PRIO_HIGH
+/* MID keeps the draw threads below the Wi-Fi/lwIP tasks while still above fplTask. */
+#define LV_DRAW_THREAD_PRIO LV_THREAD_PRIO_MID
 
 #define LV_USE_DRAW_SW 1
 #if LV_USE_DRAW_SW == 1
@@ -192,7 +210,15 @@
     /** Set number of draw units.
      *  - > 1 requires operating system to be enabled in `LV_USE_OS`.
      *  - > 1 means multiple threads will render the screen in parallel. */
+    /* One per ESP32-S3 core. LVGL creates its draw threads unpinned, so the
+     * scheduler decides where they run: the second unit can only help while a
+     * core is free, and nothing keeps it off uiTask's core. `bench ui` shows
+     * what it buys. */
+    #ifdef FPL_HOST_BUILD
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #else
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    2
+    #endif
 
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -497,7 +523,9 @@
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
  *  released immediately after use. */
-#define LV_CACHE_DEF_SIZE       0
+/* Kits are palette-indexed (I8); keep the ARGB8888 expansion of the popup kit
+ * (110x145x4 = 63800 B) so it is not re-decoded on every redraw. */
+#define LV_CACHE_DEF_SIZE       (128 * 1024)
 
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
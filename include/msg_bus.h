@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <time.h>
+
+#include <cstring>
+#include <type_traits>
+
+// Typed publish/subscribe between tasks. Every subscriber owns a FreeRTOS
+// queue of fixed-size messages and a topic mask; a publish copies the message
+// into each matching queue without waiting, so no publisher (uiTask included)
+// ever blocks on another task's consumer. When a queue is full the message goes
+// to the subscriber's overflow slots, which busReceive hands out, in publish
+// order, once the queue is drained. A state topic keeps one overflow slot and
+// the newest value replaces it. Event topics (kBusEventTopics) carry things
+// that happened rather than the latest value, so each takes its own slot; with
+// none left it is dropped, counted and logged. The state each topic describes
+// lives with its consumer: uiTask owns the UI state, ledTask the ring state,
+// and so on.
+enum class BusTopic : uint8_t {
+    UiStatus,         // StatusMsg
+    UiGwPoints,       // GwPointsMsg
+    UiGwStateText,    // TextMsg
+    UiGameweek,       // GameweekMsg
+    UiRank,           // RankMsg
+    UiTotalPoints,    // TotalPointsMsg
+    UiFreshness,      // FreshnessMsg
+    UiEvent,          // UiEventItem (main.cpp)
+    UiEventsCleared,  // no payload
+    UiSquadRow,       // SquadRowMsg (main.cpp), one per row
+    UiScriptedDemo,   // ScriptedDemoMsg: start a scripted demo on uiTask
+    DemoActive,       // FlagMsg: a scripted demo owns the UI, polling pauses
+    LedPulsePeriod,   // U32Msg
+    LedAnimMode,      // U32Msg
+    LedFlash,         // U32Msg: flash duration in ms
+    Count
+};
+
+struct StatusMsg {
+    char text[48];
+    uint32_t color;
+};
+
+struct GwPointsMsg {
+    int points;
+};
+
+struct TextMsg {
+    char text[48];
+};
+
+struct GameweekMsg {
+    bool isLiveGw;
+    bool hasNextGw;
+    bool hasDeadline;
+    int currentGw;
+    int nextGw;
+    time_t deadlineUtc;
+};
+
+struct RankMsg {
+    int overallRank;
+    int rankDiff;
+    bool hasRankData;
+};
+
+struct TotalPointsMsg {
+    int totalPoints;
+    bool hasTotalPoints;
+};
+
+struct FreshnessMsg {
+    bool isStale;
+    uint32_t lastApiUpdateMs;
+};
+
+struct ScriptedDemoMsg {
+    uint8_t kind;  // ScriptedDemoKind (main.cpp)
+    int32_t secondsToDeadline;
+};
+
+struct FlagMsg {
+    bool value;
+};
+
+struct U32Msg {
+    uint32_t value;
+};
+
+static constexpr size_t kBusPayloadMax = 112;
+static constexpr size_t kBusMaxSubscribers = 6;
+static constexpr size_t kBusOverflowSlots = 4;
+
+struct BusMessage {
+    BusTopic topic;
+    uint8_t size;
+    uint32_t publishedMs;
+    alignas(8) uint8_t payload[kBusPayloadMax];
+};
+
+struct BusSubscriber;
+
+constexpr uint32_t busTopicBit(BusTopic topic) {
+    return 1UL << static_cast<uint8_t>(topic);
+}
+
+static constexpr uint32_t kBusEventTopics = busTopicBit(BusTopic::UiEvent) | busTopicBit(BusTopic::UiEventsCleared) |
+                                           busTopicBit(BusTopic::UiSquadRow) |
+                                           busTopicBit(BusTopic::UiScriptedDemo) | busTopicBit(BusTopic::LedFlash);
+
+// Subscriptions are made in setup(), before any task publishes.
+BusSubscriber *busSubscribe(const char *name, uint32_t topicMask, size_t depth);
+// Task woken (xTaskNotifyGive) whenever a message lands in the queue.
+void busSetNotifyTask(BusSubscriber *sub, TaskHandle_t task);
+// Non-blocking; false when the queue and the overflow slots are empty.
+bool busReceive(BusSubscriber *sub, BusMessage &out);
+// Never blocks. False if any subscriber had to drop the message.
+bool busPublishRaw(BusTopic topic, const void *payload, size_t size);
+// Messages dropped for the subscriber so far.
+uint32_t busDropped(const BusSubscriber *sub);
+void busPrintStats();
+
+template <typename T>
+bool busPublish(BusTopic topic, const T &payload) {
+    static_assert(sizeof(T) <= kBusPayloadMax, "bus payload too large");
+    static_assert(std::is_trivially_copyable<T>::value, "bus payloads are copied bytewise");
+    return busPublishRaw(topic, &payload, sizeof(T));
+}
+
+inline bool busPublish(BusTopic topic) {
+    return busPublishRaw(topic, nullptr, 0);
+}
+
+template <typename T>
+bool busRead(const BusMessage &msg, T &out) {
+    if (msg.size != sizeof(T)) {
+        return false;
+    }
+    memcpy(&out, msg.payload, sizeof(T));
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fetch_pipeline.h"
+#include "fpl_config.h"
+
+// Per-endpoint network counters: requests, failures by kind and HTTP status,
+// retries, fixed-bucket histograms of DNS, TCP+TLS connect, time to first
+// byte, body download, throughput and JSON parse time, and body sizes against
+// the PSRAM cap. Cumulative since boot (or `netstats reset`); the `netstats`
+// command prints the full table and a one-line summary per endpoint is logged
+// every FPL_NETSTATS_LOG_INTERVAL_MS.
+
+// Where an HTTP attempt stopped, in request order.
+enum class NetFailure : uint8_t {
+    Dns,
+    Connect,   // TCP connect or TLS handshake
+    Http,      // non-200 status or an HTTPClient error code
+    TooLarge,  // body over the PSRAM cap
+    NoMemory,  // PSRAM alloc/realloc
+    Empty,     // connection closed before any body byte
+    Count
+};
+
+// One HTTP attempt as seen by fetchUrlToPsram().
+struct NetSample {
+    FetchEndpoint endpoint = FetchEndpoint::Count;
+    bool ok = false;
+    NetFailure failure = NetFailure::Count;  // set when !ok
+    int httpCode = 0;  // status line, or a negative HTTPClient error; 0 = GET never ran
+    uint32_t dnsUs = 0;
+    uint32_t connectUs = 0;
+    uint32_t ttfbUs = 0;  // request sent until the status line and headers are in
+    uint32_t bodyUs = 0;
+    size_t bytes = 0;
+    size_t maxBytes = 0;  // the job's PSRAM cap
+};
+
+#if FPL_NETSTATS_ENABLED
+
+void netStatsInit();
+void netStatsRecord(const NetSample &sample);
+// A repeated download of the same endpoint: empty body or truncated JSON.
+void netStatsRetry(FetchEndpoint endpoint);
+void netStatsRecordParse(FetchEndpoint endpoint, uint32_t us);
+// Logs the summary when FPL_NETSTATS_LOG_INTERVAL_MS has passed and there was traffic. Called from loop().
+void netStatsTick(uint32_t nowMs);
+void netStatsPrint();
+void netStatsReset();
+
+#else
+
+inline void netStatsInit() {}
+inline void netStatsRecord(const NetSample &) {}
+inline void netStatsRetry(FetchEndpoint) {}
+inline void netStatsRecordParse(FetchEndpoint, uint32_t) {}
+inline void netStatsTick(uint32_t) {}
+inline void netStatsPrint() { Serial.println("[NET] disabled (FPL_NETSTATS_ENABLED=0)"); }
+inline void netStatsReset() {}
+
+#endif
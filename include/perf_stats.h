@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fpl_config.h"
+
+// Latency histograms for the render/flush path, printed and reset by the `perf`
+// serial command. With FPL_PERF_ENABLED=0 every call below is an empty inline
+// and the timestamps fold away.
+enum class PerfMetric : uint8_t {
+    TimerHandler,  // one lv_timer_handler() pass
+    Render,        // lv_refr_now() for a vsync-paced frame, flush included
+    FlushCb,       // CPU time inside lvglFlushCb
+    PanelQueue,    // handing one area to the panel driver (blocks on a busy buffer)
+    DmaWait,       // flush call -> DMA done for that area, i.e. until flush_ready
+    Count
+};
+
+#if FPL_PERF_ENABLED
+
+// CPU cycle counter of the calling core; spans must start and end on one core.
+inline uint32_t perfNow() { return ESP.getCycleCount(); }
+void perfRecordCycles(PerfMetric metric, uint32_t cycles);
+void perfRecordUs(PerfMetric metric, uint32_t us);
+void perfAddFlushedPixels(uint32_t pixels);
+void perfPrintAndReset();
+
+#else
+
+inline uint32_t perfNow() { return 0; }
+inline void perfRecordCycles(PerfMetric, uint32_t) {}
+inline void perfRecordUs(PerfMetric, uint32_t) {}
+inline void perfAddFlushedPixels(uint32_t) {}
+inline void perfPrintAndReset() { Serial.println("[PERF] disabled (FPL_PERF_ENABLED=0)"); }
+
+#endif
+
+inline void perfRecordSince(PerfMetric metric, uint32_t startCycles) {
+    perfRecordCycles(metric, perfNow() - startCycles);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstring>
+
+// Streams bytes to Serial as base64, three at a time, 96 characters per line,
+// with a running CRC-32 for the "end" marker. Shared by the serial dumps that
+// tools/ turns back into files (ui_capture, trace).
+struct Base64Writer {
+    static constexpr size_t kLineGroups = 24;  // 96 base64 characters per serial line
+
+    uint8_t pending[3] = {};
+    size_t pendingCount = 0;
+    size_t groupsOnLine = 0;
+    uint32_t crc = 0xFFFFFFFFU;
+
+    void writeGroup(size_t count) {
+        static constexpr char kChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        char out[4];
+        const uint32_t v = (static_cast<uint32_t>(pending[0]) << 16) | (static_cast<uint32_t>(pending[1]) << 8) | pending[2];
+        out[0] = kChars[(v >> 18) & 0x3F];
+        out[1] = kChars[(v >> 12) & 0x3F];
+        out[2] = count > 1 ? kChars[(v >> 6) & 0x3F] : '=';
+        out[3] = count > 2 ? kChars[v & 0x3F] : '=';
+        Serial.write(reinterpret_cast<const uint8_t *>(out), sizeof(out));
+        if (++groupsOnLine == kLineGroups) {
+            Serial.write('\n');
+            groupsOnLine = 0;
+        }
+    }
+
+    void put(uint8_t byte) {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+        pending[pendingCount++] = byte;
+        if (pendingCount == 3) {
+            writeGroup(3);
+            pendingCount = 0;
+        }
+    }
+
+    void putLe16(uint16_t value) {
+        put(static_cast<uint8_t>(value & 0xFF));
+        put(static_cast<uint8_t>(value >> 8));
+    }
+
+    void putLe32(uint32_t value) {
+        putLe16(static_cast<uint16_t>(value & 0xFFFF));
+        putLe16(static_cast<uint16_t>(value >> 16));
+    }
+
+    void finish() {
+        if (pendingCount) {
+            memset(pending + pendingCount, 0, sizeof(pending) - pendingCount);
+            writeGroup(pendingCount);
+            pendingCount = 0;
+        }
+        if (groupsOnLine) {
+            Serial.write('\n');
+            groupsOnLine = 0;
+        }
+    }
+
+    // Value for the "end" marker line.
+    uint32_t digest() const { return ~crc; }
+};
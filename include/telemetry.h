@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "fpl_config.h"
+
+// Periodic system samples (per-core load, per-task CPU share and free stack,
+// internal/PSRAM heap and largest free block) kept in a ring buffer. The
+// `stats` serial command prints min/max/trend over the ring; a fragmented or
+// low internal heap is logged when a sample sees it.
+#if FPL_TELEMETRY_ENABLED
+
+// Tasks whose stack and CPU share are tracked; call once per task after creating it.
+void telemetryRegisterTask(const char *name, TaskHandle_t task);
+// Takes a sample when FPL_TELEMETRY_INTERVAL_MS has passed. Called from loop().
+void telemetryTick(uint32_t nowMs);
+void telemetryPrintStats();
+
+#else
+
+inline void telemetryRegisterTask(const char *, TaskHandle_t) {}
+inline void telemetryTick(uint32_t) {}
+inline void telemetryPrintStats() { Serial.println("[STATS] disabled (FPL_TELEMETRY_ENABLED=0)"); }
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "fpl_config.h"
+
+// Span tracer: begin/end events go into a PSRAM ring as 8-byte records
+// (timestamp, span, task, core, argument) and are streamed over serial by the
+// `trace` command. tools/trace_to_chrome.py turns the dump into Chrome Trace
+// Event JSON for Perfetto. Recording is lock-free and safe from any task.
+enum class TraceSpan : uint8_t {
+    Poll,     // one runPollPipeline() pass
+    Fetch,    // one endpoint download, queue excluded; arg = FetchEndpoint
+    HttpGet,  // connect + TLS + request until the status line
+    Body,     // reading the response body into PSRAM
+    Parse,    // deserializeJson(); arg = FetchEndpoint
+    Diff,     // detectAndNotify* over the squad
+    Publish,  // TeamSnapshot handed to the UI
+    Popup,    // showing one notification popup; arg = ms it waited in the queue
+    Render,   // vsync-paced lv_refr_now()
+    Flush,    // lvglFlushCb for one area
+    Count
+};
+
+#if FPL_TRACE_ENABLED
+
+// Allocates the ring; until then (or if PSRAM is short) every call is a no-op.
+void traceInit();
+void traceBegin(TraceSpan span, uint16_t arg = 0);
+void traceEnd(TraceSpan span, uint16_t arg = 0);
+void traceSetRecording(bool on);
+void traceClear();
+// Writes "[TRACE] begin ..." / base64 records / "[TRACE] end ..."; recording
+// pauses for the dump and the ring is kept.
+void traceDump();
+
+#else
+
+inline void traceInit() {}
+inline void traceBegin(TraceSpan, uint16_t = 0) {}
+inline void traceEnd(TraceSpan, uint16_t = 0) {}
+inline void traceSetRecording(bool) {}
+inline void traceClear() {}
+inline void traceDump() { Serial.println("[TRACE] disabled (FPL_TRACE_ENABLED=0)"); }
+
+#endif
+
+// Begin on construction, end when the scope closes.
+class TraceScope {
+   public:
+    explicit TraceScope(TraceSpan span, uint16_t arg = 0) : span_(span), arg_(arg) { traceBegin(span_, arg_); }
+    ~TraceScope() { traceEnd(span_, arg_); }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+   private:
+    TraceSpan span_;
+    uint16_t arg_;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Mirrors flushed strips into a PSRAM framebuffer while a capture is open and
+// streams the finished frame over serial, where tools/ui_shots.py turns it into
+// a PNG for golden-image comparison. The buffer is only allocated on first use.
+bool uiCaptureBegin(uint16_t width, uint16_t height);
+bool uiCaptureActive();
+// Flush callback, before any masking: RGB565, or RGB565_SWAPPED with `swapped`.
+// The frame is kept in native order either way.
+void uiCaptureArea(int x, int y, int w, int h, const uint8_t *pixels, bool swapped = false);
+// Writes the frame as "[SHOT] begin ..." / base64 lines / "[SHOT] end ..." and closes the capture.
+void uiCaptureDump(const char *name);
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// UI state shared by uiTask, fplTask's mirror and the boot snapshot. Plain
+// data only, so the snapshot codec and host tests can use it without LVGL.
+
+static constexpr size_t kMaxUiEvents = 24;
+static constexpr size_t kMaxPopupEvents = 8;
+static constexpr size_t kMaxSquadRows = 16;
+
+enum class UiMode {
+    Idle,
+    Deadline,
+    FinalHour,
+    Live,
+    EventPopup,
+    EventsList,
+    Squad
+};
+
+static constexpr size_t kUiModeCount = static_cast<size_t>(UiMode::Squad) + 1;
+// Short names for logs and `shots` file names, indexed by UiMode.
+static constexpr const char *kUiModeNames[kUiModeCount] = {"idle", "deadline", "final", "live", "popup", "events", "squad"};
+
+struct UiEventItem {
+    char icon[8] = "";
+    char label[24] = "";
+    char player[24] = "";
+    char team[24] = "";
+    int delta = 0;
+    int totalBefore = 0;
+    int totalAfter = 0;
+    bool isGk = false;
+    uint32_t epochMs = 0;
+};
+
+struct UiSquadRow {
+    char player[24] = "";
+    char team[24] = "";
+    char breakdown[32] = "";
+    int points = 0;
+    bool hasPlayed = false;
+    bool isCaptain = false;
+    bool isViceCaptain = false;
+    bool isBench = false;
+    bool isGk = false;
+};
+
+// Payload of BusTopic::UiSquadRow: row `index` of a squad of `count` rows.
+struct SquadRowMsg {
+    uint8_t index;
+    uint8_t count;
+    UiSquadRow row;
+};
+
+struct UiRuntimeState {
+    UiEventItem recentEvents[kMaxUiEvents];
+    size_t recentEventCount = 0;
+    UiEventItem popupQueue[kMaxPopupEvents];
+    size_t popupHead = 0;
+    size_t popupTail = 0;
+    size_t popupCount = 0;
+    UiSquadRow squadRows[kMaxSquadRows];
+    size_t squadCount = 0;
+    uint32_t eventVersion = 0;
+    uint32_t squadVersion = 0;
+};
+
+struct SharedUiState {
+    int gwPoints = 0;
+    bool hasGwPoints = false;
+    int overallRank = 0;
+    int rankDiff = 0;
+    bool hasRankData = false;
+    uint32_t statusColor = 0xFFFFFF;
+    char statusText[48] = "Booting...";
+    char gwStateText[48] = "GW live: ? | next: --";
+    int nextGw = 0;
+    bool hasNextGw = false;
+    time_t nextDeadlineUtc = 0;
+    bool hasNextDeadline = false;
+    bool isLiveGw = false;
+    int currentGw = 0;
+    int totalPoints = 0;
+    bool hasTotalPoints = false;
+    bool isStale = false;
+    uint32_t lastApiUpdateMs = 0;
+    uint32_t version = 0;
+};
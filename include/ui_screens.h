@@ -0,0 +1,46 @@
+#pragma once
+
+#include <lvgl.h>
+
+#include "ui_model.h"
+
+// The seven screens: widgets, layout and the per-screen updates from
+// SharedUiState/UiRuntimeState. uiTask only (see the threading note in
+// main.cpp); nothing here touches the panel, so the host tests drive it
+// against an in-memory display.
+
+// The layout is drawn for the 412x412 round panel.
+static constexpr uint16_t kUiScreenWidth = 412;
+static constexpr uint16_t kUiScreenHeight = 412;
+
+// What the screens need from the rest of the application: the kit image for
+// the popup and the squad screen's demo buttons.
+struct UiScreenHooks {
+    const lv_image_dsc_t *(*kitImage)(const char *team, bool isGk) = nullptr;
+    void (*notificationDemo)() = nullptr;
+    void (*deadlineDemo)(int32_t secondsToDeadline) = nullptr;
+};
+
+// Builds every screen and shows Idle. Call once the LVGL display exists.
+void createUi(const UiScreenHooks &hooks);
+UiMode currentUiMode();
+void loadMode(UiMode mode, lv_screen_load_anim_t anim);
+// The screen the data asks for; the overlays (lists, popup) are left alone.
+UiMode determineAutoMode(const SharedUiState &state);
+// Only the screen on display is touched; a hidden screen catches up when
+// loadMode switches to it, before the next render.
+void updateModeUi(const SharedUiState &state, const UiRuntimeState &runtime);
+void bindPopupEvent(const UiEventItem &event);
+// Milliseconds until the screen on display changes without new data
+// (countdown second, colon blink, live pulse, ticker rotation) or
+// determineAutoMode() picks another screen.
+uint32_t msUntilScreenChange(const SharedUiState &state, const UiRuntimeState &runtime, uint32_t nowMs);
+
+// Fixed data for `shots` and the host tests, so every run draws the same frames.
+void fillUiShotEvent(UiEventItem &event, const char *icon, const char *label, const char *player,
+                     const char *team, int delta, int totalBefore);
+void fillUiShotFixture(SharedUiState &state, UiRuntimeState &runtime);
+// Restarts the live ticker at the newest event.
+void resetLiveTicker(uint32_t nowMs);
+// Makes the next updateModeUi() rebind the event and squad lists from scratch.
+void invalidateUiLists();
@@ -8,18 +8,43 @@
 #include <cstring>
 #include <esp_heap_caps.h>
 #include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "esp_lcd_spd2010.h"
 
 static const char *TAG = "SPD2010";
 
-SPD2010Display::SPD2010Display() : _panel(nullptr), _io(nullptr), _initialized(false) {
+SPD2010Display::SPD2010Display()
+    : _panel(nullptr),
+      _io(nullptr),
+      _initialized(false),
+      _chunkBuf{nullptr, nullptr},
+      _chunkBufPixels(0),
+      _panelResets(0),
+      _bytesQueued(0) {
+    spd2010BuildChordTable(_chords);
 }
 
 SPD2010Display::~SPD2010Display() {
     if (_panel) {
+        _pipeline.waitIdle(SPD2010_DMA_TIMEOUT_MS);
         esp_lcd_panel_del(_panel);
         _panel = nullptr;
     }
+    for (uint16_t *&buf : _chunkBuf) {
+        if (buf) {
+            heap_caps_free(buf);
+            buf = nullptr;
+        }
+    }
+}
+
+bool SPD2010Display::onColorTransDone(esp_lcd_panel_io_handle_t, esp_lcd_panel_io_event_data_t *, void *user_ctx) {
+    return static_cast<SPD2010Display *>(user_ctx)->_pipeline.onTransferDone();
+}
+
+bool SPD2010Display::submitWindow(void *target, int x1, int y1, int x2, int y2, const void *pixels) {
+    return esp_lcd_panel_draw_bitmap(static_cast<esp_lcd_panel_handle_t>(target), x1, y1, x2, y2, pixels) == ESP_OK;
 }
 
 void SPD2010Display::expanderWrite(uint8_t pin, uint8_t value) {
@@ -83,8 +108,8 @@ bool SPD2010Display::initPanel() {
     io_config.spi_mode = 3;
     io_config.pclk_hz = 40 * 1000 * 1000;
     io_config.trans_queue_depth = 10;
-    io_config.on_color_trans_done = nullptr;
-    io_config.user_ctx = nullptr;
+    io_config.on_color_trans_done = onColorTransDone;
+    io_config.user_ctx = this;
     io_config.lcd_cmd_bits = 32;
     io_config.lcd_param_bits = 8;
     io_config.flags.dc_low_on_data = 0;
@@ -122,18 +147,45 @@ bool SPD2010Display::initPanel() {
     ESP_ERROR_CHECK(esp_lcd_panel_init(_panel));
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(_panel, true));
 
+    _pipeline.setTarget(_panel);
     return true;
 }
 
+/* A transfer-done interrupt never arrived. Deleting the panel IO stops its ISR for
+ * good, so the pipeline can then write off the lost transfers without racing it. */
+void SPD2010Display::recoverPanel() {
+    ESP_LOGE(TAG, "DMA completion timeout (%u queued, %u done), resetting panel IO",
+             static_cast<unsigned>(_pipeline.queued()), static_cast<unsigned>(_pipeline.done()));
+    if (_panel) {
+        esp_lcd_panel_del(_panel);
+        _panel = nullptr;
+    }
+    if (_io) {
+        esp_lcd_panel_io_del(_io);
+        _io = nullptr;
+    }
+    _pipeline.setTarget(nullptr);
+    _pipeline.reset();
+    _panelResets++;
+    if (!initPanel()) {
+        ESP_LOGE(TAG, "panel re-init failed");
+    }
+}
+
 bool SPD2010Display::begin() {
     ESP_LOGI(TAG, "Initializing SPD2010 display %dx%d", SPD2010_WIDTH, SPD2010_HEIGHT);
 
     Wire.begin(SPD2010_TOUCH_SDA, SPD2010_TOUCH_SCL, 400000);
     resetDisplay();
 
-    pinMode(SPD2010_TE_PIN, OUTPUT);
+    pinMode(SPD2010_TE_PIN, INPUT);
 
-    if (!initPanel()) {
+    if (!_pipeline.begin(submitWindow, nullptr) || !initPanel()) {
+        return false;
+    }
+
+    if (!ensureChunkBuffers(static_cast<size_t>(SPD2010_WIDTH) * SPD2010_CHUNK_ROWS)) {
+        ESP_LOGE(TAG, "DMA chunk buffer allocation failed");
         return false;
     }
 
@@ -152,7 +204,7 @@ void SPD2010Display::fillScreen(uint16_t color) {
         return;
     }
 
-    const uint16_t swapped = static_cast<uint16_t>((color >> 8) | (color << 8));
+    const uint16_t swapped = spd2010Swap16(color);
     uint16_t *line = static_cast<uint16_t *>(heap_caps_malloc(SPD2010_WIDTH * sizeof(uint16_t), MALLOC_CAP_DMA));
     if (!line) {
         ESP_LOGE(TAG, "fillScreen buffer allocation failed");
@@ -164,85 +216,190 @@ void SPD2010Display::fillScreen(uint16_t color) {
     }
 
     for (int y = 0; y < SPD2010_HEIGHT; ++y) {
-        esp_lcd_panel_draw_bitmap(_panel, 0, y, SPD2010_WIDTH, y + 1, line);
+        _pipeline.queue(0, y, SPD2010_WIDTH, y + 1, line, -1, false, nullptr, nullptr);
     }
 
+    waitIdle();
     heap_caps_free(line);
 }
 
-void SPD2010Display::drawBitmap(int x, int y, int w, int h, const uint8_t *data) {
-    if (!_initialized || !_panel || !data || w <= 0 || h <= 0) {
-        return;
+bool SPD2010Display::ensureChunkBuffers(size_t pixels) {
+    if (_chunkBuf[0] && _chunkBuf[1] && _chunkBufPixels >= pixels) {
+        return true;
     }
 
-    if (x < 0 || y < 0 || (x + w) > SPD2010_WIDTH || (y + h) > SPD2010_HEIGHT) {
-        return;
+    waitIdle();
+    for (uint16_t *&buf : _chunkBuf) {
+        if (buf) {
+            heap_caps_free(buf);
+            buf = nullptr;
+        }
     }
+    _chunkBufPixels = 0;
 
-    // SPD2010 requires X window aligned to 4 pixels.
-    const int x1_aligned = x & ~0x3;
-    const int x2_raw = x + w - 1;
-    int x2_aligned = x2_raw | 0x3;
-    if (x2_aligned >= SPD2010_WIDTH) {
-        x2_aligned = SPD2010_WIDTH - 1;
+    for (uint16_t *&buf : _chunkBuf) {
+        buf = static_cast<uint16_t *>(heap_caps_malloc(pixels * sizeof(uint16_t), MALLOC_CAP_DMA));
+        if (!buf) {
+            return false;
+        }
     }
+    _chunkBufPixels = pixels;
+    return true;
+}
 
-    const int out_w = x2_aligned - x1_aligned + 1;
-    const int left_pad = x - x1_aligned;
+void SPD2010Display::waitIdle() {
+    if (!_pipeline.waitIdle(SPD2010_DMA_TIMEOUT_MS)) {
+        recoverPanel();
+    }
+}
+
+void SPD2010Display::clampWindowToVisible(int32_t y1, int32_t y2, int32_t &x1, int32_t &x2) const {
+#if SPD2010_ROUND_MASK
+    spd2010ClampWindowToVisible(_chords, y1, y2, x1, x2);
+#else
+    (void)y1;
+    (void)y2;
+    (void)x1;
+    (void)x2;
+#endif
+}
+
+bool SPD2010Display::queueWindow(int x1, int y1, int x2, int y2, const void *pixels, int slot, bool last,
+                                 SPD2010FlushDoneCb done, void *ctx) {
+    if (!_pipeline.queue(x1, y1, x2, y2, pixels, slot, last, done, ctx)) {
+        ESP_LOGE(TAG, "draw queue failed at row %d", y1);
+        // Earlier windows may still be reading the caller's buffer.
+        waitIdle();
+        return false;
+    }
+    _bytesQueued += static_cast<uint32_t>(x2 - x1) * (y2 - y1) * sizeof(uint16_t);
+    return true;
+}
 
-    // Reusable chunk buffer to avoid large per-flush allocations and fragmentation.
-    static uint16_t *draw_buf = nullptr;
-    static size_t draw_buf_pixels = 0;
-
-    int chunk_rows = (h < 16) ? h : 16;
-    while (chunk_rows > 0) {
-        const size_t required_pixels = static_cast<size_t>(out_w) * static_cast<size_t>(chunk_rows);
-        if (draw_buf_pixels < required_pixels) {
-            uint16_t *new_buf = static_cast<uint16_t *>(
-                heap_caps_malloc(required_pixels * sizeof(uint16_t), MALLOC_CAP_DMA));
-            if (new_buf) {
-                if (draw_buf) {
-                    heap_caps_free(draw_buf);
-                }
-                draw_buf = new_buf;
-                draw_buf_pixels = required_pixels;
+bool SPD2010Display::drawBitmapDirect(int x, int y, int w, int h, uint8_t *data, SPD2010FlushDoneCb done,
+                                      void *ctx) {
+    if (!_initialized || !_panel || !data || w <= 0 || h <= 0) {
+        return false;
+    }
+
+    if (x < 0 || y < 0 || (x + w) > SPD2010_WIDTH || (y + h) > SPD2010_HEIGHT || !isWindowXAligned(x, w)) {
+        return false;
+    }
+
+#if SPD2010_ROUND_MASK
+    // Consecutive rows with the same visible span form one window. Rows are packed in
+    // place, band after band: the write cursor never passes unread source rows, and a
+    // band already queued for DMA is never written again.
+    uint16_t *pixels = reinterpret_cast<uint16_t *>(data);
+    uint16_t *out = pixels;
+    const uint16_t *band_pixels = nullptr;
+    int band_y = 0;
+    int band_rows = 0;
+    int band_left = 0;
+    int band_right = -1;
+
+    for (int row = 0; row < h; ++row) {
+        const int left = (_chords.left[y + row] > x) ? _chords.left[y + row] : x;
+        const int right = (_chords.right[y + row] < x + w - 1) ? _chords.right[y + row] : (x + w - 1);
+        const bool visible = left <= right;
+
+        if (band_pixels && (!visible || left != band_left || right != band_right)) {
+            if (!queueWindow(band_left, y + band_y, band_right + 1, y + band_y + band_rows, band_pixels, -1, false,
+                             nullptr, nullptr)) {
+                return false;
             }
+            band_pixels = nullptr;
+        }
+        if (!visible) {
+            continue;
+        }
+        if (!band_pixels) {
+            band_pixels = out;
+            band_y = row;
+            band_rows = 0;
+            band_left = left;
+            band_right = right;
         }
 
-        if (draw_buf_pixels >= required_pixels && draw_buf) {
-            break;
+        const int span = right - left + 1;
+        const uint16_t *src = pixels + row * w + (left - x);
+        if (out != src) {
+            memmove(out, src, span * sizeof(uint16_t));
         }
-        chunk_rows /= 2;
+        out += span;
+        ++band_rows;
     }
 
-    if (chunk_rows <= 0 || !draw_buf) {
-        ESP_LOGE(TAG, "drawBitmap buffer allocation failed");
-        return;
+    if (!band_pixels) {
+        return false;  // Strip lies entirely in the masked corners.
+    }
+    return queueWindow(band_left, y + band_y, band_right + 1, y + band_y + band_rows, band_pixels, -1, true, done,
+                       ctx);
+#else
+    return queueWindow(x, y, x + w, y + h, data, -1, true, done, ctx);
+#endif
+}
+
+void SPD2010Display::drawBitmap(int x, int y, int w, int h, const uint8_t *data) {
+    if (drawBitmapAsync(x, y, w, h, data, nullptr, nullptr)) {
+        waitIdle();
+    }
+}
+
+bool SPD2010Display::drawBitmapAsync(int x, int y, int w, int h, const uint8_t *data, SPD2010FlushDoneCb done,
+                                     void *ctx) {
+    if (!_initialized || !_panel || !data || w <= 0 || h <= 0) {
+        return false;
+    }
+
+    if (x < 0 || y < 0 || (x + w) > SPD2010_WIDTH || (y + h) > SPD2010_HEIGHT) {
+        return false;
+    }
+
+    // SPD2010 requires X window aligned to 4 pixels.
+    int32_t x1_aligned = x;
+    int32_t x2_aligned = x + w - 1;
+    alignWindowX(x1_aligned, x2_aligned);
+
+    const int out_w = x2_aligned - x1_aligned + 1;
+    const int left_pad = x - x1_aligned;
+
+    if (!_chunkBuf[0] || !_chunkBuf[1]) {
+        ESP_LOGE(TAG, "drawBitmap buffers missing");
+        return false;
+    }
+    int chunk_rows = static_cast<int>(_chunkBufPixels / static_cast<size_t>(out_w));
+    if (chunk_rows > SPD2010_CHUNK_ROWS) {
+        chunk_rows = SPD2010_CHUNK_ROWS;
+    }
+    if (chunk_rows > h) {
+        chunk_rows = h;
     }
 
+    // Ping-pong: chunk N+1 is swapped into one buffer while chunk N is still on the
+    // wire from the other. A buffer is only rewritten once its own transfer is done.
     const uint16_t *src = reinterpret_cast<const uint16_t *>(data);
     for (int row_start = 0; row_start < h; row_start += chunk_rows) {
         const int rows = ((row_start + chunk_rows) <= h) ? chunk_rows : (h - row_start);
+        const int slot = _pipeline.acquireSlot(SPD2010_DMA_TIMEOUT_MS);
+        if (slot < 0) {
+            // Earlier chunks of this call were queued without `done`, so none is armed.
+            recoverPanel();
+            return false;
+        }
+        uint16_t *draw_buf = _chunkBuf[slot];
 
         for (int row = 0; row < rows; ++row) {
-            for (int col = 0; col < out_w; ++col) {
-                int src_col = col - left_pad;
-                if (src_col < 0) src_col = 0;
-                if (src_col >= w) src_col = w - 1;
-
-                const uint16_t px = src[(row_start + row) * w + src_col];
-                draw_buf[row * out_w + col] = static_cast<uint16_t>((px >> 8) | (px << 8));
-            }
+            spd2010ExtractRow(draw_buf + row * out_w, src + (row_start + row) * w, w, left_pad, out_w);
         }
 
-        esp_lcd_panel_draw_bitmap(
-            _panel,
-            x1_aligned,
-            y + row_start,
-            x2_aligned + 1,
-            y + row_start + rows,
-            draw_buf);
+        const bool last = (row_start + rows) >= h;
+        if (!queueWindow(x1_aligned, y + row_start, x2_aligned + 1, y + row_start + rows, draw_buf, slot, last, done,
+                         ctx)) {
+            return false;
+        }
     }
+    return true;
 }
 
 void SPD2010Display::setBacklight(uint8_t brightness) {
@@ -13,18 +13,7 @@
 #include <esp_lcd_panel_io.h>
 #include <esp_lcd_panel_ops.h>
 
-/* Display dimensions (override via build flags DISPLAY_WIDTH / DISPLAY_HEIGHT) */
-#ifdef DISPLAY_WIDTH
-#define SPD2010_WIDTH DISPLAY_WIDTH
-#else
-#define SPD2010_WIDTH 412
-#endif
-
-#ifdef DISPLAY_HEIGHT
-#define SPD2010_HEIGHT DISPLAY_HEIGHT
-#else
-#define SPD2010_HEIGHT 412
-#endif
+#include "SPD2010Flush.h"
 
 /* QSPI pins */
 #define SPD2010_QSPI_CS     21
@@ -49,6 +38,19 @@
 #define SPD2010_EXIO_LCD_RST    2
 #define SPD2010_EXIO_TP_RST     1
 
+/* Rows byte-swapped per DMA chunk; two chunk buffers alternate (ping-pong). */
+#define SPD2010_CHUNK_ROWS  16
+
+/* A transfer that has not completed by then is treated as lost and the panel IO is reset. */
+#ifndef SPD2010_DMA_TIMEOUT_MS
+#define SPD2010_DMA_TIMEOUT_MS  100
+#endif
+
+/* Round panel: skip the corners outside the inscribed circle when flushing. */
+#ifndef SPD2010_ROUND_MASK
+#define SPD2010_ROUND_MASK  1
+#endif
+
 class SPD2010Display {
 public:
     SPD2010Display();
@@ -56,20 +58,57 @@ public:
 
     bool begin();
     void drawBitmap(int x, int y, int w, int h, const uint8_t *data);
+    /* Queues the bitmap and returns once the source has been consumed; `done` fires
+     * when the final transfer completes. Returns false (and never calls `done`)
+     * if nothing was queued. */
+    bool drawBitmapAsync(int x, int y, int w, int h, const uint8_t *data, SPD2010FlushDoneCb done, void *ctx);
+    /* Zero-copy variant: `data` must already be big-endian RGB565 in DMA-capable
+     * memory and stay untouched until `done` fires. x and w must be multiples of 4.
+     * With SPD2010_ROUND_MASK, rows are packed in place to their visible span, so the
+     * buffer contents are consumed. Returns false if nothing was queued. */
+    bool drawBitmapDirect(int x, int y, int w, int h, uint8_t *data, SPD2010FlushDoneCb done, void *ctx);
+    void waitIdle();
     void fillScreen(uint16_t color);
     void setBacklight(uint8_t brightness);
 
     int getWidth() { return SPD2010_WIDTH; }
     int getHeight() { return SPD2010_HEIGHT; }
 
+    /* Widens [x1, x2] (inclusive) to the controller's 4-pixel column rule. */
+    static void alignWindowX(int32_t &x1, int32_t &x2) { spd2010AlignWindowX(x1, x2); }
+    static bool isWindowXAligned(int x, int w) { return spd2010WindowXAligned(x, w); }
+    /* Shrinks [x1, x2] to the widest visible chord over rows y1..y2 (round mask only). */
+    void clampWindowToVisible(int32_t y1, int32_t y2, int32_t &x1, int32_t &x2) const;
+    /* QSPI payload of one full-screen redraw with the round mask applied. */
+    uint32_t maskedFrameBytes() const { return _chords.maskedFrameBytes; }
+    /* Running total of pixel bytes handed to the panel by the draw paths. */
+    uint32_t bytesQueued() const { return _bytesQueued; }
+    /* Panel IO resets after a transfer completion went missing. */
+    uint32_t panelResets() const { return _panelResets; }
+
 private:
     esp_lcd_panel_handle_t _panel;
     esp_lcd_panel_io_handle_t _io;
     bool _initialized;
 
+    uint16_t *_chunkBuf[SPD2010ChunkPipeline::kSlots];
+    size_t _chunkBufPixels;
+    SPD2010ChunkPipeline _pipeline;
+    uint32_t _panelResets;
+
+    SPD2010ChordTable _chords;
+    uint32_t _bytesQueued;
+
     void resetDisplay();
     bool initPanel();
+    void recoverPanel();
     void expanderWrite(uint8_t pin, uint8_t value);
+    bool ensureChunkBuffers(size_t pixels);
+    bool queueWindow(int x1, int y1, int x2, int y2, const void *pixels, int slot, bool last,
+                     SPD2010FlushDoneCb done, void *ctx);
+
+    static bool submitWindow(void *target, int x1, int y1, int x2, int y2, const void *pixels);
+    static bool onColorTransDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 };
 
 class SPD2010Touch {
@@ -0,0 +1,233 @@
+/**
+ * SPD2010Flush.cpp - window alignment, swap kernels and chunk sequencing for
+ * the SPD2010 flush path.
+ */
+
+#include "SPD2010Flush.h"
+
+#include <math.h>
+
+void spd2010AlignWindowX(int32_t &x1, int32_t &x2) {
+    x1 &= ~0x3;
+    x2 |= 0x3;
+    if (x2 >= SPD2010_WIDTH) {
+        x2 = SPD2010_WIDTH - 1;
+    }
+}
+
+void spd2010BuildChordTable(SPD2010ChordTable &table) {
+    // Row y spans [y, y + 1]; keep any pixel the panel's inscribed circle touches,
+    // measured from the row edge nearest the centre, then widen to 4-pixel columns.
+    const float cx = SPD2010_WIDTH * 0.5f;
+    const float cy = SPD2010_HEIGHT * 0.5f;
+    const float r = (SPD2010_WIDTH < SPD2010_HEIGHT ? SPD2010_WIDTH : SPD2010_HEIGHT) * 0.5f;
+    table.maskedFrameBytes = 0;
+    for (int y = 0; y < SPD2010_HEIGHT; ++y) {
+        const float d0 = fabsf(static_cast<float>(y) - cy);
+        const float d1 = fabsf(static_cast<float>(y + 1) - cy);
+        const float dy = (d0 < d1) ? d0 : d1;
+        const float half = (dy < r) ? sqrtf(r * r - dy * dy) : 0.0f;
+
+        int32_t left = static_cast<int32_t>(floorf(cx - half));
+        int32_t right = static_cast<int32_t>(ceilf(cx + half)) - 1;
+        if (left < 0) left = 0;
+        if (right < left) right = left;
+        spd2010AlignWindowX(left, right);
+        table.left[y] = static_cast<int16_t>(left);
+        table.right[y] = static_cast<int16_t>(right);
+        table.maskedFrameBytes += static_cast<uint32_t>(right - left + 1) * sizeof(uint16_t);
+    }
+}
+
+void spd2010ClampWindowToVisible(const SPD2010ChordTable &table, int32_t y1, int32_t y2, int32_t &x1, int32_t &x2) {
+    if (y1 < 0) y1 = 0;
+    if (y2 >= SPD2010_HEIGHT) y2 = SPD2010_HEIGHT - 1;
+    if (y1 > y2) {
+        return;
+    }
+
+    int32_t left = table.left[y1];
+    int32_t right = table.right[y1];
+    for (int32_t y = y1 + 1; y <= y2; ++y) {
+        if (table.left[y] < left) left = table.left[y];
+        if (table.right[y] > right) right = table.right[y];
+    }
+    // A corner-only area has no visible pixels; leave it alone rather than hand LVGL
+    // an inverted rectangle. The masked flush will send nothing for it.
+    if (x2 < left || x1 > right) {
+        return;
+    }
+    if (x1 < left) x1 = left;
+    if (x2 > right) x2 = right;
+}
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SPD2010_SWAP_KERNEL "sse2"
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SPD2010_SWAP_KERNEL "neon"
+#else
+#define SPD2010_SWAP_KERNEL "scalar"
+#endif
+
+/* One pixel per step. A 32-bit SWAR variant measured slower than this on the
+ * host (0.75x on even lengths, 0.95x on odd) and there is no device
+ * measurement showing it wins on Xtensa, so the plain loop is the fallback. */
+void spd2010SwapRunScalar(uint16_t *dst, const uint16_t *src, int n) {
+    for (int i = 0; i < n; ++i) {
+        dst[i] = spd2010Swap16(src[i]);
+    }
+}
+
+/* Host builds take eight pixels per step with unaligned 128-bit loads and
+ * finish the tail with the scalar loop. The device keeps the scalar loop:
+ * it only serves the padded fallback for areas that bypassed the rounder
+ * (the normal flush goes straight from LVGL's buffer), and an S3 PIE version
+ * would need hand-written EE.* assembly with 16-byte aligned loads that
+ * nothing here can check off-target. */
+void spd2010SwapRun(uint16_t *dst, const uint16_t *src, int n) {
+#if defined(__SSE2__)
+    for (; n >= 8; n -= 8, dst += 8, src += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(__ARM_NEON)
+    for (; n >= 8; n -= 8, dst += 8, src += 8) {
+        vst1q_u8(reinterpret_cast<uint8_t *>(dst), vrev16q_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(src))));
+    }
+#endif
+    spd2010SwapRunScalar(dst, src, n);
+}
+
+const char *spd2010SwapKernelName() {
+    return SPD2010_SWAP_KERNEL;
+}
+
+static void fillRun(uint16_t *dst, uint16_t px, int n) {
+    for (int i = 0; i < n; ++i) {
+        dst[i] = px;
+    }
+}
+
+void spd2010ExtractRow(uint16_t *dst, const uint16_t *src, int w, int left_pad, int out_w) {
+    const int right_pad = out_w - left_pad - w;
+    fillRun(dst, spd2010Swap16(src[0]), left_pad);
+    spd2010SwapRun(dst + left_pad, src, w);
+    fillRun(dst + left_pad + w, spd2010Swap16(src[w - 1]), right_pad);
+}
+
+SPD2010ChunkPipeline::SPD2010ChunkPipeline()
+    : _submit(nullptr),
+      _target(nullptr),
+      _doneSem(nullptr),
+      _nextSlot(0),
+      _slotSeq{0, 0},
+      _timeouts(0),
+      _queued(0),
+      _done(0),
+      _flushEnd(0),
+      _flushDoneCb(nullptr),
+      _flushDoneCtx(nullptr) {
+}
+
+SPD2010ChunkPipeline::~SPD2010ChunkPipeline() {
+    if (_doneSem) {
+        vSemaphoreDelete(_doneSem);
+        _doneSem = nullptr;
+    }
+}
+
+bool SPD2010ChunkPipeline::begin(SPD2010SubmitFn submit, void *target) {
+    _submit = submit;
+    _target = target;
+    if (!_doneSem) {
+        _doneSem = xSemaphoreCreateBinary();
+    }
+    return _doneSem != nullptr;
+}
+
+bool SPD2010ChunkPipeline::onTransferDone() {
+    const uint32_t done = _done.load(std::memory_order_relaxed) + 1;
+    _done.store(done, std::memory_order_release);
+
+    if (done == _flushEnd.load(std::memory_order_acquire)) {
+        void *ctx = _flushDoneCtx;
+        const SPD2010FlushDoneCb cb = _flushDoneCb.exchange(nullptr);
+        if (cb) {
+            cb(ctx);
+        }
+    }
+
+    BaseType_t woken = pdFALSE;
+    if (_doneSem) {
+        xSemaphoreGiveFromISR(_doneSem, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+bool SPD2010ChunkPipeline::waitFor(uint32_t seq, uint32_t timeout_ms) {
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t limit = pdMS_TO_TICKS(timeout_ms);
+    while (spd2010SeqBefore(done(), seq)) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= limit) {
+            // The ISR may have landed between the check and the clock read.
+            if (!spd2010SeqBefore(done(), seq)) {
+                return true;
+            }
+            _timeouts++;
+            return false;
+        }
+        // A give left over from an earlier completion only costs one extra pass.
+        xSemaphoreTake(_doneSem, limit - elapsed);
+    }
+    return true;
+}
+
+int SPD2010ChunkPipeline::acquireSlot(uint32_t timeout_ms) {
+    const uint8_t slot = _nextSlot;
+    if (!waitFor(_slotSeq[slot], timeout_ms)) {
+        return -1;
+    }
+    _nextSlot = static_cast<uint8_t>((slot + 1) % kSlots);
+    return slot;
+}
+
+bool SPD2010ChunkPipeline::queue(int x1, int y1, int x2, int y2, const void *pixels, int slot, bool last,
+                                 SPD2010FlushDoneCb done, void *ctx) {
+    const uint32_t seq = queued() + 1;
+    if (last && done) {
+        _flushDoneCtx = ctx;
+        _flushEnd.store(seq, std::memory_order_release);
+        _flushDoneCb.store(done, std::memory_order_release);
+    }
+    // Publish the sequence number before the transfer can complete.
+    _queued.store(seq, std::memory_order_release);
+    if (!_submit || !_submit(_target, x1, y1, x2, y2, pixels)) {
+        // Nothing went on the wire, so no completion will arrive for this sequence number.
+        _flushDoneCb.store(nullptr, std::memory_order_release);
+        _queued.store(seq - 1, std::memory_order_release);
+        return false;
+    }
+    if (slot >= 0 && slot < kSlots) {
+        _slotSeq[slot] = seq;
+    }
+    return true;
+}
+
+bool SPD2010ChunkPipeline::waitIdle(uint32_t timeout_ms) {
+    return waitFor(queued(), timeout_ms);
+}
+
+void SPD2010ChunkPipeline::reset() {
+    _done.store(queued(), std::memory_order_release);
+    void *ctx = _flushDoneCtx;
+    const SPD2010FlushDoneCb cb = _flushDoneCb.exchange(nullptr);
+    if (cb) {
+        cb(ctx);
+    }
+    if (_doneSem) {
+        xSemaphoreTake(_doneSem, 0);
+    }
+}
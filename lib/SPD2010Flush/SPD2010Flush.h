@@ -0,0 +1,130 @@
+/**
+ * SPD2010Flush.h - hardware-free half of the SPD2010 flush path.
+ * Window alignment, the round-panel chord table, the RGB565 byte-swap
+ * kernels, and sequencing of the
+ * ping-pong chunk buffers against the panel's transfer-done interrupt.
+ * Nothing here touches ESP-IDF, so it also builds for host tests; the panel
+ * IO is reached only through the submit callback.
+ */
+
+#ifndef SPD2010_FLUSH_H
+#define SPD2010_FLUSH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/* Display dimensions (override via build flags DISPLAY_WIDTH / DISPLAY_HEIGHT) */
+#ifdef DISPLAY_WIDTH
+#define SPD2010_WIDTH DISPLAY_WIDTH
+#else
+#define SPD2010_WIDTH 412
+#endif
+
+#ifdef DISPLAY_HEIGHT
+#define SPD2010_HEIGHT DISPLAY_HEIGHT
+#else
+#define SPD2010_HEIGHT 412
+#endif
+
+/* Widens [x1, x2] (inclusive) to the controller's 4-pixel column rule. */
+void spd2010AlignWindowX(int32_t &x1, int32_t &x2);
+static inline bool spd2010WindowXAligned(int x, int w) {
+    return ((x | w) & 0x3) == 0;
+}
+
+static inline uint16_t spd2010Swap16(uint16_t px) {
+    return static_cast<uint16_t>((px >> 8) | (px << 8));
+}
+
+/* Byte-swaps n RGB565 pixels; any alignment of dst and src. Uses the widest
+ * kernel the target has (see spd2010SwapKernelName). */
+void spd2010SwapRun(uint16_t *dst, const uint16_t *src, int n);
+/* The one-pixel-per-step loop that spd2010SwapRun falls back to. */
+void spd2010SwapRunScalar(uint16_t *dst, const uint16_t *src, int n);
+const char *spd2010SwapKernelName();
+/* One strip row: [left pad | w swapped source pixels | right pad]. Padding
+ * repeats the nearest edge pixel; only reached when LVGL's rounder was bypassed. */
+void spd2010ExtractRow(uint16_t *dst, const uint16_t *src, int w, int left_pad, int out_w);
+
+/* Visible span of each row of the round panel, widened to the 4-pixel column rule. */
+struct SPD2010ChordTable {
+    int16_t left[SPD2010_HEIGHT];
+    int16_t right[SPD2010_HEIGHT];
+    /* QSPI payload of one full-screen redraw with the mask applied. */
+    uint32_t maskedFrameBytes;
+};
+
+void spd2010BuildChordTable(SPD2010ChordTable &table);
+/* Shrinks [x1, x2] to the widest visible chord over rows y1..y2. An area that
+ * lies wholly in a corner is left unchanged. */
+void spd2010ClampWindowToVisible(const SPD2010ChordTable &table, int32_t y1, int32_t y2, int32_t &x1, int32_t &x2);
+
+/* Invoked from the SPI transfer-done ISR once the last chunk of a flush is on the panel. */
+typedef void (*SPD2010FlushDoneCb)(void *ctx);
+
+/* Puts one window on the wire (esp_lcd_panel_draw_bitmap in the driver). Returns
+ * false if nothing was queued, in which case no completion will arrive for it. */
+typedef bool (*SPD2010SubmitFn)(void *target, int x1, int y1, int x2, int y2, const void *pixels);
+
+static inline bool spd2010SeqBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+/* Transfers are numbered in queue order. The task side owns the queued counter,
+ * the transfer-done ISR owns the done counter, and neither ever writes the
+ * other's. Waits block on a semaphore the ISR gives, with a bounded timeout;
+ * a timeout means a completion was lost, and the caller must tear down the
+ * panel IO before reset() takes the done counter back. */
+class SPD2010ChunkPipeline {
+public:
+    static const uint8_t kSlots = 2;
+
+    SPD2010ChunkPipeline();
+    ~SPD2010ChunkPipeline();
+
+    bool begin(SPD2010SubmitFn submit, void *target);
+    void setTarget(void *target) { _target = target; }
+
+    /* Task: next ping-pong slot, once the transfer last queued from it is done.
+     * Returns -1 on timeout. */
+    int acquireSlot(uint32_t timeout_ms);
+    /* Task: queues one window. `slot` is the buffer it was built in (-1 for
+     * caller-owned pixels). With `last`, `done` fires from the ISR when this
+     * window completes. Returns false, leaving `done` unarmed, if the submit failed. */
+    bool queue(int x1, int y1, int x2, int y2, const void *pixels, int slot, bool last, SPD2010FlushDoneCb done,
+               void *ctx);
+    /* Task: false if the queued transfers did not all complete within the timeout. */
+    bool waitIdle(uint32_t timeout_ms);
+    /* Task, only after the panel IO has been deleted so no completion can race
+     * it: writes off the lost transfers and fires a still-armed `done`. */
+    void reset();
+
+    /* Transfer-done ISR. Returns true if a higher-priority task was woken. */
+    bool onTransferDone();
+
+    uint32_t queued() const { return _queued.load(std::memory_order_relaxed); }
+    uint32_t done() const { return _done.load(std::memory_order_acquire); }
+    uint32_t timeouts() const { return _timeouts; }
+
+private:
+    bool waitFor(uint32_t seq, uint32_t timeout_ms);
+
+    SPD2010SubmitFn _submit;
+    void *_target;
+    SemaphoreHandle_t _doneSem;
+    uint8_t _nextSlot;
+    uint32_t _slotSeq[kSlots];
+    uint32_t _timeouts;
+    std::atomic<uint32_t> _queued;
+    std::atomic<uint32_t> _done;
+    std::atomic<uint32_t> _flushEnd;
+    std::atomic<SPD2010FlushDoneCb> _flushDoneCb;
+    void *volatile _flushDoneCtx;
+};
+
+#endif /* SPD2010_FLUSH_H */
@@ -0,0 +1,89 @@
+#include "boot_snapshot.h"
+
+#include <cstring>
+
+namespace {
+
+uint32_t bootSnapshotCrc(const BootSnapshot &snap) {
+    return crc32Update(0, reinterpret_cast<const uint8_t *>(&snap), offsetof(BootSnapshot, crc));
+}
+
+// Into a zeroed buffer, so the bytes after the terminator are zero too.
+template <size_t N>
+void copyText(char (&dst)[N], const char (&src)[N]) {
+    memcpy(dst, src, strnlen(src, N - 1));
+}
+
+// The copies below go field by field into zeroed storage: a struct assignment
+// may copy the source's indeterminate padding, which the CRC would then cover.
+void copyUiState(const SharedUiState &in, SharedUiState &out) {
+    out.gwPoints = in.gwPoints;
+    out.hasGwPoints = in.hasGwPoints;
+    out.overallRank = in.overallRank;
+    out.rankDiff = in.rankDiff;
+    out.hasRankData = in.hasRankData;
+    out.statusColor = in.statusColor;
+    copyText(out.gwStateText, in.gwStateText);
+    out.nextGw = in.nextGw;
+    out.hasNextGw = in.hasNextGw;
+    out.nextDeadlineUtc = in.nextDeadlineUtc;
+    out.hasNextDeadline = in.hasNextDeadline;
+    out.isLiveGw = in.isLiveGw;
+    out.currentGw = in.currentGw;
+    out.totalPoints = in.totalPoints;
+    out.hasTotalPoints = in.hasTotalPoints;
+    // statusText, isStale, lastApiUpdateMs and version are meaningless after a
+    // reset and stay zero, so the CRC tracks content only.
+}
+
+void copySquadRow(const UiSquadRow &in, UiSquadRow &out) {
+    copyText(out.player, in.player);
+    copyText(out.team, in.team);
+    copyText(out.breakdown, in.breakdown);
+    out.points = in.points;
+    out.hasPlayed = in.hasPlayed;
+    out.isCaptain = in.isCaptain;
+    out.isViceCaptain = in.isViceCaptain;
+    out.isBench = in.isBench;
+    out.isGk = in.isGk;
+}
+
+}  // namespace
+
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+void encodeBootSnapshot(const SharedUiState &state, const UiRuntimeState &runtime, BootSnapshot &out) {
+    // Zero padding too: the CRC covers the raw bytes.
+    memset(static_cast<void *>(&out), 0, sizeof(out));
+    out.magic = kBootSnapshotMagic;
+    out.version = kBootSnapshotVersion;
+    out.size = static_cast<uint16_t>(sizeof(BootSnapshot));
+    copyUiState(state, out.ui);
+    out.squadCount = static_cast<uint32_t>(runtime.squadCount < kMaxSquadRows ? runtime.squadCount : kMaxSquadRows);
+    for (size_t i = 0; i < out.squadCount; ++i) {
+        copySquadRow(runtime.squadRows[i], out.squadRows[i]);
+    }
+    out.crc = bootSnapshotCrc(out);
+}
+
+bool decodeBootSnapshot(const BootSnapshot &snap) {
+    return snap.magic == kBootSnapshotMagic && snap.version == kBootSnapshotVersion &&
+           snap.size == sizeof(BootSnapshot) && snap.squadCount <= kMaxSquadRows && snap.crc == bootSnapshotCrc(snap);
+}
+
+bool decodeBootSnapshot(const uint8_t *data, size_t len, BootSnapshot &out) {
+    if (data == nullptr || len != sizeof(BootSnapshot)) {
+        return false;
+    }
+    memcpy(&out, data, sizeof(out));
+    return decodeBootSnapshot(out);
+}
@@ -0,0 +1,223 @@
+#include "fetch_pipeline.h"
+
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <esp_heap_caps.h>
+
+#include <cstring>
+
+#include "net_stats.h"
+#include "trace.h"
+
+namespace {
+
+static constexpr int32_t kConnectTimeoutMs = 15000;
+static constexpr uint16_t kReadTimeoutMs = 30000;
+
+static void setupHttpDefaults(HTTPClient &http) {
+    http.setConnectTimeout(kConnectTimeoutMs);
+    http.setTimeout(kReadTimeoutMs);
+    http.useHTTP10(true);
+    http.setUserAgent("fpl-buddy/1.0");
+    http.addHeader("Accept", "application/json");
+    http.addHeader("Accept-Encoding", "identity");
+    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+}
+
+// Host part of an "https://host/path" URL.
+static bool urlHost(const char *url, char *host, size_t size) {
+    const char *start = strstr(url, "://");
+    if (!start) {
+        return false;
+    }
+    start += 3;
+    const char *end = strchr(start, '/');
+    const size_t len = end ? static_cast<size_t>(end - start) : strlen(start);
+    if (len == 0 || len >= size) {
+        return false;
+    }
+    memcpy(host, start, len);
+    host[len] = '\0';
+    return true;
+}
+
+}  // namespace
+
+bool fetchHttpTransport(const FetchJob &job, char *&bodyOut, size_t &lengthOut) {
+    bodyOut = nullptr;
+    lengthOut = 0;
+    return WiFi.status() == WL_CONNECTED && fetchUrlToPsram(job, bodyOut, lengthOut);
+}
+
+bool fetchUrlToPsram(const FetchJob &job, char *&bufferOut, size_t &lengthOut) {
+    bufferOut = nullptr;
+    lengthOut = 0;
+    const char *url = job.url;
+    const size_t maxBytes = job.maxBytes;
+    char host[64];
+    if (!urlHost(url, host, sizeof(host))) {
+        Serial.printf("Bad URL [%s]\n", url);
+        return false;
+    }
+
+    for (int attempt = 1; attempt <= 2; ++attempt) {
+        if (attempt > 1) {
+            netStatsRetry(job.endpoint);
+        }
+        NetSample sample;
+        sample.endpoint = job.endpoint;
+        sample.maxBytes = maxBytes;
+
+        // Resolve and connect here rather than inside GET(): HTTPClient reuses a
+        // client that is already connected, so DNS, TCP+TLS and the wait for the
+        // response are timed separately. All FPL endpoints are HTTPS on 443.
+        uint32_t phaseUs = micros();
+        IPAddress address;
+        if (!WiFi.hostByName(host, address)) {
+            Serial.printf("DNS lookup failed [%s]\n", host);
+            sample.failure = NetFailure::Dns;
+            netStatsRecord(sample);
+            return false;
+        }
+        sample.dnsUs = micros() - phaseUs;
+
+        WiFiClientSecure client;
+        client.setInsecure();
+        phaseUs = micros();
+        // Resolves again, from the lwIP cache this time.
+        if (!client.connect(host, 443, kConnectTimeoutMs)) {
+            Serial.printf("Connect failed [%s]\n", host);
+            sample.failure = NetFailure::Connect;
+            netStatsRecord(sample);
+            return false;
+        }
+        sample.connectUs = micros() - phaseUs;
+
+        HTTPClient http;
+        setupHttpDefaults(http);
+        if (!http.begin(client, url)) {
+            client.stop();
+            sample.failure = NetFailure::Connect;
+            netStatsRecord(sample);
+            return false;
+        }
+        // HTTPClient only applies its read timeout to a client it connected itself.
+        http.setTimeout(kReadTimeoutMs);
+
+        phaseUs = micros();
+        traceBegin(TraceSpan::HttpGet);
+        const int code = http.GET();
+        traceEnd(TraceSpan::HttpGet);
+        sample.ttfbUs = micros() - phaseUs;
+        sample.httpCode = code;
+        if (code != HTTP_CODE_OK) {
+            Serial.printf("GET failed [%s], HTTP %d\n", url, code);
+            http.end();
+            sample.failure = NetFailure::Http;
+            netStatsRecord(sample);
+            return false;
+        }
+        int contentLen = http.getSize();
+        if (contentLen < 0) {
+            contentLen = 65536;
+        }
+
+        size_t capacity = static_cast<size_t>(contentLen) + 1;
+        if (capacity > maxBytes + 1) {
+            capacity = maxBytes + 1;
+        }
+        if (capacity < 4096) {
+            capacity = 4096;
+        }
+
+        char *buf = static_cast<char *>(heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (!buf) {
+            Serial.printf("PSRAM alloc failed [%s]\n", url);
+            http.end();
+            sample.failure = NetFailure::NoMemory;
+            netStatsRecord(sample);
+            return false;
+        }
+
+        size_t len = 0;
+        uint8_t chunk[1024];
+        WiFiClient *stream = http.getStreamPtr();
+        TraceScope bodyTrace(TraceSpan::Body);
+        phaseUs = micros();
+
+        while (http.connected() || stream->available()) {
+            const int avail = stream->available();
+            if (avail <= 0) {
+                delay(1);
+                continue;
+            }
+
+            const size_t want = static_cast<size_t>(avail > static_cast<int>(sizeof(chunk)) ? sizeof(chunk) : avail);
+            const int got = stream->readBytes(chunk, want);
+            if (got <= 0) {
+                continue;
+            }
+
+            if (len + static_cast<size_t>(got) + 1 > capacity) {
+                size_t newCapacity = capacity * 2;
+                if (newCapacity < len + static_cast<size_t>(got) + 1) {
+                    newCapacity = len + static_cast<size_t>(got) + 1;
+                }
+                if (newCapacity > maxBytes + 1) {
+                    newCapacity = maxBytes + 1;
+                }
+
+                if (newCapacity <= capacity) {
+                    Serial.printf("Payload too large [%s] (> %u bytes)\n", url, static_cast<unsigned>(maxBytes));
+                    heap_caps_free(buf);
+                    http.end();
+                    sample.failure = NetFailure::TooLarge;
+                    netStatsRecord(sample);
+                    return false;
+                }
+
+                char *grown = static_cast<char *>(heap_caps_realloc(buf, newCapacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+                if (!grown) {
+                    Serial.printf("PSRAM realloc failed [%s]\n", url);
+                    heap_caps_free(buf);
+                    http.end();
+                    sample.failure = NetFailure::NoMemory;
+                    netStatsRecord(sample);
+                    return false;
+                }
+                buf = grown;
+                capacity = newCapacity;
+            }
+
+            memcpy(buf + len, chunk, static_cast<size_t>(got));
+            len += static_cast<size_t>(got);
+        }
+        sample.bodyUs = micros() - phaseUs;
+        http.end();
+
+        if (len == 0) {
+            Serial.printf("Empty HTTP payload [%s], attempt %d/2\n", url, attempt);
+            heap_caps_free(buf);
+            sample.failure = NetFailure::Empty;
+            netStatsRecord(sample);
+            if (attempt == 1) {
+                delay(200);
+                continue;
+            }
+            return false;
+        }
+
+        buf[len] = '\0';
+        bufferOut = buf;
+        lengthOut = len;
+        sample.ok = true;
+        sample.bytes = len;
+        netStatsRecord(sample);
+        Serial.printf("PSRAM payload [%s]: %u bytes in %lu ms\n", url, static_cast<unsigned>(len),
+                      static_cast<unsigned long>(sample.bodyUs / 1000U));
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,351 @@
+#include "fetch_pipeline.h"
+
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <cstring>
+
+#include "telemetry.h"
+#include "trace.h"
+
+namespace {
+
+static constexpr const char *kEndpointNames[kFetchEndpointCount] = {"bootstrap", "entry", "history", "picks", "live"};
+static constexpr size_t kFetchClassCount = static_cast<size_t>(FetchClass::Count);
+static constexpr const char *kClassNames[kFetchClassCount] = {"live", "entry", "metadata"};
+
+// One job per endpoint per poll, plus room for a retry or an abandoned poll's
+// jobs; the result queue holds as many.
+static constexpr size_t kMaxPendingJobs = kFetchEndpointCount + 3;
+static constexpr size_t kResultQueueDepth = kFetchEndpointCount * 2;
+// fetchUrlToPsram keeps a 1 KB read chunk and a TLS client on the stack.
+static constexpr uint32_t kWorkerStackBytes = 12288;
+// Metadata may occupy all workers but this many, so an urgent job always finds one.
+static constexpr int kUrgentReservedWorkers = FPL_FETCH_WORKERS > 1 ? 1 : 0;
+
+struct PendingJob {
+    bool used = false;
+    FetchJob job;
+    uint32_t queuedMs = 0;
+    uint32_t dueMs = 0;
+    uint32_t seq = 0;
+};
+
+struct ClassStats {
+    uint32_t submitted = 0;
+    uint32_t coalesced = 0;
+    uint32_t expired = 0;
+    uint32_t rejected = 0;  // pending table full
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    uint64_t queueMsSum = 0;
+    uint32_t queueMsMax = 0;
+    uint64_t runMsSum = 0;
+};
+
+struct FetchPipelineState {
+    PendingJob pending[kMaxPendingJobs];
+    uint32_t nextSeq = 0;
+    int busyMetadata = 0;
+    ClassStats stats[kFetchClassCount];
+    SemaphoreHandle_t mutex = nullptr;
+    // Given on every submit and every finished job; a worker that wakes and
+    // finds nothing it may run goes back to sleep.
+    SemaphoreHandle_t work = nullptr;
+    QueueHandle_t results = nullptr;
+    FetchTransport transport = nullptr;
+    TaskHandle_t workers[FPL_FETCH_WORKERS > 0 ? FPL_FETCH_WORKERS : 1] = {};
+};
+
+static FetchPipelineState gState;
+
+static size_t classIndex(FetchEndpoint endpoint) {
+    return static_cast<size_t>(fetchEndpointClass(endpoint));
+}
+
+static void runJob(const FetchJob &job, uint32_t queuedMs, FetchResult &out) {
+    out.endpoint = job.endpoint;
+    out.pollId = job.pollId;
+    out.body = nullptr;
+    out.length = 0;
+    out.queuedMs = queuedMs;
+    out.startMs = millis();
+    traceBegin(TraceSpan::Fetch, static_cast<uint16_t>(job.endpoint));
+    out.ok = gState.transport(job, out.body, out.length);
+    traceEnd(TraceSpan::Fetch, static_cast<uint16_t>(job.endpoint));
+    out.doneMs = millis();
+}
+
+// Called with the mutex held.
+static void recordFinished(const FetchResult &result) {
+    ClassStats &stats = gState.stats[classIndex(result.endpoint)];
+    const uint32_t queueMs = result.startMs - result.queuedMs;
+    stats.queueMsSum += queueMs;
+    if (queueMs > stats.queueMsMax) {
+        stats.queueMsMax = queueMs;
+    }
+    stats.runMsSum += result.doneMs - result.startMs;
+    if (result.ok) {
+        stats.completed++;
+    } else {
+        stats.failed++;
+    }
+}
+
+// Called with the mutex held. Sorts out expired jobs into `expired` and returns
+// the index of the most urgent job this worker may start, or -1.
+static int pickJob(uint32_t nowMs, PendingJob &expired, bool &hasExpired) {
+    hasExpired = false;
+    int best = -1;
+    for (size_t i = 0; i < kMaxPendingJobs; ++i) {
+        PendingJob &slot = gState.pending[i];
+        if (!slot.used) {
+            continue;
+        }
+        if (static_cast<int32_t>(nowMs - slot.dueMs) > 0) {
+            if (!hasExpired) {
+                expired = slot;
+                hasExpired = true;
+                slot.used = false;
+            }
+            continue;
+        }
+        const FetchClass cls = fetchEndpointClass(slot.job.endpoint);
+        if (cls == FetchClass::Metadata && gState.busyMetadata >= FPL_FETCH_WORKERS - kUrgentReservedWorkers) {
+            continue;
+        }
+        if (best < 0) {
+            best = static_cast<int>(i);
+            continue;
+        }
+        const PendingJob &other = gState.pending[best];
+        const FetchClass otherCls = fetchEndpointClass(other.job.endpoint);
+        if (cls != otherCls) {
+            if (cls < otherCls) {
+                best = static_cast<int>(i);
+            }
+        } else if (slot.dueMs != other.dueMs) {
+            if (static_cast<int32_t>(slot.dueMs - other.dueMs) < 0) {
+                best = static_cast<int>(i);
+            }
+        } else if (static_cast<int32_t>(slot.seq - other.seq) < 0) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+static void fetchWorker(void *) {
+    for (;;) {
+        xSemaphoreTake(gState.work, portMAX_DELAY);
+
+        PendingJob job{};
+        PendingJob expired{};
+        bool hasExpired = false;
+        bool hasJob = false;
+        xSemaphoreTake(gState.mutex, portMAX_DELAY);
+        const uint32_t nowMs = millis();
+        const int idx = pickJob(nowMs, expired, hasExpired);
+        if (idx >= 0) {
+            job = gState.pending[idx];
+            gState.pending[idx].used = false;
+            hasJob = true;
+            if (fetchEndpointClass(job.job.endpoint) == FetchClass::Metadata) {
+                gState.busyMetadata++;
+            }
+        }
+        if (hasExpired) {
+            gState.stats[classIndex(expired.job.endpoint)].expired++;
+        }
+        xSemaphoreGive(gState.mutex);
+
+        if (hasExpired) {
+            FetchResult result = {};
+            result.endpoint = expired.job.endpoint;
+            result.pollId = expired.job.pollId;
+            result.ok = false;
+            result.queuedMs = expired.queuedMs;
+            result.startMs = nowMs;
+            result.doneMs = nowMs;
+            Serial.printf("[FETCH] %s expired after %lu ms in queue\n", fetchEndpointName(expired.job.endpoint),
+                          static_cast<unsigned long>(nowMs - expired.queuedMs));
+            xQueueSend(gState.results, &result, portMAX_DELAY);
+            // There may be more expired jobs or a job this worker skipped.
+            xSemaphoreGive(gState.work);
+        }
+        if (!hasJob) {
+            continue;
+        }
+
+        FetchResult result;
+        runJob(job.job, job.queuedMs, result);
+
+        xSemaphoreTake(gState.mutex, portMAX_DELAY);
+        recordFinished(result);
+        if (fetchEndpointClass(job.job.endpoint) == FetchClass::Metadata) {
+            gState.busyMetadata--;
+        }
+        xSemaphoreGive(gState.mutex);
+        // A metadata job held back by the cap may be runnable now.
+        xSemaphoreGive(gState.work);
+
+        // Bounded: a poll that is busy parsing holds the workers back here.
+        xQueueSend(gState.results, &result, portMAX_DELAY);
+    }
+}
+
+}  // namespace
+
+const char *fetchEndpointName(FetchEndpoint endpoint) {
+    const size_t idx = static_cast<size_t>(endpoint);
+    return idx < kFetchEndpointCount ? kEndpointNames[idx] : "?";
+}
+
+FetchClass fetchEndpointClass(FetchEndpoint endpoint) {
+    switch (endpoint) {
+        case FetchEndpoint::Live:
+            return FetchClass::Live;
+        case FetchEndpoint::Entry:
+        case FetchEndpoint::Picks:
+            return FetchClass::Entry;
+        default:
+            return FetchClass::Metadata;
+    }
+}
+
+void fetchPipelineInit(FetchTransport transport) {
+    gState.transport = transport;
+    gState.mutex = xSemaphoreCreateMutex();
+    gState.work = xSemaphoreCreateCounting(64, 0);
+    gState.results = xQueueCreate(kResultQueueDepth, sizeof(FetchResult));
+    if (!gState.mutex || !gState.work || !gState.results) {
+        Serial.println("[FETCH] queue alloc failed");
+        gState.results = nullptr;
+        return;
+    }
+    // Core 0 with the WiFi stack, like fplTask.
+    static char names[FPL_FETCH_WORKERS > 0 ? FPL_FETCH_WORKERS : 1][8];
+    for (int i = 0; i < FPL_FETCH_WORKERS; ++i) {
+        snprintf(names[i], sizeof(names[i]), "fetch%d", i);
+        TaskHandle_t handle = nullptr;
+        if (xTaskCreatePinnedToCore(fetchWorker, names[i], kWorkerStackBytes, nullptr, 1, &handle, 0) != pdPASS) {
+            Serial.printf("[FETCH] worker %d create failed\n", i);
+            continue;
+        }
+        gState.workers[i] = handle;
+        telemetryRegisterTask(names[i], handle);
+    }
+    Serial.printf("[FETCH] %d download worker(s)\n", FPL_FETCH_WORKERS);
+}
+
+bool fetchSubmit(const FetchJob &job) {
+    if (!gState.results) {
+        return false;
+    }
+    const size_t cls = classIndex(job.endpoint);
+    const uint32_t nowMs = millis();
+    if (FPL_FETCH_WORKERS == 0) {
+        FetchResult result;
+        runJob(job, nowMs, result);
+        xSemaphoreTake(gState.mutex, portMAX_DELAY);
+        gState.stats[cls].submitted++;
+        recordFinished(result);
+        xSemaphoreGive(gState.mutex);
+        if (xQueueSend(gState.results, &result, 0) != pdTRUE) {
+            fetchRelease(result);
+            return false;
+        }
+        return true;
+    }
+
+    const uint32_t dueMs = nowMs + (job.deadlineMs > 0 ? job.deadlineMs : FPL_FETCH_JOB_DEADLINE_MS);
+    bool queued = false;
+    xSemaphoreTake(gState.mutex, portMAX_DELAY);
+    gState.stats[cls].submitted++;
+    // Same URL still waiting: keep one job, owned by the newest poll, with the
+    // earlier deadline and its original queue time.
+    for (PendingJob &slot : gState.pending) {
+        if (slot.used && strcmp(slot.job.url, job.url) == 0) {
+            slot.job.pollId = job.pollId;
+            if (static_cast<int32_t>(dueMs - slot.dueMs) < 0) {
+                slot.dueMs = dueMs;
+            }
+            gState.stats[cls].coalesced++;
+            queued = true;
+            break;
+        }
+    }
+    if (!queued) {
+        for (PendingJob &slot : gState.pending) {
+            if (!slot.used) {
+                slot.used = true;
+                slot.job = job;
+                slot.queuedMs = nowMs;
+                slot.dueMs = dueMs;
+                slot.seq = gState.nextSeq++;
+                queued = true;
+                break;
+            }
+        }
+        if (!queued) {
+            gState.stats[cls].rejected++;
+        }
+    }
+    xSemaphoreGive(gState.mutex);
+    if (queued) {
+        xSemaphoreGive(gState.work);
+    }
+    return queued;
+}
+
+bool fetchWaitResult(FetchResult &out, uint32_t timeoutMs) {
+    return gState.results && xQueueReceive(gState.results, &out, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void fetchRelease(FetchResult &result) {
+    if (result.body) {
+        heap_caps_free(result.body);
+        result.body = nullptr;
+    }
+    result.length = 0;
+}
+
+void fetchPrintStats() {
+    if (!gState.mutex) {
+        Serial.println("[FETCH] not initialised");
+        return;
+    }
+    ClassStats stats[kFetchClassCount];
+    size_t pending = 0;
+    xSemaphoreTake(gState.mutex, portMAX_DELAY);
+    for (size_t i = 0; i < kFetchClassCount; ++i) {
+        stats[i] = gState.stats[i];
+    }
+    for (const PendingJob &slot : gState.pending) {
+        pending += slot.used ? 1 : 0;
+    }
+    xSemaphoreGive(gState.mutex);
+
+    Serial.printf("[FETCH] %d worker(s), %u job(s) pending\n", FPL_FETCH_WORKERS, static_cast<unsigned>(pending));
+    for (size_t i = 0; i < kFetchClassCount; ++i) {
+        const ClassStats &s = stats[i];
+        const uint32_t ran = s.completed + s.failed;
+        Serial.printf("[FETCH] %-8s %lu submitted, %lu ok, %lu failed, %lu coalesced, %lu expired, %lu rejected | "
+                      "queue avg %lu max %lu ms | run avg %lu ms\n",
+                      kClassNames[i], static_cast<unsigned long>(s.submitted), static_cast<unsigned long>(s.completed),
+                      static_cast<unsigned long>(s.failed), static_cast<unsigned long>(s.coalesced),
+                      static_cast<unsigned long>(s.expired), static_cast<unsigned long>(s.rejected),
+                      static_cast<unsigned long>(ran ? s.queueMsSum / ran : 0), static_cast<unsigned long>(s.queueMsMax),
+                      static_cast<unsigned long>(ran ? s.runMsSum / ran : 0));
+    }
+    for (int i = 0; i < FPL_FETCH_WORKERS; ++i) {
+        if (gState.workers[i]) {
+            Serial.printf("[FETCH] fetch%d stack: %u of %lu bytes never used\n", i,
+                          static_cast<unsigned>(uxTaskGetStackHighWaterMark(gState.workers[i])),
+                          static_cast<unsigned long>(kWorkerStackBytes));
+        }
+    }
+}
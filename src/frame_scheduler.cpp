@@ -0,0 +1,214 @@
+#include "frame_scheduler.h"
+
+#include "fpl_config.h"
+#include "perf_stats.h"
+#include "trace.h"
+
+#include <freertos/task.h>
+
+#if FPL_FRAME_SCHEDULER_ENABLED
+
+#include <esp_timer.h>
+
+namespace {
+
+struct FrameSchedulerState {
+    lv_display_t *disp = nullptr;
+    TaskHandle_t uiTask = nullptr;
+    const FrameVsyncSource *source = nullptr;
+    volatile uint32_t vsyncCount = 0;
+    // Set when LVGL invalidates something; only then does a vsync wake the UI task.
+    volatile bool framePending = false;
+    uint32_t pendingSinceVsync = 0;
+    uint32_t lastSeenVsync = 0;
+    uint32_t lastVsyncMs = 0;
+    bool fellBack = false;
+
+    // Counters for the current report window.
+    uint32_t windowVsyncs = 0;
+    uint32_t windowFrames = 0;
+    uint32_t windowMissed = 0;
+    uint32_t windowStartMs = 0;
+    uint32_t framesPresented = 0;
+};
+
+static FrameSchedulerState gState;
+static esp_timer_handle_t gTimer = nullptr;
+
+static void IRAM_ATTR onTeEdge() {
+    frameSchedulerVsync();
+}
+
+static bool startPanelTe() {
+    pinMode(FPL_FRAME_SCHEDULER_TE_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(FPL_FRAME_SCHEDULER_TE_PIN), onTeEdge, RISING);
+    return true;
+}
+
+static void stopPanelTe() {
+    detachInterrupt(digitalPinToInterrupt(FPL_FRAME_SCHEDULER_TE_PIN));
+}
+
+static void onTimer(void *) {
+    frameSchedulerVsync();
+}
+
+static bool startTimer() {
+    if (!gTimer) {
+        esp_timer_create_args_t args = {};
+        args.callback = onTimer;
+        args.name = "vsync";
+        if (esp_timer_create(&args, &gTimer) != 0) {
+            gTimer = nullptr;
+            return false;
+        }
+    }
+    return esp_timer_start_periodic(gTimer, static_cast<uint64_t>(LV_DEF_REFR_PERIOD) * 1000ULL) == 0;
+}
+
+static void stopTimer() {
+    if (gTimer) {
+        esp_timer_stop(gTimer);
+    }
+}
+
+static const FrameVsyncSource kPanelTeSource = {"te", startPanelTe, stopPanelTe};
+static const FrameVsyncSource kTimerSource = {"timer", startTimer, stopTimer};
+
+static void switchSource(const FrameVsyncSource *source) {
+    if (gState.source) {
+        gState.source->stop();
+    }
+    gState.source = source;
+    if (!source->start()) {
+        Serial.printf("[FRAME] vsync source %s failed to start\n", source->name);
+    }
+}
+
+static void reportStats(uint32_t nowMs) {
+    const uint32_t elapsedMs = nowMs - gState.windowStartMs;
+    if (elapsedMs < FPL_FRAME_SCHEDULER_REPORT_INTERVAL_MS) {
+        return;
+    }
+    Serial.printf("[FRAME] src=%s vsync=%.1fHz fps=%.1f missed=%lu\n", gState.source ? gState.source->name : "-",
+                  gState.windowVsyncs * 1000.0f / elapsedMs, gState.windowFrames * 1000.0f / elapsedMs,
+                  static_cast<unsigned long>(gState.windowMissed));
+    gState.windowVsyncs = 0;
+    gState.windowFrames = 0;
+    gState.windowMissed = 0;
+    gState.windowStartMs = nowMs;
+}
+
+}  // namespace
+
+const FrameVsyncSource *frameSchedulerPanelTeSource() {
+    return &kPanelTeSource;
+}
+
+const FrameVsyncSource *frameSchedulerTimerSource() {
+    return &kTimerSource;
+}
+
+void frameSchedulerInit(lv_display_t *disp, const FrameVsyncSource *source) {
+    gState.disp = disp;
+    gState.uiTask = xTaskGetCurrentTaskHandle();
+    gState.lastVsyncMs = millis();
+    gState.windowStartMs = gState.lastVsyncMs;
+    gState.windowVsyncs = 0;
+    gState.windowFrames = 0;
+    gState.windowMissed = 0;
+    gState.lastSeenVsync = gState.vsyncCount;
+
+    // Rendering is started from the vsync edge instead of LVGL's free-running timer.
+    lv_timer_pause(lv_display_get_refr_timer(disp));
+    switchSource(source ? source : &kPanelTeSource);
+    frameSchedulerRequestFrame();  // anything invalidated before init
+}
+
+void IRAM_ATTR frameSchedulerVsync() {
+    gState.vsyncCount = gState.vsyncCount + 1;
+    TaskHandle_t task = gState.uiTask;
+    if (!task || !gState.framePending) {
+        return;
+    }
+    if (xPortInIsrContext()) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else {
+        xTaskNotifyGive(task);
+    }
+}
+
+void frameSchedulerRequestFrame() {
+    if (!gState.framePending) {
+        // The render waits for the first edge after the request, not an old one.
+        gState.pendingSinceVsync = gState.vsyncCount;
+        gState.framePending = true;
+    }
+}
+
+void frameSchedulerWait(TickType_t maxWait) {
+    ulTaskNotifyTake(pdTRUE, maxWait);
+}
+
+void frameSchedulerTick(uint32_t nowMs) {
+    if (!gState.disp) {
+        return;
+    }
+
+    // Edges keep counting while nothing is pending, so the source's health is
+    // known even though they no longer wake the task.
+    const uint32_t vsync = gState.vsyncCount;
+    if (vsync != gState.lastSeenVsync) {
+        gState.windowVsyncs += vsync - gState.lastSeenVsync;
+        gState.lastSeenVsync = vsync;
+        gState.lastVsyncMs = nowMs;
+    } else if (!gState.fellBack && gState.framePending &&
+               nowMs - gState.lastVsyncMs > FPL_FRAME_SCHEDULER_VSYNC_TIMEOUT_MS) {
+        Serial.printf("[FRAME] no vsync from %s for %lums, falling back to timer\n", gState.source->name,
+                      static_cast<unsigned long>(nowMs - gState.lastVsyncMs));
+        gState.fellBack = true;
+        switchSource(&kTimerSource);
+        gState.lastVsyncMs = nowMs;
+    }
+    if (!gState.framePending || vsync == gState.pendingSinceVsync) {
+        reportStats(nowMs);
+        return;
+    }
+
+    // Several edges since the last service collapse into one render of everything
+    // invalidated so far: late frames are merged, never queued up behind each other.
+    // Invalidations made while rendering re-arm the flag for the next edge.
+    gState.framePending = false;
+
+    const uint32_t presentedBefore = gState.framesPresented;
+    const uint32_t renderStart = perfNow();
+    traceBegin(TraceSpan::Render);
+    lv_refr_now(gState.disp);
+    traceEnd(TraceSpan::Render);
+    if (gState.framesPresented != presentedBefore) {
+        perfRecordSince(PerfMetric::Render, renderStart);
+        gState.windowFrames++;
+        // Edges that arrived while this frame rendered had work waiting but could not start it.
+        gState.windowMissed += gState.vsyncCount - vsync;
+    }
+    reportStats(nowMs);
+}
+
+void frameSchedulerFramePresented() {
+    gState.framesPresented++;
+}
+
+#else
+
+const FrameVsyncSource *frameSchedulerPanelTeSource() { return nullptr; }
+const FrameVsyncSource *frameSchedulerTimerSource() { return nullptr; }
+void frameSchedulerInit(lv_display_t *, const FrameVsyncSource *) {}
+void frameSchedulerVsync() {}
+void frameSchedulerRequestFrame() {}
+void frameSchedulerWait(TickType_t maxWait) { vTaskDelay(maxWait); }
+void frameSchedulerTick(uint32_t) {}
+void frameSchedulerFramePresented() {}
+
+#endif
@@ -0,0 +1,57 @@
+#include "json_slicer.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <cstring>
+
+JsonSliceReader::JsonSliceReader(const char *data, size_t length, uint32_t budgetUs)
+    : data_(data), length_(length), nextCheck_(FPL_JSON_SLICE_BYTES), budgetUs_(budgetUs) {
+    startUs_ = micros();
+    sliceStartUs_ = startUs_;
+}
+
+size_t JsonSliceReader::readBytes(char *buffer, size_t length) {
+    size_t copied = 0;
+    while (copied < length && pos_ < length_) {
+        if (pos_ >= nextCheck_) {
+            checkSlice();
+        }
+        size_t chunk = length - copied;
+        if (chunk > length_ - pos_) {
+            chunk = length_ - pos_;
+        }
+        if (chunk > nextCheck_ - pos_) {
+            chunk = nextCheck_ - pos_;
+        }
+        memcpy(buffer + copied, data_ + pos_, chunk);
+        pos_ += chunk;
+        copied += chunk;
+    }
+    return copied;
+}
+
+void JsonSliceReader::checkSlice() {
+    nextCheck_ = pos_ + FPL_JSON_SLICE_BYTES;
+    const uint32_t nowUs = micros();
+    const uint32_t sliceUs = nowUs - sliceStartUs_;
+    if (budgetUs_ == 0 || sliceUs < budgetUs_) {
+        return;
+    }
+    if (sliceUs > maxSliceUs_) {
+        maxSliceUs_ = sliceUs;
+    }
+    // A tick, not taskYIELD(): the idle task sits below every worker task.
+    vTaskDelay(1);
+    yields_++;
+    sliceStartUs_ = micros();
+}
+
+void JsonSliceReader::finish() {
+    const uint32_t nowUs = micros();
+    const uint32_t sliceUs = nowUs - sliceStartUs_;
+    if (sliceUs > maxSliceUs_) {
+        maxSliceUs_ = sliceUs;
+    }
+    elapsedUs_ = nowUs - startUs_;
+}
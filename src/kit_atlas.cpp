@@ -0,0 +1,97 @@
+#include "kit_atlas.h"
+
+#include "fpl_config.h"
+#include "kit_atlas_index.h"
+#include "kit_file.h"
+
+#if FPL_KIT_ATLAS_ENABLED
+
+#include <esp_partition.h>
+
+namespace {
+
+struct KitAtlasState {
+    const uint8_t *base = nullptr;
+    uint16_t count = 0;
+    // One descriptor per entry, built at init so lookups hand out stable pointers.
+    lv_image_dsc_t *dscs = nullptr;
+    esp_partition_mmap_handle_t mapHandle = 0;
+};
+
+static KitAtlasState gState;
+
+static void unmap() {
+    if (gState.mapHandle) {
+        esp_partition_munmap(gState.mapHandle);
+    }
+    free(gState.dscs);
+    gState = KitAtlasState();
+}
+
+}  // namespace
+
+bool kitAtlasInit() {
+    const esp_partition_t *part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, FPL_KIT_ATLAS_PARTITION);
+    if (!part) {
+        Serial.println("[KIT] no atlas partition, using LittleFS kits");
+        return false;
+    }
+
+    // Map only what the header says is used; the rest of the partition stays unmapped.
+    KitAtlasHeader header;
+    if (esp_partition_read(part, 0, &header, sizeof(header)) != ESP_OK || header.magic != kKitAtlasMagic ||
+        header.totalBytes < sizeof(header) || header.totalBytes > part->size) {
+        Serial.println("[KIT] atlas partition empty or invalid, using LittleFS kits");
+        return false;
+    }
+
+    const void *mapped = nullptr;
+    if (esp_partition_mmap(part, 0, header.totalBytes, ESP_PARTITION_MMAP_DATA, &mapped, &gState.mapHandle) !=
+        ESP_OK) {
+        Serial.println("[KIT] atlas mmap failed, using LittleFS kits");
+        gState = KitAtlasState();
+        return false;
+    }
+    gState.base = static_cast<const uint8_t *>(mapped);
+    if (kitAtlasValidate(gState.base, header.totalBytes, kKitWidth, kKitHeight) < 0) {
+        Serial.println("[KIT] atlas index invalid, using LittleFS kits");
+        unmap();
+        return false;
+    }
+    gState.dscs = static_cast<lv_image_dsc_t *>(calloc(header.count, sizeof(lv_image_dsc_t)));
+    if (!gState.dscs) {
+        unmap();
+        return false;
+    }
+
+    for (uint16_t i = 0; i < header.count; ++i) {
+        const KitAtlasEntry &e = kitAtlasEntry(gState.base, i);
+        lv_image_dsc_t &dsc = gState.dscs[i];
+        dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+        dsc.header.cf = (e.bpp == 4) ? LV_COLOR_FORMAT_I4 : LV_COLOR_FORMAT_I8;
+        dsc.header.w = e.width;
+        dsc.header.h = e.height;
+        dsc.data_size = e.size;
+        dsc.data = gState.base + e.offset;
+    }
+    gState.count = header.count;
+    Serial.printf("[KIT] atlas mapped: %u kits, %lu bytes at 0x%06lx\n", static_cast<unsigned>(gState.count),
+                  static_cast<unsigned long>(header.totalBytes), static_cast<unsigned long>(part->address));
+    return true;
+}
+
+const lv_image_dsc_t *kitAtlasFind(const char *slug) {
+    if (gState.count == 0) {
+        return nullptr;
+    }
+    const int i = kitAtlasIndexOf(gState.base, slug);
+    return i < 0 ? nullptr : &gState.dscs[i];
+}
+
+#else
+
+bool kitAtlasInit() { return false; }
+const lv_image_dsc_t *kitAtlasFind(const char *) { return nullptr; }
+
+#endif
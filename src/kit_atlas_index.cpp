@@ -0,0 +1,62 @@
+#include "kit_atlas_index.h"
+
+#include <cstring>
+
+namespace {
+
+const KitAtlasHeader &atlasHeader(const uint8_t *blob) { return *reinterpret_cast<const KitAtlasHeader *>(blob); }
+
+bool validEntry(const KitAtlasEntry &e, uint32_t totalBytes, uint16_t kitWidth, uint16_t kitHeight) {
+    const size_t indexBytes = ((e.bpp == 4) ? (e.width + 1) / 2 : e.width) * static_cast<size_t>(e.height);
+    const size_t paletteBytes = ((e.bpp == 4) ? 16U : 256U) * 4U;
+    return (e.bpp == 4 || e.bpp == 8) && e.width == kitWidth && e.height == kitHeight &&
+           e.size == paletteBytes + indexBytes && (e.offset & 3U) == 0 && e.offset <= totalBytes &&
+           e.size <= totalBytes - e.offset && memchr(e.slug, '\0', kKitAtlasSlugBytes) != nullptr;
+}
+
+}  // namespace
+
+int kitAtlasValidate(const uint8_t *blob, size_t size, uint16_t kitWidth, uint16_t kitHeight) {
+    if (!blob || size < sizeof(KitAtlasHeader)) {
+        return -1;
+    }
+    const KitAtlasHeader &header = atlasHeader(blob);
+    if (header.magic != kKitAtlasMagic || header.version != kKitAtlasVersion || header.totalBytes > size ||
+        header.indexOffset < sizeof(KitAtlasHeader) || (header.indexOffset & 3U) != 0 ||
+        header.indexOffset + static_cast<uint64_t>(header.count) * sizeof(KitAtlasEntry) > header.totalBytes) {
+        return -1;
+    }
+    for (int i = 0; i < header.count; ++i) {
+        const KitAtlasEntry &e = kitAtlasEntry(blob, i);
+        if (!validEntry(e, header.totalBytes, kitWidth, kitHeight) ||
+            (i > 0 && strcmp(kitAtlasEntry(blob, i - 1).slug, e.slug) >= 0)) {
+            return -1;
+        }
+    }
+    return header.count;
+}
+
+int kitAtlasIndexOf(const uint8_t *blob, const char *slug) {
+    if (!blob || !slug) {
+        return -1;
+    }
+    int lo = 0;
+    int hi = atlasHeader(blob).count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        const int cmp = strcmp(kitAtlasEntry(blob, mid).slug, slug);
+        if (cmp == 0) {
+            return mid;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+const KitAtlasEntry &kitAtlasEntry(const uint8_t *blob, int index) {
+    return reinterpret_cast<const KitAtlasEntry *>(blob + atlasHeader(blob).indexOffset)[index];
+}
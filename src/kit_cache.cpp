@@ -0,0 +1,350 @@
+#include "kit_cache.h"
+
+#include "fpl_config.h"
+#include "kit_atlas.h"
+#include "kit_file.h"
+
+#include <LittleFS.h>
+#include <cstring>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace {
+
+struct DecodedKit {
+    lv_color_format_t cf = LV_COLOR_FORMAT_I8;
+    uint32_t dataSize = 0;
+};
+
+struct KitEntry {
+    char team[24] = "";
+    bool isGk = false;
+    bool valid = false;
+    // The slot was refilled after LVGL may have drawn it. LVGL's image cache is
+    // keyed by descriptor address, so its decoded copy of the previous kit must
+    // be dropped before this descriptor is handed out again.
+    bool imageCacheStale = false;
+    uint32_t lastUsed = 0;
+    uint8_t *pixels = nullptr;
+    lv_image_dsc_t dsc;
+};
+
+struct KitMiss {
+    char team[24] = "";
+    bool isGk = false;
+    bool valid = false;
+};
+
+struct KitCacheState {
+    KitEntry entries[FPL_KIT_CACHE_ENTRIES];
+    KitMiss misses[FPL_KIT_CACHE_NEGATIVE_ENTRIES];
+    size_t nextMiss = 0;
+    int pinned = -1;
+    uint32_t useClock = 0;
+
+    uint32_t atlasHits = 0;
+    uint32_t hits = 0;
+    uint32_t loads = 0;
+    uint32_t negativeHits = 0;
+    uint32_t prefetchLoads = 0;
+
+    SemaphoreHandle_t mutex = nullptr;
+    // Serialises flash reads and owns the scratch buffer they land in.
+    SemaphoreHandle_t loadMutex = nullptr;
+    uint8_t *scratch = nullptr;
+    uint8_t *payload = nullptr;
+    DecodedKit scratchKit;
+};
+
+static KitCacheState gState;
+
+static bool loadKitFile(const char *team, const char *type, uint8_t *dst, DecodedKit &out) {
+    char path[96];
+    snprintf(path, sizeof(path), "/kits/%s_%s_%dx%d.kit", team, type, kKitWidth, kKitHeight);
+
+    const uint32_t readStartUs = micros();
+    File f = LittleFS.open(path, "r");
+    if (!f) {
+        return false;
+    }
+    uint8_t raw[kKitHeaderBytes];
+    KitFileHeader header;
+    if (f.read(raw, sizeof(raw)) != sizeof(raw) || !kitParseHeader(raw, kKitWidth, kKitHeight, header)) {
+        Serial.printf("[KIT] bad header: %s\n", path);
+        f.close();
+        return false;
+    }
+
+    memset(dst, 0, header.paletteBytes);
+    const size_t usedPaletteBytes = header.paletteEntries * 4U;
+    const bool readOk = f.read(dst, usedPaletteBytes) == usedPaletteBytes &&
+                        f.read(gState.payload, header.payloadBytes) == header.payloadBytes;
+    f.close();
+    const uint32_t readUs = micros() - readStartUs;
+    if (!readOk) {
+        Serial.printf("[KIT] short read: %s\n", path);
+        return false;
+    }
+
+    const uint32_t decodeStartUs = micros();
+    if (!kitDecodeIndices(header, gState.payload, dst + header.paletteBytes)) {
+        Serial.printf("[KIT] corrupt index stream: %s\n", path);
+        return false;
+    }
+    out.cf = (header.bpp == 4) ? LV_COLOR_FORMAT_I4 : LV_COLOR_FORMAT_I8;
+    out.dataSize = static_cast<uint32_t>(header.paletteBytes + header.indexBytes);
+    Serial.printf("[KIT] loaded %s: %lu B read in %luus, decoded in %luus\n", path,
+                  static_cast<unsigned long>(kKitHeaderBytes + usedPaletteBytes + header.payloadBytes),
+                  static_cast<unsigned long>(readUs), static_cast<unsigned long>(micros() - decodeStartUs));
+    return true;
+}
+
+static bool resolveKitFile(const char *team, bool isGk, uint8_t *dst, DecodedKit &out) {
+    if (loadKitFile(team, isGk ? "gk" : "outfield", dst, out)) {
+        return true;
+    }
+    if (isGk) {
+        return loadKitFile(team, "goalkeeper", dst, out) || loadKitFile(team, "outfield", dst, out);
+    }
+    return loadKitFile(team, "player", dst, out);
+}
+
+static const lv_image_dsc_t *atlasKit(const char *team, const char *type) {
+    char slug[48];
+    snprintf(slug, sizeof(slug), "%s_%s", team, type);
+    return kitAtlasFind(slug);
+}
+
+// Same fallback order as resolveKitFile. Atlas kits live in mapped flash, so
+// they bypass the LRU entirely: nothing to load, copy or pin.
+static const lv_image_dsc_t *resolveAtlasKit(const char *team, bool isGk) {
+    const lv_image_dsc_t *dsc = atlasKit(team, isGk ? "gk" : "outfield");
+    if (dsc) {
+        return dsc;
+    }
+    if (isGk) {
+        dsc = atlasKit(team, "goalkeeper");
+        return dsc ? dsc : atlasKit(team, "outfield");
+    }
+    return atlasKit(team, "player");
+}
+
+static int findEntry(const char *team, bool isGk) {
+    for (int i = 0; i < FPL_KIT_CACHE_ENTRIES; ++i) {
+        const KitEntry &e = gState.entries[i];
+        if (e.valid && e.isGk == isGk && strcmp(e.team, team) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool isKnownMiss(const char *team, bool isGk) {
+    for (const KitMiss &m : gState.misses) {
+        if (m.valid && m.isGk == isGk && strcmp(m.team, team) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void rememberMiss(const char *team, bool isGk) {
+    KitMiss &m = gState.misses[gState.nextMiss];
+    gState.nextMiss = (gState.nextMiss + 1) % FPL_KIT_CACHE_NEGATIVE_ENTRIES;
+    strlcpy(m.team, team, sizeof(m.team));
+    m.isGk = isGk;
+    m.valid = true;
+}
+
+// Least recently used slot that is not pinned; empty slots first.
+static int pickVictim() {
+    int victim = -1;
+    for (int i = 0; i < FPL_KIT_CACHE_ENTRIES; ++i) {
+        if (i == gState.pinned) {
+            continue;
+        }
+        const KitEntry &e = gState.entries[i];
+        if (!e.valid) {
+            return i;
+        }
+        if (victim < 0 || static_cast<int32_t>(e.lastUsed - gState.entries[victim].lastUsed) < 0) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+static int insertEntry(const char *team, bool isGk, const uint8_t *pixels, const DecodedKit &kit) {
+    const int slot = pickVictim();
+    if (slot < 0) {
+        return -1;
+    }
+    KitEntry &e = gState.entries[slot];
+    if (!e.pixels) {
+        e.pixels = static_cast<uint8_t *>(heap_caps_malloc(kKitMaxDecodedBytes, MALLOC_CAP_SPIRAM));
+        if (!e.pixels) {
+            return -1;
+        }
+    }
+    // Prefetch runs on fplTask, which must not call LVGL; the UI task drops the
+    // old cache entry in kitCacheAcquire.
+    if (e.valid) {
+        e.imageCacheStale = true;
+    }
+    memcpy(e.pixels, pixels, kit.dataSize);
+    strlcpy(e.team, team, sizeof(e.team));
+    e.isGk = isGk;
+    e.valid = true;
+    e.lastUsed = ++gState.useClock;
+
+    memset(&e.dsc, 0, sizeof(e.dsc));
+    e.dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    e.dsc.header.cf = kit.cf;
+    e.dsc.header.w = kKitWidth;
+    e.dsc.header.h = kKitHeight;
+    e.dsc.data_size = kit.dataSize;
+    e.dsc.data = e.pixels;
+    return slot;
+}
+
+enum class Lookup { Hit, KnownMiss, NotCached };
+
+static Lookup lookupLocked(const char *team, bool isGk, bool pin, const lv_image_dsc_t **out) {
+    const int slot = findEntry(team, isGk);
+    if (slot >= 0) {
+        KitEntry &e = gState.entries[slot];
+        e.lastUsed = ++gState.useClock;
+        if (pin) {
+            gState.pinned = slot;
+            *out = &e.dsc;
+        }
+        return Lookup::Hit;
+    }
+    return isKnownMiss(team, isGk) ? Lookup::KnownMiss : Lookup::NotCached;
+}
+
+// Reads the kit from flash outside the cache lock, then publishes it.
+static int loadAndInsert(const char *team, bool isGk, bool pin) {
+    if (xSemaphoreTake(gState.loadMutex, portMAX_DELAY) != pdTRUE) {
+        return -1;
+    }
+    const bool found = resolveKitFile(team, isGk, gState.scratch, gState.scratchKit);
+
+    int slot = -1;
+    if (xSemaphoreTake(gState.mutex, portMAX_DELAY) == pdTRUE) {
+        // Another task may have loaded it while we were reading.
+        slot = findEntry(team, isGk);
+        if (slot < 0) {
+            if (found) {
+                slot = insertEntry(team, isGk, gState.scratch, gState.scratchKit);
+            } else if (!isKnownMiss(team, isGk)) {
+                rememberMiss(team, isGk);
+                Serial.printf("[KIT] no kit for %s (%s)\n", team, isGk ? "gk" : "outfield");
+            }
+        }
+        if (slot >= 0 && pin) {
+            gState.pinned = slot;
+        }
+        xSemaphoreGive(gState.mutex);
+    }
+    xSemaphoreGive(gState.loadMutex);
+    return slot;
+}
+
+// UI task. The slot is pinned, so no prefetch can refill it behind our back.
+static const lv_image_dsc_t *handOut(int slot) {
+    if (slot < 0) {
+        return nullptr;
+    }
+    KitEntry &e = gState.entries[slot];
+    bool stale = false;
+    if (xSemaphoreTake(gState.mutex, portMAX_DELAY) == pdTRUE) {
+        stale = e.imageCacheStale;
+        e.imageCacheStale = false;
+        xSemaphoreGive(gState.mutex);
+    }
+    if (stale) {
+        lv_image_cache_drop(&e.dsc);
+    }
+    return &e.dsc;
+}
+
+}  // namespace
+
+void kitCacheInit() {
+    kitAtlasInit();
+    gState.mutex = xSemaphoreCreateMutex();
+    gState.loadMutex = xSemaphoreCreateMutex();
+    gState.scratch = static_cast<uint8_t *>(heap_caps_malloc(kKitMaxDecodedBytes, MALLOC_CAP_SPIRAM));
+    gState.payload = static_cast<uint8_t *>(heap_caps_malloc(kKitMaxIndexBytes, MALLOC_CAP_SPIRAM));
+    if (!gState.mutex || !gState.loadMutex || !gState.scratch || !gState.payload) {
+        Serial.println("[KIT] cache init failed");
+    }
+}
+
+const lv_image_dsc_t *kitCacheAcquire(const char *team, bool isGk) {
+    if (!team || !team[0]) {
+        return nullptr;
+    }
+    if (const lv_image_dsc_t *atlas = resolveAtlasKit(team, isGk)) {
+        gState.atlasHits++;
+        return atlas;
+    }
+    if (!gState.mutex || !gState.scratch) {
+        return nullptr;
+    }
+
+    const lv_image_dsc_t *dsc = nullptr;
+    if (xSemaphoreTake(gState.mutex, portMAX_DELAY) != pdTRUE) {
+        return nullptr;
+    }
+    const Lookup result = lookupLocked(team, isGk, true, &dsc);
+    const int pinnedSlot = gState.pinned;
+    if (result == Lookup::Hit) {
+        gState.hits++;
+    } else if (result == Lookup::KnownMiss) {
+        gState.negativeHits++;
+    } else {
+        gState.loads++;
+    }
+    xSemaphoreGive(gState.mutex);
+    if (result == Lookup::Hit) {
+        return handOut(pinnedSlot);
+    }
+    if (result == Lookup::KnownMiss) {
+        return nullptr;
+    }
+    return handOut(loadAndInsert(team, isGk, true));
+}
+
+void kitCachePrefetch(const char *team, bool isGk) {
+    if (!team || !team[0] || !gState.mutex || !gState.scratch || resolveAtlasKit(team, isGk)) {
+        return;
+    }
+    if (xSemaphoreTake(gState.mutex, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+    const Lookup result = lookupLocked(team, isGk, false, nullptr);
+    xSemaphoreGive(gState.mutex);
+    if (result == Lookup::NotCached && loadAndInsert(team, isGk, false) >= 0) {
+        gState.prefetchLoads++;
+    }
+}
+
+void kitCachePrintStats() {
+    size_t used = 0;
+    for (const KitEntry &e : gState.entries) {
+        used += e.valid ? 1 : 0;
+    }
+    const uint32_t lookups = gState.atlasHits + gState.hits + gState.loads + gState.negativeHits;
+    Serial.printf("[KIT] cache %u/%u entries | popup lookups %lu: atlas %lu, hit %lu, flash %lu, known-missing %lu "
+                  "(%lu%% hit) | prefetched %lu\n",
+                  static_cast<unsigned>(used), static_cast<unsigned>(FPL_KIT_CACHE_ENTRIES),
+                  static_cast<unsigned long>(lookups), static_cast<unsigned long>(gState.atlasHits),
+                  static_cast<unsigned long>(gState.hits),
+                  static_cast<unsigned long>(gState.loads), static_cast<unsigned long>(gState.negativeHits),
+                  static_cast<unsigned long>(
+                      lookups ? ((gState.atlasHits + gState.hits + gState.negativeHits) * 100U) / lookups : 0),
+                  static_cast<unsigned long>(gState.prefetchLoads));
+}
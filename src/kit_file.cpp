@@ -0,0 +1,65 @@
+#include "kit_file.h"
+
+#include <cstring>
+
+namespace {
+
+uint16_t readLe16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+uint32_t readLe32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+}  // namespace
+
+bool kitParseHeader(const uint8_t *raw, uint16_t kitWidth, uint16_t kitHeight, KitFileHeader &out) {
+    if (!raw || readLe32(raw) != kKitMagic || readLe16(raw + 4) != kitWidth || readLe16(raw + 6) != kitHeight) {
+        return false;
+    }
+    out.bpp = raw[8];
+    out.flags = raw[9];
+    out.paletteEntries = readLe16(raw + 10);
+    out.payloadBytes = readLe32(raw + 12);
+    const size_t paletteSlots = (out.bpp == 4) ? 16U : 256U;
+    out.paletteBytes = paletteSlots * 4U;
+    out.indexBytes = ((out.bpp == 4) ? (kitWidth + 1U) / 2U : kitWidth) * static_cast<size_t>(kitHeight);
+    return (out.bpp == 4 || out.bpp == 8) && out.paletteEntries <= paletteSlots &&
+           out.payloadBytes <= static_cast<size_t>(kitWidth) * kitHeight;
+}
+
+bool kitRleDecode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstLen) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < srcLen) {
+        const uint8_t ctrl = src[i++];
+        if (ctrl < 128) {
+            const size_t n = ctrl + 1U;
+            if (i + n > srcLen || o + n > dstLen) {
+                return false;
+            }
+            memcpy(dst + o, src + i, n);
+            i += n;
+            o += n;
+        } else {
+            const size_t n = ctrl - 126U;
+            if (i >= srcLen || o + n > dstLen) {
+                return false;
+            }
+            memset(dst + o, src[i++], n);
+            o += n;
+        }
+    }
+    return o == dstLen;
+}
+
+bool kitDecodeIndices(const KitFileHeader &header, const uint8_t *payload, uint8_t *indices) {
+    if (header.flags & kKitFlagRle) {
+        return kitRleDecode(payload, header.payloadBytes, indices, header.indexBytes);
+    }
+    if (header.payloadBytes != header.indexBytes) {
+        return false;
+    }
+    memcpy(indices, payload, header.indexBytes);
+    return true;
+}
@@ -0,0 +1,299 @@
+#include "led_anim.h"
+
+namespace {
+
+enum class LedPattern : uint8_t {
+    Solid,     // every LED at the envelope level
+    Notch,     // every LED lit, the moving head scaled by factors[0]
+    Comet,     // moving head plus a tail scaled by factors[distance]
+    Progress,  // `progress` LEDs lit from 12 o'clock; only the leading one follows the envelope
+};
+
+struct LedKeyframe {
+    uint8_t at;     // position in the period, 0..255 = 0..100%
+    uint8_t level;  // Q8, 255 = full colour
+};
+
+struct LedEffect {
+    const char *name;
+    LedPattern pattern;
+    // Level envelope over one period: a sampled 257-entry curve, or keyframes
+    // (linear or held until the next key).
+    const uint8_t *curve;
+    const LedKeyframe *keys;
+    uint8_t keyCount;
+    bool stepped;
+    const uint8_t *factors;
+    uint8_t factorCount;
+    // Share of the layers below that shows through pixels the pattern leaves
+    // uncovered, and the opacity of the pixels it covers at full level.
+    uint8_t backdrop;
+    uint8_t alpha;
+};
+
+// Generated by tools/led_ring_lut.py: Q8 pulse scale over one period.
+static const uint8_t kPulseLut[257] = {
+    138, 141, 143, 146, 149, 152, 155, 158, 161, 163, 166, 169, 172, 174, 177, 180,
+    183, 185, 188, 190, 193, 196, 198, 200, 203, 205, 208, 210, 212, 214, 216, 219,
+    221, 223, 225, 227, 228, 230, 232, 234, 235, 237, 238, 240, 241, 242, 244, 245,
+    246, 247, 248, 249, 250, 251, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+    255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 251, 250, 249, 248, 247,
+    246, 245, 244, 242, 241, 240, 238, 237, 235, 234, 232, 230, 228, 227, 225, 223,
+    221, 219, 216, 214, 212, 210, 208, 205, 203, 200, 198, 196, 193, 190, 188, 185,
+    183, 180, 177, 174, 172, 169, 166, 163, 161, 158, 155, 152, 149, 146, 143, 141,
+    138, 135, 132, 129, 126, 123, 120, 118, 115, 112, 109, 106, 104, 101,  98,  95,
+     93,  90,  88,  85,  82,  80,  77,  75,  73,  70,  68,  66,  63,  61,  59,  57,
+     55,  53,  51,  49,  47,  45,  43,  42,  40,  39,  37,  36,  34,  33,  32,  30,
+     29,  28,  27,  26,  25,  25,  24,  23,  23,  22,  22,  21,  21,  21,  21,  20,
+     20,  20,  21,  21,  21,  21,  22,  22,  23,  23,  24,  25,  25,  26,  27,  28,
+     29,  30,  32,  33,  34,  36,  37,  39,  40,  42,  43,  45,  47,  49,  51,  53,
+     55,  57,  59,  61,  63,  66,  68,  70,  73,  75,  77,  80,  82,  85,  88,  90,
+     93,  95,  98, 101, 104, 106, 109, 112, 115, 118, 120, 123, 126, 129, 132, 135,
+    138,
+};
+static const uint8_t kCometTailQ8[] = {255, 115, 46, 20};
+static const uint8_t kDimNotchQ8[] = {56};
+static const LedKeyframe kBlinkKeys[] = {{0, 255}, {128, 0}};  // on for the first half
+static const LedKeyframe kSteadyKeys[] = {{0, 255}};
+
+static const LedEffect kEffects[] = {
+    // name         pattern               curve      keys         n  stepped factors       n  backdrop alpha
+    {"none",        LedPattern::Solid,    nullptr,   kSteadyKeys, 1, true,  nullptr,      0, 255,     0},
+    {"breathing",   LedPattern::Solid,    kPulseLut, nullptr,     0, false, nullptr,      0, 0,       255},
+    {"dim-notch",   LedPattern::Notch,    kPulseLut, nullptr,     0, false, kDimNotchQ8,  1, 0,       255},
+    {"comet",       LedPattern::Comet,    kPulseLut, nullptr,     0, false, kCometTailQ8, 4, 0,       255},
+    // Unlit segments keep the rank trend at a quarter; the leading segment
+    // blinks through to it.
+    {"deadline",    LedPattern::Progress, nullptr,   kBlinkKeys,  2, true,  nullptr,      0, 64,      255},
+    // Tints the whole ring while on, leaves it alone while off.
+    {"flash",       LedPattern::Solid,    nullptr,   kBlinkKeys,  2, true,  nullptr,      0, 255,     224},
+};
+static_assert(sizeof(kEffects) / sizeof(kEffects[0]) == static_cast<size_t>(LedEffectId::Count),
+              "one kEffects row per LedEffectId");
+
+static uint8_t mulQ8(uint8_t a, uint8_t b) {
+    return static_cast<uint8_t>((static_cast<uint16_t>(a) * b) / 255U);
+}
+
+static LedPixel scalePixel(LedPixel px, uint8_t scaleQ8) {
+    return {mulQ8(px.r, scaleQ8), mulQ8(px.g, scaleQ8), mulQ8(px.b, scaleQ8)};
+}
+
+static uint8_t mixQ8(uint8_t below, uint8_t over, uint8_t opacityQ8) {
+    return static_cast<uint8_t>((static_cast<uint16_t>(below) * (255U - opacityQ8) +
+                                 static_cast<uint16_t>(over) * opacityQ8) / 255U);
+}
+
+// `over` drawn on `below` at opacityQ8; over black this is scalePixel(over, opacityQ8).
+static LedPixel mixPixel(LedPixel below, LedPixel over, uint8_t opacityQ8) {
+    return {mixQ8(below.r, over.r, opacityQ8), mixQ8(below.g, over.g, opacityQ8), mixQ8(below.b, over.b, opacityQ8)};
+}
+
+// Position in the current period, 0..65535.
+static uint32_t envelopePhase(const LedLayerState &layer, uint32_t nowMs) {
+    const uint32_t periodMs = layer.periodMs > 0 ? layer.periodMs : 1U;
+    return static_cast<uint32_t>((static_cast<uint64_t>((nowMs - layer.startMs) % periodMs) << 16) / periodMs);
+}
+
+static uint8_t envelopeLevel(const LedEffect &effect, uint32_t phase) {
+    if (effect.curve) {
+        const uint32_t idx = phase >> 8;
+        const int32_t frac = static_cast<int32_t>(phase & 0xFFU);
+        const int32_t a = effect.curve[idx];
+        const int32_t b = effect.curve[idx + 1];
+        return static_cast<uint8_t>(a + (((b - a) * frac) >> 8));
+    }
+    if (effect.keyCount == 0) {
+        return 255;
+    }
+    // Last key at or before the phase; the envelope wraps from the last key to the first.
+    uint8_t i = 0;
+    while (i + 1 < effect.keyCount && (static_cast<uint32_t>(effect.keys[i + 1].at) << 8) <= phase) {
+        ++i;
+    }
+    const LedKeyframe &from = effect.keys[i];
+    if (effect.stepped || effect.keyCount == 1) {
+        return from.level;
+    }
+    const LedKeyframe &to = effect.keys[(i + 1) % effect.keyCount];
+    const uint32_t fromPos = static_cast<uint32_t>(from.at) << 8;
+    uint32_t toPos = static_cast<uint32_t>(to.at) << 8;
+    uint32_t pos = phase;
+    if (toPos <= fromPos) {
+        toPos += 65536U;
+        if (pos < fromPos) {
+            pos += 65536U;
+        }
+    }
+    const int32_t span = static_cast<int32_t>(toPos - fromPos);
+    const int32_t delta = static_cast<int32_t>(to.level) - static_cast<int32_t>(from.level);
+    return static_cast<uint8_t>(from.level + (delta * static_cast<int32_t>(pos - fromPos)) / span);
+}
+
+static constexpr int kUncovered = -1;
+
+// Q8 coverage of LED i (scaled by the effect's alpha), or kUncovered to leave
+// the pixel to the layers below.
+static int patternFactor(const LedEffect &effect, const LedLayerState &layer, uint8_t level, uint32_t nowMs,
+                         uint16_t i, uint16_t count) {
+    switch (effect.pattern) {
+        case LedPattern::Solid:
+            return level;
+        case LedPattern::Notch:
+        case LedPattern::Comet: {
+            const uint32_t stepMs = layer.stepMs > 0 ? layer.stepMs : 1U;
+            const uint16_t head = static_cast<uint16_t>(((nowMs - layer.startMs) / stepMs) % count);
+            const uint16_t distance = static_cast<uint16_t>((i + count - head) % count);
+            if (effect.pattern == LedPattern::Notch) {
+                return distance == 0 && effect.factorCount > 0 ? mulQ8(level, effect.factors[0]) : level;
+            }
+            return distance < effect.factorCount ? mulQ8(level, effect.factors[distance]) : kUncovered;
+        }
+        case LedPattern::Progress: {
+            // Segment k sits k LEDs anticlockwise of 12 o'clock (a quarter turn from index 0).
+            const uint16_t segment = static_cast<uint16_t>((count / 4 + count - i) % count);
+            if (segment >= layer.progress) {
+                return kUncovered;
+            }
+            return segment + 1 == layer.progress ? level : 255;  // the leading segment blinks
+        }
+    }
+    return kUncovered;
+}
+
+static const LedEffect *activeEffect(const LedLayerState &layer) {
+    if (layer.effect == LedEffectId::None ||
+        static_cast<size_t>(layer.effect) >= static_cast<size_t>(LedEffectId::Count)) {
+        return nullptr;
+    }
+    return &kEffects[static_cast<size_t>(layer.effect)];
+}
+
+static uint32_t minMs(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+
+// True if the effect hides every layer below it at every phase: a fully opaque
+// solid fill whose level never drops.
+static bool opaque(const LedEffect &effect) {
+    if (effect.pattern != LedPattern::Solid || effect.alpha != 255) {
+        return false;
+    }
+    if (effect.curve) {
+        for (size_t i = 0; i < 257; ++i) {
+            if (effect.curve[i] != 255) {
+                return false;
+            }
+        }
+        return true;
+    }
+    for (uint8_t i = 0; i < effect.keyCount; ++i) {
+        if (effect.keys[i].level != 255) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// First millisecond offset (from the period start) at which the phase reaches the key.
+static uint32_t keyOffsetMs(const LedKeyframe &key, uint32_t periodMs) {
+    return (static_cast<uint32_t>(key.at) * periodMs + 255U) / 256U;
+}
+
+static uint32_t envelopeMsUntilChange(const LedEffect &effect, const LedLayerState &layer, uint32_t nowMs) {
+    if (!effect.curve && effect.keyCount < 2) {
+        return kLedAnimStatic;
+    }
+    if (effect.pattern == LedPattern::Progress && layer.progress == 0) {
+        return kLedAnimStatic;  // no segment follows the envelope
+    }
+    const uint32_t periodMs = layer.periodMs > 0 ? layer.periodMs : 1U;
+    if (effect.stepped) {
+        const uint32_t posMs = (nowMs - layer.startMs) % periodMs;
+        for (uint8_t i = 0; i < effect.keyCount; ++i) {
+            const uint32_t keyMs = keyOffsetMs(effect.keys[i], periodMs);
+            if (keyMs > posMs) {
+                return keyMs - posMs;
+            }
+        }
+        return periodMs - posMs + keyOffsetMs(effect.keys[0], periodMs);
+    }
+    // Smooth envelopes: probe forward until the level moves.
+    const uint8_t level = envelopeLevel(effect, envelopePhase(layer, nowMs));
+    for (uint32_t dt = 1; dt <= kLedAnimEnvelopeProbeMs; ++dt) {
+        if (envelopeLevel(effect, envelopePhase(layer, nowMs + dt)) != level) {
+            return dt;
+        }
+    }
+    return kLedAnimEnvelopeProbeMs;
+}
+
+static uint32_t layerMsUntilChange(const LedEffect &effect, const LedLayerState &layer, uint32_t nowMs) {
+    uint32_t waitMs = envelopeMsUntilChange(effect, layer, nowMs);
+    if (effect.pattern == LedPattern::Notch || effect.pattern == LedPattern::Comet) {
+        const uint32_t stepMs = layer.stepMs > 0 ? layer.stepMs : 1U;
+        waitMs = minMs(waitMs, stepMs - (nowMs - layer.startMs) % stepMs);
+    }
+    return waitMs;
+}
+
+}  // namespace
+
+LedLayerState &ledAnimLayer(LedScene &scene, LedLayer layer) {
+    return scene.layers[static_cast<size_t>(layer)];
+}
+
+const char *ledAnimEffectName(LedEffectId effect) {
+    return static_cast<size_t>(effect) < static_cast<size_t>(LedEffectId::Count)
+               ? kEffects[static_cast<size_t>(effect)].name
+               : "?";
+}
+
+void ledAnimRender(const LedScene &scene, uint32_t nowMs, LedPixel *out, uint16_t count) {
+    for (uint16_t i = 0; i < count; ++i) {
+        out[i] = {0, 0, 0};
+    }
+    if (count == 0) {
+        return;
+    }
+
+    for (const LedLayerState &layer : scene.layers) {
+        const LedEffect *active = activeEffect(layer);
+        if (!active) {
+            continue;
+        }
+        const LedEffect &effect = *active;
+        const uint8_t level = envelopeLevel(effect, envelopePhase(layer, nowMs));
+        for (uint16_t i = 0; i < count; ++i) {
+            const int factor = patternFactor(effect, layer, level, nowMs, i, count);
+            out[i] = factor == kUncovered
+                         ? scalePixel(out[i], effect.backdrop)
+                         : mixPixel(out[i], layer.color, mulQ8(effect.alpha, static_cast<uint8_t>(factor)));
+        }
+    }
+}
+
+uint32_t ledAnimMsUntilChange(const LedScene &scene, uint32_t nowMs) {
+    // An opaque layer hides everything under it, so only it and the layers
+    // above can change the output.
+    size_t firstVisible = 0;
+    for (size_t i = 0; i < static_cast<size_t>(LedLayer::Count); ++i) {
+        const LedEffect *effect = activeEffect(scene.layers[i]);
+        if (effect && opaque(*effect)) {
+            firstVisible = i;
+        }
+    }
+    uint32_t waitMs = kLedAnimStatic;
+    for (size_t i = firstVisible; i < static_cast<size_t>(LedLayer::Count); ++i) {
+        const LedEffect *effect = activeEffect(scene.layers[i]);
+        if (effect) {
+            waitMs = minMs(waitMs, layerMsUntilChange(*effect, scene.layers[i], nowMs));
+        }
+    }
+    return waitMs;
+}
+
+uint32_t ledAnimSleepMs(const LedScene &scene, uint32_t nowMs, uint32_t stateWaitMs) {
+    const uint32_t waitMs = minMs(minMs(ledAnimMsUntilChange(scene, nowMs), stateWaitMs), kLedAnimMaxSleepMs);
+    return waitMs < kLedAnimMinFrameMs ? kLedAnimMinFrameMs : waitMs;
+}
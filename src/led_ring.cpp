@@ -4,39 +4,58 @@
 
 #if FPL_LED_RING_ENABLED
 
+#include "led_anim.h"
+#include "msg_bus.h"
+
 #include <Adafruit_NeoPixel.h>
-#include <cmath>
 #include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <sys/time.h>
 #include <time.h>
 
 namespace {
 
+// Owned by ledTask; other tasks change it by publishing on the bus.
 struct LedRingState {
     bool initialized = false;
     int rankTrend = 0;  // +1 = rank up, -1 = rank down, 0 = no signal
     bool deadlineCountdownEnabled = false;
     time_t deadlineUtc = 0;
     uint8_t animationMode = kLedRingAnimBreathing;
-    uint8_t head = 0;
-    uint32_t lastRotateMs = 0;
+    uint32_t spinStartMs = 0;
     uint32_t pulsePeriodMs = FPL_LED_RING_PULSE_PERIOD_MS;
     bool flashActive = false;
-    bool flashOn = false;
+    uint32_t flashStartMs = 0;
     uint32_t flashEndMs = 0;
-    uint32_t nextFlashStepMs = 0;
-    SemaphoreHandle_t mutex = nullptr;
+    BusSubscriber *bus = nullptr;
+    bool busNotifySet = false;
+};
+
+// ledTask only: wakeups, frames pushed to the ring and identical frames skipped.
+struct LedRingStats {
+    uint32_t lastFrameHash = 0;
+    bool haveFrame = false;
+    uint32_t shows = 0;
+    uint32_t skipped = 0;
+    uint32_t ticks = 0;
+    uint32_t renderUs = 0;
+    uint32_t windowStartMs = 0;
 };
 
 static LedRingState gState;
+static LedRingStats gStats;
+static LedPixel gFrame[FPL_LED_RING_LED_COUNT];
 static Adafruit_NeoPixel gRing(FPL_LED_RING_LED_COUNT, FPL_LED_RING_PIN, NEO_GRB + NEO_KHZ800);
 
-static constexpr float kTwoPi = 6.283185307f;
-static constexpr uint8_t kPurpleR = 180;
-static constexpr uint8_t kPurpleG = 0;
-static constexpr uint8_t kPurpleB = 180;
+static constexpr LedPixel kPurple = {180, 0, 180};
+static constexpr LedPixel kRed = {255, 0, 0};
+static constexpr LedPixel kGreen = {0, 255, 0};
 static constexpr int32_t kDeadlineCountdownWindowSec = 3600;
+static constexpr int32_t kDeadlineFinalColourSec = 900;
 static constexpr int32_t kDeadlineStepSec = 225;  // 3.75 minutes
+static constexpr uint32_t kDeadlineBlinkPeriodMs = 1000;
+static constexpr uint32_t kStatsReportIntervalMs = 10000;
+static constexpr size_t kBusQueueDepth = 8;
 
 static uint8_t clampByte(int value) {
     if (value < 0) {
@@ -48,11 +67,6 @@ static uint8_t clampByte(int value) {
     return static_cast<uint8_t>(value);
 }
 
-static uint8_t scaleChannel(uint8_t channel, float scale) {
-    const int scaled = static_cast<int>(static_cast<float>(channel) * scale);
-    return clampByte(scaled);
-}
-
 static uint32_t normalizePulsePeriodMs(uint32_t periodMs) {
     if (periodMs < 50U) {
         return 50U;
@@ -64,11 +78,6 @@ static uint32_t safeSpinIntervalMs() {
     return (FPL_LED_RING_SPIN_INTERVAL_MS > 0U) ? FPL_LED_RING_SPIN_INTERVAL_MS : 1U;
 }
 
-static float pulseScale(uint32_t nowMs, uint32_t periodMs) {
-    const float phase = static_cast<float>(nowMs % periodMs) / static_cast<float>(periodMs);
-    return 0.08f + (0.92f * (0.5f + (0.5f * sinf(kTwoPi * phase))));
-}
-
 static uint32_t safeFlashDurationMs() {
     return (FPL_LED_RING_NOTIFICATION_FLASH_MS > 0U) ? FPL_LED_RING_NOTIFICATION_FLASH_MS : 1U;
 }
@@ -82,132 +91,187 @@ static bool timeReached(uint32_t nowMs, uint32_t targetMs) {
     return static_cast<int32_t>(nowMs - targetMs) >= 0;
 }
 
-static void clearRing() {
-    gRing.clear();
-    gRing.show();
-}
-
-static void renderSolid(uint8_t r, uint8_t g, uint8_t b) {
-    for (uint16_t i = 0; i < gRing.numPixels(); ++i) {
-        gRing.setPixelColor(i, r, g, b);
-    }
-    gRing.show();
-}
-
-static float cometTailScaleFromDistance(uint8_t distance) {
-    switch (distance) {
-        case 0: return 1.00f;
-        case 1: return 0.45f;
-        case 2: return 0.18f;
-        case 3: return 0.08f;
-        default: return 0.0f;
+static uint32_t frameHash(const uint8_t *data, size_t len) {
+    uint32_t hash = 2166136261U;  // FNV-1a
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ data[i]) * 16777619U;
     }
+    return hash;
 }
 
-static void renderRankTrendBreathing(uint32_t nowMs, int rankTrend, uint32_t pulsePeriodMs) {
-    if (rankTrend == 0) {
-        clearRing();
+// show() bit-bangs the whole ring with interrupts off on this core, so only
+// frames that differ from the last one pushed are sent.
+static void presentFrame(bool force = false) {
+    const uint32_t hash = frameHash(gRing.getPixels(), static_cast<size_t>(gRing.numPixels()) * 3U);
+    if (!force && gStats.haveFrame && hash == gStats.lastFrameHash) {
+        gStats.skipped++;
         return;
     }
+    gRing.show();
+    gStats.lastFrameHash = hash;
+    gStats.haveFrame = true;
+    gStats.shows++;
+}
 
-    const uint8_t baseR = rankTrend > 0 ? 0 : 255;
-    const uint8_t baseG = rankTrend > 0 ? 255 : 0;
-    const uint8_t ledCount = static_cast<uint8_t>(gRing.numPixels());
-    if (ledCount == 0) {
+static void reportStats(uint32_t nowMs) {
+    const uint32_t elapsedMs = nowMs - gStats.windowStartMs;
+    if (elapsedMs < kStatsReportIntervalMs) {
         return;
     }
+    Serial.printf("[LED] %.1f wakeups/min, show %.1f/s, skipped %.1f/s identical frames, render %luus/tick\n",
+                  gStats.ticks * 60000.0f / elapsedMs, gStats.shows * 1000.0f / elapsedMs,
+                  gStats.skipped * 1000.0f / elapsedMs,
+                  static_cast<unsigned long>(gStats.ticks ? gStats.renderUs / gStats.ticks : 0));
+    gStats.shows = 0;
+    gStats.skipped = 0;
+    gStats.ticks = 0;
+    gStats.renderUs = 0;
+    gStats.windowStartMs = nowMs;
+}
 
-    const float pulse = pulseScale(nowMs, pulsePeriodMs);
-    for (uint8_t i = 0; i < ledCount; ++i) {
-        gRing.setPixelColor(i, scaleChannel(baseR, pulse), scaleChannel(baseG, pulse), 0);
+static LedEffectId rankEffectForMode(uint8_t mode) {
+    switch (mode) {
+        case kLedRingAnimComet: return LedEffectId::RankComet;
+        case kLedRingAnimDimNotch: return LedEffectId::RankDimNotch;
+        default: return LedEffectId::RankBreathing;
     }
-    gRing.show();
 }
 
-static void renderRankTrendDimNotch(uint32_t nowMs, int rankTrend, uint8_t head, uint32_t pulsePeriodMs) {
-    if (rankTrend == 0) {
-        clearRing();
-        return;
+// Layers stack bottom-up: rank trend, deadline countdown, notification flash.
+// The countdown dims the trend under its unlit segments and the flash tints
+// the ring (see kEffects in led_anim.cpp).
+static void buildScene(LedScene &scene, uint32_t nowMs, uint16_t ledCount) {
+    LedLayerState &base = ledAnimLayer(scene, LedLayer::Base);
+    if (gState.rankTrend != 0) {
+        base.effect = rankEffectForMode(gState.animationMode);
+        base.color = gState.rankTrend > 0 ? kGreen : kRed;
+        base.periodMs = normalizePulsePeriodMs(gState.pulsePeriodMs);
+        base.startMs = gState.spinStartMs;
+        base.stepMs = safeSpinIntervalMs();
+    }
+
+    const time_t nowUtc = time(nullptr);
+    if (gState.deadlineCountdownEnabled && nowUtc > 100000 && gState.deadlineUtc > 0) {
+        const int64_t secRemaining = static_cast<int64_t>(gState.deadlineUtc) - static_cast<int64_t>(nowUtc);
+        if (secRemaining <= kDeadlineCountdownWindowSec) {
+            LedLayerState &overlay = ledAnimLayer(scene, LedLayer::Overlay);
+            overlay.effect = LedEffectId::DeadlineProgress;
+            overlay.color = secRemaining <= kDeadlineFinalColourSec ? kRed : kPurple;
+            overlay.periodMs = kDeadlineBlinkPeriodMs;
+            int64_t lit = secRemaining <= 0 ? 0 : (secRemaining + (kDeadlineStepSec - 1)) / kDeadlineStepSec;
+            if (lit > ledCount) {
+                lit = ledCount;
+            }
+            overlay.progress = static_cast<uint8_t>(lit);
+        }
     }
 
-    const uint8_t baseR = rankTrend > 0 ? 0 : 255;
-    const uint8_t baseG = rankTrend > 0 ? 255 : 0;
-    const uint8_t ledCount = static_cast<uint8_t>(gRing.numPixels());
-    if (ledCount == 0) {
-        return;
+    if (gState.flashActive && timeReached(nowMs, gState.flashEndMs)) {
+        gState.flashActive = false;
     }
-
-    const float pulse = pulseScale(nowMs, pulsePeriodMs);
-
-    const float dimmerScale = 0.22f;
-    for (uint8_t i = 0; i < ledCount; ++i) {
-        const bool isDimmer = (i == head);
-        const float scale = pulse * (isDimmer ? dimmerScale : 1.0f);
-        gRing.setPixelColor(i, scaleChannel(baseR, scale), scaleChannel(baseG, scale), 0);
+    if (gState.flashActive) {
+        LedLayerState &flash = ledAnimLayer(scene, LedLayer::Transient);
+        flash.effect = LedEffectId::NotificationFlash;
+        flash.color = kPurple;
+        flash.startMs = gState.flashStartMs;
+        flash.periodMs = 2U * safeFlashDurationMs();
     }
-
-    gRing.show();
 }
 
-static void renderRankTrendComet(uint32_t nowMs, int rankTrend, uint8_t head, uint32_t pulsePeriodMs) {
-    if (rankTrend == 0) {
-        clearRing();
-        return;
-    }
-
-    const uint8_t baseR = rankTrend > 0 ? 0 : 255;
-    const uint8_t baseG = rankTrend > 0 ? 255 : 0;
-    const uint8_t ledCount = static_cast<uint8_t>(gRing.numPixels());
-    if (ledCount == 0) {
-        return;
-    }
+static uint32_t minMs(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
 
-    const float pulse = pulseScale(nowMs, pulsePeriodMs);
-    for (uint8_t i = 0; i < ledCount; ++i) {
-        const uint8_t distance = (i >= head) ? static_cast<uint8_t>(i - head)
-                                             : static_cast<uint8_t>(ledCount + i - head);
-        const float scale = pulse * cometTailScaleFromDistance(distance);
-        gRing.setPixelColor(i, scaleChannel(baseR, scale), scaleChannel(baseG, scale), 0);
+// Time until something outside the animation
+// envelopes changes the scene: the flash ending, the countdown window opening
+// or the countdown dropping a segment (every kDeadlineStepSec).
+static uint32_t msUntilStateChange(uint32_t nowMs) {
+    uint32_t waitMs = kLedAnimStatic;
+    if (gState.flashActive) {
+        const int32_t untilEnd = static_cast<int32_t>(gState.flashEndMs - nowMs);
+        waitMs = untilEnd > 0 ? static_cast<uint32_t>(untilEnd) : 0U;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    if (gState.deadlineCountdownEnabled && tv.tv_sec > 100000 && gState.deadlineUtc > 0) {
+        const int64_t secRemaining = static_cast<int64_t>(gState.deadlineUtc) - static_cast<int64_t>(tv.tv_sec);
+        int64_t untilSec = -1;
+        if (secRemaining > kDeadlineCountdownWindowSec) {
+            untilSec = secRemaining - kDeadlineCountdownWindowSec;
+        } else if (secRemaining > 0) {
+            untilSec = (secRemaining - 1) % kDeadlineStepSec + 1;
+        }
+        if (untilSec >= 0) {
+            int64_t untilMs = untilSec * 1000 - tv.tv_usec / 1000;
+            if (untilMs > kLedAnimMaxSleepMs) {
+                untilMs = kLedAnimMaxSleepMs;
+            }
+            waitMs = minMs(waitMs, untilMs > 0 ? static_cast<uint32_t>(untilMs) : 0U);
+        }
     }
-    gRing.show();
+    return waitMs;
 }
 
-static void renderDeadlineCountdown(uint32_t nowMs, int32_t secRemaining) {
-    const uint16_t ledCount = gRing.numPixels();
-    if (ledCount == 0) {
-        return;
+static void startFlash(uint32_t durationMs, uint32_t nowMs) {
+    if (durationMs == 0U) {
+        durationMs = safeFlashDurationMs();
     }
-
-    if (secRemaining <= 0) {
-        clearRing();
+    const uint32_t requestedEndMs = nowMs + durationMs;
+    if (!gState.flashActive || timeReached(nowMs, gState.flashEndMs)) {
+        gState.flashActive = true;
+        gState.flashStartMs = nowMs;
+        gState.flashEndMs = requestedEndMs;
         return;
     }
-    const uint8_t baseR = (secRemaining <= 900) ? 255 : kPurpleR;
-    const uint8_t baseG = (secRemaining <= 900) ? 0 : kPurpleG;
-    const uint8_t baseB = (secRemaining <= 900) ? 0 : kPurpleB;
-
-    int litCount = (secRemaining + (kDeadlineStepSec - 1)) / kDeadlineStepSec;
-    if (litCount < 0) {
-        litCount = 0;
-    } else if (litCount > static_cast<int>(ledCount)) {
-        litCount = static_cast<int>(ledCount);
+    // A flash already running is extended, not restarted.
+    if (static_cast<int32_t>(requestedEndMs - gState.flashEndMs) > 0) {
+        gState.flashEndMs = requestedEndMs;
     }
-    const bool blinkOn = ((nowMs / 500U) % 2U) == 0U;
+}
 
-    gRing.clear();
-    const int rotationOffset = static_cast<int>(ledCount) / 4;  // move final segment from 9 o'clock to 12 o'clock
-    for (int i = 0; i < litCount; ++i) {
-        const bool isCurrent = (i == litCount - 1);
-        const uint16_t physicalIndex = static_cast<uint16_t>(
-            (rotationOffset - i + static_cast<int>(ledCount)) % static_cast<int>(ledCount));
-        if (isCurrent && !blinkOn) {
-            gRing.setPixelColor(physicalIndex, 0, 0, 0);
-        } else {
-            gRing.setPixelColor(physicalIndex, baseR, baseG, baseB);
+static void applyMessage(const BusMessage &msg, uint32_t nowMs) {
+    switch (msg.topic) {
+        case BusTopic::UiRank: {
+            RankMsg rank;
+            if (busRead(msg, rank)) {
+                gState.rankTrend = (!rank.hasRankData || rank.rankDiff == 0) ? 0 : (rank.rankDiff > 0 ? 1 : -1);
+            }
+            break;
+        }
+        case BusTopic::UiGameweek: {
+            GameweekMsg gw;
+            if (busRead(msg, gw)) {
+                gState.deadlineCountdownEnabled = gw.hasDeadline && !gw.isLiveGw;
+                gState.deadlineUtc = gw.deadlineUtc;
+            }
+            break;
+        }
+        case BusTopic::LedPulsePeriod: {
+            U32Msg period;
+            if (busRead(msg, period)) {
+                gState.pulsePeriodMs = normalizePulsePeriodMs(period.value);
+            }
+            break;
         }
+        case BusTopic::LedAnimMode: {
+            U32Msg mode;
+            if (busRead(msg, mode)) {
+                gState.animationMode = mode.value > kLedRingAnimComet ? kLedRingAnimBreathing
+                                                                      : static_cast<uint8_t>(mode.value);
+            }
+            break;
+        }
+        case BusTopic::LedFlash: {
+            U32Msg duration;
+            if (busRead(msg, duration)) {
+                startFlash(duration.value, nowMs);
+            }
+            break;
+        }
+        default:
+            break;
     }
-
-    gRing.show();
 }
 
 }  // namespace
@@ -217,107 +281,39 @@ void ledRingInit() {
         return;
     }
 
-    gState.mutex = xSemaphoreCreateMutex();
-    if (!gState.mutex) {
+    gState.bus = busSubscribe("led",
+                              busTopicBit(BusTopic::UiRank) | busTopicBit(BusTopic::UiGameweek) |
+                                  busTopicBit(BusTopic::LedPulsePeriod) | busTopicBit(BusTopic::LedAnimMode) |
+                                  busTopicBit(BusTopic::LedFlash),
+                              kBusQueueDepth);
+    if (!gState.bus) {
         return;
     }
 
     gRing.begin();
     gRing.setBrightness(clampByte(FPL_LED_RING_MAX_BRIGHTNESS));
-    clearRing();
-
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-        gState.initialized = true;
-        gState.animationMode = FPL_LED_RING_DEFAULT_ANIMATION;
-        gState.head = 0;
-        gState.lastRotateMs = millis();
-        gState.pulsePeriodMs = normalizePulsePeriodMs(FPL_LED_RING_PULSE_PERIOD_MS);
-        gState.flashActive = false;
-        gState.flashOn = false;
-        gState.flashEndMs = 0;
-        gState.nextFlashStepMs = 0;
-        xSemaphoreGive(gState.mutex);
-    }
-}
-
-void ledRingSetRankTrend(int rankDiff, bool hasRankData) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-
-    const int trend = (!hasRankData || rankDiff == 0) ? 0 : (rankDiff > 0 ? 1 : -1);
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-    gState.rankTrend = trend;
-    xSemaphoreGive(gState.mutex);
-}
-
-void ledRingSetDeadlineCountdown(bool enabled, time_t deadlineUtc) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-    gState.deadlineCountdownEnabled = enabled;
-    gState.deadlineUtc = deadlineUtc;
-    xSemaphoreGive(gState.mutex);
+    gRing.clear();
+    presentFrame(true);
+    gStats.windowStartMs = millis();
+
+    gState.animationMode = FPL_LED_RING_DEFAULT_ANIMATION;
+    gState.spinStartMs = millis();
+    gState.pulsePeriodMs = normalizePulsePeriodMs(FPL_LED_RING_PULSE_PERIOD_MS);
+    gState.flashActive = false;
+    gState.flashEndMs = 0;
+    gState.initialized = true;
 }
 
 void ledRingSetPulsePeriodMs(uint32_t periodMs) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-    gState.pulsePeriodMs = normalizePulsePeriodMs(periodMs);
-    xSemaphoreGive(gState.mutex);
+    busPublish(BusTopic::LedPulsePeriod, U32Msg{periodMs});
 }
 
 void ledRingSetAnimationMode(uint8_t mode) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-    if (mode > kLedRingAnimComet) {
-        mode = kLedRingAnimBreathing;
-    }
-    gState.animationMode = mode;
-    xSemaphoreGive(gState.mutex);
+    busPublish(BusTopic::LedAnimMode, U32Msg{mode});
 }
 
 void ledRingTriggerNotificationForMs(uint32_t durationMs) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-
-    const uint32_t nowMs = millis();
-    const uint32_t blinkIntervalMs = safeFlashDurationMs();
-    if (durationMs == 0U) {
-        durationMs = blinkIntervalMs;
-    }
-
-    const uint32_t requestedEndMs = nowMs + durationMs;
-    if (!gState.flashActive || timeReached(nowMs, gState.flashEndMs)) {
-        gState.flashActive = true;
-        gState.flashOn = true;
-        gState.flashEndMs = requestedEndMs;
-        gState.nextFlashStepMs = nowMs + blinkIntervalMs;
-        xSemaphoreGive(gState.mutex);
-        return;
-    }
-
-    if (static_cast<int32_t>(requestedEndMs - gState.flashEndMs) > 0) {
-        gState.flashEndMs = requestedEndMs;
-    }
-    xSemaphoreGive(gState.mutex);
+    busPublish(BusTopic::LedFlash, U32Msg{durationMs});
 }
 
 void ledRingTriggerNotification() {
@@ -325,86 +321,47 @@ void ledRingTriggerNotification() {
     ledRingTriggerNotificationForMs(totalMs);
 }
 
-void ledRingTick(uint32_t nowMs) {
-    if (!gState.initialized || !gState.mutex) {
-        return;
-    }
-    if (xSemaphoreTake(gState.mutex, pdMS_TO_TICKS(5)) != pdTRUE) {
-        return;
+uint32_t ledRingTick(uint32_t nowMs) {
+    if (!gState.initialized) {
+        return kLedAnimMaxSleepMs;
     }
-
     const uint16_t pixelCount = gRing.numPixels();
     if (pixelCount == 0U) {
-        xSemaphoreGive(gState.mutex);
-        return;
+        return kLedAnimMaxSleepMs;
     }
-
-    const uint32_t spinIntervalMs = safeSpinIntervalMs();
-    if ((nowMs - gState.lastRotateMs) >= spinIntervalMs) {
-        const uint32_t steps = (nowMs - gState.lastRotateMs) / spinIntervalMs;
-        gState.head = static_cast<uint8_t>((gState.head + steps) % pixelCount);
-        gState.lastRotateMs += steps * spinIntervalMs;
+    if (!gState.busNotifySet) {
+        busSetNotifyTask(gState.bus, xTaskGetCurrentTaskHandle());
+        gState.busNotifySet = true;
     }
-
-    if (gState.flashActive && timeReached(nowMs, gState.flashEndMs)) {
-        gState.flashActive = false;
-        gState.flashOn = false;
-    } else if (gState.flashActive && timeReached(nowMs, gState.nextFlashStepMs)) {
-        gState.flashOn = !gState.flashOn;
-        gState.nextFlashStepMs = nowMs + safeFlashDurationMs();
-        if (timeReached(gState.nextFlashStepMs, gState.flashEndMs)) {
-            gState.flashActive = false;
-            gState.flashOn = false;
-        }
+    BusMessage msg;
+    while (busReceive(gState.bus, msg)) {
+        applyMessage(msg, nowMs);
     }
 
-    const bool flashOn = gState.flashActive && gState.flashOn;
-    const bool flashWindowActive = gState.flashActive;
-    const bool deadlineCountdownEnabled = gState.deadlineCountdownEnabled;
-    const time_t deadlineUtc = gState.deadlineUtc;
-    const int rankTrend = gState.rankTrend;
-    const uint8_t animationMode = gState.animationMode;
-    const uint8_t head = gState.head;
-    const uint32_t pulsePeriodMs = normalizePulsePeriodMs(gState.pulsePeriodMs);
-    xSemaphoreGive(gState.mutex);
-
-    if (flashWindowActive) {
-        if (flashOn) {
-            renderSolid(kPurpleR, kPurpleG, kPurpleB);
-        } else {
-            clearRing();
-        }
-        return;
-    }
+    LedScene scene;
+    buildScene(scene, nowMs, pixelCount);
+    const uint32_t stateWaitMs = msUntilStateChange(nowMs);
 
-    if (deadlineCountdownEnabled) {
-        const time_t nowUtc = time(nullptr);
-        if (nowUtc > 100000 && deadlineUtc > 0) {
-            const int64_t secRemaining64 = static_cast<int64_t>(deadlineUtc) - static_cast<int64_t>(nowUtc);
-            if (secRemaining64 <= kDeadlineCountdownWindowSec) {
-                renderDeadlineCountdown(nowMs, static_cast<int32_t>(secRemaining64));
-                return;
-            }
-        }
+    const uint32_t renderStartUs = micros();
+    ledAnimRender(scene, nowMs, gFrame, pixelCount);
+    for (uint16_t i = 0; i < pixelCount; ++i) {
+        gRing.setPixelColor(i, gFrame[i].r, gFrame[i].g, gFrame[i].b);
     }
+    gStats.renderUs += micros() - renderStartUs;
+    gStats.ticks++;
 
-    if (animationMode == kLedRingAnimComet) {
-        renderRankTrendComet(nowMs, rankTrend, head, pulsePeriodMs);
-        return;
-    }
-    if (animationMode == kLedRingAnimDimNotch) {
-        renderRankTrendDimNotch(nowMs, rankTrend, head, pulsePeriodMs);
-        return;
-    }
-    renderRankTrendBreathing(nowMs, rankTrend, pulsePeriodMs);
+    presentFrame();
+    reportStats(nowMs);
+
+    return ledAnimSleepMs(scene, nowMs, stateWaitMs);
 }
 
 #else
 
 void ledRingInit() {}
-void ledRingTick(uint32_t) {}
-void ledRingSetRankTrend(int, bool) {}
-void ledRingSetDeadlineCountdown(bool, time_t) {}
+uint32_t ledRingTick(uint32_t) {
+    return UINT32_MAX;
+}
 void ledRingSetPulsePeriodMs(uint32_t) {}
 void ledRingSetAnimationMode(uint8_t) {}
 void ledRingTriggerNotificationForMs(uint32_t) {}
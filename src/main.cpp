@@ -1,39 +1,45 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include <HTTPClient.h>
 #include <LittleFS.h>
 #include <SPD2010.h>
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
 #include <esp_heap_caps.h>
 #include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include <freertos/semphr.h>
 #include <lvgl.h>
 #include <time.h>
 #include <cstring>
 
+#include "boot_snapshot.h"
+#include "fetch_pipeline.h"
 #include "fpl_config.h"
+#include "frame_scheduler.h"
+#include "json_slicer.h"
+#include "kit_cache.h"
 #include "led_ring.h"
+#include "msg_bus.h"
+#include "net_stats.h"
+#include "perf_stats.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "ui_capture.h"
+#include "ui_model.h"
+#include "ui_screens.h"
 #include "wifi_config.h"
 
-LV_FONT_DECLARE(lv_font_montserrat_16);
-LV_FONT_DECLARE(lv_font_montserrat_18);
-LV_FONT_DECLARE(lv_font_montserrat_22);
-LV_FONT_DECLARE(lv_font_montserrat_24);
-LV_FONT_DECLARE(lv_font_montserrat_26);
-LV_FONT_DECLARE(lv_font_montserrat_28);
-LV_FONT_DECLARE(lv_font_montserrat_32);
-LV_FONT_DECLARE(lv_font_montserrat_48);
-
 static SPD2010Display display;
 static SPD2010Touch touch;
 
 static constexpr uint16_t kDisplayWidth = SPD2010_WIDTH;
 static constexpr uint16_t kDisplayHeight = SPD2010_HEIGHT;
 static constexpr size_t kLvglBufPixels = kDisplayWidth * 40;
+static_assert(kDisplayWidth == kUiScreenWidth && kDisplayHeight == kUiScreenHeight,
+              "ui_screens lays out for a different panel size");
 
 static lv_display_t *lvglDisp = nullptr;
 static uint8_t *lvglBuf = nullptr;
+static uint8_t *lvglBuf2 = nullptr;
 
 static uint32_t lastPollMs = 0;
 static uint32_t lastWifiRetryMs = 0;
@@ -41,141 +47,70 @@ static TaskHandle_t uiTaskHandle = nullptr;
 static TaskHandle_t fplTaskHandle = nullptr;
 static TaskHandle_t ledTaskHandle = nullptr;
 
-static constexpr int kKitWidth = 110;
-static constexpr int kKitHeight = 145;
-static constexpr size_t kKitRgb565Bytes = kKitWidth * kKitHeight * 2;
-static constexpr size_t kMaxUiEvents = 24;
-static constexpr size_t kMaxPopupEvents = 8;
-static constexpr size_t kMaxSquadRows = 16;
-
-enum class UiMode {
-    Idle,
-    Deadline,
-    FinalHour,
-    Live,
-    EventPopup,
-    EventsList,
-    Squad
+// UI threading model:
+// - Only uiTask calls LVGL. LVGL's software draw units (LV_DRAW_SW_DRAW_UNIT_CNT)
+//   render parts of each frame on their own threads, but they are started and
+//   joined by LVGL inside uiTask's refresh, so widgets never see another caller.
+// - LVGL event callbacks run inside lv_timer_handler() on uiTask and may call
+//   loadMode() directly.
+// - uiTask owns sharedUiState and uiRuntimeState. fplTask and the serial loop
+//   change them only by publishing on the message bus (the setShared*/pushUiEvent
+//   helpers) and ask for screen changes with requestUiMode(); uiTask applies both
+//   on its next pass. fplTask keeps its own copy of the UI topics for the boot
+//   snapshot.
+struct UiModeRequest {
+    UiMode mode;
+    lv_screen_load_anim_t anim;
 };
 
-struct UiEventItem {
-    char icon[8] = "";
-    char label[24] = "";
-    char player[24] = "";
-    char team[24] = "";
-    int delta = 0;
-    int totalBefore = 0;
-    int totalAfter = 0;
-    bool isGk = false;
-    uint32_t epochMs = 0;
-};
+static QueueHandle_t uiModeRequestQueue = nullptr;
+static volatile bool uiBenchRequested = false;
+static volatile bool uiShotsRequested = false;
+static constexpr uint32_t kUiBenchFramesPerScreen = 10;
 
-struct UiSquadRow {
-    char player[24] = "";
-    char team[24] = "";
-    char breakdown[32] = "";
-    int points = 0;
-    bool hasPlayed = false;
-    bool isCaptain = false;
-    bool isViceCaptain = false;
-    bool isBench = false;
-    bool isGk = false;
-};
+// uiTask sleeps until it has something to do (see uiSleepMs); bus messages,
+// touches and mode requests wake it.
+static constexpr bool kUiEventDriven = (FPL_UI_EVENT_DRIVEN != 0);
+static constexpr uint32_t kUiPollIntervalMs = 10;
+static lv_indev_t *lvglTouchIndev = nullptr;
+static volatile bool touchWakePending = false;
 
-struct UiRuntimeState {
-    UiEventItem recentEvents[kMaxUiEvents];
-    size_t recentEventCount = 0;
-    UiEventItem popupQueue[kMaxPopupEvents];
-    size_t popupHead = 0;
-    size_t popupTail = 0;
-    size_t popupCount = 0;
-    UiSquadRow squadRows[kMaxSquadRows];
-    size_t squadCount = 0;
-    uint32_t eventVersion = 0;
-    uint32_t squadVersion = 0;
-};
+// One poll publishes ~25 messages (state, squad rows, events); the queues hold
+// a couple of polls so a stalled consumer catches up instead of dropping.
+static constexpr size_t kUiBusDepth = 48;
+static constexpr size_t kFplBusDepth = 48;
+static BusSubscriber *uiBus = nullptr;
+static BusSubscriber *fplBus = nullptr;
 
-static SemaphoreHandle_t uiRuntimeMutex = nullptr;
-static UiRuntimeState uiRuntimeState;
-static uint8_t kitImageBuffer[kKitRgb565Bytes];
-static lv_image_dsc_t kitImageDsc;
-
-struct UiWidgets {
-    lv_obj_t *screenIdle = nullptr;
-    lv_obj_t *screenDeadline = nullptr;
-    lv_obj_t *screenFinalHour = nullptr;
-    lv_obj_t *screenLive = nullptr;
-    lv_obj_t *screenPopup = nullptr;
-    lv_obj_t *screenEvents = nullptr;
-    lv_obj_t *screenSquad = nullptr;
-
-    // Idle
-    lv_obj_t *idleRankArrow = nullptr;
-    lv_obj_t *idleRankValue = nullptr;
-    lv_obj_t *idleGwPoints = nullptr;
-    lv_obj_t *idleTotalPoints = nullptr;
-
-    // Deadline
-    lv_obj_t *deadlineLabel = nullptr;
-    lv_obj_t *deadlineCountdown = nullptr;
-    lv_obj_t *deadlineMeta = nullptr;
-
-    // Final hour
-    lv_obj_t *finalArc = nullptr;
-    lv_obj_t *finalCountdown = nullptr;
-
-    // Live
-    lv_obj_t *liveTitle = nullptr;
-    lv_obj_t *liveDot = nullptr;
-    lv_obj_t *livePoints = nullptr;
-    lv_obj_t *liveRank = nullptr;
-    lv_obj_t *liveTickerBtn = nullptr;
-    lv_obj_t *liveTickerLabel = nullptr;
-    lv_obj_t *liveHoldArc = nullptr;
-
-    // Popup
-    lv_obj_t *popupTitle = nullptr;
-    lv_obj_t *popupKit = nullptr;
-    lv_obj_t *popupPlayer = nullptr;
-    lv_obj_t *popupDelta = nullptr;
-    lv_obj_t *popupTotal = nullptr;
-
-    // Shared top line / stale
-    lv_obj_t *statusLabel = nullptr;
-
-    // Lists
-    lv_obj_t *eventsList = nullptr;
-    lv_obj_t *squadList = nullptr;
-};
+static void wakeUiTask() {
+    if (uiTaskHandle) {
+        xTaskNotifyGive(uiTaskHandle);
+    }
+}
 
-static UiWidgets ui;
-static UiMode currentMode = UiMode::Idle;
+static UiRuntimeState uiRuntimeState;  // uiTask only
 
-struct SharedUiState {
-    int gwPoints = 0;
-    bool hasGwPoints = false;
-    int overallRank = 0;
-    int rankDiff = 0;
-    bool hasRankData = false;
-    uint32_t statusColor = 0xFFFFFF;
-    char statusText[48] = "Booting...";
-    char gwStateText[48] = "GW live: ? | next: --";
-    int nextGw = 0;
-    bool hasNextGw = false;
-    time_t nextDeadlineUtc = 0;
-    bool hasNextDeadline = false;
-    bool isLiveGw = false;
-    int currentGw = 0;
-    int totalPoints = 0;
-    bool hasTotalPoints = false;
-    bool isStale = false;
-    uint32_t lastApiUpdateMs = 0;
-    uint32_t version = 0;
+static SharedUiState sharedUiState;  // uiTask only
+// fplTask's copy of the same topics, for the boot snapshot.
+static SharedUiState fplUiMirror;
+static UiRuntimeState fplRuntimeMirror;
+static bool fplScriptedDemoActive = false;
+static bool timeConfigured = false;
+
+// Milliseconds since boot at which each startup phase first completed (0 = not yet).
+struct BootTimeline {
+    uint32_t lvglReadyMs = 0;
+    uint32_t uiBuiltMs = 0;
+    uint32_t snapshotRestoredMs = 0;
+    uint32_t firstMeaningfulFrameMs = 0;
+    uint32_t wifiConnectedMs = 0;
+    uint32_t timeSyncedMs = 0;
+    uint32_t firstPollMs = 0;
+    bool restoredFromSnapshot = false;
+    bool reported = false;
 };
 
-static SharedUiState sharedUiState;
-static SemaphoreHandle_t sharedUiMutex = nullptr;
-static bool timeConfigured = false;
+static BootTimeline bootTimeline;
 static bool parseIsoUtcToEpoch(const char *iso, time_t &epochOut);
 static constexpr bool kUseServerEventBreakdown = (FPL_USE_SERVER_EVENT_BREAKDOWN != 0);
 
@@ -270,7 +205,8 @@ static DemoState demoState;
 static SemaphoreHandle_t demoMutex = nullptr;
 enum class ScriptedDemoKind {
     None = 0,
-    Notification = 1
+    Notification = 1,
+    Deadline = 2
 };
 struct ScriptedDemoState {
     bool active = false;
@@ -279,8 +215,7 @@ struct ScriptedDemoState {
     uint32_t triggerAtMs = 0;
     int baseRank = 0;
 };
-static ScriptedDemoState scriptedDemoState;
-static SemaphoreHandle_t scriptedDemoMutex = nullptr;
+static ScriptedDemoState scriptedDemoState;  // uiTask only
 static constexpr uint32_t kDemoNotificationDelayMs = 30000U;
 static constexpr int32_t kDemoDeadline45mSec = 45 * 60;
 static constexpr int32_t kDemoDeadline7mSec = 7 * 60;
@@ -312,274 +247,133 @@ static bool ensureUkTimeConfigured();
 static void serviceScriptedDemo();
 static void startNotificationScriptedDemo();
 static void startDeadlineScriptedDemo(int32_t secondsToDeadline);
-static void squadDemoNotificationBtnCb(lv_event_t *e);
-static void squadDemoDeadline45BtnCb(lv_event_t *e);
-static void squadDemoDeadline7BtnCb(lv_event_t *e);
 static void handleSerialCommandLine(char *line);
 static void processSerialInput();
 
-static void setupHttpDefaults(HTTPClient &http) {
-    http.setConnectTimeout(15000);
-    http.setTimeout(30000);
-    http.useHTTP10(true);
-    http.setUserAgent("fpl-buddy/1.0");
-    http.addHeader("Accept", "application/json");
-    http.addHeader("Accept-Encoding", "identity");
-    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-}
-
-enum class JsonReadMode {
-    Stream,
-    StringBody
+enum class ParseOutcome {
+    Ok,
+    Truncated,  // short or empty body: worth one refetch
+    Invalid
 };
 
-static bool getJsonDocument(const String &url, DynamicJsonDocument &doc, JsonDocument *filter = nullptr,
-                            JsonReadMode mode = JsonReadMode::Stream) {
-    if (WiFi.status() != WL_CONNECTED) {
-        return false;
-    }
-
-    for (int attempt = 1; attempt <= 2; ++attempt) {
-        WiFiClientSecure client;
-        client.setInsecure();
-
-        HTTPClient http;
-        setupHttpDefaults(http);
-
-        if (!http.begin(client, url)) {
-            return false;
-        }
-
-        const int code = http.GET();
-        if (code != HTTP_CODE_OK) {
-            Serial.printf("GET failed [%s], HTTP %d\n", url.c_str(), code);
-            http.end();
-            return false;
-        }
-
-        DeserializationError err;
-        if (mode == JsonReadMode::StringBody) {
-            const String payload = http.getString();
-            if (payload.length() == 0) {
-                Serial.printf("Empty HTTP payload [%s], attempt %d/2\n", url.c_str(), attempt);
-                http.end();
-                if (attempt == 1) {
-                    delay(200);
-                    continue;
-                }
-                return false;
-            }
-            if (filter) {
-                err = deserializeJson(doc, payload, DeserializationOption::Filter(*filter));
-            } else {
-                err = deserializeJson(doc, payload);
-            }
-
-            if (err) {
-                const size_t previewLen = payload.length() < 200 ? payload.length() : 200;
-                Serial.printf("JSON parse error [%s] attempt %d/2: %s\n", url.c_str(), attempt, err.c_str());
-                Serial.printf("Payload bytes: %u | preview: %.*s\n", static_cast<unsigned>(payload.length()),
-                              static_cast<int>(previewLen), payload.c_str());
-            }
-        } else {
-            if (filter) {
-                err = deserializeJson(doc, *http.getStreamPtr(), DeserializationOption::Filter(*filter));
-            } else {
-                err = deserializeJson(doc, *http.getStreamPtr());
-            }
-
-            if (err) {
-                Serial.printf("JSON parse error [%s] attempt %d/2: %s\n", url.c_str(), attempt, err.c_str());
-            }
-        }
-        http.end();
-
-        if (!err) {
-            return true;
-        }
-
-        // transient short reads are common on embedded HTTPS; retry once
-        if (attempt == 1 &&
-            (err == DeserializationError::IncompleteInput || err == DeserializationError::EmptyInput)) {
-            delay(200);
-            continue;
-        }
-
-        return false;
+// The body is read through a JsonSliceReader: the parse yields the core every
+// FPL_JSON_SLICE_BUDGET_US and, reading a stream, copies the strings it keeps,
+// so the document outlives the PSRAM buffer.
+static ParseOutcome parseJsonBody(const char *body, size_t length, JsonDocument &doc, JsonDocument &filter,
+                                  FetchEndpoint endpoint) {
+    JsonSliceReader reader(body, length);
+    traceBegin(TraceSpan::Parse, static_cast<uint16_t>(endpoint));
+    const DeserializationError err = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
+    traceEnd(TraceSpan::Parse, static_cast<uint16_t>(endpoint));
+    reader.finish();
+    netStatsRecordParse(endpoint, reader.elapsedUs());
+    Serial.printf("[JSON] %s: %u bytes in %lu ms, %lu yields, longest slice %lu us\n", fetchEndpointName(endpoint),
+                  static_cast<unsigned>(length), static_cast<unsigned long>(reader.elapsedUs() / 1000U),
+                  static_cast<unsigned long>(reader.yields()), static_cast<unsigned long>(reader.maxSliceUs()));
+    if (!err) {
+        return ParseOutcome::Ok;
+    }
+    const size_t previewLen = length < 200 ? length : 200;
+    Serial.printf("JSON parse error [%s]: %s\n", fetchEndpointName(endpoint), err.c_str());
+    Serial.printf("Payload bytes: %u | preview: %.*s\n", static_cast<unsigned>(length), static_cast<int>(previewLen),
+                  body);
+    if (err == DeserializationError::IncompleteInput || err == DeserializationError::EmptyInput) {
+        return ParseOutcome::Truncated;
+    }
+    return ParseOutcome::Invalid;
+}
+
+static void buildFetchJob(FetchEndpoint endpoint, int gw, FetchJob &job) {
+    job.endpoint = endpoint;
+    job.pollId = 0;
+    job.maxBytes = FPL_SMALL_PSRAM_MAX_BYTES;
+    switch (endpoint) {
+        case FetchEndpoint::Bootstrap:
+            strlcpy(job.url, "https://fantasy.premierleague.com/api/bootstrap-static/", sizeof(job.url));
+            job.maxBytes = FPL_BOOTSTRAP_PSRAM_MAX_BYTES;
+            break;
+        case FetchEndpoint::Entry:
+            snprintf(job.url, sizeof(job.url), "https://fantasy.premierleague.com/api/entry/%d/", FPL_ENTRY_ID);
+            break;
+        case FetchEndpoint::History:
+            snprintf(job.url, sizeof(job.url), "https://fantasy.premierleague.com/api/entry/%d/history/",
+                     FPL_ENTRY_ID);
+            break;
+        case FetchEndpoint::Picks:
+            snprintf(job.url, sizeof(job.url), "https://fantasy.premierleague.com/api/entry/%d/event/%d/picks/",
+                     FPL_ENTRY_ID, gw);
+            break;
+        case FetchEndpoint::Live:
+            snprintf(job.url, sizeof(job.url), "https://fantasy.premierleague.com/api/event/%d/live/", gw);
+            job.maxBytes = FPL_LIVE_PSRAM_MAX_BYTES;
+            break;
+        default:
+            job.url[0] = '\0';
+            break;
     }
-
-    return false;
 }
 
-static bool fetchUrlToPsramBuffer(const String &url, char *&bufferOut, size_t &lengthOut, size_t maxBytes) {
-    bufferOut = nullptr;
-    lengthOut = 0;
-
-    for (int attempt = 1; attempt <= 2; ++attempt) {
-        WiFiClientSecure client;
-        client.setInsecure();
-
-        HTTPClient http;
-        setupHttpDefaults(http);
-        if (!http.begin(client, url)) {
-            return false;
-        }
-
-        const int code = http.GET();
-        if (code != HTTP_CODE_OK) {
-            Serial.printf("GET failed [%s], HTTP %d\n", url.c_str(), code);
-            http.end();
-            return false;
-        }
-
-        int contentLen = http.getSize();
-        if (contentLen < 0) {
-            contentLen = 65536;
-        }
-
-        size_t capacity = static_cast<size_t>(contentLen) + 1;
-        if (capacity > maxBytes + 1) {
-            capacity = maxBytes + 1;
-        }
-        if (capacity < 4096) {
-            capacity = 4096;
-        }
-
-        char *buf = static_cast<char *>(heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
-        if (!buf) {
-            Serial.printf("PSRAM alloc failed [%s]\n", url.c_str());
-            http.end();
-            return false;
-        }
-
-        size_t len = 0;
-        uint8_t chunk[1024];
-        WiFiClient *stream = http.getStreamPtr();
-
-        while (http.connected() || stream->available()) {
-            const int avail = stream->available();
-            if (avail <= 0) {
-                delay(1);
-                continue;
-            }
-
-            const size_t want = static_cast<size_t>(avail > static_cast<int>(sizeof(chunk)) ? sizeof(chunk) : avail);
-            const int got = stream->readBytes(chunk, want);
-            if (got <= 0) {
-                continue;
-            }
-
-            if (len + static_cast<size_t>(got) + 1 > capacity) {
-                size_t newCapacity = capacity * 2;
-                if (newCapacity < len + static_cast<size_t>(got) + 1) {
-                    newCapacity = len + static_cast<size_t>(got) + 1;
-                }
-                if (newCapacity > maxBytes + 1) {
-                    newCapacity = maxBytes + 1;
-                }
-
-                if (newCapacity <= capacity) {
-                    Serial.printf("Payload too large [%s] (> %u bytes)\n", url.c_str(), static_cast<unsigned>(maxBytes));
-                    heap_caps_free(buf);
-                    http.end();
-                    return false;
-                }
-
-                char *grown = static_cast<char *>(heap_caps_realloc(buf, newCapacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
-                if (!grown) {
-                    Serial.printf("PSRAM realloc failed [%s]\n", url.c_str());
-                    heap_caps_free(buf);
-                    http.end();
-                    return false;
-                }
-                buf = grown;
-                capacity = newCapacity;
-            }
-
-            memcpy(buf + len, chunk, static_cast<size_t>(got));
-            len += static_cast<size_t>(got);
-        }
-        http.end();
-
-        if (len == 0) {
-            Serial.printf("Empty HTTP payload [%s], attempt %d/2\n", url.c_str(), attempt);
-            heap_caps_free(buf);
-            if (attempt == 1) {
-                delay(200);
-                continue;
-            }
-            return false;
-        }
-
-        buf[len] = '\0';
-        bufferOut = buf;
-        lengthOut = len;
-        Serial.printf("PSRAM payload [%s]: %u bytes\n", url.c_str(), static_cast<unsigned>(len));
-        return true;
+// Console path: download on the calling task, then parse; a truncated body is
+// fetched once more. The poll goes through runPollPipeline() instead.
+template <typename Parse>
+static bool fetchAndParse(FetchEndpoint endpoint, int gw, Parse parse) {
+    if (WiFi.status() != WL_CONNECTED) {
+        return false;
     }
-
-    return false;
-}
-
-static bool getJsonDocumentFromPsramUrl(const String &url, DynamicJsonDocument &doc, size_t maxBytes,
-                                        JsonDocument *filter = nullptr) {
+    FetchJob job;
+    buildFetchJob(endpoint, gw, job);
     for (int attempt = 1; attempt <= 2; ++attempt) {
-        char *payload = nullptr;
-        size_t payloadLen = 0;
-        if (!fetchUrlToPsramBuffer(url, payload, payloadLen, maxBytes)) {
+        char *body = nullptr;
+        size_t length = 0;
+        traceBegin(TraceSpan::Fetch, static_cast<uint16_t>(endpoint));
+        const bool fetched = fetchUrlToPsram(job, body, length);
+        traceEnd(TraceSpan::Fetch, static_cast<uint16_t>(endpoint));
+        if (!fetched) {
             return false;
         }
-
-        DeserializationError err;
-        if (filter) {
-            err = deserializeJson(doc, payload, payloadLen, DeserializationOption::Filter(*filter));
-        } else {
-            err = deserializeJson(doc, payload, payloadLen);
-        }
-        heap_caps_free(payload);
-
-        if (!err) {
-            return true;
-        }
-
-        Serial.printf("JSON parse error [%s] from PSRAM attempt %d/2: %s\n", url.c_str(), attempt, err.c_str());
-        if (attempt == 1 &&
-            (err == DeserializationError::IncompleteInput || err == DeserializationError::EmptyInput)) {
+        const ParseOutcome outcome = parse(body, length);
+        heap_caps_free(body);
+        if (outcome == ParseOutcome::Truncated && attempt == 1) {
+            netStatsRetry(endpoint);
             delay(200);
             continue;
         }
-        return false;
+        return outcome == ParseOutcome::Ok;
     }
     return false;
 }
 
-static bool fetchEntrySummary(int &currentGwOut, int &overallRankOut, int &overallPointsOut) {
+static ParseOutcome parseEntrySummary(const char *body, size_t length, int &currentGwOut, int &overallRankOut,
+                                      int &overallPointsOut) {
     DynamicJsonDocument filter(256);
     filter["current_event"] = true;
     filter["summary_overall_rank"] = true;
     filter["summary_overall_points"] = true;
 
     DynamicJsonDocument doc(1024);
-    String url = "https://fantasy.premierleague.com/api/entry/";
-    url += String(FPL_ENTRY_ID);
-    url += "/";
-
-    if (!getJsonDocument(url, doc, &filter, JsonReadMode::StringBody)) {
-        return false;
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::Entry);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     if (!doc["current_event"].is<int>()) {
         Serial.println("entry response missing current_event");
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     currentGwOut = doc["current_event"].as<int>();
     overallRankOut = doc["summary_overall_rank"] | 0;
     overallPointsOut = doc["summary_overall_points"] | 0;
-    return true;
+    return ParseOutcome::Ok;
 }
 
-static bool fetchPreviousOverallRank(int currentGw, int &prevRankOut) {
+static bool fetchEntrySummary(int &currentGwOut, int &overallRankOut, int &overallPointsOut) {
+    return fetchAndParse(FetchEndpoint::Entry, 0, [&](const char *body, size_t length) {
+        return parseEntrySummary(body, length, currentGwOut, overallRankOut, overallPointsOut);
+    });
+}
+
+static ParseOutcome parsePreviousOverallRank(const char *body, size_t length, int currentGw, int &prevRankOut) {
     DynamicJsonDocument filter(512);
     JsonArray currentFilter = filter.createNestedArray("current");
     JsonObject currentEventFilter = currentFilter.createNestedObject();
@@ -587,17 +381,14 @@ static bool fetchPreviousOverallRank(int currentGw, int &prevRankOut) {
     currentEventFilter["overall_rank"] = true;
 
     DynamicJsonDocument doc(16384);
-    String url = "https://fantasy.premierleague.com/api/entry/";
-    url += String(FPL_ENTRY_ID);
-    url += "/history/";
-
-    if (!getJsonDocument(url, doc, &filter, JsonReadMode::StringBody)) {
-        return false;
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::History);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     JsonArray current = doc["current"].as<JsonArray>();
     if (current.isNull() || current.size() == 0) {
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     int bestEvent = -1;
@@ -611,7 +402,7 @@ static bool fetchPreviousOverallRank(int currentGw, int &prevRankOut) {
         }
         if (targetEvent > 0 && ev == targetEvent) {
             prevRankOut = rank;
-            return true;
+            return ParseOutcome::Ok;
         }
         if (ev < currentGw && ev > bestEvent) {
             bestEvent = ev;
@@ -621,12 +412,19 @@ static bool fetchPreviousOverallRank(int currentGw, int &prevRankOut) {
 
     if (bestEvent > 0 && bestRank > 0) {
         prevRankOut = bestRank;
-        return true;
+        return ParseOutcome::Ok;
     }
-    return false;
+    return ParseOutcome::Invalid;
 }
 
-static bool fetchGameweekState(bool &isLiveOut, int &nextGwOut, bool &hasDeadlineOut, time_t &deadlineOut) {
+static bool fetchPreviousOverallRank(int currentGw, int &prevRankOut) {
+    return fetchAndParse(FetchEndpoint::History, 0, [&](const char *body, size_t length) {
+        return parsePreviousOverallRank(body, length, currentGw, prevRankOut);
+    });
+}
+
+static ParseOutcome parseGameweekState(const char *body, size_t length, bool &isLiveOut, int &nextGwOut,
+                                       bool &hasDeadlineOut, time_t &deadlineOut) {
     DynamicJsonDocument filter(512);
     JsonArray eventsFilter = filter.createNestedArray("events");
     JsonObject eventFilter = eventsFilter.createNestedObject();
@@ -637,16 +435,17 @@ static bool fetchGameweekState(bool &isLiveOut, int &nextGwOut, bool &hasDeadlin
     eventFilter["deadline_time"] = true;
     eventFilter["deadline_time_epoch"] = true;
 
-    DynamicJsonDocument doc(8192);
-    const String url = "https://fantasy.premierleague.com/api/bootstrap-static/";
-    if (!getJsonDocumentFromPsramUrl(url, doc, FPL_BOOTSTRAP_PSRAM_MAX_BYTES, &filter)) {
-        return false;
+    // Copy-mode parse: leaves room for the ~38 deadline_time strings.
+    DynamicJsonDocument doc(12288);
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::Bootstrap);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     JsonArray events = doc["events"].as<JsonArray>();
     if (events.isNull()) {
         Serial.println("bootstrap response missing events");
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     bool foundCurrent = false;
@@ -683,7 +482,7 @@ static bool fetchGameweekState(bool &isLiveOut, int &nextGwOut, bool &hasDeadlin
     }
 
     if (!foundCurrent && !foundNext) {
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     // Proxy for live state from bootstrap event flags.
@@ -691,10 +490,17 @@ static bool fetchGameweekState(bool &isLiveOut, int &nextGwOut, bool &hasDeadlin
     nextGwOut = foundNext ? nextGw : 0;
     hasDeadlineOut = hasDeadline;
     deadlineOut = parsedDeadline;
-    return true;
+    return ParseOutcome::Ok;
 }
 
-static bool fetchPicksForGw(int gw, TeamPick *picks, size_t picksCapacity, size_t &pickCountOut, String &activeChipOut) {
+static bool fetchGameweekState(bool &isLiveOut, int &nextGwOut, bool &hasDeadlineOut, time_t &deadlineOut) {
+    return fetchAndParse(FetchEndpoint::Bootstrap, 0, [&](const char *body, size_t length) {
+        return parseGameweekState(body, length, isLiveOut, nextGwOut, hasDeadlineOut, deadlineOut);
+    });
+}
+
+static ParseOutcome parsePicks(const char *body, size_t length, TeamPick *picks, size_t picksCapacity,
+                               size_t &pickCountOut, String &activeChipOut) {
     DynamicJsonDocument filter(512);
     filter["active_chip"] = true;
     JsonObject pickFilter = filter["picks"].createNestedObject();
@@ -705,14 +511,9 @@ static bool fetchPicksForGw(int gw, TeamPick *picks, size_t picksCapacity, size_
     pickFilter["is_vice_captain"] = true;
 
     DynamicJsonDocument doc(8192);
-    String url = "https://fantasy.premierleague.com/api/entry/";
-    url += String(FPL_ENTRY_ID);
-    url += "/event/";
-    url += String(gw);
-    url += "/picks/";
-
-    if (!getJsonDocument(url, doc, &filter, JsonReadMode::StringBody)) {
-        return false;
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::Picks);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     activeChipOut = doc["active_chip"].is<const char *>() ? doc["active_chip"].as<const char *>() : "none";
@@ -720,7 +521,7 @@ static bool fetchPicksForGw(int gw, TeamPick *picks, size_t picksCapacity, size_
     JsonArray picksArray = doc["picks"].as<JsonArray>();
     if (picksArray.isNull()) {
         Serial.println("picks response missing picks array");
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     pickCountOut = 0;
@@ -736,10 +537,16 @@ static bool fetchPicksForGw(int gw, TeamPick *picks, size_t picksCapacity, size_
         pick.isViceCaptain = p["is_vice_captain"] | false;
     }
 
-    return pickCountOut > 0;
+    return pickCountOut > 0 ? ParseOutcome::Ok : ParseOutcome::Invalid;
 }
 
-static bool fetchLivePointsForPicks(int gw, TeamPick *picks, size_t pickCount) {
+static bool fetchPicksForGw(int gw, TeamPick *picks, size_t picksCapacity, size_t &pickCountOut, String &activeChipOut) {
+    return fetchAndParse(FetchEndpoint::Picks, gw, [&](const char *body, size_t length) {
+        return parsePicks(body, length, picks, picksCapacity, pickCountOut, activeChipOut);
+    });
+}
+
+static ParseOutcome parseLivePoints(const char *body, size_t length, TeamPick *picks, size_t pickCount) {
     DynamicJsonDocument filter(512);
     JsonArray elementsFilter = filter.createNestedArray("elements");
     JsonObject elementFilter = elementsFilter.createNestedObject();
@@ -768,18 +575,15 @@ static bool fetchLivePointsForPicks(int gw, TeamPick *picks, size_t pickCount) {
     explainStatFilter["value"] = true;
 
     DynamicJsonDocument doc(FPL_LIVE_JSON_DOC_CAPACITY);
-    String url = "https://fantasy.premierleague.com/api/event/";
-    url += String(gw);
-    url += "/live/";
-
-    if (!getJsonDocumentFromPsramUrl(url, doc, FPL_LIVE_PSRAM_MAX_BYTES, &filter)) {
-        return false;
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::Live);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     JsonArray elements = doc["elements"].as<JsonArray>();
     if (elements.isNull()) {
         Serial.println("live response missing elements array");
-        return false;
+        return ParseOutcome::Invalid;
     }
 
     for (size_t i = 0; i < pickCount; ++i) {
@@ -814,7 +618,13 @@ static bool fetchLivePointsForPicks(int gw, TeamPick *picks, size_t pickCount) {
         }
     }
 
-    return true;
+    return ParseOutcome::Ok;
+}
+
+static bool fetchLivePointsForPicks(int gw, TeamPick *picks, size_t pickCount) {
+    return fetchAndParse(FetchEndpoint::Live, gw, [&](const char *body, size_t length) {
+        return parseLivePoints(body, length, picks, pickCount);
+    });
 }
 
 #if FPL_ENABLE_NAME_LOOKUP
@@ -881,7 +691,7 @@ static void normalizeKitTeamSlug(char *slug, size_t slugLen) {
     }
 }
 
-static bool fetchPlayerMetaForPicks(TeamPick *picks, size_t pickCount) {
+static ParseOutcome parsePlayerMeta(const char *body, size_t length, TeamPick *picks, size_t pickCount) {
     DynamicJsonDocument filter(1152);
     JsonArray elementsFilter = filter.createNestedArray("elements");
     JsonObject elementFilter = elementsFilter.createNestedObject();
@@ -900,10 +710,11 @@ static bool fetchPlayerMetaForPicks(TeamPick *picks, size_t pickCount) {
     teamFilter["id"] = true;
     teamFilter["name"] = true;
 
-    DynamicJsonDocument doc(90000);
-    const String url = "https://fantasy.premierleague.com/api/bootstrap-static/";
-    if (!getJsonDocumentFromPsramUrl(url, doc, FPL_BOOTSTRAP_PSRAM_MAX_BYTES, &filter)) {
-        return false;
+    // Copy-mode parse: includes room for every web_name and team name.
+    DynamicJsonDocument doc(110000);
+    const ParseOutcome outcome = parseJsonBody(body, length, doc, filter, FetchEndpoint::Bootstrap);
+    if (outcome != ParseOutcome::Ok) {
+        return outcome;
     }
 
     struct TypeName {
@@ -969,7 +780,13 @@ static bool fetchPlayerMetaForPicks(TeamPick *picks, size_t pickCount) {
         }
     }
 
-    return true;
+    return ParseOutcome::Ok;
+}
+
+static bool fetchPlayerMetaForPicks(TeamPick *picks, size_t pickCount) {
+    return fetchAndParse(FetchEndpoint::Bootstrap, 0, [&](const char *body, size_t length) {
+        return parsePlayerMeta(body, length, picks, pickCount);
+    });
 }
 #endif
 
@@ -1335,6 +1152,7 @@ static void notifyEvent(const TeamPick &pick, int pts, const char *what) {
 }
 
 static void detectAndNotifyPointChangesFromBreakdown(int gw, const TeamPick *picks, size_t pickCount) {
+    TraceScope trace(TraceSpan::Diff);
     for (size_t i = 0; i < pickCount; ++i) {
         const TeamPick &p = picks[i];
         LastPickState *state = nullptr;
@@ -1425,6 +1243,7 @@ static void detectAndNotifyPointChangesFromBreakdown(int gw, const TeamPick *pic
 }
 
 static void detectAndNotifyPointChanges(int gw, const TeamPick *picks, size_t pickCount) {
+    TraceScope trace(TraceSpan::Diff);
     for (size_t i = 0; i < pickCount; ++i) {
         const TeamPick &p = picks[i];
         LastPickState *state = nullptr;
@@ -1620,23 +1439,25 @@ static bool fetchTeamSnapshot(TeamSnapshot &out) {
     return true;
 }
 
-static bool fetchAndPrintTeamSnapshot(int &gwPointsOut, int *currentGwOut = nullptr, int *overallPointsOut = nullptr) {
-    TeamSnapshot snapshot;
-    if (!fetchTeamSnapshot(snapshot)) {
-        return false;
-    }
-
+// Diff/publish stage of a poll: squad rows, kit prefetch, event notifications and the log dump.
+static void publishTeamSnapshot(TeamSnapshot &snapshot) {
+    TraceScope trace(TraceSpan::Publish);
     updateSharedSquadFromPicks(snapshot.picks, snapshot.pickCount);
 
+    // Warm the kit cache now so a popup for any pick never has to read flash.
+    for (size_t i = 0; i < snapshot.pickCount; ++i) {
+        kitCachePrefetch(snapshot.picks[i].teamShortName, snapshot.picks[i].elementType == 1);
+    }
+    kitCachePrintStats();
+
     if (kUseServerEventBreakdown) {
         detectAndNotifyPointChangesFromBreakdown(snapshot.currentGw, snapshot.picks, snapshot.pickCount);
     } else {
         detectAndNotifyPointChanges(snapshot.currentGw, snapshot.picks, snapshot.pickCount);
     }
-    gwPointsOut = snapshot.gwPoints;
 
     Serial.println("\n=== FPL Team Snapshot ===");
-    Serial.printf("Entry ID: %d | GW: %d | GW points: %d\n", FPL_ENTRY_ID, snapshot.currentGw, gwPointsOut);
+    Serial.printf("Entry ID: %d | GW: %d | GW points: %d\n", FPL_ENTRY_ID, snapshot.currentGw, snapshot.gwPoints);
     if (snapshot.overallRank > 0) {
         Serial.printf("Overall rank: %d\n", snapshot.overallRank);
     }
@@ -1682,15 +1503,6 @@ static bool fetchAndPrintTeamSnapshot(int &gwPointsOut, int *currentGwOut = null
         }
     }
     Serial.println("=========================\n");
-
-    if (currentGwOut) {
-        *currentGwOut = snapshot.currentGw;
-    }
-    if (overallPointsOut) {
-        *overallPointsOut = snapshot.overallPoints;
-    }
-
-    return true;
 }
 
 static bool fetchRankDelta(int &overallRankOut, int &rankDiffOut) {
@@ -1715,179 +1527,542 @@ static bool fetchRankDelta(int &overallRankOut, int &rankDiffOut) {
     return true;
 }
 
-static void lvglFlushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-    const int x1 = area->x1;
-    const int y1 = area->y1;
-    const int x2 = area->x2;
-    const int y2 = area->y2;
-    const int w = x2 - x1 + 1;
-    const int h = y2 - y1 + 1;
+// One poll as a pipeline: the download workers fetch while fplTask parses
+// whatever has arrived and has its inputs. Entry unlocks picks and live (they
+// need the GW) and history; picks unlock the live merge and the bootstrap name
+// lookup. Bootstrap is fetched once and parsed twice.
+struct PollPipeline {
+    uint32_t pollId = 0;
+    uint32_t startMs = 0;
+    uint8_t outstanding = 0;
+    uint8_t attempts[kFetchEndpointCount] = {};
+    bool held[kFetchEndpointCount] = {};      // body arrived, not parsed yet
+    bool finished[kFetchEndpointCount] = {};  // parsed, failed or skipped
+    FetchResult results[kFetchEndpointCount] = {};
+    uint32_t queueMs[kFetchEndpointCount] = {};
+    uint32_t downloadMs[kFetchEndpointCount] = {};
+    uint32_t parseMs[kFetchEndpointCount] = {};
+
+    bool gwStateParsed = false;
+    bool hasGwState = false;
+    bool isLive = false;
+    int nextGw = 0;
+    bool hasDeadline = false;
+    time_t deadlineUtc = 0;
+    bool hasEntry = false;
+    bool hasPicks = false;
+    bool hasLive = false;
+    int previousRank = 0;
+    TeamSnapshot snapshot;
+};
 
-    display.drawBitmap(x1, y1, w, h, px_map);
-    lv_display_flush_ready(disp);
-}
+static PollPipeline pollPipeline;  // fplTask only; TeamSnapshot is too big for its stack
+static constexpr uint32_t kPollResultTimeoutMs = 120000;
 
-static uint32_t lvglTickCb(void) {
-    return millis();
+static size_t endpointIndex(FetchEndpoint endpoint) {
+    return static_cast<size_t>(endpoint);
 }
 
-static void lvglTouchCb(lv_indev_t *, lv_indev_data_t *data) {
-    int x = 0;
-    int y = 0;
-    if (touch.getTouch(&x, &y)) {
-        data->point.x = x;
-        data->point.y = y;
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED;
+static void submitPollFetch(PollPipeline &p, FetchEndpoint endpoint) {
+    const size_t idx = endpointIndex(endpoint);
+    FetchJob job;
+    buildFetchJob(endpoint, p.snapshot.currentGw, job);
+    job.pollId = p.pollId;
+    if (!fetchSubmit(job)) {
+        Serial.printf("[POLL] could not queue %s\n", fetchEndpointName(endpoint));
+        p.finished[idx] = true;
+        return;
     }
+    if (p.startMs == 0) {
+        p.startMs = millis();
+    }
+    p.attempts[idx]++;
+    p.outstanding++;
 }
 
-static void formatNumberWithCommas(int value, char *out, size_t outLen) {
-    if (!out || outLen == 0) {
+// Frees the body and either refetches a truncated one (once) or closes the endpoint.
+static void finishPollFetch(PollPipeline &p, FetchEndpoint endpoint, ParseOutcome outcome) {
+    const size_t idx = endpointIndex(endpoint);
+    fetchRelease(p.results[idx]);
+    p.held[idx] = false;
+    if (outcome == ParseOutcome::Truncated && p.attempts[idx] < 2) {
+        netStatsRetry(endpoint);
+        submitPollFetch(p, endpoint);
         return;
     }
-    char raw[24];
-    snprintf(raw, sizeof(raw), "%d", value);
-    const int rawLen = static_cast<int>(strlen(raw));
-    if (rawLen <= 3) {
-        strlcpy(out, raw, outLen);
-        return;
+    p.finished[idx] = true;
+}
+
+template <typename Parse>
+static ParseOutcome timedPollParse(PollPipeline &p, FetchEndpoint endpoint, Parse parse) {
+    const size_t idx = endpointIndex(endpoint);
+    const uint32_t parseStart = millis();
+    const ParseOutcome outcome = parse(p.results[idx].body, p.results[idx].length);
+    p.parseMs[idx] += millis() - parseStart;
+    return outcome;
+}
+
+static void advancePoll(PollPipeline &p) {
+    const size_t entry = endpointIndex(FetchEndpoint::Entry);
+    const size_t history = endpointIndex(FetchEndpoint::History);
+    const size_t picks = endpointIndex(FetchEndpoint::Picks);
+    const size_t live = endpointIndex(FetchEndpoint::Live);
+    const size_t bootstrap = endpointIndex(FetchEndpoint::Bootstrap);
+    TeamSnapshot &snap = p.snapshot;
+
+    if (p.held[entry]) {
+        const ParseOutcome outcome = timedPollParse(p, FetchEndpoint::Entry, [&](const char *body, size_t length) {
+            return parseEntrySummary(body, length, snap.currentGw, snap.overallRank, snap.overallPoints);
+        });
+        p.hasEntry = outcome == ParseOutcome::Ok;
+        finishPollFetch(p, FetchEndpoint::Entry, outcome);
+        if (p.hasEntry) {
+            submitPollFetch(p, FetchEndpoint::Picks);
+            submitPollFetch(p, FetchEndpoint::Live);
+        }
+    }
+    if (p.finished[entry] && !p.hasEntry) {
+        // No GW, so nothing to ask for.
+        p.finished[picks] = true;
+        p.finished[live] = true;
+    }
+    if (p.held[bootstrap] && !p.gwStateParsed) {
+        const ParseOutcome outcome = timedPollParse(p, FetchEndpoint::Bootstrap, [&](const char *body, size_t length) {
+            return parseGameweekState(body, length, p.isLive, p.nextGw, p.hasDeadline, p.deadlineUtc);
+        });
+        p.hasGwState = outcome == ParseOutcome::Ok;
+        p.gwStateParsed = outcome != ParseOutcome::Truncated;
+        if (!p.gwStateParsed) {
+            finishPollFetch(p, FetchEndpoint::Bootstrap, outcome);
+        }
+    }
+    if (p.held[picks]) {
+        String activeChip;
+        const ParseOutcome outcome = timedPollParse(p, FetchEndpoint::Picks, [&](const char *body, size_t length) {
+            return parsePicks(body, length, snap.picks, 16, snap.pickCount, activeChip);
+        });
+        p.hasPicks = outcome == ParseOutcome::Ok;
+        snap.activeChip = activeChip;
+        finishPollFetch(p, FetchEndpoint::Picks, outcome);
+    }
+    if (p.held[live] && p.finished[picks]) {
+        ParseOutcome outcome = ParseOutcome::Invalid;
+        if (p.hasPicks) {
+            outcome = timedPollParse(p, FetchEndpoint::Live, [&](const char *body, size_t length) {
+                return parseLivePoints(body, length, snap.picks, snap.pickCount);
+            });
+        }
+        p.hasLive = outcome == ParseOutcome::Ok;
+        finishPollFetch(p, FetchEndpoint::Live, outcome);
+    }
+    if (p.held[history] && p.finished[entry]) {
+        ParseOutcome outcome = ParseOutcome::Invalid;
+        if (p.hasEntry) {
+            outcome = timedPollParse(p, FetchEndpoint::History, [&](const char *body, size_t length) {
+                return parsePreviousOverallRank(body, length, snap.currentGw, p.previousRank);
+            });
+        }
+        finishPollFetch(p, FetchEndpoint::History, outcome);
+    }
+    if (p.held[bootstrap] && p.gwStateParsed && p.finished[picks]) {
+        ParseOutcome outcome = ParseOutcome::Invalid;
+#if FPL_ENABLE_NAME_LOOKUP
+        if (p.hasPicks) {
+            outcome = timedPollParse(p, FetchEndpoint::Bootstrap, [&](const char *body, size_t length) {
+                return parsePlayerMeta(body, length, snap.picks, snap.pickCount);
+            });
+        }
+#endif
+        snap.hasPlayerMeta = outcome == ParseOutcome::Ok;
+        if (outcome == ParseOutcome::Truncated) {
+            p.gwStateParsed = false;  // the refetch is parsed from the start
+        }
+        finishPollFetch(p, FetchEndpoint::Bootstrap, outcome);
+    }
+}
+
+static PollPipeline &runPollPipeline() {
+    TraceScope trace(TraceSpan::Poll);
+    static uint32_t nextPollId = 0;
+    PollPipeline &p = pollPipeline;
+    for (size_t i = 0; i < kFetchEndpointCount; ++i) {
+        p.attempts[i] = 0;
+        p.held[i] = false;
+        p.finished[i] = false;
+        p.results[i] = FetchResult{};
+        p.queueMs[i] = 0;
+        p.downloadMs[i] = 0;
+        p.parseMs[i] = 0;
+    }
+    p.pollId = ++nextPollId;
+    p.startMs = 0;
+    p.outstanding = 0;
+    p.gwStateParsed = false;
+    p.hasGwState = false;
+    p.isLive = false;
+    p.nextGw = 0;
+    p.hasDeadline = false;
+    p.deadlineUtc = 0;
+    p.hasEntry = false;
+    p.hasPicks = false;
+    p.hasLive = false;
+    p.previousRank = 0;
+    p.snapshot = TeamSnapshot{};
+
+    // The scheduler starts entry ahead of the two metadata jobs, and live and
+    // picks ahead of whichever metadata job is still waiting.
+    submitPollFetch(p, FetchEndpoint::Entry);
+    submitPollFetch(p, FetchEndpoint::Bootstrap);
+    submitPollFetch(p, FetchEndpoint::History);
+    advancePoll(p);
+
+    while (p.outstanding > 0) {
+        FetchResult result;
+        if (!fetchWaitResult(result, kPollResultTimeoutMs)) {
+            Serial.printf("[POLL] gave up waiting for %u response(s)\n", static_cast<unsigned>(p.outstanding));
+            break;
+        }
+        if (result.pollId != p.pollId) {
+            fetchRelease(result);  // straggler from a poll that timed out
+            continue;
+        }
+        p.outstanding--;
+        const size_t idx = endpointIndex(result.endpoint);
+        p.queueMs[idx] += result.startMs - result.queuedMs;
+        p.downloadMs[idx] += result.doneMs - result.startMs;
+        p.results[idx] = result;
+        if (result.ok) {
+            p.held[idx] = true;
+        } else {
+            p.finished[idx] = true;
+        }
+        advancePoll(p);
     }
 
-    char rev[32];
-    int idx = 0;
-    int digits = 0;
-    for (int i = rawLen - 1; i >= 0; --i) {
-        rev[idx++] = raw[i];
-        ++digits;
-        if (digits == 3 && i > 0) {
-            rev[idx++] = ',';
-            digits = 0;
+    for (size_t i = 0; i < kFetchEndpointCount; ++i) {
+        if (p.held[i]) {
+            fetchRelease(p.results[i]);
+            p.held[i] = false;
         }
     }
-    int outIdx = 0;
-    for (int i = idx - 1; i >= 0 && static_cast<size_t>(outIdx + 1) < outLen; --i) {
-        out[outIdx++] = rev[i];
+    if (p.hasEntry && p.hasPicks && p.hasLive) {
+        p.snapshot.gwPoints = computeGwPointsFromPicks(p.snapshot.picks, p.snapshot.pickCount);
     }
-    out[outIdx] = '\0';
+    return p;
 }
 
-static constexpr uint32_t kColorBgDeep = 0x1A0533;
-static constexpr uint32_t kColorBgSurface = 0x2D1B4E;
-static constexpr uint32_t kColorTextPrimary = 0xFFFFFF;
-static constexpr uint32_t kColorTextSecondary = 0xB0A0C0;
-static constexpr uint32_t kColorAccentGreen = 0x00FF87;
-static constexpr uint32_t kColorAccentRed = 0xFF2882;
-static constexpr uint32_t kColorAccentAmber = 0xFFC107;
-static constexpr uint32_t kColorAccentCyan = 0x00E5FF;
-static constexpr uint32_t kColorButtonPurple = 0x6A3DFF;
-
-static const lv_font_t *kFontHero = &lv_font_montserrat_48;
-static const lv_font_t *kFontLarge = &lv_font_montserrat_32;
-static const lv_font_t *kFontBody = &lv_font_montserrat_20;
-static const lv_font_t *kFontCaption = &lv_font_montserrat_18;
-static const lv_font_t *kFontMicro = &lv_font_montserrat_14;
+// First request -> UI publish, and where the time went per endpoint:
+// q = waiting for a worker, dl = download, p = parse on fplTask.
+static void reportPollLatency(const PollPipeline &p, uint32_t publishedMs) {
+    uint32_t downloadSum = 0;
+    uint32_t parseSum = 0;
+    char detail[192];
+    size_t used = 0;
+    detail[0] = '\0';
+    for (size_t i = 0; i < kFetchEndpointCount; ++i) {
+        if (p.attempts[i] == 0) {
+            continue;
+        }
+        downloadSum += p.downloadMs[i];
+        parseSum += p.parseMs[i];
+        if (used < sizeof(detail)) {
+            const int n = snprintf(detail + used, sizeof(detail) - used, " %s q%lu/dl%lu/p%lu",
+                                   fetchEndpointName(static_cast<FetchEndpoint>(i)),
+                                   static_cast<unsigned long>(p.queueMs[i]), static_cast<unsigned long>(p.downloadMs[i]),
+                                   static_cast<unsigned long>(p.parseMs[i]));
+            used += n > 0 ? static_cast<size_t>(n) : 0;
+        }
+    }
+    Serial.printf("[POLL] first request -> publish %lu ms (downloads %lu ms, parse %lu ms, %d worker(s))\n",
+                  static_cast<unsigned long>(publishedMs - p.startMs), static_cast<unsigned long>(downloadSum),
+                  static_cast<unsigned long>(parseSum), FPL_FETCH_WORKERS);
+    Serial.printf("[POLL]%s\n", detail);
+}
+
+// Per-frame flush cost, split by full-screen vs partial redraws. "Copied" bytes went
+// through the driver's swap-and-pad path; "direct" bytes were DMA'd from LVGL's buffer.
+struct FlushBucket {
+    uint32_t frames = 0;
+    uint64_t copiedBytes = 0;
+    uint64_t directBytes = 0;
+    uint64_t cpuUs = 0;
+    uint64_t wallUs = 0;
+};
 
-static uint32_t popupHideAtMs = 0;
-static constexpr uint32_t kPopupDisplayDurationMs = 4000U;
-static uint32_t lastTickerRotateMs = 0;
-static uint32_t lastDeadlineBlinkMs = 0;
-static bool deadlineColonVisible = true;
-static size_t tickerEventIndex = 0;
-static uint32_t holdStartMs = 0;
-static bool holdTriggered = false;
-static uint32_t renderedEventsVersion = 0;
-static uint32_t renderedSquadVersion = 0;
-
-static lv_obj_t *modeToScreen(UiMode mode) {
-    switch (mode) {
-        case UiMode::Idle: return ui.screenIdle;
-        case UiMode::Deadline: return ui.screenDeadline;
-        case UiMode::FinalHour: return ui.screenFinalHour;
-        case UiMode::Live: return ui.screenLive;
-        case UiMode::EventPopup: return ui.screenPopup;
-        case UiMode::EventsList: return ui.screenEvents;
-        case UiMode::Squad: return ui.screenSquad;
-    }
-    return ui.screenIdle;
-}
-
-static void loadMode(UiMode mode, lv_screen_load_anim_t anim) {
-    if (currentMode == mode) {
-        return;
-    }
-    lv_obj_t *target = modeToScreen(mode);
-    if (!target) {
-        return;
-    }
-    lv_screen_load_anim(target, anim, 200, 0, false);
-    currentMode = mode;
-    // Force one-time rebuild of overlay lists after screen switch.
-    if (mode == UiMode::EventsList) {
-        renderedEventsVersion = 0;
-    } else if (mode == UiMode::Squad) {
-        renderedSquadVersion = 0;
-    }
-}
+struct FlushStats {
+    FlushBucket full;
+    FlushBucket partial;
+    bool frameOpen = false;
+    bool framePending = false;
+    uint32_t frameStartUs = 0;
+    uint32_t framePixels = 0;
+    uint32_t frameCopiedBytes = 0;
+    uint32_t frameDirectBytes = 0;
+    uint32_t frameCpuUs = 0;
+    volatile uint32_t lastQueuedUs = 0;
+    volatile uint32_t lastDoneUs = 0;
+    uint32_t lastReportMs = 0;
+};
 
-static lv_obj_t *createLabel(lv_obj_t *parent, const lv_font_t *font, uint32_t colorHex, lv_text_align_t align) {
-    lv_obj_t *label = lv_label_create(parent);
-    lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
-    lv_obj_set_style_text_color(label, lv_color_hex(colorHex), LV_PART_MAIN);
-    lv_obj_set_style_text_align(label, align, LV_PART_MAIN);
-    return label;
-}
+static FlushStats flushStats;
+static constexpr uint32_t kFlushStatsReportIntervalMs = 10000;
 
-static void styleScreen(lv_obj_t *screen, uint32_t bgHex) {
-    lv_obj_set_style_bg_color(screen, lv_color_hex(bgHex), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_radius(screen, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-    lv_obj_set_style_clip_corner(screen, true, LV_PART_MAIN);
-}
+// Pixels invalidated while each screen was active (after rounding), per report window.
+static uint32_t invalidatedPixels[kUiModeCount] = {};
 
-static void stylePurpleButton(lv_obj_t *btn) {
-    if (!btn) {
+static void closeFlushFrame() {
+    if (!flushStats.framePending) {
         return;
     }
-    lv_obj_set_style_bg_color(btn, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_80, LV_PART_MAIN);
+    flushStats.framePending = false;
+    FlushBucket &bucket = (flushStats.framePixels >= static_cast<uint32_t>(kDisplayWidth) * kDisplayHeight)
+                              ? flushStats.full
+                              : flushStats.partial;
+    bucket.frames++;
+    bucket.copiedBytes += flushStats.frameCopiedBytes;
+    bucket.directBytes += flushStats.frameDirectBytes;
+    bucket.cpuUs += flushStats.frameCpuUs;
+    bucket.wallUs += flushStats.lastDoneUs - flushStats.frameStartUs;
 }
 
-static void appendAsciiChar(char *out, size_t outLen, size_t &j, char ch) {
-    if (!out || outLen == 0 || j + 1 >= outLen) {
+static void printFlushBucket(const char *label, const FlushBucket &bucket) {
+    if (bucket.frames == 0) {
         return;
     }
-    out[j++] = ch;
-    out[j] = '\0';
+    Serial.printf("[FLUSH] %s: frames=%lu copied=%lluB/frame direct=%lluB/frame cpu=%lluus wall=%lluus\n", label,
+                  static_cast<unsigned long>(bucket.frames),
+                  static_cast<unsigned long long>(bucket.copiedBytes / bucket.frames),
+                  static_cast<unsigned long long>(bucket.directBytes / bucket.frames),
+                  static_cast<unsigned long long>(bucket.cpuUs / bucket.frames),
+                  static_cast<unsigned long long>(bucket.wallUs / bucket.frames));
 }
 
-static void sanitizeUtf8ToAscii(const char *in, char *out, size_t outLen) {
-    if (!out || outLen == 0) {
+static void reportFlushStats(uint32_t nowMs) {
+    if (nowMs - flushStats.lastReportMs < kFlushStatsReportIntervalMs) {
         return;
     }
-    out[0] = '\0';
-    if (!in) {
-        return;
+    const uint32_t windowMs = nowMs - flushStats.lastReportMs;
+    flushStats.lastReportMs = nowMs;
+    if (!flushStats.frameOpen) {
+        closeFlushFrame();
     }
+    printFlushBucket("full", flushStats.full);
+    printFlushBucket("partial", flushStats.partial);
+    flushStats.full = FlushBucket();
+    flushStats.partial = FlushBucket();
 
-    size_t j = 0;
-    for (size_t i = 0; in[i] != '\0' && j + 1 < outLen; ++i) {
-        const uint8_t c = static_cast<uint8_t>(in[i]);
-        if (c < 0x80) {
-            appendAsciiChar(out, outLen, j, static_cast<char>(c));
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        if (invalidatedPixels[i] == 0) {
             continue;
         }
+        Serial.printf("[INVAL] %s: %lu px/s\n", kUiModeNames[i],
+                      static_cast<unsigned long>((static_cast<uint64_t>(invalidatedPixels[i]) * 1000ULL) / windowMs));
+        invalidatedPixels[i] = 0;
+    }
+}
 
-        if (c == 0xC3) {
-            const uint8_t d = static_cast<uint8_t>(in[i + 1]);
-            if (d == 0) {
-                break;
-            }
-            i++;
-            switch (d) {
-                case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: appendAsciiChar(out, outLen, j, 'A'); break;
-                case 0x87: appendAsciiChar(out, outLen, j, 'C'); break;
+// Share of wall time uiTask spends awake, per screen on display.
+struct UiCpuStats {
+    uint64_t busyUs[kUiModeCount] = {};
+    uint64_t shownUs[kUiModeCount] = {};
+    uint32_t wakes[kUiModeCount] = {};
+    uint32_t lastReportMs = 0;
+};
+
+static UiCpuStats uiCpuStats;
+
+static void reportUiCpu(uint32_t nowMs) {
+    if (nowMs - uiCpuStats.lastReportMs < kFlushStatsReportIntervalMs) {
+        return;
+    }
+    uiCpuStats.lastReportMs = nowMs;
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        if (uiCpuStats.shownUs[i] == 0) {
+            continue;
+        }
+        const float shownSec = uiCpuStats.shownUs[i] / 1000000.0f;
+        Serial.printf("[UICPU] %s: %.2f%% busy, %.1f wakes/s over %.1fs (%s)\n", kUiModeNames[i],
+                      100.0f * uiCpuStats.busyUs[i] / uiCpuStats.shownUs[i], uiCpuStats.wakes[i] / shownSec,
+                      shownSec, kUiEventDriven ? "event-driven" : "10ms poll");
+    }
+    uiCpuStats = UiCpuStats();
+    uiCpuStats.lastReportMs = nowMs;
+}
+
+// SPD2010 column windows must start and end on 4-pixel boundaries. Widening the dirty
+// area here (rather than padding in the driver) lets LVGL render the real pixels for
+// those columns, so the strip can be sent straight from the draw buffer.
+static void lvglRounderCb(lv_event_t *e) {
+    lv_area_t *area = static_cast<lv_area_t *>(lv_event_get_param(e));
+    // The round panel never shows the corners, so they are never worth redrawing.
+    display.clampWindowToVisible(area->y1, area->y2, area->x1, area->x2);
+    SPD2010Display::alignWindowX(area->x1, area->x2);
+    invalidatedPixels[static_cast<size_t>(currentUiMode())] += lv_area_get_size(area);
+    frameSchedulerRequestFrame();
+}
+
+static void lvglFlushDoneCb(void *ctx) {
+    flushStats.lastDoneUs = micros();
+    perfRecordUs(PerfMetric::DmaWait, flushStats.lastDoneUs - flushStats.lastQueuedUs);
+    lv_display_flush_ready(static_cast<lv_display_t *>(ctx));
+}
+
+static void lvglFlushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    TraceScope trace(TraceSpan::Flush);
+    const uint32_t perfStart = perfNow();
+    const uint32_t startUs = micros();
+    const int x1 = area->x1;
+    const int y1 = area->y1;
+    const int x2 = area->x2;
+    const int y2 = area->y2;
+    const int w = x2 - x1 + 1;
+    const int h = y2 - y1 + 1;
+    const uint32_t pixels = static_cast<uint32_t>(w) * h;
+
+    if (!flushStats.frameOpen) {
+        closeFlushFrame();
+        flushStats.frameOpen = true;
+        flushStats.frameStartUs = startUs;
+        flushStats.framePixels = 0;
+        flushStats.frameCopiedBytes = 0;
+        flushStats.frameDirectBytes = 0;
+        flushStats.frameCpuUs = 0;
+    }
+    flushStats.framePixels += pixels;
+
+    // Completion is reported from the DMA-done ISR so LVGL can render the next
+    // strip into the other buffer while this one is still going out.
+    // LVGL renders RGB565_SWAPPED, i.e. already in the panel's byte order.
+    if (uiCaptureActive()) {
+        uiCaptureArea(x1, y1, w, h, px_map, true);
+    }
+
+    bool queued;
+    const uint32_t bytesBefore = display.bytesQueued();
+    flushStats.lastQueuedUs = startUs;
+    if (SPD2010Display::isWindowXAligned(x1, w)) {
+        const uint32_t queueStart = perfNow();
+        queued = display.drawBitmapDirect(x1, y1, w, h, px_map, lvglFlushDoneCb, disp);
+        perfRecordSince(PerfMetric::PanelQueue, queueStart);
+        flushStats.frameDirectBytes += display.bytesQueued() - bytesBefore;
+    } else {
+        // Only reachable if an area bypassed the rounder; the driver pads a copy,
+        // swapping as it goes, so hand it native pixels.
+        lv_draw_sw_rgb565_swap(px_map, pixels);
+        const uint32_t queueStart = perfNow();
+        queued = display.drawBitmapAsync(x1, y1, w, h, px_map, lvglFlushDoneCb, disp);
+        perfRecordSince(PerfMetric::PanelQueue, queueStart);
+        flushStats.frameCopiedBytes += display.bytesQueued() - bytesBefore;
+    }
+    perfAddFlushedPixels(pixels);
+    if (!queued) {
+        flushStats.lastDoneUs = micros();
+        lv_display_flush_ready(disp);
+    }
+
+    flushStats.frameCpuUs += micros() - startUs;
+    perfRecordSince(PerfMetric::FlushCb, perfStart);
+    if (lv_display_flush_is_last(disp)) {
+        flushStats.frameOpen = false;
+        flushStats.framePending = true;
+        frameSchedulerFramePresented();
+    }
+}
+
+static uint32_t lvglTickCb(void) {
+    return millis();
+}
+
+static void lvglTouchCb(lv_indev_t *indev, lv_indev_data_t *data) {
+    int x = 0;
+    int y = 0;
+    if (touch.getTouch(&x, &y)) {
+        data->point.x = x;
+        data->point.y = y;
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+        if (kUiEventDriven && !touch.isTouched()) {
+            // Release reported; stop polling until the controller raises INT again.
+            lv_timer_pause(lv_indev_get_read_timer(indev));
+        }
+    }
+}
+
+static void IRAM_ATTR onTouchInterrupt() {
+    touchWakePending = true;
+    if (uiTaskHandle) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(uiTaskHandle, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+static void resumeTouchPolling() {
+    if (lvglTouchIndev) {
+        lv_timer_t *readTimer = lv_indev_get_read_timer(lvglTouchIndev);
+        lv_timer_resume(readTimer);
+        lv_timer_ready(readTimer);
+    }
+}
+
+static uint32_t popupHideAtMs = 0;
+static constexpr uint32_t kPopupDisplayDurationMs = 4000U;
+// Safe from any task: loads directly on uiTask, otherwise hands the switch over.
+// A newer request replaces one that has not been applied yet.
+static void requestUiMode(UiMode mode, lv_screen_load_anim_t anim) {
+    if (uiTaskHandle && xTaskGetCurrentTaskHandle() == uiTaskHandle) {
+        loadMode(mode, anim);
+        return;
+    }
+    if (uiModeRequestQueue) {
+        const UiModeRequest request = {mode, anim};
+        xQueueOverwrite(uiModeRequestQueue, &request);
+        wakeUiTask();
+    }
+}
+
+static void applyUiModeRequest() {
+    UiModeRequest request;
+    if (uiModeRequestQueue && xQueueReceive(uiModeRequestQueue, &request, 0) == pdTRUE) {
+        loadMode(request.mode, request.anim);
+    }
+}
+
+static void appendAsciiChar(char *out, size_t outLen, size_t &j, char ch) {
+    if (!out || outLen == 0 || j + 1 >= outLen) {
+        return;
+    }
+    out[j++] = ch;
+    out[j] = '\0';
+}
+
+static void sanitizeUtf8ToAscii(const char *in, char *out, size_t outLen) {
+    if (!out || outLen == 0) {
+        return;
+    }
+    out[0] = '\0';
+    if (!in) {
+        return;
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; in[i] != '\0' && j + 1 < outLen; ++i) {
+        const uint8_t c = static_cast<uint8_t>(in[i]);
+        if (c < 0x80) {
+            appendAsciiChar(out, outLen, j, static_cast<char>(c));
+            continue;
+        }
+
+        if (c == 0xC3) {
+            const uint8_t d = static_cast<uint8_t>(in[i + 1]);
+            if (d == 0) {
+                break;
+            }
+            i++;
+            switch (d) {
+                case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: appendAsciiChar(out, outLen, j, 'A'); break;
+                case 0x87: appendAsciiChar(out, outLen, j, 'C'); break;
                 case 0x88: case 0x89: case 0x8A: case 0x8B: appendAsciiChar(out, outLen, j, 'E'); break;
                 case 0x8C: case 0x8D: case 0x8E: case 0x8F: appendAsciiChar(out, outLen, j, 'I'); break;
                 case 0x91: appendAsciiChar(out, outLen, j, 'N'); break;
@@ -1929,541 +2104,45 @@ static void sanitizeUtf8ToAscii(const char *in, char *out, size_t outLen) {
     }
 }
 
-static bool loadKitImage(const char *team, const char *type) {
-    if (!team || !team[0] || !type || !type[0]) {
-        Serial.printf("[KIT] invalid args team='%s' type='%s'\n", team ? team : "(null)", type ? type : "(null)");
-        return false;
-    }
-    char path[96];
-    snprintf(path, sizeof(path), "/kits/%s_%s_%dx%d.rgb565", team, type, kKitWidth, kKitHeight);
-
-    File f = LittleFS.open(path, "r");
-    if (!f) {
-        Serial.printf("[KIT] missing file: %s\n", path);
-        return false;
-    }
-    const size_t bytes = f.read(kitImageBuffer, kKitRgb565Bytes);
-    f.close();
-    if (bytes != kKitRgb565Bytes) {
-        Serial.printf("[KIT] short read: %s (%u/%u)\n", path, static_cast<unsigned>(bytes),
-                      static_cast<unsigned>(kKitRgb565Bytes));
-        return false;
-    }
-    Serial.printf("[KIT] loaded: %s\n", path);
-    return true;
-}
-
-static bool resolveAndLoadKitImage(const UiEventItem &event) {
-    if (!event.team[0]) {
-        Serial.printf("[KIT] event missing team slug: player='%s' label='%s'\n", event.player, event.label);
-        return false;
-    }
-    const char *type = event.isGk ? "gk" : "outfield";
-    if (loadKitImage(event.team, type)) {
-        return true;
-    }
-    if (event.isGk && loadKitImage(event.team, "goalkeeper")) {
-        return true;
-    }
-    if (event.isGk && loadKitImage(event.team, "outfield")) {
-        return true;
-    }
-    if (!event.isGk && loadKitImage(event.team, "player")) {
-        return true;
-    }
-    return false;
-}
-
-static void refreshEventsList(const UiRuntimeState &runtime) {
-    if (!ui.eventsList) {
-        return;
-    }
-    lv_obj_clean(ui.eventsList);
-    if (runtime.recentEventCount == 0) {
-        lv_obj_t *empty = createLabel(ui.eventsList, kFontCaption, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-        lv_label_set_text(empty, "No events yet");
-        lv_obj_center(empty);
-        return;
-    }
-
-    for (int i = static_cast<int>(runtime.recentEventCount) - 1; i >= 0; --i) {
-        const UiEventItem &e = runtime.recentEvents[i];
-        lv_obj_t *row = lv_obj_create(ui.eventsList);
-        lv_obj_set_size(row, lv_pct(100), 36);
-        lv_obj_set_style_min_height(row, 36, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
-        lv_obj_set_style_border_side(row, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
-        lv_obj_set_style_border_width(row, 1, LV_PART_MAIN);
-        lv_obj_set_style_border_color(row, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
-
-        lv_obj_t *left = createLabel(row, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_LEFT);
-        char leftBuf[48];
-        snprintf(leftBuf, sizeof(leftBuf), "%s %s", e.icon, e.player);
-        lv_label_set_text(left, leftBuf);
-        lv_obj_align(left, LV_ALIGN_LEFT_MID, 6, 0);
-
-        lv_obj_t *right = createLabel(row, kFontBody, e.delta >= 0 ? kColorAccentGreen : kColorAccentRed,
-                                      LV_TEXT_ALIGN_RIGHT);
-        char rightBuf[16];
-        snprintf(rightBuf, sizeof(rightBuf), "%+d", e.delta);
-        lv_label_set_text(right, rightBuf);
-        lv_obj_align(right, LV_ALIGN_RIGHT_MID, -6, 0);
-    }
-}
-
-static void refreshSquadList(const UiRuntimeState &runtime) {
-    if (!ui.squadList) {
-        return;
-    }
-    lv_obj_clean(ui.squadList);
-    for (size_t i = 0; i < runtime.squadCount; ++i) {
-        const UiSquadRow &rowData = runtime.squadRows[i];
-        lv_obj_t *row = lv_obj_create(ui.squadList);
-        lv_obj_set_size(row, lv_pct(100), 34);
-        lv_obj_set_style_min_height(row, 34, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
-
-        lv_obj_t *name = createLabel(row, &lv_font_montserrat_18, rowData.isBench ? kColorTextSecondary : kColorTextPrimary,
-                                     LV_TEXT_ALIGN_LEFT);
-        char nameBuf[48];
-        snprintf(nameBuf, sizeof(nameBuf), "%s%s%s", rowData.player, rowData.isCaptain ? " C" : "",
-                 rowData.isViceCaptain ? " V" : "");
-        lv_label_set_text(name, nameBuf);
-        lv_obj_align(name, LV_ALIGN_LEFT_MID, 6, 0);
-
-        lv_obj_t *breakdown = createLabel(row, &lv_font_montserrat_16, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-        lv_label_set_text(breakdown, rowData.breakdown);
-        lv_obj_align(breakdown, LV_ALIGN_CENTER, 28, 0);
-
-        lv_obj_t *points = createLabel(row, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_RIGHT);
-        char ptsBuf[12];
-        if (rowData.hasPlayed) {
-            snprintf(ptsBuf, sizeof(ptsBuf), "%d", rowData.points);
-        } else {
-            strlcpy(ptsBuf, "-", sizeof(ptsBuf));
-        }
-        lv_label_set_text(points, ptsBuf);
-        lv_obj_align(points, LV_ALIGN_RIGHT_MID, -8, 0);
-    }
-
-    lv_obj_t *footer = lv_obj_create(ui.squadList);
-    lv_obj_set_size(footer, lv_pct(100), 42);
-    lv_obj_set_style_bg_opa(footer, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(footer, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(footer, 0, LV_PART_MAIN);
-
-    static constexpr int kFooterBtnW = 100;
-    static constexpr int kFooterBtnH = 32;
-    static constexpr int kFooterGap = 6;
-
-    lv_obj_t *demoBtn1 = lv_button_create(footer);
-    lv_obj_set_size(demoBtn1, kFooterBtnW, kFooterBtnH);
-    lv_obj_align(demoBtn1, LV_ALIGN_LEFT_MID, 6, 0);
-    stylePurpleButton(demoBtn1);
-    lv_obj_set_style_border_width(demoBtn1, 0, LV_PART_MAIN);
-    lv_obj_add_event_cb(demoBtn1, squadDemoNotificationBtnCb, LV_EVENT_CLICKED, nullptr);
-    lv_obj_t *demoBtn1Label = createLabel(demoBtn1, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(demoBtn1Label, "Notify");
-    lv_obj_center(demoBtn1Label);
-
-    lv_obj_t *demoBtn2 = lv_button_create(footer);
-    lv_obj_set_size(demoBtn2, kFooterBtnW, kFooterBtnH);
-    lv_obj_align_to(demoBtn2, demoBtn1, LV_ALIGN_OUT_RIGHT_MID, kFooterGap, 0);
-    stylePurpleButton(demoBtn2);
-    lv_obj_set_style_border_width(demoBtn2, 0, LV_PART_MAIN);
-    lv_obj_add_event_cb(demoBtn2, squadDemoDeadline45BtnCb, LV_EVENT_CLICKED, nullptr);
-    lv_obj_t *demoBtn2Label = createLabel(demoBtn2, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(demoBtn2Label, "45m");
-    lv_obj_center(demoBtn2Label);
-
-    lv_obj_t *demoBtn3 = lv_button_create(footer);
-    lv_obj_set_size(demoBtn3, kFooterBtnW, kFooterBtnH);
-    lv_obj_align_to(demoBtn3, demoBtn2, LV_ALIGN_OUT_RIGHT_MID, kFooterGap, 0);
-    stylePurpleButton(demoBtn3);
-    lv_obj_set_style_border_width(demoBtn3, 0, LV_PART_MAIN);
-    lv_obj_add_event_cb(demoBtn3, squadDemoDeadline7BtnCb, LV_EVENT_CLICKED, nullptr);
-    lv_obj_t *demoBtn3Label = createLabel(demoBtn3, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(demoBtn3Label, "7m");
-    lv_obj_center(demoBtn3Label);
-}
-
-static void backFromEventsCb(lv_event_t *) {
-    loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
-}
-
-static void backFromSquadCb(lv_event_t *) {
-    loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_MOVE_TOP);
-}
-
-static void showEventsEventCb(lv_event_t *) {
-    loadMode(UiMode::EventsList, LV_SCR_LOAD_ANIM_MOVE_LEFT);
-}
-
-static void showSquadFromHold(void) {
-    loadMode(UiMode::Squad, LV_SCR_LOAD_ANIM_MOVE_BOTTOM);
-    holdTriggered = true;
-    if (ui.liveHoldArc) {
-        lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
-        lv_arc_set_value(ui.liveHoldArc, 0);
-    }
-}
-
-static void livePressEventCb(lv_event_t *e) {
-    const lv_event_code_t code = lv_event_get_code(e);
-    if (ui.liveTickerBtn) {
-        lv_indev_t *indev = lv_indev_active();
-        if (indev) {
-            lv_point_t p;
-            lv_indev_get_point(indev, &p);
-            lv_area_t tickerArea;
-            lv_obj_get_coords(ui.liveTickerBtn, &tickerArea);
-            const bool inTicker = (p.x >= tickerArea.x1 && p.x <= tickerArea.x2 && p.y >= tickerArea.y1 && p.y <= tickerArea.y2);
-            if (inTicker) {
-                return;
-            }
-        }
-    }
-
-    if (code == LV_EVENT_PRESSED) {
-        holdStartMs = millis();
-        holdTriggered = false;
-        if (ui.liveHoldArc) {
-            lv_obj_remove_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
-            lv_arc_set_value(ui.liveHoldArc, 0);
-        }
-    } else if (code == LV_EVENT_PRESSING) {
-        if (holdStartMs == 0 || holdTriggered || !ui.liveHoldArc) {
-            return;
-        }
-        const uint32_t elapsed = millis() - holdStartMs;
-        int progress = static_cast<int>((elapsed * 100U) / 3000U);
-        if (progress > 100) {
-            progress = 100;
-        }
-        lv_arc_set_value(ui.liveHoldArc, progress);
-        if (elapsed >= 3000U) {
-            showSquadFromHold();
-        }
-    } else if (code == LV_EVENT_RELEASED || code == LV_EVENT_PRESS_LOST) {
-        holdStartMs = 0;
-        if (!holdTriggered && ui.liveHoldArc) {
-            lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
-            lv_arc_set_value(ui.liveHoldArc, 0);
-        }
-        holdTriggered = false;
-    }
-}
-
-static lv_obj_t *createOverlayListScreen(lv_obj_t *screen, const char *title, lv_event_cb_t backCb) {
-    static constexpr int kPanelX = 340;
-    static constexpr int kPanelY = 340;
-    static constexpr int kPanelTop = 22;
-    static constexpr int kListW = 324;
-    static constexpr int kListH = 286;
-    static constexpr int kChordY = (kPanelTop + kPanelY) - 1;
-
-    lv_obj_t *panel = lv_obj_create(screen);
-    lv_obj_set_size(panel, kPanelX, kPanelY);
-    lv_obj_align(panel, LV_ALIGN_TOP_MID, 0, kPanelTop);
-    lv_obj_set_style_bg_opa(panel, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(panel, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(panel, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
-    lv_obj_set_style_radius(panel, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(panel, 0, LV_PART_MAIN);
-
-    lv_obj_t *titleLabel = createLabel(panel, kFontCaption, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(titleLabel, title);
-    lv_obj_align(titleLabel, LV_ALIGN_TOP_MID, 0, 10);
-
-    lv_obj_t *list = lv_obj_create(panel);
-    lv_obj_set_size(list, kListW, kListH);
-    lv_obj_align(list, LV_ALIGN_TOP_MID, 0, 42);
-    lv_obj_set_scroll_dir(list, LV_DIR_VER);
-    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_style_bg_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(list, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(list, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_row(list, 2, LV_PART_MAIN);
-
-    lv_obj_t *chordLine = lv_obj_create(screen);
-    lv_obj_set_size(chordLine, kPanelX, 2);
-    lv_obj_align(chordLine, LV_ALIGN_TOP_MID, 0, kChordY);
-    lv_obj_set_style_bg_color(chordLine, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(chordLine, LV_OPA_70, LV_PART_MAIN);
-    lv_obj_set_style_border_width(chordLine, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(chordLine, 0, LV_PART_MAIN);
-
-    lv_obj_t *back = lv_button_create(screen);
-    lv_obj_set_size(back, kPanelX, kDisplayHeight - kChordY);
-    lv_obj_align(back, LV_ALIGN_TOP_MID, 0, kChordY);
-    lv_obj_set_style_radius(back, 0, LV_PART_MAIN);
-    stylePurpleButton(back);
-    lv_obj_set_style_border_width(back, 0, LV_PART_MAIN);
-    lv_obj_add_event_cb(back, backCb, LV_EVENT_CLICKED, nullptr);
-    lv_obj_t *backLabel = createLabel(back, &lv_font_montserrat_32, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(backLabel, "<");
-    lv_obj_center(backLabel);
-
-    lv_obj_move_foreground(chordLine);
-    lv_obj_move_foreground(back);
-    return list;
-}
-
-static void createUi(void) {
-    memset(&ui, 0, sizeof(ui));
-    ui.screenIdle = lv_obj_create(nullptr);
-    ui.screenDeadline = lv_obj_create(nullptr);
-    ui.screenFinalHour = lv_obj_create(nullptr);
-    ui.screenLive = lv_obj_create(nullptr);
-    ui.screenPopup = lv_obj_create(nullptr);
-    ui.screenEvents = lv_obj_create(nullptr);
-    ui.screenSquad = lv_obj_create(nullptr);
-
-    styleScreen(ui.screenIdle, kColorBgDeep);
-    styleScreen(ui.screenDeadline, kColorBgDeep);
-    styleScreen(ui.screenFinalHour, 0x0C0B14);
-    styleScreen(ui.screenLive, kColorBgDeep);
-    styleScreen(ui.screenPopup, kColorBgDeep);
-    styleScreen(ui.screenEvents, kColorBgDeep);
-    styleScreen(ui.screenSquad, kColorBgDeep);
-
-    lv_obj_t *idleRing = lv_arc_create(ui.screenIdle);
-    lv_obj_set_size(idleRing, 340, 340);
-    lv_obj_center(idleRing);
-    lv_obj_set_style_arc_color(idleRing, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
-    lv_obj_set_style_arc_opa(idleRing, LV_OPA_30, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(idleRing, 1, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(idleRing, 0, LV_PART_INDICATOR);
-    lv_obj_remove_style(idleRing, nullptr, LV_PART_KNOB);
-    lv_obj_remove_flag(idleRing, LV_OBJ_FLAG_CLICKABLE);
-
-    ui.idleRankArrow = createLabel(ui.screenIdle, kFontBody, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.idleRankArrow, LV_ALIGN_CENTER, -68, -48);
-    ui.idleRankValue = createLabel(ui.screenIdle, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.idleRankValue, LV_ALIGN_CENTER, 16, -48);
-    ui.idleGwPoints = createLabel(ui.screenIdle, &lv_font_montserrat_26, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.idleGwPoints, LV_ALIGN_CENTER, 0, 36);
-    ui.idleTotalPoints = createLabel(ui.screenIdle, kFontCaption, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.idleTotalPoints, LV_ALIGN_CENTER, 0, 78);
-    ui.statusLabel = createLabel(ui.screenIdle, kFontMicro, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.statusLabel, LV_ALIGN_BOTTOM_MID, 0, -22);
-
-    ui.deadlineLabel = createLabel(ui.screenDeadline, &lv_font_montserrat_28, kColorAccentAmber, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_text(ui.deadlineLabel, "DEADLINE");
-    lv_obj_align(ui.deadlineLabel, LV_ALIGN_CENTER, 0, -110);
-    ui.deadlineCountdown = createLabel(ui.screenDeadline, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.deadlineCountdown, LV_ALIGN_CENTER, 0, -20);
-    ui.deadlineMeta = createLabel(ui.screenDeadline, &lv_font_montserrat_22, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.deadlineMeta, LV_ALIGN_CENTER, 0, 84);
-
-    ui.finalCountdown = createLabel(ui.screenFinalHour, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_center(ui.finalCountdown);
-
-    ui.liveTitle = createLabel(ui.screenLive, &lv_font_montserrat_16, kColorAccentCyan, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.liveTitle, LV_ALIGN_TOP_MID, 0, 24);
-    ui.liveDot = lv_obj_create(ui.screenLive);
-    lv_obj_set_size(ui.liveDot, 8, 8);
-    lv_obj_align(ui.liveDot, LV_ALIGN_TOP_MID, 84, 30);
-    lv_obj_set_style_radius(ui.liveDot, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(ui.liveDot, lv_color_hex(kColorAccentCyan), LV_PART_MAIN);
-    lv_obj_set_style_border_width(ui.liveDot, 0, LV_PART_MAIN);
-    ui.livePoints = createLabel(ui.screenLive, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.livePoints, LV_ALIGN_CENTER, 0, -46);
-    ui.liveRank = createLabel(ui.screenLive, &lv_font_montserrat_26, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.liveRank, LV_ALIGN_CENTER, 0, 26);
-    static constexpr int kLiveEventsTopY = static_cast<int>(kDisplayHeight) - 116;
-    lv_obj_t *liveEventsLine = lv_obj_create(ui.screenLive);
-    lv_obj_set_size(liveEventsLine, kDisplayWidth, 2);
-    lv_obj_align(liveEventsLine, LV_ALIGN_TOP_MID, 0, kLiveEventsTopY);
-    lv_obj_set_style_bg_color(liveEventsLine, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(liveEventsLine, LV_OPA_70, LV_PART_MAIN);
-    lv_obj_set_style_border_width(liveEventsLine, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(liveEventsLine, 0, LV_PART_MAIN);
-
-    ui.liveTickerBtn = lv_button_create(ui.screenLive);
-    lv_obj_set_size(ui.liveTickerBtn, kDisplayWidth, static_cast<int>(kDisplayHeight) - kLiveEventsTopY);
-    lv_obj_align(ui.liveTickerBtn, LV_ALIGN_TOP_MID, 0, kLiveEventsTopY);
-    stylePurpleButton(ui.liveTickerBtn);
-    lv_obj_set_style_radius(ui.liveTickerBtn, 0, LV_PART_MAIN);
-    lv_obj_set_style_border_width(ui.liveTickerBtn, 0, LV_PART_MAIN);
-    lv_obj_add_event_cb(ui.liveTickerBtn, showEventsEventCb, LV_EVENT_CLICKED, nullptr);
-    ui.liveTickerLabel = createLabel(ui.liveTickerBtn, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.liveTickerLabel, LV_ALIGN_TOP_MID, 0, 10);
-    ui.liveHoldArc = lv_arc_create(ui.screenLive);
-    lv_obj_set_size(ui.liveHoldArc, 360, 360);
-    lv_obj_center(ui.liveHoldArc);
-    lv_arc_set_range(ui.liveHoldArc, 0, 100);
-    lv_obj_set_style_arc_width(ui.liveHoldArc, 4, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(ui.liveHoldArc, lv_color_hex(kColorAccentCyan), LV_PART_INDICATOR);
-    lv_obj_set_style_arc_width(ui.liveHoldArc, 0, LV_PART_MAIN);
-    lv_obj_remove_style(ui.liveHoldArc, nullptr, LV_PART_KNOB);
-    lv_obj_remove_flag(ui.liveHoldArc, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESSED, nullptr);
-    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESSING, nullptr);
-    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_RELEASED, nullptr);
-    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESS_LOST, nullptr);
-
-    ui.popupTitle = createLabel(ui.screenPopup, kFontLarge, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.popupTitle, LV_ALIGN_CENTER, 0, -140);
-    memset(&kitImageDsc, 0, sizeof(kitImageDsc));
-    kitImageDsc.header.magic = LV_IMAGE_HEADER_MAGIC;
-    kitImageDsc.header.cf = LV_COLOR_FORMAT_RGB565;
-    kitImageDsc.header.w = kKitWidth;
-    kitImageDsc.header.h = kKitHeight;
-    kitImageDsc.data_size = kKitRgb565Bytes;
-    kitImageDsc.data = kitImageBuffer;
-    ui.popupKit = lv_image_create(ui.screenPopup);
-    lv_image_set_src(ui.popupKit, &kitImageDsc);
-    lv_obj_align(ui.popupKit, LV_ALIGN_CENTER, 0, -24);
-    ui.popupPlayer = createLabel(ui.screenPopup, kFontLarge, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.popupPlayer, LV_ALIGN_CENTER, 0, 68);
-    ui.popupDelta = createLabel(ui.screenPopup, &lv_font_montserrat_28, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.popupDelta, LV_ALIGN_CENTER, 0, 118);
-    ui.popupTotal = createLabel(ui.screenPopup, kFontBody, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
-    lv_obj_align(ui.popupTotal, LV_ALIGN_CENTER, 0, 154);
-
-    ui.eventsList = createOverlayListScreen(ui.screenEvents, "EVENTS", backFromEventsCb);
-    ui.squadList = createOverlayListScreen(ui.screenSquad, "MY SQUAD", backFromSquadCb);
-
-    lv_screen_load(ui.screenIdle);
-    currentMode = UiMode::Idle;
-}
-
 static void setSharedStatus(const char *text, uint32_t colorHex) {
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    strlcpy(sharedUiState.statusText, text, sizeof(sharedUiState.statusText));
-    sharedUiState.statusColor = colorHex;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    StatusMsg msg = {};
+    strlcpy(msg.text, text, sizeof(msg.text));
+    msg.color = colorHex;
+    busPublish(BusTopic::UiStatus, msg);
 }
 
 static void setSharedGwPoints(int points) {
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    sharedUiState.gwPoints = points;
-    sharedUiState.hasGwPoints = true;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    busPublish(BusTopic::UiGwPoints, GwPointsMsg{points});
 }
 
 static void setSharedGwStateText(const char *text) {
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    strlcpy(sharedUiState.gwStateText, text, sizeof(sharedUiState.gwStateText));
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    TextMsg msg = {};
+    strlcpy(msg.text, text, sizeof(msg.text));
+    busPublish(BusTopic::UiGwStateText, msg);
 }
 
 static void setSharedGameweekContext(bool isLiveGw, int currentGw, int nextGw, bool hasNextGw, time_t deadlineUtc,
                                      bool hasDeadline) {
-    ledRingSetDeadlineCountdown(hasDeadline && !isLiveGw, deadlineUtc);
-
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    sharedUiState.isLiveGw = isLiveGw;
-    sharedUiState.currentGw = currentGw;
-    sharedUiState.nextGw = nextGw;
-    sharedUiState.hasNextGw = hasNextGw;
-    sharedUiState.nextDeadlineUtc = deadlineUtc;
-    sharedUiState.hasNextDeadline = hasDeadline;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    GameweekMsg msg = {};
+    msg.isLiveGw = isLiveGw;
+    msg.hasNextGw = hasNextGw;
+    msg.hasDeadline = hasDeadline;
+    msg.currentGw = currentGw;
+    msg.nextGw = nextGw;
+    msg.deadlineUtc = deadlineUtc;
+    busPublish(BusTopic::UiGameweek, msg);
 }
 
 static void setSharedRankData(int overallRank, int rankDiff, bool hasRankData) {
-    ledRingSetRankTrend(rankDiff, hasRankData);
-
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    sharedUiState.overallRank = overallRank;
-    sharedUiState.rankDiff = rankDiff;
-    sharedUiState.hasRankData = hasRankData;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    busPublish(BusTopic::UiRank, RankMsg{overallRank, rankDiff, hasRankData});
 }
 
 static void setSharedTotalPoints(int totalPoints, bool hasTotalPoints) {
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    sharedUiState.totalPoints = totalPoints;
-    sharedUiState.hasTotalPoints = hasTotalPoints;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
+    busPublish(BusTopic::UiTotalPoints, TotalPointsMsg{totalPoints, hasTotalPoints});
 }
 
 static void setSharedFreshness(bool isStale, uint32_t lastApiUpdateMs) {
-    if (!sharedUiMutex) {
-        return;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    sharedUiState.isStale = isStale;
-    sharedUiState.lastApiUpdateMs = lastApiUpdateMs;
-    sharedUiState.version++;
-    xSemaphoreGive(sharedUiMutex);
-}
-
-static bool readSharedUiState(SharedUiState &out) {
-    if (!sharedUiMutex) {
-        return false;
-    }
-    if (xSemaphoreTake(sharedUiMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return false;
-    }
-
-    out = sharedUiState;
-    xSemaphoreGive(sharedUiMutex);
-    return true;
-}
-
-static bool isScriptedDemoActive() {
-    if (!scriptedDemoMutex) {
-        return false;
-    }
-    if (xSemaphoreTake(scriptedDemoMutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return false;
-    }
-    const bool active = scriptedDemoState.active;
-    xSemaphoreGive(scriptedDemoMutex);
-    return active;
+    busPublish(BusTopic::UiFreshness, FreshnessMsg{isStale, lastApiUpdateMs});
 }
 
 static void fillScriptedEventFromSlot(int slot, const char *label, int delta, const char *icon, int totalBefore,
@@ -2477,12 +2156,6 @@ static void fillScriptedEventFromSlot(int slot, const char *label, int delta, co
     eventOut.totalAfter = totalBefore + delta;
     eventOut.epochMs = millis();
 
-    if (!uiRuntimeMutex) {
-        return;
-    }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(20)) != pdTRUE) {
-        return;
-    }
     const size_t idx = (slot > 0) ? static_cast<size_t>(slot - 1) : 0;
     if (idx < uiRuntimeState.squadCount) {
         const UiSquadRow &row = uiRuntimeState.squadRows[idx];
@@ -2490,39 +2163,40 @@ static void fillScriptedEventFromSlot(int slot, const char *label, int delta, co
         strlcpy(eventOut.team, row.team, sizeof(eventOut.team));
         eventOut.isGk = row.isGk;
     }
-    xSemaphoreGive(uiRuntimeMutex);
 }
 
+static void setScriptedDemoActive(bool active) {
+    scriptedDemoState.active = active;
+    busPublish(BusTopic::DemoActive, FlagMsg{active});
+}
+
+// Scripted demos run on uiTask: touch callbacks call these directly, the serial
+// console publishes BusTopic::UiScriptedDemo.
 static void startNotificationScriptedDemo() {
-    SharedUiState local;
-    if (!readSharedUiState(local)) {
-        memset(&local, 0, sizeof(local));
-    }
+    const SharedUiState &local = sharedUiState;
 
     const int baseRank = (local.hasRankData && local.overallRank > 0) ? local.overallRank : 100000;
     const int currentGw = local.currentGw > 0 ? local.currentGw : 1;
     const int nextGw = local.hasNextGw ? local.nextGw : (currentGw + 1);
     const bool hasNextGw = local.hasNextGw || nextGw > 0;
 
-    if (scriptedDemoMutex && xSemaphoreTake(scriptedDemoMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-        scriptedDemoState.active = true;
-        scriptedDemoState.kind = ScriptedDemoKind::Notification;
-        scriptedDemoState.stage = 0;
-        scriptedDemoState.baseRank = baseRank;
-        scriptedDemoState.triggerAtMs = millis() + kDemoNotificationDelayMs;
-        xSemaphoreGive(scriptedDemoMutex);
-    }
+    scriptedDemoState.kind = ScriptedDemoKind::Notification;
+    scriptedDemoState.stage = 0;
+    scriptedDemoState.baseRank = baseRank;
+    scriptedDemoState.triggerAtMs = millis() + kDemoNotificationDelayMs;
+    setScriptedDemoActive(true);
 
     setSharedGameweekContext(true, currentGw, nextGw, hasNextGw, local.nextDeadlineUtc, local.hasNextDeadline);
     setSharedRankData(baseRank, -500, true);
     setSharedStatus("Demo: rank dropping", 0xFF5A5A);
-    loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_FADE_ON);
+    requestUiMode(UiMode::Live, LV_SCR_LOAD_ANIM_FADE_ON);
 }
 
 static void startDeadlineScriptedDemo(int32_t secondsToDeadline) {
-    if (scriptedDemoMutex && xSemaphoreTake(scriptedDemoMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-        scriptedDemoState = ScriptedDemoState{};
-        xSemaphoreGive(scriptedDemoMutex);
+    const bool wasActive = scriptedDemoState.active;
+    scriptedDemoState = ScriptedDemoState{};
+    if (wasActive) {
+        setScriptedDemoActive(false);
     }
 
     ensureUkTimeConfigured();
@@ -2532,65 +2206,35 @@ static void startDeadlineScriptedDemo(int32_t secondsToDeadline) {
         return;
     }
 
-    SharedUiState local;
-    if (!readSharedUiState(local)) {
-        memset(&local, 0, sizeof(local));
-    }
-
+    const SharedUiState &local = sharedUiState;
     const int currentGw = local.currentGw > 0 ? local.currentGw : 1;
     const int nextGw = local.hasNextGw ? local.nextGw : (currentGw + 1);
     const bool hasNextGw = local.hasNextGw || nextGw > 0;
     const time_t deadlineUtc = nowUtc + secondsToDeadline;
     setSharedGameweekContext(false, currentGw, nextGw, hasNextGw, deadlineUtc, true);
     setSharedStatus("Demo: custom deadline", 0x00E5FF);
-    loadMode(UiMode::FinalHour, LV_SCR_LOAD_ANIM_FADE_ON);
-}
-
-static void squadDemoNotificationBtnCb(lv_event_t *e) {
-    if (lv_event_get_code(e) != LV_EVENT_CLICKED) {
-        return;
-    }
-    startNotificationScriptedDemo();
+    requestUiMode(UiMode::FinalHour, LV_SCR_LOAD_ANIM_FADE_ON);
 }
 
-static void squadDemoDeadline45BtnCb(lv_event_t *e) {
-    if (lv_event_get_code(e) != LV_EVENT_CLICKED) {
-        return;
-    }
-    startDeadlineScriptedDemo(kDemoDeadline45mSec);
-}
-
-static void squadDemoDeadline7BtnCb(lv_event_t *e) {
-    if (lv_event_get_code(e) != LV_EVENT_CLICKED) {
-        return;
+static uint32_t msUntilScriptedDemoDue(uint32_t nowMs) {
+    if (!scriptedDemoState.active || scriptedDemoState.kind != ScriptedDemoKind::Notification ||
+        scriptedDemoState.stage != 0) {
+        return UINT32_MAX;
     }
-    startDeadlineScriptedDemo(kDemoDeadline7mSec);
+    const int32_t dueIn = static_cast<int32_t>(scriptedDemoState.triggerAtMs - nowMs);
+    return dueIn > 0 ? static_cast<uint32_t>(dueIn) : 0;
 }
 
 static void serviceScriptedDemo() {
-    if (!scriptedDemoMutex) {
-        return;
-    }
-
-    int baseRank = 0;
-    bool triggerEvents = false;
     const uint32_t nowMs = millis();
-    if (xSemaphoreTake(scriptedDemoMutex, pdMS_TO_TICKS(10)) != pdTRUE) {
-        return;
-    }
-    if (scriptedDemoState.active && scriptedDemoState.kind == ScriptedDemoKind::Notification &&
-        scriptedDemoState.stage == 0 && nowMs >= scriptedDemoState.triggerAtMs) {
-        scriptedDemoState.stage = 1;
-        baseRank = scriptedDemoState.baseRank;
-        scriptedDemoState.active = false;
-        scriptedDemoState.kind = ScriptedDemoKind::None;
-        triggerEvents = true;
-    }
-    xSemaphoreGive(scriptedDemoMutex);
-
-    if (!triggerEvents) {
+    if (!scriptedDemoState.active || scriptedDemoState.kind != ScriptedDemoKind::Notification ||
+        scriptedDemoState.stage != 0 || nowMs < scriptedDemoState.triggerAtMs) {
         return;
     }
+    const int baseRank = scriptedDemoState.baseRank;
+    scriptedDemoState.stage = 1;
+    scriptedDemoState.kind = ScriptedDemoKind::None;
+    setScriptedDemoActive(false);
 
     UiEventItem goalEvent;
     fillScriptedEventFromSlot(2, "GOAL!", 5, "G", 1, goalEvent);
@@ -2600,12 +2244,10 @@ static void serviceScriptedDemo() {
     fillScriptedEventFromSlot(5, "ASSIST!", 3, "A", 1, assistEvent);
     pushUiEvent(assistEvent);
 
-    SharedUiState local;
-    if (readSharedUiState(local)) {
-        setSharedGwPoints(local.gwPoints + goalEvent.delta + assistEvent.delta);
-        if (local.hasTotalPoints) {
-            setSharedTotalPoints(local.totalPoints + goalEvent.delta + assistEvent.delta, true);
-        }
+    const SharedUiState &local = sharedUiState;
+    setSharedGwPoints(local.gwPoints + goalEvent.delta + assistEvent.delta);
+    if (local.hasTotalPoints) {
+        setSharedTotalPoints(local.totalPoints + goalEvent.delta + assistEvent.delta, true);
     }
 
     const int improvedRank = (baseRank > 10000) ? (baseRank - 10000) : 1;
@@ -2614,91 +2256,46 @@ static void serviceScriptedDemo() {
     loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_FADE_ON);
 }
 
-static void snapshotUiRuntime(UiRuntimeState &out) {
-    memset(&out, 0, sizeof(out));
-    if (!uiRuntimeMutex) {
-        return;
-    }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(30)) != pdTRUE) {
-        return;
+static void runScriptedDemoCommand(const ScriptedDemoMsg &cmd) {
+    if (static_cast<ScriptedDemoKind>(cmd.kind) == ScriptedDemoKind::Notification) {
+        startNotificationScriptedDemo();
+    } else if (static_cast<ScriptedDemoKind>(cmd.kind) == ScriptedDemoKind::Deadline) {
+        startDeadlineScriptedDemo(cmd.secondsToDeadline);
     }
-    out = uiRuntimeState;
-    xSemaphoreGive(uiRuntimeMutex);
 }
 
 static void pushUiEvent(const UiEventItem &event) {
-    if (!uiRuntimeMutex) {
-        return;
-    }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    if (uiRuntimeState.recentEventCount < kMaxUiEvents) {
-        uiRuntimeState.recentEvents[uiRuntimeState.recentEventCount++] = event;
-    } else {
-        for (size_t i = 1; i < kMaxUiEvents; ++i) {
-            uiRuntimeState.recentEvents[i - 1] = uiRuntimeState.recentEvents[i];
-        }
-        uiRuntimeState.recentEvents[kMaxUiEvents - 1] = event;
-    }
+    busPublish(BusTopic::UiEvent, event);
+}
 
-    if (uiRuntimeState.popupCount < kMaxPopupEvents) {
-        uiRuntimeState.popupQueue[uiRuntimeState.popupTail] = event;
-        uiRuntimeState.popupTail = (uiRuntimeState.popupTail + 1) % kMaxPopupEvents;
-        uiRuntimeState.popupCount++;
-    }
-    uiRuntimeState.eventVersion++;
-    xSemaphoreGive(uiRuntimeMutex);
+static void clearUiEvents() {
+    busPublish(BusTopic::UiEventsCleared);
 }
 
+// uiTask only.
 static bool popUiPopup(UiEventItem &eventOut) {
-    if (!uiRuntimeMutex) {
-        return false;
-    }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(30)) != pdTRUE) {
-        return false;
-    }
     if (uiRuntimeState.popupCount == 0) {
-        xSemaphoreGive(uiRuntimeMutex);
         return false;
     }
-
     eventOut = uiRuntimeState.popupQueue[uiRuntimeState.popupHead];
     uiRuntimeState.popupHead = (uiRuntimeState.popupHead + 1) % kMaxPopupEvents;
     uiRuntimeState.popupCount--;
-    xSemaphoreGive(uiRuntimeMutex);
     return true;
 }
 
-static void clearUiEvents() {
-    if (!uiRuntimeMutex) {
-        return;
-    }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    uiRuntimeState.recentEventCount = 0;
-    uiRuntimeState.popupHead = 0;
-    uiRuntimeState.popupTail = 0;
-    uiRuntimeState.popupCount = 0;
-    uiRuntimeState.eventVersion++;
-    xSemaphoreGive(uiRuntimeMutex);
-}
-
 static void updateSharedSquadFromPicks(const TeamPick *picks, size_t pickCount) {
-    if (!uiRuntimeMutex) {
+    const size_t count = pickCount < kMaxSquadRows ? pickCount : kMaxSquadRows;
+    SquadRowMsg msg;
+    if (count == 0) {
+        memset(&msg, 0, sizeof(msg));
+        busPublish(BusTopic::UiSquadRow, msg);
         return;
     }
-    if (xSemaphoreTake(uiRuntimeMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    uiRuntimeState.squadCount = 0;
-    for (size_t i = 0; i < pickCount && i < kMaxSquadRows; ++i) {
-        UiSquadRow &row = uiRuntimeState.squadRows[uiRuntimeState.squadCount++];
-        memset(&row, 0, sizeof(row));
+    for (size_t i = 0; i < count; ++i) {
+        memset(&msg, 0, sizeof(msg));
+        msg.index = static_cast<uint8_t>(i);
+        msg.count = static_cast<uint8_t>(count);
+        UiSquadRow &row = msg.row;
         sanitizeUtf8ToAscii(picks[i].playerName.length() ? picks[i].playerName.c_str() : "unknown", row.player,
                             sizeof(row.player));
         strlcpy(row.team, picks[i].teamShortName, sizeof(row.team));
@@ -2724,10 +2321,285 @@ static void updateSharedSquadFromPicks(const TeamPick *picks, size_t pickCount)
         } else {
             row.breakdown[0] = '\0';
         }
+        busPublish(BusTopic::UiSquadRow, msg);
+    }
+}
+
+// Folds one UI topic message into a state/runtime pair. Used by uiTask for the
+// live state and by fplTask for its mirror.
+static void applyUiMessage(const BusMessage &msg, SharedUiState &state, UiRuntimeState &runtime) {
+    switch (msg.topic) {
+        case BusTopic::UiStatus: {
+            StatusMsg m;
+            if (busRead(msg, m)) {
+                strlcpy(state.statusText, m.text, sizeof(state.statusText));
+                state.statusColor = m.color;
+            }
+            break;
+        }
+        case BusTopic::UiGwPoints: {
+            GwPointsMsg m;
+            if (busRead(msg, m)) {
+                state.gwPoints = m.points;
+                state.hasGwPoints = true;
+            }
+            break;
+        }
+        case BusTopic::UiGwStateText: {
+            TextMsg m;
+            if (busRead(msg, m)) {
+                strlcpy(state.gwStateText, m.text, sizeof(state.gwStateText));
+            }
+            break;
+        }
+        case BusTopic::UiGameweek: {
+            GameweekMsg m;
+            if (busRead(msg, m)) {
+                state.isLiveGw = m.isLiveGw;
+                state.currentGw = m.currentGw;
+                state.nextGw = m.nextGw;
+                state.hasNextGw = m.hasNextGw;
+                state.nextDeadlineUtc = m.deadlineUtc;
+                state.hasNextDeadline = m.hasDeadline;
+            }
+            break;
+        }
+        case BusTopic::UiRank: {
+            RankMsg m;
+            if (busRead(msg, m)) {
+                state.overallRank = m.overallRank;
+                state.rankDiff = m.rankDiff;
+                state.hasRankData = m.hasRankData;
+            }
+            break;
+        }
+        case BusTopic::UiTotalPoints: {
+            TotalPointsMsg m;
+            if (busRead(msg, m)) {
+                state.totalPoints = m.totalPoints;
+                state.hasTotalPoints = m.hasTotalPoints;
+            }
+            break;
+        }
+        case BusTopic::UiFreshness: {
+            FreshnessMsg m;
+            if (busRead(msg, m)) {
+                state.isStale = m.isStale;
+                state.lastApiUpdateMs = m.lastApiUpdateMs;
+            }
+            break;
+        }
+        case BusTopic::UiEvent: {
+            UiEventItem event;
+            if (!busRead(msg, event)) {
+                return;
+            }
+            if (runtime.recentEventCount < kMaxUiEvents) {
+                runtime.recentEvents[runtime.recentEventCount++] = event;
+            } else {
+                for (size_t i = 1; i < kMaxUiEvents; ++i) {
+                    runtime.recentEvents[i - 1] = runtime.recentEvents[i];
+                }
+                runtime.recentEvents[kMaxUiEvents - 1] = event;
+            }
+            if (runtime.popupCount < kMaxPopupEvents) {
+                runtime.popupQueue[runtime.popupTail] = event;
+                runtime.popupTail = (runtime.popupTail + 1) % kMaxPopupEvents;
+                runtime.popupCount++;
+            }
+            runtime.eventVersion++;
+            return;
+        }
+        case BusTopic::UiEventsCleared:
+            runtime.recentEventCount = 0;
+            runtime.popupHead = 0;
+            runtime.popupTail = 0;
+            runtime.popupCount = 0;
+            runtime.eventVersion++;
+            return;
+        case BusTopic::UiSquadRow: {
+            SquadRowMsg m;
+            if (!busRead(msg, m) || m.count > kMaxSquadRows || (m.count > 0 && m.index >= m.count)) {
+                return;
+            }
+            if (m.count > 0) {
+                runtime.squadRows[m.index] = m.row;
+            }
+            runtime.squadCount = m.count;
+            // A refresh arrives row by row; publish it to the screen once complete.
+            if (m.count == 0 || m.index + 1 == m.count) {
+                runtime.squadVersion++;
+            }
+            return;
+        }
+        default:
+            return;
+    }
+    state.version++;
+}
+
+static constexpr uint32_t kUiBusTopics =
+    busTopicBit(BusTopic::UiStatus) | busTopicBit(BusTopic::UiGwPoints) | busTopicBit(BusTopic::UiGwStateText) |
+    busTopicBit(BusTopic::UiGameweek) | busTopicBit(BusTopic::UiRank) | busTopicBit(BusTopic::UiTotalPoints) |
+    busTopicBit(BusTopic::UiFreshness) | busTopicBit(BusTopic::UiEvent) | busTopicBit(BusTopic::UiEventsCleared) |
+    busTopicBit(BusTopic::UiSquadRow);
+
+// uiTask (or setup() before uiTask starts): apply everything published so far.
+static void drainUiBus() {
+    BusMessage msg;
+    while (busReceive(uiBus, msg)) {
+        if (msg.topic == BusTopic::UiScriptedDemo) {
+            ScriptedDemoMsg cmd;
+            if (busRead(msg, cmd)) {
+                runScriptedDemoCommand(cmd);
+            }
+            continue;
+        }
+        applyUiMessage(msg, sharedUiState, uiRuntimeState);
+    }
+}
+
+// fplTask: keep the mirror and the scripted-demo flag current.
+static void drainFplBus() {
+    BusMessage msg;
+    while (busReceive(fplBus, msg)) {
+        if (msg.topic == BusTopic::DemoActive) {
+            FlagMsg flag;
+            if (busRead(msg, flag)) {
+                fplScriptedDemoActive = flag.value;
+            }
+            continue;
+        }
+        applyUiMessage(msg, fplUiMirror, fplRuntimeMirror);
+    }
+}
+
+static void markBootPhase(uint32_t &phaseMs) {
+    if (phaseMs == 0) {
+        phaseMs = millis();
+    }
+}
+
+static void reportBootTimeline() {
+    if (bootTimeline.reported) {
+        return;
+    }
+    bootTimeline.reported = true;
+    Serial.printf("[BOOT] lvgl:%lums ui:%lums snapshot:%lums(%s) first-meaningful-frame:%lums wifi:%lums "
+                  "ntp:%lums first-poll:%lums\n",
+                  static_cast<unsigned long>(bootTimeline.lvglReadyMs),
+                  static_cast<unsigned long>(bootTimeline.uiBuiltMs),
+                  static_cast<unsigned long>(bootTimeline.snapshotRestoredMs),
+                  bootTimeline.restoredFromSnapshot ? "hit" : "miss",
+                  static_cast<unsigned long>(bootTimeline.firstMeaningfulFrameMs),
+                  static_cast<unsigned long>(bootTimeline.wifiConnectedMs),
+                  static_cast<unsigned long>(bootTimeline.timeSyncedMs),
+                  static_cast<unsigned long>(bootTimeline.firstPollMs));
+}
+
+#if FPL_BOOT_SNAPSHOT_ENABLED
+static constexpr const char *kBootSnapshotPath = "/ui_snapshot.bin";
+
+RTC_NOINIT_ATTR static BootSnapshot rtcBootSnapshot;
+static uint32_t lastFlashSnapshotCrc = 0;
+static uint32_t lastFlashSnapshotMs = 0;
+
+// fplTask, after a successful poll; encodes its mirror of the UI topics.
+static void saveBootSnapshot() {
+    drainFplBus();
+    if (!fplUiMirror.hasGwPoints) {
+        return;
+    }
+
+    BootSnapshot snap;
+    encodeBootSnapshot(fplUiMirror, fplRuntimeMirror, snap);
+    rtcBootSnapshot = snap;
+
+    const uint32_t nowMs = millis();
+    if (snap.crc == lastFlashSnapshotCrc) {
+        return;
+    }
+    if (lastFlashSnapshotMs != 0 && nowMs - lastFlashSnapshotMs < FPL_BOOT_SNAPSHOT_FLASH_INTERVAL_MS) {
+        return;
+    }
+
+    File f = LittleFS.open(kBootSnapshotPath, "w");
+    if (!f) {
+        Serial.printf("[SNAPSHOT] cannot open %s for write\n", kBootSnapshotPath);
+        return;
+    }
+    const size_t written = f.write(reinterpret_cast<const uint8_t *>(&snap), sizeof(snap));
+    f.close();
+    if (written != sizeof(snap)) {
+        Serial.printf("[SNAPSHOT] short write (%u/%u)\n", static_cast<unsigned>(written),
+                      static_cast<unsigned>(sizeof(snap)));
+        return;
+    }
+    lastFlashSnapshotCrc = snap.crc;
+    lastFlashSnapshotMs = nowMs;
+    Serial.printf("[SNAPSHOT] saved to flash (%u bytes)\n", static_cast<unsigned>(sizeof(snap)));
+}
+
+static bool loadBootSnapshot(BootSnapshot &out, const char *&sourceOut) {
+    if (decodeBootSnapshot(rtcBootSnapshot)) {
+        out = rtcBootSnapshot;
+        sourceOut = "rtc";
+        return true;
+    }
+
+    File f = LittleFS.open(kBootSnapshotPath, "r");
+    if (!f) {
+        return false;
+    }
+    static uint8_t raw[sizeof(BootSnapshot)];
+    const size_t bytes = f.read(raw, sizeof(raw));
+    f.close();
+    if (!decodeBootSnapshot(raw, bytes, out)) {
+        Serial.println("[SNAPSHOT] flash image invalid, ignoring");
+        return false;
+    }
+    lastFlashSnapshotCrc = out.crc;
+    sourceOut = "flash";
+    return true;
+}
+
+// Called from setup() before worker tasks exist, so uiTask's state and fplTask's
+// mirror are written directly and the first rendered frame already carries data.
+static bool restoreBootSnapshot() {
+    static BootSnapshot snap;
+    const char *source = nullptr;
+    if (!loadBootSnapshot(snap, source)) {
+        Serial.println("[SNAPSHOT] none available");
+        return false;
+    }
+
+    sharedUiState = snap.ui;
+    strlcpy(sharedUiState.statusText, "Cached data", sizeof(sharedUiState.statusText));
+    sharedUiState.statusColor = 0xFFCC66;
+    sharedUiState.isStale = true;
+    sharedUiState.lastApiUpdateMs = 0;
+    sharedUiState.version++;
+
+    uiRuntimeState.squadCount = snap.squadCount;
+    for (size_t i = 0; i < snap.squadCount; ++i) {
+        uiRuntimeState.squadRows[i] = snap.squadRows[i];
     }
     uiRuntimeState.squadVersion++;
-    xSemaphoreGive(uiRuntimeMutex);
+    fplUiMirror = sharedUiState;
+    fplRuntimeMirror = uiRuntimeState;
+
+    // The ring follows the rank and gameweek topics.
+    setSharedRankData(snap.ui.overallRank, snap.ui.rankDiff, snap.ui.hasRankData);
+    setSharedGameweekContext(snap.ui.isLiveGw, snap.ui.currentGw, snap.ui.nextGw, snap.ui.hasNextGw,
+                             snap.ui.nextDeadlineUtc, snap.ui.hasNextDeadline);
+    Serial.printf("[SNAPSHOT] restored from %s: GW%d %d pts, %u squad rows\n", source, snap.ui.currentGw,
+                  snap.ui.gwPoints, static_cast<unsigned>(snap.squadCount));
+    return true;
 }
+#else
+static void saveBootSnapshot() {}
+static bool restoreBootSnapshot() { return false; }
+#endif
 
 static int64_t daysFromCivil(int y, unsigned m, unsigned d) {
     y -= m <= 2;
@@ -2801,6 +2673,8 @@ static bool ensureUkTimeConfigured() {
     while (millis() - startMs < 10000) {
         if (time(nullptr) > 100000) {
             timeConfigured = true;
+            markBootPhase(bootTimeline.timeSyncedMs);
+            wakeUiTask();  // countdown screens depend on a valid clock
             Serial.println("NTP synced (UK timezone)");
             return true;
         }
@@ -2825,6 +2699,7 @@ static bool connectWiFi() {
     }
 
     if (WiFi.status() == WL_CONNECTED) {
+        markBootPhase(bootTimeline.wifiConnectedMs);
         Serial.printf("WiFi connected: %s\n", WiFi.localIP().toString().c_str());
         return true;
     }
@@ -3092,6 +2967,14 @@ static void printDemoHelp() {
     Serial.println("  gw deadline in <seconds>");
     Serial.println("  gw deadline clear");
     Serial.println("  event <slot> <type> [count]");
+    Serial.println("  bench ui");
+    Serial.println("  bus");
+    Serial.println("  fetch");
+    Serial.println("  netstats [reset]");
+    Serial.println("  stats");
+    Serial.println("  perf");
+    Serial.println("  trace [clear|on|off]");
+    Serial.println("  shots");
     Serial.println("Event types:");
     Serial.println("  goal assist cs concede save bonus yc rc og pen_save pen_miss defcontrib mins");
     Serial.println();
@@ -3116,6 +2999,62 @@ static void handleSerialCommandLine(char *line) {
         return;
     }
 
+    if (strcmp(tokens[0], "bench") == 0) {
+        if (tokenCount >= 2 && strcmp(tokens[1], "ui") == 0) {
+            // Runs on uiTask; LVGL is never driven from the serial loop.
+            uiBenchRequested = true;
+            wakeUiTask();
+            Serial.println("[BENCH] UI render benchmark queued");
+            return;
+        }
+        Serial.println("[BENCH] Usage: bench ui");
+        return;
+    }
+
+    if (strcmp(tokens[0], "bus") == 0) {
+        busPrintStats();
+        return;
+    }
+    if (strcmp(tokens[0], "fetch") == 0) {
+        fetchPrintStats();
+        return;
+    }
+    if (strcmp(tokens[0], "netstats") == 0) {
+        if (tokenCount >= 2 && strcmp(tokens[1], "reset") == 0) {
+            netStatsReset();
+        } else {
+            netStatsPrint();
+        }
+        return;
+    }
+    if (strcmp(tokens[0], "stats") == 0) {
+        telemetryPrintStats();
+        return;
+    }
+    if (strcmp(tokens[0], "perf") == 0) {
+        perfPrintAndReset();
+        return;
+    }
+    if (strcmp(tokens[0], "trace") == 0) {
+        if (tokenCount < 2) {
+            traceDump();
+        } else if (strcmp(tokens[1], "clear") == 0) {
+            traceClear();
+        } else if (strcmp(tokens[1], "on") == 0 || strcmp(tokens[1], "off") == 0) {
+            traceSetRecording(strcmp(tokens[1], "on") == 0);
+        } else {
+            Serial.println("[TRACE] Usage: trace [clear|on|off] (decode with tools/trace_to_chrome.py)");
+        }
+        return;
+    }
+
+    if (strcmp(tokens[0], "shots") == 0) {
+        uiShotsRequested = true;
+        wakeUiTask();
+        Serial.println("[SHOT] Screen capture script queued (decode with tools/ui_shots.py)");
+        return;
+    }
+
     if (strcmp(tokens[0], "demo") == 0) {
         if (tokenCount < 2 || strcmp(tokens[1], "help") == 0) {
             printDemoHelp();
@@ -3130,19 +3069,22 @@ static void handleSerialCommandLine(char *line) {
 
             if (strcmp(tokens[2], "notification") == 0 || strcmp(tokens[2], "notify") == 0 ||
                 strcmp(tokens[2], "notif") == 0 || strcmp(tokens[2], "n") == 0) {
-                startNotificationScriptedDemo();
+                busPublish(BusTopic::UiScriptedDemo,
+                           ScriptedDemoMsg{static_cast<uint8_t>(ScriptedDemoKind::Notification), 0});
                 Serial.println("[DEMO] Sequence started: notification");
                 return;
             }
             if (strcmp(tokens[2], "deadline1") == 0 || strcmp(tokens[2], "d1") == 0 ||
                 strcmp(tokens[2], "45m") == 0) {
-                startDeadlineScriptedDemo(kDemoDeadline45mSec);
+                busPublish(BusTopic::UiScriptedDemo,
+                           ScriptedDemoMsg{static_cast<uint8_t>(ScriptedDemoKind::Deadline), kDemoDeadline45mSec});
                 Serial.println("[DEMO] Sequence started: deadline1 (45m)");
                 return;
             }
             if (strcmp(tokens[2], "deadline2") == 0 || strcmp(tokens[2], "d2") == 0 ||
                 strcmp(tokens[2], "7m") == 0) {
-                startDeadlineScriptedDemo(kDemoDeadline7mSec);
+                busPublish(BusTopic::UiScriptedDemo,
+                           ScriptedDemoMsg{static_cast<uint8_t>(ScriptedDemoKind::Deadline), kDemoDeadline7mSec});
                 Serial.println("[DEMO] Sequence started: deadline2 (7m)");
                 return;
             }
@@ -3482,215 +3424,206 @@ static void processSerialInput() {
     }
 }
 
-static UiMode determineAutoMode(const SharedUiState &state) {
-    if (currentMode == UiMode::EventsList || currentMode == UiMode::Squad || currentMode == UiMode::EventPopup) {
-        return currentMode;
-    }
-    if (state.isLiveGw) {
-        return UiMode::Live;
-    }
-    if (!state.hasNextDeadline || state.nextDeadlineUtc <= 0) {
-        return UiMode::Idle;
-    }
-    const time_t now = time(nullptr);
-    if (now <= 100000) {
-        return UiMode::Idle;
-    }
-    const int64_t diff = static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now);
-    if (diff <= 3600) {
-        return UiMode::FinalHour;
-    }
-    if (diff <= 6 * 3600) {
-        return UiMode::Deadline;
-    }
-    return UiMode::Idle;
+static void showPopupEvent(const UiEventItem &event) {
+    const uint32_t queuedMs = millis() - event.epochMs;
+    TraceScope trace(TraceSpan::Popup, static_cast<uint16_t>(queuedMs > 0xFFFFU ? 0xFFFFU : queuedMs));
+    const uint32_t startUs = micros();
+    bindPopupEvent(event);
+    loadMode(UiMode::EventPopup, LV_SCR_LOAD_ANIM_FADE_ON);
+    Serial.printf("[KIT] popup ready in %luus\n", static_cast<unsigned long>(micros() - startUs));
+    ledRingTriggerNotificationForMs(kPopupDisplayDurationMs);
+    popupHideAtMs = millis() + kPopupDisplayDurationMs;
 }
 
-static void updateModeUi(const SharedUiState &state, const UiRuntimeState &runtime) {
-    char buf[96];
+// Full-screen redraw of every screen, timed on uiTask. Includes the flush, so the
+// figure is what one frame of that screen costs end to end.
+static void runUiRenderBenchmark(const SharedUiState &state, const UiRuntimeState &runtime) {
+    const UiMode previousMode = currentUiMode();
+    Serial.printf("[BENCH] %lu full-screen frames per screen, %d draw unit(s)\n",
+                  static_cast<unsigned long>(kUiBenchFramesPerScreen), LV_DRAW_SW_DRAW_UNIT_CNT);
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        loadMode(static_cast<UiMode>(i), LV_SCR_LOAD_ANIM_NONE);
+        updateModeUi(state, runtime);
+        lv_refr_now(lvglDisp);  // settle the screen switch and any list rebuild
+
+        uint32_t totalUs = 0;
+        uint32_t maxUs = 0;
+        for (uint32_t frame = 0; frame < kUiBenchFramesPerScreen; ++frame) {
+            lv_obj_invalidate(lv_screen_active());
+            const uint32_t startUs = micros();
+            lv_refr_now(lvglDisp);
+            const uint32_t elapsedUs = micros() - startUs;
+            totalUs += elapsedUs;
+            maxUs = elapsedUs > maxUs ? elapsedUs : maxUs;
+        }
+        const uint32_t avgUs = totalUs / kUiBenchFramesPerScreen;
+        Serial.printf("[BENCH] %-8s avg %6luus max %6luus (%.1f fps)\n", kUiModeNames[i],
+                      static_cast<unsigned long>(avgUs), static_cast<unsigned long>(maxUs),
+                      avgUs ? 1000000.0f / avgUs : 0.0f);
+    }
+    loadMode(previousMode, LV_SCR_LOAD_ANIM_NONE);
+    updateModeUi(state, runtime);
+}
+
+// One frame of the current screen: render time (including the flush), pixels
+// invalidated after rounding, and bytes queued to the panel.
+static void measureUiShotFrame(const char *screen, const char *step) {
+    const size_t modeIndex = static_cast<size_t>(currentUiMode());
+    const uint32_t invalidatedBefore = invalidatedPixels[modeIndex];
+    const uint32_t bytesBefore = display.bytesQueued();
+    const uint32_t startUs = micros();
+    lv_refr_now(lvglDisp);
+    Serial.printf("[SHOT] frame %s %s render_us=%lu invalidated_px=%lu flushed_bytes=%lu\n", screen, step,
+                  static_cast<unsigned long>(micros() - startUs),
+                  static_cast<unsigned long>(invalidatedPixels[modeIndex] - invalidatedBefore),
+                  static_cast<unsigned long>(display.bytesQueued() - bytesBefore));
+}
+
+// Walks every screen through the fixture: a full frame that is captured and
+// streamed, then an incremental update that is only measured.
+static void runUiShotScript(const SharedUiState &liveState, const UiRuntimeState &liveRuntime) {
+    const UiMode previousMode = currentUiMode();
+    SharedUiState state;
+    UiRuntimeState runtime;
+    Serial.println("[SHOT] script start");
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        const UiMode mode = static_cast<UiMode>(i);
+        const char *screen = kUiModeNames[i];
+        fillUiShotFixture(state, runtime);
+        if (mode == UiMode::FinalHour) {
+            state.nextDeadlineUtc = time(nullptr) + 45 * 60;
+        }
+        resetLiveTicker(millis());
+
+        loadMode(mode, LV_SCR_LOAD_ANIM_NONE);
+        if (mode == UiMode::EventPopup) {
+            bindPopupEvent(runtime.recentEvents[0]);
+        }
+        updateModeUi(state, runtime);
+        lv_refr_now(lvglDisp);  // settle the switch before measuring
+
+        lv_obj_invalidate(lv_screen_active());
+        const bool capturing = uiCaptureBegin(kDisplayWidth, kDisplayHeight);
+        measureUiShotFrame(screen, "full");
+        if (capturing) {
+            uiCaptureDump(screen);
+        }
+
+        state.gwPoints += 4;
+        state.totalPoints += 4;
+        state.overallRank -= 1500;
+        state.nextDeadlineUtc -= 60;
+        fillUiShotEvent(runtime.recentEvents[3], "B", "BONUS", "Haaland", "man_city", 3, 734);
+        runtime.recentEventCount = 4;
+        runtime.eventVersion++;
+        runtime.squadRows[9].points += 3;
+        runtime.squadVersion++;
+        if (mode == UiMode::EventPopup) {
+            bindPopupEvent(runtime.recentEvents[3]);
+        }
+        updateModeUi(state, runtime);
+        measureUiShotFrame(screen, "update");
+    }
+    Serial.println("[SHOT] script done");
+
+    // Lists rebuilt from the fixture must be rebuilt again from real data.
+    invalidateUiLists();
+    loadMode(previousMode, LV_SCR_LOAD_ANIM_NONE);
+    updateModeUi(liveState, liveRuntime);
+    lv_obj_invalidate(lv_screen_active());
+}
+
+// How long uiTask may sleep: until LVGL's next timer or the next moment the
+// current screen changes on its own. Data changes, touches, mode requests and
+// pending frames notify the task and cut the sleep short.
+static uint32_t uiSleepMs(const SharedUiState &state, const UiRuntimeState &runtime, uint32_t lvglDueMs,
+                          uint32_t nowMs) {
+    uint32_t waitMs = lvglDueMs < FPL_UI_MAX_SLEEP_MS ? lvglDueMs : FPL_UI_MAX_SLEEP_MS;
+    auto wakeIn = [&](uint32_t ms) { waitMs = ms < waitMs ? ms : waitMs; };
+
+    wakeIn(msUntilScreenChange(state, runtime, nowMs));
+    if (currentUiMode() == UiMode::EventPopup && popupHideAtMs > 0) {
+        const int32_t dueIn = static_cast<int32_t>(popupHideAtMs - nowMs);
+        wakeIn(dueIn > 0 ? static_cast<uint32_t>(dueIn) : 0U);
+    }
+    wakeIn(msUntilScriptedDemoDue(nowMs));
+    return waitMs;
+}
 
-    if (ui.statusLabel) {
-        lv_label_set_text(ui.statusLabel, state.statusText);
-        lv_obj_set_style_text_color(ui.statusLabel, lv_color_hex(state.statusColor), LV_PART_MAIN);
-    }
+static void uiTask(void *) {
+    const SharedUiState &state = sharedUiState;
+    const UiRuntimeState &runtime = uiRuntimeState;
+    uint32_t lastWakeUs = micros();
 
-    if (ui.idleRankArrow && ui.idleRankValue) {
-        if (!state.hasRankData) {
-            lv_label_set_text(ui.idleRankArrow, "-");
-            lv_label_set_text(ui.idleRankValue, "--");
-            lv_obj_set_style_text_color(ui.idleRankArrow, lv_color_hex(kColorTextSecondary), LV_PART_MAIN);
-        } else {
-            lv_label_set_text(ui.idleRankArrow, state.rankDiff > 0 ? "^" : (state.rankDiff < 0 ? "v" : "-"));
-            lv_obj_set_style_text_color(ui.idleRankArrow,
-                                        lv_color_hex(state.rankDiff > 0 ? kColorAccentGreen :
-                                                     (state.rankDiff < 0 ? kColorAccentRed : kColorTextSecondary)),
-                                        LV_PART_MAIN);
-            formatNumberWithCommas(state.overallRank, buf, sizeof(buf));
-            lv_label_set_text(ui.idleRankValue, buf);
-        }
-    }
+    busSetNotifyTask(uiBus, xTaskGetCurrentTaskHandle());
+    frameSchedulerInit(lvglDisp, frameSchedulerPanelTeSource());
 
-    if (ui.idleGwPoints) {
-        snprintf(buf, sizeof(buf), "GW%d: %d pts", state.currentGw, state.gwPoints);
-        lv_label_set_text(ui.idleGwPoints, buf);
-    }
-    if (ui.idleTotalPoints) {
-        if (state.hasTotalPoints) {
-            char totalBuf[24];
-            formatNumberWithCommas(state.totalPoints, totalBuf, sizeof(totalBuf));
-            snprintf(buf, sizeof(buf), "%s total pts", totalBuf);
-        } else {
-            strlcpy(buf, "-- total pts", sizeof(buf));
-        }
-        lv_label_set_text(ui.idleTotalPoints, buf);
-    }
+    for (;;) {
+        const uint32_t wakeUs = micros();
+        const size_t cpuMode = static_cast<size_t>(currentUiMode());
+        uiCpuStats.shownUs[cpuMode] += wakeUs - lastWakeUs;
+        uiCpuStats.wakes[cpuMode]++;
+        lastWakeUs = wakeUs;
 
-    if (ui.deadlineCountdown && state.hasNextDeadline) {
-        const time_t now = time(nullptr);
-        int64_t sec = now > 100000 ? (static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now)) : 0;
-        if (sec < 0) {
-            sec = 0;
-        }
-        const int hours = static_cast<int>(sec / 3600);
-        const int mins = static_cast<int>((sec % 3600) / 60);
-        const int secs = static_cast<int>(sec % 60);
-        if (millis() - lastDeadlineBlinkMs >= 500) {
-            deadlineColonVisible = !deadlineColonVisible;
-            lastDeadlineBlinkMs = millis();
+        if (touchWakePending) {
+            touchWakePending = false;
+            resumeTouchPolling();
         }
-        snprintf(buf, sizeof(buf), "%02d%c%02d%c%02d", hours, deadlineColonVisible ? ':' : ' ', mins,
-                 deadlineColonVisible ? ':' : ' ', secs);
-        lv_label_set_text(ui.deadlineCountdown, buf);
-        snprintf(buf, sizeof(buf), "Gameweek %d", state.hasNextGw ? state.nextGw : 0);
-        lv_label_set_text(ui.deadlineMeta, buf);
-    }
+        const uint32_t handlerStart = perfNow();
+        const uint32_t lvglDueMs = lv_timer_handler();
+        perfRecordSince(PerfMetric::TimerHandler, handlerStart);
 
-    if (ui.finalCountdown && state.hasNextDeadline) {
-        const time_t now = time(nullptr);
-        int64_t sec = now > 100000 ? (static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now)) : 0;
-        if (sec < 0) {
-            sec = 0;
-        }
-        if (sec > 3600) {
-            sec = 3600;
+        // Everything published since the last pass, applied in order.
+        drainUiBus();
+        updateModeUi(state, runtime);
+        const UiMode updatedMode = currentUiMode();
+        if (bootTimeline.firstMeaningfulFrameMs == 0 && state.hasGwPoints) {
+            // Force the refresh so the timestamp reflects pixels on the panel.
+            lv_refr_now(lvglDisp);
+            markBootPhase(bootTimeline.firstMeaningfulFrameMs);
         }
-        snprintf(buf, sizeof(buf), "%02d:%02d", static_cast<int>(sec / 60), static_cast<int>(sec % 60));
-        lv_label_set_text(ui.finalCountdown, buf);
-    }
+        serviceScriptedDemo();
+        applyUiModeRequest();
 
-    if (ui.liveTitle) {
-        snprintf(buf, sizeof(buf), "GW%d LIVE", state.currentGw);
-        lv_label_set_text(ui.liveTitle, buf);
-    }
-    if (ui.livePoints) {
-        snprintf(buf, sizeof(buf), "%d\npoints", state.gwPoints);
-        lv_label_set_text(ui.livePoints, buf);
-    }
-    if (ui.liveRank) {
-        if (state.hasRankData) {
-            char rankBuf[24];
-            formatNumberWithCommas(state.overallRank, rankBuf, sizeof(rankBuf));
-            snprintf(buf, sizeof(buf), "%s %s", state.rankDiff >= 0 ? "^" : "v", rankBuf);
-            lv_label_set_text(ui.liveRank, buf);
-            lv_obj_set_style_text_color(ui.liveRank, lv_color_hex(state.rankDiff >= 0 ? kColorAccentGreen : kColorAccentRed),
-                                        LV_PART_MAIN);
-        } else {
-            lv_label_set_text(ui.liveRank, "live rank --");
+        UiMode autoMode = determineAutoMode(state);
+        if (currentUiMode() != UiMode::EventsList && currentUiMode() != UiMode::Squad && currentUiMode() != UiMode::EventPopup) {
+            if (autoMode != currentUiMode()) {
+                loadMode(autoMode, LV_SCR_LOAD_ANIM_FADE_ON);
+            }
         }
-    }
-    if (ui.liveDot) {
-        const bool pulseOn = ((millis() / 750U) % 2U) == 0U;
-        lv_obj_set_style_bg_color(ui.liveDot, lv_color_hex(state.isStale ? kColorAccentAmber : kColorAccentCyan), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(ui.liveDot, state.isStale ? LV_OPA_80 : (pulseOn ? LV_OPA_COVER : LV_OPA_30), LV_PART_MAIN);
-    }
 
-    if (ui.liveTickerLabel) {
-        if (runtime.recentEventCount == 0) {
-            lv_label_set_text(ui.liveTickerLabel, "No events yet");
-        } else {
-            if (millis() - lastTickerRotateMs > 3000U) {
-                tickerEventIndex = (tickerEventIndex + 1) % runtime.recentEventCount;
-                lastTickerRotateMs = millis();
+        if (currentUiMode() == UiMode::Live) {
+            UiEventItem popupEvent;
+            if (popUiPopup(popupEvent)) {
+                showPopupEvent(popupEvent);
             }
-            const UiEventItem &e = runtime.recentEvents[(runtime.recentEventCount - 1) - tickerEventIndex];
-            snprintf(buf, sizeof(buf), "%s %s %+d", e.icon, e.player, e.delta);
-            lv_label_set_text(ui.liveTickerLabel, buf);
         }
-    }
-
-    if (currentMode == UiMode::EventsList && renderedEventsVersion != runtime.eventVersion) {
-        refreshEventsList(runtime);
-        renderedEventsVersion = runtime.eventVersion;
-    }
-    if (currentMode == UiMode::Squad && renderedSquadVersion != runtime.squadVersion) {
-        refreshSquadList(runtime);
-        renderedSquadVersion = runtime.squadVersion;
-    }
-}
-
-static void showPopupEvent(const UiEventItem &event) {
-    if (ui.popupTitle) {
-        lv_label_set_text(ui.popupTitle, event.label[0] ? event.label : "event");
-        lv_obj_set_style_text_color(ui.popupTitle, lv_color_hex(event.delta >= 0 ? kColorAccentGreen : kColorAccentRed), LV_PART_MAIN);
-    }
-    if (ui.popupPlayer) {
-        lv_label_set_text(ui.popupPlayer, event.player);
-    }
-    if (ui.popupDelta) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%+d pts", event.delta);
-        lv_label_set_text(ui.popupDelta, buf);
-        lv_obj_set_style_text_color(ui.popupDelta, lv_color_hex(event.delta >= 0 ? kColorAccentGreen : kColorAccentRed), LV_PART_MAIN);
-    }
-    if (ui.popupTotal) {
-        char buf[40];
-        snprintf(buf, sizeof(buf), "%d -> %d total", event.totalBefore, event.totalAfter);
-        lv_label_set_text(ui.popupTotal, buf);
-    }
-    if (ui.popupKit) {
-        if (resolveAndLoadKitImage(event)) {
-            lv_obj_clear_flag(ui.popupKit, LV_OBJ_FLAG_HIDDEN);
-            lv_image_set_src(ui.popupKit, &kitImageDsc);
-        } else {
-            lv_obj_add_flag(ui.popupKit, LV_OBJ_FLAG_HIDDEN);
+        if (currentUiMode() == UiMode::EventPopup && popupHideAtMs > 0 && millis() >= popupHideAtMs) {
+            popupHideAtMs = 0;
+            loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_FADE_ON);
         }
-    }
-    loadMode(UiMode::EventPopup, LV_SCR_LOAD_ANIM_FADE_ON);
-    ledRingTriggerNotificationForMs(kPopupDisplayDurationMs);
-    popupHideAtMs = millis() + kPopupDisplayDurationMs;
-}
-
-static void uiTask(void *) {
-    SharedUiState localState;
-    UiRuntimeState localRuntime;
-
-    for (;;) {
-        lv_timer_handler();
-        if (readSharedUiState(localState)) {
-            snapshotUiRuntime(localRuntime);
-            updateModeUi(localState, localRuntime);
-            serviceScriptedDemo();
-
-            UiMode autoMode = determineAutoMode(localState);
-            if (currentMode != UiMode::EventsList && currentMode != UiMode::Squad && currentMode != UiMode::EventPopup) {
-                if (autoMode != currentMode) {
-                    loadMode(autoMode, LV_SCR_LOAD_ANIM_FADE_ON);
-                }
-            }
-
-            if (currentMode == UiMode::Live) {
-                UiEventItem popupEvent;
-                if (popUiPopup(popupEvent)) {
-                    showPopupEvent(popupEvent);
-                }
-            }
-            if (currentMode == UiMode::EventPopup && popupHideAtMs > 0 && millis() >= popupHideAtMs) {
-                popupHideAtMs = 0;
-                loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_FADE_ON);
-            }
+        if (currentUiMode() != updatedMode) {
+            // Bring the incoming screen up to date before its first frame.
+            updateModeUi(state, runtime);
+        }
+        if (uiBenchRequested) {
+            uiBenchRequested = false;
+            runUiRenderBenchmark(state, runtime);
+        }
+        if (uiShotsRequested) {
+            uiShotsRequested = false;
+            runUiShotScript(state, runtime);
         }
+        frameSchedulerTick(millis());
+        const uint32_t nowMs = millis();
+        reportFlushStats(nowMs);
+        reportUiCpu(nowMs);
 
-        vTaskDelay(pdMS_TO_TICKS(10));
+        const uint32_t sleepMs =
+            kUiEventDriven ? uiSleepMs(state, runtime, lvglDueMs, nowMs) : kUiPollIntervalMs;
+        uiCpuStats.busyUs[cpuMode] += micros() - wakeUs;
+        // A pending frame is woken by the next vsync so the render starts at the top of the scan.
+        frameSchedulerWait(pdMS_TO_TICKS(sleepMs));
     }
 }
 
@@ -3703,8 +3636,9 @@ static void fplTask(void *) {
 
     for (;;) {
         const uint32_t now = millis();
+        drainFplBus();
 
-        if (isScriptedDemoActive()) {
+        if (fplScriptedDemoActive) {
             vTaskDelay(pdMS_TO_TICKS(50));
             continue;
         }
@@ -3739,11 +3673,12 @@ static void fplTask(void *) {
             lastPollMs = now;
             setSharedStatus("Fetching FPL points...", 0xFFCC66);
 
-            bool isLive = false;
-            int nextGw = 0;
-            bool hasDeadline = false;
-            time_t deadlineUtc = 0;
-            if (fetchGameweekState(isLive, nextGw, hasDeadline, deadlineUtc)) {
+            PollPipeline &poll = runPollPipeline();
+            const bool isLive = poll.isLive;
+            const int nextGw = poll.nextGw;
+            const bool hasDeadline = poll.hasDeadline;
+            const time_t deadlineUtc = poll.deadlineUtc;
+            if (poll.hasGwState) {
                 char gwStateBuf[48];
                 snprintf(gwStateBuf, sizeof(gwStateBuf), "GW live: %s | next: %d", isLive ? "yes" : "no", nextGw);
                 setSharedGwStateText(gwStateBuf);
@@ -3752,21 +3687,24 @@ static void fplTask(void *) {
                 setSharedGwStateText("GW live: ? | next: --");
             }
 
-            int gwPoints = 0;
-            int currentGw = 0;
-            int totalPoints = 0;
-            if (fetchAndPrintTeamSnapshot(gwPoints, &currentGw, &totalPoints)) {
-                setSharedGwPoints(gwPoints);
-                int overallRank = 0;
-                int rankDiff = 0;
-                const bool hasRank = fetchRankDelta(overallRank, rankDiff);
-                setSharedRankData(overallRank, rankDiff, hasRank);
-                setSharedGameweekContext(isLive, currentGw, nextGw, nextGw > 0, deadlineUtc, hasDeadline);
-                setSharedTotalPoints(totalPoints, true);
+            if (poll.hasEntry && poll.hasPicks && poll.hasLive) {
+                TeamSnapshot &snapshot = poll.snapshot;
+                publishTeamSnapshot(snapshot);
+                setSharedGwPoints(snapshot.gwPoints);
+                // Positive means improvement (rank number got smaller).
+                const bool hasRank = snapshot.overallRank > 0 && poll.previousRank > 0;
+                const int rankDiff = hasRank ? poll.previousRank - snapshot.overallRank : 0;
+                setSharedRankData(hasRank ? snapshot.overallRank : 0, rankDiff, hasRank);
+                setSharedGameweekContext(isLive, snapshot.currentGw, nextGw, nextGw > 0, deadlineUtc, hasDeadline);
+                setSharedTotalPoints(snapshot.overallPoints, true);
                 lastSuccessMs = now;
                 setSharedFreshness(false, lastSuccessMs);
                 setSharedStatus("FPL updated", 0x38D39F);
-                Serial.printf("FPL GW points: %d\n", gwPoints);
+                reportPollLatency(poll, millis());
+                Serial.printf("FPL GW points: %d\n", snapshot.gwPoints);
+                saveBootSnapshot();
+                markBootPhase(bootTimeline.firstPollMs);
+                reportBootTimeline();
             } else {
                 const bool stale = (lastSuccessMs == 0) || ((now - lastSuccessMs) > 300000U);
                 setSharedFreshness(stale, lastSuccessMs);
@@ -3780,8 +3718,8 @@ static void fplTask(void *) {
 
 static void ledTask(void *) {
     for (;;) {
-        ledRingTick(millis());
-        vTaskDelay(pdMS_TO_TICKS(10));
+        const uint32_t sleepMs = ledRingTick(millis());
+        ulTaskNotifyTake(pdTRUE, sleepMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(sleepMs));
     }
 }
 
@@ -3791,6 +3729,9 @@ void setup() {
 
     Serial.println("\\n=== Waveshare ESP32-S3-Touch-LCD-1.46B: FPL Buddy ===");
     ledRingInit();
+    traceInit();
+    netStatsInit();
+    fetchPipelineInit(fetchHttpTransport);
 
     if (!display.begin()) {
         Serial.println("Display init failed");
@@ -3799,6 +3740,12 @@ void setup() {
         }
     }
 
+#if SPD2010_ROUND_MASK
+    Serial.printf("[FLUSH] round mask: full-frame QSPI bytes %lu -> %lu\n",
+                  static_cast<unsigned long>(kDisplayWidth) * kDisplayHeight * sizeof(uint16_t),
+                  static_cast<unsigned long>(display.maskedFrameBytes()));
+#endif
+
     if (!touch.begin()) {
         Serial.println("Touch init failed (continuing without touch)");
     }
@@ -3808,13 +3755,15 @@ void setup() {
     } else {
         Serial.println("LittleFS mounted");
     }
+    kitCacheInit();
 
     Serial.println("Init LVGL...");
     lv_init();
     lv_tick_set_cb(lvglTickCb);
 
     lvglBuf = static_cast<uint8_t *>(heap_caps_malloc(kLvglBufPixels * sizeof(lv_color_t), MALLOC_CAP_DMA));
-    if (!lvglBuf) {
+    lvglBuf2 = static_cast<uint8_t *>(heap_caps_malloc(kLvglBufPixels * sizeof(lv_color_t), MALLOC_CAP_DMA));
+    if (!lvglBuf || !lvglBuf2) {
         Serial.println("LVGL DMA buffer allocation failed");
         while (true) {
             delay(1000);
@@ -3829,8 +3778,12 @@ void setup() {
             delay(1000);
         }
     }
+    // The panel takes RGB565 big-endian; rendering it that way saves a swap pass per flush.
+    lv_display_set_color_format(lvglDisp, LV_COLOR_FORMAT_RGB565_SWAPPED);
     lv_display_set_flush_cb(lvglDisp, lvglFlushCb);
-    lv_display_set_buffers(lvglDisp, lvglBuf, nullptr, kLvglBufPixels * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(lvglDisp, lvglRounderCb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    lv_display_set_buffers(lvglDisp, lvglBuf, lvglBuf2, kLvglBufPixels * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    markBootPhase(bootTimeline.lvglReadyMs);
 
     Serial.println("Create LVGL input...");
     lv_indev_t *touchIndev = lv_indev_create();
@@ -3842,23 +3795,27 @@ void setup() {
     }
     lv_indev_set_type(touchIndev, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(touchIndev, lvglTouchCb);
+    lvglTouchIndev = touchIndev;
+    if (kUiEventDriven) {
+        attachInterrupt(digitalPinToInterrupt(SPD2010_TOUCH_INT), onTouchInterrupt, FALLING);
+    }
 
     Serial.println("Build UI...");
-    createUi();
+    UiScreenHooks screenHooks;
+    screenHooks.kitImage = kitCacheAcquire;
+    screenHooks.notificationDemo = startNotificationScriptedDemo;
+    screenHooks.deadlineDemo = startDeadlineScriptedDemo;
+    createUi(screenHooks);
     lv_timer_handler();  // flush first frame before worker tasks start
+    markBootPhase(bootTimeline.uiBuiltMs);
     Serial.println("UI ready");
-    sharedUiMutex = xSemaphoreCreateMutex();
-    uiRuntimeMutex = xSemaphoreCreateMutex();
+    // DemoState holds Strings the console edits in place, so it keeps its mutex.
     demoMutex = xSemaphoreCreateMutex();
-    scriptedDemoMutex = xSemaphoreCreateMutex();
-    if (!sharedUiMutex) {
-        Serial.println("Failed to create UI state mutex");
-        while (true) {
-            delay(1000);
-        }
-    }
-    if (!uiRuntimeMutex) {
-        Serial.println("Failed to create UI runtime mutex");
+    uiModeRequestQueue = xQueueCreate(1, sizeof(UiModeRequest));
+    uiBus = busSubscribe("ui", kUiBusTopics | busTopicBit(BusTopic::UiScriptedDemo), kUiBusDepth);
+    fplBus = busSubscribe("fpl", kUiBusTopics | busTopicBit(BusTopic::DemoActive), kFplBusDepth);
+    if (!uiBus || !fplBus) {
+        Serial.println("Failed to create message bus queues");
         while (true) {
             delay(1000);
         }
@@ -3869,8 +3826,8 @@ void setup() {
             delay(1000);
         }
     }
-    if (!scriptedDemoMutex) {
-        Serial.println("Failed to create scripted demo mutex");
+    if (!uiModeRequestQueue) {
+        Serial.println("Failed to create UI mode request queue");
         while (true) {
             delay(1000);
         }
@@ -3881,6 +3838,22 @@ void setup() {
     setSharedRankData(0, 0, false);
     setSharedTotalPoints(0, false);
     setSharedFreshness(true, 0);
+    drainUiBus();
+    drainFplBus();
+
+    if (restoreBootSnapshot()) {
+        bootTimeline.restoredFromSnapshot = true;
+        markBootPhase(bootTimeline.snapshotRestoredMs);
+        const UiMode restoredMode = determineAutoMode(sharedUiState);
+        if (restoredMode != currentUiMode()) {
+            loadMode(restoredMode, LV_SCR_LOAD_ANIM_NONE);
+        }
+        updateModeUi(sharedUiState, uiRuntimeState);
+        lv_refr_now(lvglDisp);
+        markBootPhase(bootTimeline.firstMeaningfulFrameMs);
+        Serial.printf("[BOOT] cached frame on screen at %lums\n",
+                      static_cast<unsigned long>(bootTimeline.firstMeaningfulFrameMs));
+    }
 
 #if CONFIG_FREERTOS_UNICORE
     constexpr BaseType_t kUiCore = 0;
@@ -3900,11 +3873,17 @@ void setup() {
             delay(1000);
         }
     }
+    telemetryRegisterTask("ui", uiTaskHandle);
+    telemetryRegisterTask("fpl", fplTaskHandle);
+    telemetryRegisterTask("led", ledTaskHandle);
+    telemetryRegisterTask("loop", xTaskGetCurrentTaskHandle());
     Serial.println("Worker tasks started");
     Serial.println("Type `demo help` in serial monitor for manual demo controls");
 }
 
 void loop() {
     processSerialInput();
+    telemetryTick(millis());
+    netStatsTick(millis());
     vTaskDelay(pdMS_TO_TICKS(20));
 }
@@ -0,0 +1,246 @@
+#include "msg_bus.h"
+
+#include <freertos/queue.h>
+
+#include <atomic>
+
+struct BusOverflowSlot {
+    bool used = false;
+    uint32_t seq = 0;  // publish order across the slots
+    BusMessage msg;
+};
+
+struct BusSubscriber {
+    const char *name = "";
+    uint32_t topicMask = 0;
+    size_t depth = 0;
+    QueueHandle_t queue = nullptr;
+    TaskHandle_t notifyTask = nullptr;
+    // Messages that found the queue full. While any is pending, later ones park
+    // behind it instead of overtaking it through the queue.
+    portMUX_TYPE overflowLock = portMUX_INITIALIZER_UNLOCKED;
+    BusOverflowSlot overflow[kBusOverflowSlots];
+    uint32_t overflowSeq = 0;
+    std::atomic<uint32_t> overflowPending{0};
+    std::atomic<uint32_t> delivered{0};
+    std::atomic<uint32_t> overflowed{0};  // parked in an overflow slot
+    std::atomic<uint32_t> coalesced{0};   // state values replaced by a newer one before delivery
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> highWater{0};
+    uint32_t maxLatencyMs = 0;  // publish -> receive, updated by the owner only
+};
+
+namespace {
+
+static constexpr size_t kTopicCount = static_cast<size_t>(BusTopic::Count);
+static_assert(kTopicCount <= 32, "topic masks are 32 bits");
+static constexpr const char *kTopicNames[kTopicCount] = {
+    "ui_status", "ui_gw_points", "ui_gw_state", "ui_gameweek", "ui_rank",       "ui_total",
+    "ui_fresh",  "ui_event",     "ui_cleared",  "ui_squad",    "ui_demo",       "demo_active",
+    "led_pulse", "led_mode",     "led_flash",
+};
+
+struct BusState {
+    BusSubscriber subscribers[kBusMaxSubscribers];
+    size_t subscriberCount = 0;
+    std::atomic<uint32_t> published[kTopicCount] = {};
+    std::atomic<uint32_t> unrouted{0};  // published with no subscriber for the topic
+};
+
+static BusState gState;
+
+enum class Parked { Slot, Coalesced, Dropped };
+
+// Caller holds sub.overflowLock: copies only, no FreeRTOS calls.
+static Parked parkLocked(BusSubscriber &sub, const BusMessage &msg, bool isEvent) {
+    BusOverflowSlot *free = nullptr;
+    for (BusOverflowSlot &slot : sub.overflow) {
+        if (!slot.used) {
+            free = free ? free : &slot;
+        } else if (!isEvent && slot.msg.topic == msg.topic) {
+            slot.msg = msg;
+            slot.seq = ++sub.overflowSeq;
+            return Parked::Coalesced;
+        }
+    }
+    if (!free) {
+        return Parked::Dropped;
+    }
+    free->used = true;
+    free->seq = ++sub.overflowSeq;
+    free->msg = msg;
+    sub.overflowPending.fetch_add(1, std::memory_order_release);
+    return Parked::Slot;
+}
+
+static BusOverflowSlot *oldestLocked(BusSubscriber &sub) {
+    BusOverflowSlot *oldest = nullptr;
+    for (BusOverflowSlot &slot : sub.overflow) {
+        if (slot.used && (!oldest || static_cast<int32_t>(slot.seq - oldest->seq) < 0)) {
+            oldest = &slot;
+        }
+    }
+    return oldest;
+}
+
+// Receiver only: moves parked messages into the queue, oldest first, while it
+// has room. Only the receiver frees a slot; a publisher may replace a state
+// value in the meantime, and then the newer value stays parked.
+static void refillFromOverflow(BusSubscriber &sub) {
+    while (sub.overflowPending.load(std::memory_order_acquire) != 0) {
+        BusMessage msg;
+        uint32_t seq = 0;
+        portENTER_CRITICAL_SAFE(&sub.overflowLock);
+        BusOverflowSlot *oldest = oldestLocked(sub);
+        if (oldest) {
+            msg = oldest->msg;
+            seq = oldest->seq;
+        }
+        portEXIT_CRITICAL_SAFE(&sub.overflowLock);
+        if (!oldest || xQueueSend(sub.queue, &msg, 0) != pdTRUE) {
+            return;
+        }
+        portENTER_CRITICAL_SAFE(&sub.overflowLock);
+        if (oldest->seq == seq) {
+            oldest->used = false;
+            sub.overflowPending.fetch_sub(1, std::memory_order_release);
+        }
+        portEXIT_CRITICAL_SAFE(&sub.overflowLock);
+    }
+}
+
+static void raiseHighWater(std::atomic<uint32_t> &highWater, uint32_t depth) {
+    uint32_t seen = highWater.load(std::memory_order_relaxed);
+    while (depth > seen && !highWater.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+BusSubscriber *busSubscribe(const char *name, uint32_t topicMask, size_t depth) {
+    if (gState.subscriberCount >= kBusMaxSubscribers || depth == 0) {
+        Serial.printf("[BUS] cannot subscribe %s\n", name);
+        return nullptr;
+    }
+    QueueHandle_t queue = xQueueCreate(depth, sizeof(BusMessage));
+    if (!queue) {
+        Serial.printf("[BUS] queue alloc failed for %s (%u x %u bytes)\n", name, static_cast<unsigned>(depth),
+                      static_cast<unsigned>(sizeof(BusMessage)));
+        return nullptr;
+    }
+    BusSubscriber &sub = gState.subscribers[gState.subscriberCount];
+    sub.name = name;
+    sub.topicMask = topicMask;
+    sub.depth = depth;
+    sub.queue = queue;
+    // Publishers read subscriberCount without a lock; the slot is filled first.
+    __atomic_store_n(&gState.subscriberCount, gState.subscriberCount + 1, __ATOMIC_RELEASE);
+    return &sub;
+}
+
+void busSetNotifyTask(BusSubscriber *sub, TaskHandle_t task) {
+    if (sub) {
+        sub->notifyTask = task;
+    }
+}
+
+bool busPublishRaw(BusTopic topic, const void *payload, size_t size) {
+    if (static_cast<size_t>(topic) >= kTopicCount || size > kBusPayloadMax) {
+        return false;
+    }
+    BusMessage msg;
+    msg.topic = topic;
+    msg.size = static_cast<uint8_t>(size);
+    msg.publishedMs = millis();
+    if (size > 0) {
+        memcpy(msg.payload, payload, size);
+    }
+    gState.published[static_cast<size_t>(topic)].fetch_add(1, std::memory_order_relaxed);
+
+    const uint32_t bit = busTopicBit(topic);
+    const bool isEvent = (kBusEventTopics & bit) != 0;
+    const size_t count = __atomic_load_n(&gState.subscriberCount, __ATOMIC_ACQUIRE);
+    bool routed = false;
+    bool allDelivered = true;
+    for (size_t i = 0; i < count; ++i) {
+        BusSubscriber &sub = gState.subscribers[i];
+        if (!(sub.topicMask & bit)) {
+            continue;
+        }
+        routed = true;
+        if (sub.overflowPending.load(std::memory_order_acquire) != 0 || xQueueSend(sub.queue, &msg, 0) != pdTRUE) {
+            portENTER_CRITICAL_SAFE(&sub.overflowLock);
+            const Parked parked = parkLocked(sub, msg, isEvent);
+            portEXIT_CRITICAL_SAFE(&sub.overflowLock);
+            if (parked == Parked::Dropped) {
+                sub.dropped.fetch_add(1, std::memory_order_relaxed);
+                allDelivered = false;
+                if (isEvent) {
+                    Serial.printf("[BUS] %s queue full, dropped %s\n", sub.name,
+                                  kTopicNames[static_cast<size_t>(topic)]);
+                }
+                continue;
+            }
+            (parked == Parked::Coalesced ? sub.coalesced : sub.overflowed).fetch_add(1, std::memory_order_relaxed);
+        }
+        sub.delivered.fetch_add(1, std::memory_order_relaxed);
+        raiseHighWater(sub.highWater, static_cast<uint32_t>(uxQueueMessagesWaiting(sub.queue)));
+        if (sub.notifyTask) {
+            xTaskNotifyGive(sub.notifyTask);
+        }
+    }
+    if (!routed) {
+        gState.unrouted.fetch_add(1, std::memory_order_relaxed);
+    }
+    return allDelivered;
+}
+
+bool busReceive(BusSubscriber *sub, BusMessage &out) {
+    if (!sub) {
+        return false;
+    }
+    // The queue holds the older messages; parked ones follow into the room just made.
+    bool received = xQueueReceive(sub->queue, &out, 0) == pdTRUE;
+    if (sub->overflowPending.load(std::memory_order_acquire) != 0) {
+        refillFromOverflow(*sub);
+        received = received || xQueueReceive(sub->queue, &out, 0) == pdTRUE;
+    }
+    if (!received) {
+        return false;
+    }
+    const uint32_t latencyMs = millis() - out.publishedMs;
+    if (latencyMs > sub->maxLatencyMs) {
+        sub->maxLatencyMs = latencyMs;
+    }
+    return true;
+}
+
+uint32_t busDropped(const BusSubscriber *sub) {
+    return sub ? sub->dropped.load() : 0;
+}
+
+void busPrintStats() {
+    const size_t count = __atomic_load_n(&gState.subscriberCount, __ATOMIC_ACQUIRE);
+    Serial.printf("[BUS] %u subscribers, %u-byte messages\n", static_cast<unsigned>(count),
+                  static_cast<unsigned>(sizeof(BusMessage)));
+    for (size_t i = 0; i < count; ++i) {
+        BusSubscriber &sub = gState.subscribers[i];
+        Serial.printf("[BUS] %-8s depth %u/%u (max %u)  delivered %u  overflowed %u  coalesced %u  dropped %u  "
+                      "max latency %ums\n",
+                      sub.name, static_cast<unsigned>(uxQueueMessagesWaiting(sub.queue)),
+                      static_cast<unsigned>(sub.depth), static_cast<unsigned>(sub.highWater.load()),
+                      static_cast<unsigned>(sub.delivered.load()), static_cast<unsigned>(sub.overflowed.load()),
+                      static_cast<unsigned>(sub.coalesced.load()), static_cast<unsigned>(sub.dropped.load()),
+                      static_cast<unsigned>(sub.maxLatencyMs));
+    }
+    for (size_t t = 0; t < kTopicCount; ++t) {
+        const uint32_t n = gState.published[t].load();
+        if (n > 0) {
+            Serial.printf("[BUS]   %-12s %u published\n", kTopicNames[t], static_cast<unsigned>(n));
+        }
+    }
+    const uint32_t unrouted = gState.unrouted.load();
+    if (unrouted > 0) {
+        Serial.printf("[BUS]   %u messages had no subscriber\n", static_cast<unsigned>(unrouted));
+    }
+}
@@ -0,0 +1,331 @@
+#include "net_stats.h"
+
+#if FPL_NETSTATS_ENABLED
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <cstring>
+
+namespace {
+
+// Fixed bucket upper edges; one more bucket past the last edge is open.
+static constexpr uint32_t kMsEdges[] = {5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+static constexpr uint32_t kKbpsEdges[] = {8, 16, 32, 64, 128, 256, 512, 1024};
+static constexpr size_t kMaxBuckets = sizeof(kMsEdges) / sizeof(kMsEdges[0]) + 1;
+static constexpr size_t kFailureCount = static_cast<size_t>(NetFailure::Count);
+static constexpr const char *kFailureNames[kFailureCount] = {"dns", "connect", "http", "too_large", "no_memory", "empty"};
+// Distinct non-200 statuses kept per endpoint; any further ones are lumped together.
+static constexpr size_t kCodeSlots = 4;
+
+enum Timing : uint8_t { Dns, Connect, Ttfb, Body, Parse, TimingCount };
+static constexpr const char *kTimingNames[TimingCount] = {"dns", "connect", "ttfb", "body", "parse"};
+
+struct Histogram {
+    uint32_t buckets[kMaxBuckets];
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+
+    template <size_t N>
+    void add(uint32_t value, const uint32_t (&edges)[N]) {
+        static_assert(N < kMaxBuckets, "too many edges");
+        size_t b = 0;
+        while (b < N && value > edges[b]) {
+            ++b;
+        }
+        buckets[b]++;
+        count++;
+        total += value;
+        if (value > max) {
+            max = value;
+        }
+    }
+
+    // Upper edge of the bucket holding the pct-th percentile, capped at the max.
+    template <size_t N>
+    uint32_t percentile(uint32_t pct, const uint32_t (&edges)[N]) const {
+        if (count == 0) {
+            return 0;
+        }
+        const uint32_t rank = (count * pct + 99U) / 100U;
+        uint32_t seen = 0;
+        for (size_t b = 0; b < N; ++b) {
+            seen += buckets[b];
+            if (seen >= rank) {
+                return edges[b] < max ? edges[b] : max;
+            }
+        }
+        return max;
+    }
+
+    uint32_t avg() const { return count ? static_cast<uint32_t>(total / count) : 0; }
+};
+
+struct CodeCount {
+    int16_t code;
+    uint16_t count;
+};
+
+struct EndpointStats {
+    uint32_t requests;
+    uint32_t ok;
+    uint32_t retries;
+    uint32_t failures[kFailureCount];
+    CodeCount codes[kCodeSlots];
+    uint32_t otherCodes;
+    Histogram timingsMs[TimingCount];
+    Histogram kbps;
+    uint64_t bytesTotal;
+    uint32_t bytesMax;
+    uint32_t capBytes;
+};
+
+struct NetStatsState {
+    EndpointStats endpoints[kFetchEndpointCount];
+    SemaphoreHandle_t mutex = nullptr;
+    uint32_t lastLogMs = 0;
+    uint32_t requestsAtLastLog = 0;
+};
+
+static NetStatsState gState;
+
+static uint32_t usToMs(uint32_t us) {
+    return (us + 500U) / 1000U;
+}
+
+static void countCode(EndpointStats &s, int code) {
+    for (CodeCount &slot : s.codes) {
+        if (slot.count && slot.code == code) {
+            slot.count++;
+            return;
+        }
+        if (!slot.count) {
+            slot.code = static_cast<int16_t>(code);
+            slot.count = 1;
+            return;
+        }
+    }
+    s.otherCodes++;
+}
+
+static bool lock() {
+    return gState.mutex && xSemaphoreTake(gState.mutex, portMAX_DELAY) == pdTRUE;
+}
+
+static void unlock() {
+    xSemaphoreGive(gState.mutex);
+}
+
+static void snapshot(EndpointStats (&out)[kFetchEndpointCount]) {
+    if (!lock()) {
+        memset(out, 0, sizeof(out));
+        return;
+    }
+    memcpy(out, gState.endpoints, sizeof(out));
+    unlock();
+}
+
+static uint32_t totalRequests(const EndpointStats (&stats)[kFetchEndpointCount]) {
+    uint32_t total = 0;
+    for (const EndpointStats &s : stats) {
+        total += s.requests;
+    }
+    return total;
+}
+
+// "http 503 x2, connect x1", or "none".
+static void formatFailures(const EndpointStats &s, char *out, size_t size) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (size_t f = 0; f < kFailureCount; ++f) {
+        if (!s.failures[f]) {
+            continue;
+        }
+        int n = 0;
+        if (f == static_cast<size_t>(NetFailure::Http)) {
+            for (const CodeCount &slot : s.codes) {
+                if (slot.count && used < size) {
+                    n = snprintf(out + used, size - used, "%shttp %d x%u", used ? ", " : "", slot.code,
+                                 static_cast<unsigned>(slot.count));
+                    used += n > 0 ? static_cast<size_t>(n) : 0;
+                }
+            }
+            if (s.otherCodes && used < size) {
+                n = snprintf(out + used, size - used, "%shttp other x%lu", used ? ", " : "",
+                             static_cast<unsigned long>(s.otherCodes));
+                used += n > 0 ? static_cast<size_t>(n) : 0;
+            }
+            continue;
+        }
+        if (used < size) {
+            n = snprintf(out + used, size - used, "%s%s x%lu", used ? ", " : "", kFailureNames[f],
+                         static_cast<unsigned long>(s.failures[f]));
+            used += n > 0 ? static_cast<size_t>(n) : 0;
+        }
+    }
+    if (!used) {
+        strlcpy(out, "none", size);
+    }
+}
+
+static void printSummary(const EndpointStats (&stats)[kFetchEndpointCount]) {
+    for (size_t i = 0; i < kFetchEndpointCount; ++i) {
+        const EndpointStats &s = stats[i];
+        if (!s.requests) {
+            continue;
+        }
+        uint32_t failed = 0;
+        for (uint32_t f : s.failures) {
+            failed += f;
+        }
+        const Histogram *t = s.timingsMs;
+        Serial.printf("[NET] %-9s %lu req %lu fail %lu retry | p95 dns %lu conn %lu ttfb %lu body %lu parse %lu ms | "
+                      "p50 %lu KB/s | max %lu KB\n",
+                      fetchEndpointName(static_cast<FetchEndpoint>(i)), static_cast<unsigned long>(s.requests),
+                      static_cast<unsigned long>(failed), static_cast<unsigned long>(s.retries),
+                      static_cast<unsigned long>(t[Dns].percentile(95, kMsEdges)),
+                      static_cast<unsigned long>(t[Connect].percentile(95, kMsEdges)),
+                      static_cast<unsigned long>(t[Ttfb].percentile(95, kMsEdges)),
+                      static_cast<unsigned long>(t[Body].percentile(95, kMsEdges)),
+                      static_cast<unsigned long>(t[Parse].percentile(95, kMsEdges)),
+                      static_cast<unsigned long>(s.kbps.percentile(50, kKbpsEdges)),
+                      static_cast<unsigned long>(s.bytesMax / 1024U));
+    }
+}
+
+}  // namespace
+
+void netStatsInit() {
+    gState.mutex = xSemaphoreCreateMutex();
+    if (!gState.mutex) {
+        Serial.println("[NET] mutex alloc failed");
+    }
+    gState.lastLogMs = millis();
+}
+
+void netStatsRecord(const NetSample &sample) {
+    const size_t idx = static_cast<size_t>(sample.endpoint);
+    if (idx >= kFetchEndpointCount || !lock()) {
+        return;
+    }
+    EndpointStats &s = gState.endpoints[idx];
+    s.requests++;
+    // Phases the attempt got through; NetFailure is in request order.
+    const NetFailure reached = sample.ok ? NetFailure::Count : sample.failure;
+    if (reached > NetFailure::Dns) {
+        s.timingsMs[Dns].add(usToMs(sample.dnsUs), kMsEdges);
+    }
+    if (reached > NetFailure::Connect) {
+        s.timingsMs[Connect].add(usToMs(sample.connectUs), kMsEdges);
+    }
+    if (sample.httpCode > 0) {
+        s.timingsMs[Ttfb].add(usToMs(sample.ttfbUs), kMsEdges);
+    }
+    if (sample.ok) {
+        s.ok++;
+        s.timingsMs[Body].add(usToMs(sample.bodyUs), kMsEdges);
+        const uint32_t kbps = static_cast<uint32_t>(
+            (static_cast<uint64_t>(sample.bytes) * 1000000ULL) / (sample.bodyUs ? sample.bodyUs : 1U) / 1024U);
+        s.kbps.add(kbps, kKbpsEdges);
+        s.bytesTotal += sample.bytes;
+        if (sample.bytes > s.bytesMax) {
+            s.bytesMax = static_cast<uint32_t>(sample.bytes);
+        }
+    } else if (sample.failure < NetFailure::Count) {
+        s.failures[static_cast<size_t>(sample.failure)]++;
+        if (sample.failure == NetFailure::Http) {
+            countCode(s, sample.httpCode);
+        }
+    }
+    s.capBytes = static_cast<uint32_t>(sample.maxBytes);
+    unlock();
+}
+
+void netStatsRetry(FetchEndpoint endpoint) {
+    const size_t idx = static_cast<size_t>(endpoint);
+    if (idx >= kFetchEndpointCount || !lock()) {
+        return;
+    }
+    gState.endpoints[idx].retries++;
+    unlock();
+}
+
+void netStatsRecordParse(FetchEndpoint endpoint, uint32_t us) {
+    const size_t idx = static_cast<size_t>(endpoint);
+    if (idx >= kFetchEndpointCount || !lock()) {
+        return;
+    }
+    gState.endpoints[idx].timingsMs[Parse].add(usToMs(us), kMsEdges);
+    unlock();
+}
+
+void netStatsTick(uint32_t nowMs) {
+    if (!gState.mutex || nowMs - gState.lastLogMs < FPL_NETSTATS_LOG_INTERVAL_MS) {
+        return;
+    }
+    gState.lastLogMs = nowMs;
+    static EndpointStats stats[kFetchEndpointCount];
+    snapshot(stats);
+    const uint32_t requests = totalRequests(stats);
+    if (requests == gState.requestsAtLastLog) {
+        return;
+    }
+    gState.requestsAtLastLog = requests;
+    printSummary(stats);
+}
+
+void netStatsPrint() {
+    if (!gState.mutex) {
+        Serial.println("[NET] not initialised");
+        return;
+    }
+    // Static: the serial task has no stack to spare for five endpoints' histograms.
+    static EndpointStats stats[kFetchEndpointCount];
+    snapshot(stats);
+    if (!totalRequests(stats)) {
+        Serial.println("[NET] no requests yet");
+        return;
+    }
+
+    char failures[128];
+    for (size_t i = 0; i < kFetchEndpointCount; ++i) {
+        const EndpointStats &s = stats[i];
+        if (!s.requests) {
+            continue;
+        }
+        formatFailures(s, failures, sizeof(failures));
+        Serial.printf("[NET] %s: %lu req, %lu ok, %lu retry | failed: %s\n",
+                      fetchEndpointName(static_cast<FetchEndpoint>(i)), static_cast<unsigned long>(s.requests),
+                      static_cast<unsigned long>(s.ok), static_cast<unsigned long>(s.retries), failures);
+        Serial.printf("[NET]   bytes avg %lu max %lu (%lu%% of %lu KB cap)\n",
+                      static_cast<unsigned long>(s.ok ? s.bytesTotal / s.ok : 0), static_cast<unsigned long>(s.bytesMax),
+                      static_cast<unsigned long>(s.capBytes ? (100ULL * s.bytesMax) / s.capBytes : 0),
+                      static_cast<unsigned long>(s.capBytes / 1024U));
+        Serial.println("[NET]   metric    count     avg     p50     p95     max");
+        for (size_t t = 0; t < TimingCount; ++t) {
+            const Histogram &h = s.timingsMs[t];
+            Serial.printf("[NET]   %-7s %7lu %7lu %7lu %7lu %7lu ms\n", kTimingNames[t],
+                          static_cast<unsigned long>(h.count), static_cast<unsigned long>(h.avg()),
+                          static_cast<unsigned long>(h.percentile(50, kMsEdges)),
+                          static_cast<unsigned long>(h.percentile(95, kMsEdges)), static_cast<unsigned long>(h.max));
+        }
+        Serial.printf("[NET]   %-7s %7lu %7lu %7lu %7lu %7lu KB/s\n", "rate", static_cast<unsigned long>(s.kbps.count),
+                      static_cast<unsigned long>(s.kbps.avg()),
+                      static_cast<unsigned long>(s.kbps.percentile(50, kKbpsEdges)),
+                      static_cast<unsigned long>(s.kbps.percentile(95, kKbpsEdges)),
+                      static_cast<unsigned long>(s.kbps.max));
+    }
+}
+
+void netStatsReset() {
+    if (!lock()) {
+        return;
+    }
+    memset(gState.endpoints, 0, sizeof(gState.endpoints));
+    gState.requestsAtLastLog = 0;
+    unlock();
+    Serial.println("[NET] counters reset");
+}
+
+#endif
@@ -0,0 +1,115 @@
+#include "perf_stats.h"
+
+#include <cstring>
+
+#if FPL_PERF_ENABLED
+
+namespace {
+
+// Log-linear buckets: 4 per power of two of microseconds, so a percentile is
+// known to within ~19% at any scale. Bucket 0 holds 0us; the last one is open.
+static constexpr size_t kSubBuckets = 4;
+static constexpr size_t kOctaves = 22;  // up to ~4 s
+static constexpr size_t kBucketCount = 1 + kOctaves * kSubBuckets;
+static constexpr size_t kMetricCount = static_cast<size_t>(PerfMetric::Count);
+static constexpr const char *kMetricNames[kMetricCount] = {"timer_handler", "render", "flush_cb", "panel_queue",
+                                                          "dma_wait"};
+
+struct PerfHistogram {
+    uint32_t buckets[kBucketCount];
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+struct PerfState {
+    PerfHistogram histograms[kMetricCount];
+    uint64_t flushedPixels = 0;
+    uint32_t windowStartMs = 0;
+};
+
+static PerfState gState;
+
+static size_t bucketFor(uint32_t us) {
+    if (us == 0) {
+        return 0;
+    }
+    const uint32_t octave = 31U - static_cast<uint32_t>(__builtin_clz(us));
+    if (octave >= kOctaves) {
+        return kBucketCount - 1;
+    }
+    // The two bits below the leading one pick the quarter within the octave.
+    const uint32_t sub = octave >= 2 ? (us >> (octave - 2)) & 0x3U : (us << (2 - octave)) & 0x3U;
+    return 1 + octave * kSubBuckets + sub;
+}
+
+// Midpoint of the bucket, in microseconds.
+static uint32_t bucketValue(size_t bucket) {
+    if (bucket == 0) {
+        return 0;
+    }
+    const size_t octave = (bucket - 1) / kSubBuckets;
+    const size_t sub = (bucket - 1) % kSubBuckets;
+    const float base = static_cast<float>(1UL << octave);
+    return static_cast<uint32_t>(base * (1.0f + sub / 4.0f + 0.125f) + 0.5f);
+}
+
+static uint32_t percentile(const PerfHistogram &h, uint32_t pct) {
+    if (h.count == 0) {
+        return 0;
+    }
+    const uint32_t rank = (h.count * pct + 99U) / 100U;
+    uint32_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += h.buckets[i];
+        if (seen >= rank) {
+            const uint32_t value = bucketValue(i);
+            return value < h.maxUs ? value : h.maxUs;
+        }
+    }
+    return h.maxUs;
+}
+
+}  // namespace
+
+void IRAM_ATTR perfRecordUs(PerfMetric metric, uint32_t us) {
+    // Best effort: a record racing a reset from the serial task may be lost.
+    PerfHistogram &h = gState.histograms[static_cast<size_t>(metric)];
+    h.buckets[bucketFor(us)]++;
+    h.count++;
+    h.totalUs += us;
+    if (us > h.maxUs) {
+        h.maxUs = us;
+    }
+}
+
+void perfRecordCycles(PerfMetric metric, uint32_t cycles) {
+    static const uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+    perfRecordUs(metric, cycles / cyclesPerUs);
+}
+
+void perfAddFlushedPixels(uint32_t pixels) {
+    gState.flushedPixels += pixels;
+}
+
+void perfPrintAndReset() {
+    const uint32_t nowMs = millis();
+    const uint32_t elapsedMs = nowMs - gState.windowStartMs;
+    Serial.printf("[PERF] window %.1fs, flushed %llu px (%lu px/s)\n", elapsedMs / 1000.0f,
+                  static_cast<unsigned long long>(gState.flushedPixels),
+                  static_cast<unsigned long>(elapsedMs ? (gState.flushedPixels * 1000ULL) / elapsedMs : 0));
+    Serial.println("[PERF] metric          count      avg      p50      p95      p99      max  (us)");
+    for (size_t i = 0; i < kMetricCount; ++i) {
+        const PerfHistogram &h = gState.histograms[i];
+        Serial.printf("[PERF] %-13s %7lu %8lu %8lu %8lu %8lu %8lu\n", kMetricNames[i],
+                      static_cast<unsigned long>(h.count),
+                      static_cast<unsigned long>(h.count ? h.totalUs / h.count : 0),
+                      static_cast<unsigned long>(percentile(h, 50)), static_cast<unsigned long>(percentile(h, 95)),
+                      static_cast<unsigned long>(percentile(h, 99)), static_cast<unsigned long>(h.maxUs));
+    }
+    memset(gState.histograms, 0, sizeof(gState.histograms));
+    gState.flushedPixels = 0;
+    gState.windowStartMs = nowMs;
+}
+
+#endif
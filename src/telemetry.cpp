@@ -0,0 +1,310 @@
+#include "telemetry.h"
+
+#if FPL_TELEMETRY_ENABLED
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+namespace {
+
+#if CONFIG_FREERTOS_UNICORE
+static constexpr size_t kCoreCount = 1;
+#else
+static constexpr size_t kCoreCount = 2;
+#endif
+static constexpr size_t kMaxTasks = 10;
+static constexpr size_t kSampleCount = FPL_TELEMETRY_SAMPLES;
+static constexpr uint16_t kUnknown = 0xFFFF;
+static constexpr size_t kStackWarnBytes = 512;
+
+struct TelemetrySample {
+    uint32_t timeMs;
+    uint16_t coreLoadPermille[kCoreCount];  // kUnknown without FreeRTOS run-time stats
+    uint16_t taskCpuPermille[kMaxTasks];    // share of one core
+    uint16_t taskStackFree[kMaxTasks];      // bytes never used so far
+    uint32_t internalFree;
+    uint32_t internalLargest;
+    uint32_t internalMinFree;  // low-water mark since boot
+    uint32_t psramFree;
+    uint32_t psramLargest;
+};
+
+struct TrackedTask {
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t lastRunTime;
+};
+
+// Conditions that log once when they appear and again only after clearing.
+enum WarnBit : uint32_t {
+    kWarnInternalFragmented = 1U << 0,
+    kWarnInternalLow = 1U << 1,
+    kWarnPsramFragmented = 1U << 2,
+    kWarnStackLow = 1U << 3,
+};
+
+struct TelemetryState {
+    TrackedTask tasks[kMaxTasks];
+    size_t taskCount = 0;
+    TelemetrySample samples[kSampleCount];
+    size_t head = 0;  // next slot to write
+    size_t count = 0;
+    uint32_t lastSampleMs = 0;
+    bool haveRunTime = false;
+    uint32_t lastTotalRunTime = 0;
+    uint32_t lastIdleRunTime[kCoreCount] = {};
+    uint64_t firstSampleUs = 0;
+    uint64_t sampleCostUs = 0;
+    uint32_t samplesTaken = 0;
+    uint32_t warnings = 0;
+};
+
+static TelemetryState gState;
+
+#if configGENERATE_RUN_TIME_STATS
+static constexpr size_t kMaxTaskStatus = 40;
+static TaskStatus_t gTaskStatus[kMaxTaskStatus];
+
+static uint16_t permille(uint32_t part, uint32_t whole) {
+    if (whole == 0) {
+        return kUnknown;
+    }
+    const uint64_t value = static_cast<uint64_t>(part) * 1000U / whole;
+    return static_cast<uint16_t>(value > 1000U ? 1000U : value);
+}
+
+// Fills the CPU fields from run-time counter deltas since the previous sample.
+static void sampleRunTime(TelemetrySample &sample) {
+    uint32_t totalRunTime = 0;
+    const UBaseType_t n = uxTaskGetSystemState(gTaskStatus, kMaxTaskStatus, &totalRunTime);
+    if (n == 0) {
+        return;  // more tasks than kMaxTaskStatus
+    }
+    const uint32_t wall = totalRunTime - gState.lastTotalRunTime;
+    for (size_t core = 0; core < kCoreCount; ++core) {
+        const TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(core);
+        for (UBaseType_t i = 0; i < n; ++i) {
+            if (gTaskStatus[i].xHandle != idle) {
+                continue;
+            }
+            if (gState.haveRunTime) {
+                const uint16_t idlePermille = permille(gTaskStatus[i].ulRunTimeCounter - gState.lastIdleRunTime[core], wall);
+                sample.coreLoadPermille[core] = idlePermille == kUnknown ? kUnknown : 1000U - idlePermille;
+            }
+            gState.lastIdleRunTime[core] = gTaskStatus[i].ulRunTimeCounter;
+        }
+    }
+    for (size_t t = 0; t < gState.taskCount; ++t) {
+        TrackedTask &task = gState.tasks[t];
+        for (UBaseType_t i = 0; i < n; ++i) {
+            if (gTaskStatus[i].xHandle != task.handle) {
+                continue;
+            }
+            if (gState.haveRunTime) {
+                sample.taskCpuPermille[t] = permille(gTaskStatus[i].ulRunTimeCounter - task.lastRunTime, wall);
+            }
+            task.lastRunTime = gTaskStatus[i].ulRunTimeCounter;
+        }
+    }
+    gState.lastTotalRunTime = totalRunTime;
+    gState.haveRunTime = true;
+}
+#else
+static void sampleRunTime(TelemetrySample &) {}
+#endif
+
+static void checkWarnings(const TelemetrySample &sample) {
+    uint32_t warnings = 0;
+    if (sample.internalLargest * 100U < sample.internalFree * FPL_TELEMETRY_FRAG_WARN_PCT) {
+        warnings |= kWarnInternalFragmented;
+    }
+    if (sample.internalFree < FPL_TELEMETRY_LOW_HEAP_BYTES) {
+        warnings |= kWarnInternalLow;
+    }
+    if (sample.psramFree > 0 && sample.psramLargest * 100U < sample.psramFree * FPL_TELEMETRY_FRAG_WARN_PCT) {
+        warnings |= kWarnPsramFragmented;
+    }
+    const char *lowStackTask = nullptr;
+    uint16_t lowStack = 0;
+    for (size_t t = 0; t < gState.taskCount; ++t) {
+        if (sample.taskStackFree[t] < kStackWarnBytes) {
+            warnings |= kWarnStackLow;
+            lowStackTask = gState.tasks[t].name;
+            lowStack = sample.taskStackFree[t];
+        }
+    }
+
+    const uint32_t raised = warnings & ~gState.warnings;
+    gState.warnings = warnings;
+    if (raised & kWarnInternalFragmented) {
+        Serial.printf("[STATS] warning: internal heap fragmented, largest block %lu of %lu bytes free\n",
+                      static_cast<unsigned long>(sample.internalLargest), static_cast<unsigned long>(sample.internalFree));
+    }
+    if (raised & kWarnInternalLow) {
+        Serial.printf("[STATS] warning: internal heap low, %lu bytes free\n",
+                      static_cast<unsigned long>(sample.internalFree));
+    }
+    if (raised & kWarnPsramFragmented) {
+        Serial.printf("[STATS] warning: PSRAM fragmented, largest block %lu of %lu bytes free\n",
+                      static_cast<unsigned long>(sample.psramLargest), static_cast<unsigned long>(sample.psramFree));
+    }
+    if (raised & kWarnStackLow) {
+        Serial.printf("[STATS] warning: %s has only %u bytes of stack left unused\n", lowStackTask,
+                      static_cast<unsigned>(lowStack));
+    }
+}
+
+static void takeSample(uint32_t nowMs) {
+    const int64_t startUs = esp_timer_get_time();
+    TelemetrySample &sample = gState.samples[gState.head];
+    sample.timeMs = nowMs;
+    for (size_t core = 0; core < kCoreCount; ++core) {
+        sample.coreLoadPermille[core] = kUnknown;
+    }
+    for (size_t t = 0; t < kMaxTasks; ++t) {
+        sample.taskCpuPermille[t] = kUnknown;
+        sample.taskStackFree[t] = kUnknown;
+    }
+    sampleRunTime(sample);
+    for (size_t t = 0; t < gState.taskCount; ++t) {
+        const UBaseType_t freeBytes = uxTaskGetStackHighWaterMark(gState.tasks[t].handle);
+        sample.taskStackFree[t] = static_cast<uint16_t>(freeBytes < kUnknown ? freeBytes : kUnknown - 1);
+    }
+    sample.internalFree = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    sample.internalLargest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    sample.internalMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    sample.psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    sample.psramLargest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+
+    gState.head = (gState.head + 1) % kSampleCount;
+    if (gState.count < kSampleCount) {
+        gState.count++;
+    }
+    checkWarnings(sample);
+
+    const int64_t endUs = esp_timer_get_time();
+    if (gState.samplesTaken == 0) {
+        gState.firstSampleUs = static_cast<uint64_t>(startUs);
+    }
+    gState.samplesTaken++;
+    gState.sampleCostUs += static_cast<uint64_t>(endUs - startUs);
+}
+
+// Oldest first.
+static const TelemetrySample &sampleAt(size_t i) {
+    return gState.samples[(gState.head + kSampleCount - gState.count + i) % kSampleCount];
+}
+
+// One metric over the ring: current value, min, max and the change per minute
+// between the oldest and newest known samples. kUnknown values are skipped.
+template <typename Get>
+static void printSeries(const char *label, const char *unit, uint32_t divisor, Get get) {
+    bool any = false;
+    int64_t minValue = 0;
+    int64_t maxValue = 0;
+    int64_t firstValue = 0;
+    int64_t lastValue = 0;
+    uint32_t firstMs = 0;
+    uint32_t lastMs = 0;
+    for (size_t i = 0; i < gState.count; ++i) {
+        const TelemetrySample &sample = sampleAt(i);
+        int64_t value = 0;
+        if (!get(sample, value)) {
+            continue;
+        }
+        if (!any) {
+            minValue = maxValue = firstValue = value;
+            firstMs = sample.timeMs;
+            any = true;
+        }
+        minValue = value < minValue ? value : minValue;
+        maxValue = value > maxValue ? value : maxValue;
+        lastValue = value;
+        lastMs = sample.timeMs;
+    }
+    if (!any) {
+        Serial.printf("[STATS] %-16s n/a\n", label);
+        return;
+    }
+    const uint32_t spanMs = lastMs - firstMs;
+    const int64_t trendPerMin = spanMs > 0 ? (lastValue - firstValue) * 60000 / static_cast<int64_t>(spanMs) : 0;
+    const int64_t d = divisor;
+    Serial.printf("[STATS] %-16s now %6ld  min %6ld  max %6ld  trend %+ld/min %s\n", label,
+                  static_cast<long>(lastValue / d), static_cast<long>(minValue / d), static_cast<long>(maxValue / d),
+                  static_cast<long>(trendPerMin / d), unit);
+}
+
+}  // namespace
+
+void telemetryRegisterTask(const char *name, TaskHandle_t task) {
+    if (!task || gState.taskCount >= kMaxTasks) {
+        return;
+    }
+    gState.tasks[gState.taskCount++] = TrackedTask{name, task, 0};
+}
+
+void telemetryTick(uint32_t nowMs) {
+    if (gState.samplesTaken > 0 && nowMs - gState.lastSampleMs < FPL_TELEMETRY_INTERVAL_MS) {
+        return;
+    }
+    gState.lastSampleMs = nowMs;
+    takeSample(nowMs);
+}
+
+void telemetryPrintStats() {
+    if (gState.count == 0) {
+        Serial.println("[STATS] no samples yet");
+        return;
+    }
+    const uint64_t spanUs = static_cast<uint64_t>(esp_timer_get_time()) - gState.firstSampleUs;
+    // Cost in millionths of wall time, printed as a percentage with four decimals.
+    const uint32_t costPpm = spanUs > 0 ? static_cast<uint32_t>(gState.sampleCostUs * 1000000U / spanUs) : 0;
+    Serial.printf("[STATS] %u samples every %lu ms, %lu us per sample, sampling cost %lu.%04lu%% CPU\n",
+                  static_cast<unsigned>(gState.count), static_cast<unsigned long>(FPL_TELEMETRY_INTERVAL_MS),
+                  static_cast<unsigned long>(gState.sampleCostUs / gState.samplesTaken),
+                  static_cast<unsigned long>(costPpm / 10000U), static_cast<unsigned long>(costPpm % 10000U));
+
+    for (size_t core = 0; core < kCoreCount; ++core) {
+        char label[16];
+        snprintf(label, sizeof(label), "cpu%u load", static_cast<unsigned>(core));
+        printSeries(label, "%", 10, [core](const TelemetrySample &s, int64_t &v) {
+            v = s.coreLoadPermille[core];
+            return s.coreLoadPermille[core] != kUnknown;
+        });
+    }
+    printSeries("internal free", "KB", 1024, [](const TelemetrySample &s, int64_t &v) {
+        v = s.internalFree;
+        return true;
+    });
+    printSeries("internal largest", "KB", 1024, [](const TelemetrySample &s, int64_t &v) {
+        v = s.internalLargest;
+        return true;
+    });
+    printSeries("internal lowest", "KB", 1024, [](const TelemetrySample &s, int64_t &v) {
+        v = s.internalMinFree;
+        return true;
+    });
+    printSeries("psram free", "KB", 1024, [](const TelemetrySample &s, int64_t &v) {
+        v = s.psramFree;
+        return true;
+    });
+    printSeries("psram largest", "KB", 1024, [](const TelemetrySample &s, int64_t &v) {
+        v = s.psramLargest;
+        return true;
+    });
+    for (size_t t = 0; t < gState.taskCount; ++t) {
+        char label[24];
+        snprintf(label, sizeof(label), "%s cpu", gState.tasks[t].name);
+        printSeries(label, "% of a core", 10, [t](const TelemetrySample &s, int64_t &v) {
+            v = s.taskCpuPermille[t];
+            return s.taskCpuPermille[t] != kUnknown;
+        });
+        snprintf(label, sizeof(label), "%s stack", gState.tasks[t].name);
+        printSeries(label, "bytes unused", 1, [t](const TelemetrySample &s, int64_t &v) {
+            v = s.taskStackFree[t];
+            return s.taskStackFree[t] != kUnknown;
+        });
+    }
+}
+
+#endif
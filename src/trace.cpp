@@ -0,0 +1,143 @@
+#include "trace.h"
+
+#if FPL_TRACE_ENABLED
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+
+#include "serial_base64.h"
+
+static_assert((FPL_TRACE_EVENTS & (FPL_TRACE_EVENTS - 1)) == 0, "FPL_TRACE_EVENTS must be a power of two");
+
+namespace {
+
+// flags: bit 0 = end, bit 1 = core, bits 2..5 = task slot.
+struct TraceRecord {
+    uint32_t tsUs;  // low 32 bits of esp_timer; the converter unwraps
+    uint8_t span;
+    uint8_t flags;
+    uint16_t arg;
+};
+static_assert(sizeof(TraceRecord) == 8, "trace record layout is read by tools/trace_to_chrome.py");
+
+// Tasks get a slot the first time they record; the last slot is shared by any
+// beyond that.
+static constexpr size_t kMaxTasks = 16;
+static constexpr uint32_t kDumpVersion = 1;
+
+struct TraceState {
+    TraceRecord *ring = nullptr;
+    std::atomic<uint32_t> head{0};
+    std::atomic<bool> recording{false};
+    std::atomic<TaskHandle_t> tasks[kMaxTasks] = {};
+};
+
+static TraceState gState;
+
+static uint8_t taskSlot() {
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (size_t i = 0; i < kMaxTasks - 1; ++i) {
+        TaskHandle_t seen = gState.tasks[i].load(std::memory_order_relaxed);
+        if (seen == self) {
+            return static_cast<uint8_t>(i);
+        }
+        if (!seen) {
+            if (gState.tasks[i].compare_exchange_strong(seen, self) || seen == self) {
+                return static_cast<uint8_t>(i);
+            }
+        }
+    }
+    return kMaxTasks - 1;
+}
+
+static void record(TraceSpan span, uint16_t arg, bool end) {
+    if (!gState.recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const uint32_t tsUs = static_cast<uint32_t>(esp_timer_get_time());
+    const uint32_t idx = gState.head.fetch_add(1, std::memory_order_relaxed) & (FPL_TRACE_EVENTS - 1);
+    TraceRecord &rec = gState.ring[idx];
+    rec.tsUs = tsUs;
+    rec.span = static_cast<uint8_t>(span);
+    rec.flags = static_cast<uint8_t>((end ? 1U : 0U) | (xPortGetCoreID() ? 2U : 0U) | (taskSlot() << 2));
+    rec.arg = arg;
+}
+
+}  // namespace
+
+void traceInit() {
+    if (gState.ring) {
+        return;
+    }
+    gState.ring = static_cast<TraceRecord *>(
+        heap_caps_calloc(FPL_TRACE_EVENTS, sizeof(TraceRecord), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!gState.ring) {
+        Serial.println("[TRACE] no PSRAM for trace ring");
+        return;
+    }
+    gState.recording.store(true);
+    Serial.printf("[TRACE] %u event ring (%u KB PSRAM)\n", static_cast<unsigned>(FPL_TRACE_EVENTS),
+                  static_cast<unsigned>(FPL_TRACE_EVENTS * sizeof(TraceRecord) / 1024));
+}
+
+void traceBegin(TraceSpan span, uint16_t arg) {
+    record(span, arg, false);
+}
+
+void traceEnd(TraceSpan span, uint16_t arg) {
+    record(span, arg, true);
+}
+
+void traceSetRecording(bool on) {
+    gState.recording.store(on && gState.ring);
+    Serial.printf("[TRACE] recording %s\n", gState.recording.load() ? "on" : "off");
+}
+
+void traceClear() {
+    const bool wasRecording = gState.recording.exchange(false);
+    vTaskDelay(pdMS_TO_TICKS(2));  // let an in-flight record() land
+    gState.head.store(0);
+    gState.recording.store(wasRecording);
+    Serial.println("[TRACE] cleared");
+}
+
+void traceDump() {
+    if (!gState.ring) {
+        Serial.println("[TRACE] not initialised");
+        return;
+    }
+    const bool wasRecording = gState.recording.exchange(false);
+    vTaskDelay(pdMS_TO_TICKS(2));
+
+    const uint32_t head = gState.head.load();
+    const uint32_t count = head < FPL_TRACE_EVENTS ? head : FPL_TRACE_EVENTS;
+    const uint32_t dropped = head - count;
+    Serial.printf("[TRACE] begin v%lu %lu %lu %lu\n", static_cast<unsigned long>(kDumpVersion),
+                  static_cast<unsigned long>(count), static_cast<unsigned long>(dropped),
+                  static_cast<unsigned long>(esp_timer_get_time()));
+    for (size_t i = 0; i < kMaxTasks; ++i) {
+        const TaskHandle_t task = gState.tasks[i].load();
+        if (task) {
+            Serial.printf("[TRACE] task %u %s\n", static_cast<unsigned>(i), pcTaskGetName(task));
+        }
+    }
+
+    Base64Writer out;
+    for (uint32_t i = head - count; i != head; ++i) {
+        const TraceRecord &rec = gState.ring[i & (FPL_TRACE_EVENTS - 1)];
+        out.putLe32(rec.tsUs);
+        out.put(rec.span);
+        out.put(rec.flags);
+        out.putLe16(rec.arg);
+    }
+    out.finish();
+    Serial.printf("[TRACE] end %08lx\n", static_cast<unsigned long>(out.digest()));
+
+    gState.recording.store(wasRecording);
+}
+
+#endif
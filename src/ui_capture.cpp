@@ -0,0 +1,101 @@
+#include "ui_capture.h"
+
+#include "fpl_config.h"
+
+#include <cstring>
+
+#if FPL_UI_CAPTURE_ENABLED
+
+#include <esp_heap_caps.h>
+
+#include "serial_base64.h"
+
+namespace {
+
+struct UiCaptureState {
+    uint16_t *frame = nullptr;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    bool active = false;
+};
+
+static UiCaptureState gState;
+
+}  // namespace
+
+bool uiCaptureBegin(uint16_t width, uint16_t height) {
+    const size_t bytes = static_cast<size_t>(width) * height * sizeof(uint16_t);
+    if (gState.frame && (gState.width != width || gState.height != height)) {
+        heap_caps_free(gState.frame);
+        gState.frame = nullptr;
+    }
+    if (!gState.frame) {
+        gState.frame = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM));
+        if (!gState.frame) {
+            Serial.println("[SHOT] no PSRAM for capture frame");
+            return false;
+        }
+        gState.width = width;
+        gState.height = height;
+    }
+    // Anything never flushed (the masked corners of the round panel) stays black.
+    memset(gState.frame, 0, bytes);
+    gState.active = true;
+    return true;
+}
+
+bool uiCaptureActive() {
+    return gState.active;
+}
+
+void uiCaptureArea(int x, int y, int w, int h, const uint8_t *pixels, bool swapped) {
+    if (!gState.active || x < 0 || y < 0 || x + w > gState.width || y + h > gState.height) {
+        return;
+    }
+    const size_t rowBytes = static_cast<size_t>(w) * sizeof(uint16_t);
+    for (int row = 0; row < h; ++row) {
+        uint16_t *dst = gState.frame + static_cast<size_t>(y + row) * gState.width + x;
+        memcpy(dst, pixels + row * rowBytes, rowBytes);
+        if (swapped) {
+            for (int i = 0; i < w; ++i) {
+                dst[i] = static_cast<uint16_t>((dst[i] >> 8) | (dst[i] << 8));
+            }
+        }
+    }
+}
+
+void uiCaptureDump(const char *name) {
+    if (!gState.active) {
+        return;
+    }
+    gState.active = false;
+
+    // Payload: (u16 run length, u16 pixel) pairs, little-endian. The UI is mostly
+    // flat fills, so this cuts the serial transfer by an order of magnitude.
+    Serial.printf("[SHOT] begin %s %u %u rle16\n", name, static_cast<unsigned>(gState.width),
+                  static_cast<unsigned>(gState.height));
+    Base64Writer out;
+    const size_t total = static_cast<size_t>(gState.width) * gState.height;
+    size_t i = 0;
+    while (i < total) {
+        const uint16_t pixel = gState.frame[i];
+        size_t run = 1;
+        while (i + run < total && run < 0xFFFF && gState.frame[i + run] == pixel) {
+            ++run;
+        }
+        out.putLe16(static_cast<uint16_t>(run));
+        out.putLe16(pixel);
+        i += run;
+    }
+    out.finish();
+    Serial.printf("[SHOT] end %s %08lx\n", name, static_cast<unsigned long>(out.digest()));
+}
+
+#else
+
+bool uiCaptureBegin(uint16_t, uint16_t) { return false; }
+bool uiCaptureActive() { return false; }
+void uiCaptureArea(int, int, int, int, const uint8_t *, bool) {}
+void uiCaptureDump(const char *) {}
+
+#endif
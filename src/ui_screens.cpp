@@ -0,0 +1,999 @@
+#include "ui_screens.h"
+
+#include "kit_cache.h"
+
+#include <Arduino.h>
+#include <cstring>
+#include <sys/time.h>
+
+LV_FONT_DECLARE(lv_font_montserrat_16);
+LV_FONT_DECLARE(lv_font_montserrat_18);
+LV_FONT_DECLARE(lv_font_montserrat_22);
+LV_FONT_DECLARE(lv_font_montserrat_24);
+LV_FONT_DECLARE(lv_font_montserrat_26);
+LV_FONT_DECLARE(lv_font_montserrat_28);
+LV_FONT_DECLARE(lv_font_montserrat_32);
+LV_FONT_DECLARE(lv_font_montserrat_48);
+
+struct UiEventRowWidgets {
+    lv_obj_t *row = nullptr;
+    lv_obj_t *left = nullptr;
+    lv_obj_t *right = nullptr;
+};
+
+struct UiSquadRowWidgets {
+    lv_obj_t *row = nullptr;
+    lv_obj_t *name = nullptr;
+    lv_obj_t *breakdown = nullptr;
+    lv_obj_t *points = nullptr;
+};
+
+struct UiWidgets {
+    lv_obj_t *screenIdle = nullptr;
+    lv_obj_t *screenDeadline = nullptr;
+    lv_obj_t *screenFinalHour = nullptr;
+    lv_obj_t *screenLive = nullptr;
+    lv_obj_t *screenPopup = nullptr;
+    lv_obj_t *screenEvents = nullptr;
+    lv_obj_t *screenSquad = nullptr;
+
+    // Idle
+    lv_obj_t *idleRankArrow = nullptr;
+    lv_obj_t *idleRankValue = nullptr;
+    lv_obj_t *idleGwPoints = nullptr;
+    lv_obj_t *idleTotalPoints = nullptr;
+
+    // Deadline
+    lv_obj_t *deadlineLabel = nullptr;
+    lv_obj_t *deadlineCountdown = nullptr;
+    lv_obj_t *deadlineMeta = nullptr;
+
+    // Final hour
+    lv_obj_t *finalArc = nullptr;
+    lv_obj_t *finalCountdown = nullptr;
+
+    // Live
+    lv_obj_t *liveTitle = nullptr;
+    lv_obj_t *liveDot = nullptr;
+    lv_obj_t *livePoints = nullptr;
+    lv_obj_t *liveRank = nullptr;
+    lv_obj_t *liveTickerBtn = nullptr;
+    lv_obj_t *liveTickerLabel = nullptr;
+    lv_obj_t *liveHoldArc = nullptr;
+
+    // Popup
+    lv_obj_t *popupTitle = nullptr;
+    lv_obj_t *popupKit = nullptr;
+    lv_obj_t *popupPlayer = nullptr;
+    lv_obj_t *popupDelta = nullptr;
+    lv_obj_t *popupTotal = nullptr;
+
+    // Shared top line / stale
+    lv_obj_t *statusLabel = nullptr;
+
+    // Lists
+    lv_obj_t *eventsList = nullptr;
+    lv_obj_t *squadList = nullptr;
+
+    // List rows are created once and rebound on refresh.
+    lv_obj_t *eventsEmpty = nullptr;
+    UiEventRowWidgets eventRows[kMaxUiEvents];
+    UiSquadRowWidgets squadRows[kMaxSquadRows];
+};
+
+static UiWidgets ui;
+static UiMode currentMode = UiMode::Idle;
+
+static UiScreenHooks hooks;
+
+static void formatNumberWithCommas(int value, char *out, size_t outLen) {
+    if (!out || outLen == 0) {
+        return;
+    }
+    char raw[24];
+    snprintf(raw, sizeof(raw), "%d", value);
+    const int rawLen = static_cast<int>(strlen(raw));
+    if (rawLen <= 3) {
+        strlcpy(out, raw, outLen);
+        return;
+    }
+
+    char rev[32];
+    int idx = 0;
+    int digits = 0;
+    for (int i = rawLen - 1; i >= 0; --i) {
+        rev[idx++] = raw[i];
+        ++digits;
+        if (digits == 3 && i > 0) {
+            rev[idx++] = ',';
+            digits = 0;
+        }
+    }
+    int outIdx = 0;
+    for (int i = idx - 1; i >= 0 && static_cast<size_t>(outIdx + 1) < outLen; --i) {
+        out[outIdx++] = rev[i];
+    }
+    out[outIdx] = '\0';
+}
+
+static constexpr uint32_t kColorBgDeep = 0x1A0533;
+static constexpr uint32_t kColorBgSurface = 0x2D1B4E;
+static constexpr uint32_t kColorTextPrimary = 0xFFFFFF;
+static constexpr uint32_t kColorTextSecondary = 0xB0A0C0;
+static constexpr uint32_t kColorAccentGreen = 0x00FF87;
+static constexpr uint32_t kColorAccentRed = 0xFF2882;
+static constexpr uint32_t kColorAccentAmber = 0xFFC107;
+static constexpr uint32_t kColorAccentCyan = 0x00E5FF;
+static constexpr uint32_t kColorButtonPurple = 0x6A3DFF;
+
+static const lv_font_t *kFontHero = &lv_font_montserrat_48;
+static const lv_font_t *kFontLarge = &lv_font_montserrat_32;
+static const lv_font_t *kFontBody = &lv_font_montserrat_20;
+static const lv_font_t *kFontCaption = &lv_font_montserrat_18;
+static const lv_font_t *kFontMicro = &lv_font_montserrat_14;
+
+static uint32_t lastTickerRotateMs = 0;
+static uint32_t lastDeadlineBlinkMs = 0;
+static bool deadlineColonVisible = true;
+static size_t tickerEventIndex = 0;
+static uint32_t holdStartMs = 0;
+static bool holdTriggered = false;
+static uint32_t renderedEventsVersion = 0;
+static uint32_t renderedSquadVersion = 0;
+
+
+UiMode currentUiMode() {
+    return currentMode;
+}
+
+static lv_obj_t *modeToScreen(UiMode mode) {
+    switch (mode) {
+        case UiMode::Idle: return ui.screenIdle;
+        case UiMode::Deadline: return ui.screenDeadline;
+        case UiMode::FinalHour: return ui.screenFinalHour;
+        case UiMode::Live: return ui.screenLive;
+        case UiMode::EventPopup: return ui.screenPopup;
+        case UiMode::EventsList: return ui.screenEvents;
+        case UiMode::Squad: return ui.screenSquad;
+    }
+    return ui.screenIdle;
+}
+
+void loadMode(UiMode mode, lv_screen_load_anim_t anim) {
+    if (currentMode == mode) {
+        return;
+    }
+    lv_obj_t *target = modeToScreen(mode);
+    if (!target) {
+        return;
+    }
+    if (anim == LV_SCR_LOAD_ANIM_NONE) {
+        // Immediate, so a following lv_refr_now() already draws the new screen.
+        lv_screen_load(target);
+    } else {
+        lv_screen_load_anim(target, anim, 200, 0, false);
+    }
+    currentMode = mode;
+    // Force one-time rebuild of overlay lists after screen switch.
+    if (mode == UiMode::EventsList) {
+        renderedEventsVersion = 0;
+    } else if (mode == UiMode::Squad) {
+        renderedSquadVersion = 0;
+    }
+}
+
+static lv_obj_t *createLabel(lv_obj_t *parent, const lv_font_t *font, uint32_t colorHex, lv_text_align_t align) {
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
+    lv_obj_set_style_text_color(label, lv_color_hex(colorHex), LV_PART_MAIN);
+    lv_obj_set_style_text_align(label, align, LV_PART_MAIN);
+    return label;
+}
+
+static void styleScreen(lv_obj_t *screen, uint32_t bgHex) {
+    lv_obj_set_style_bg_color(screen, lv_color_hex(bgHex), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_radius(screen, LV_RADIUS_CIRCLE, LV_PART_MAIN);
+    lv_obj_set_style_clip_corner(screen, true, LV_PART_MAIN);
+}
+
+static void stylePurpleButton(lv_obj_t *btn) {
+    if (!btn) {
+        return;
+    }
+    lv_obj_set_style_bg_color(btn, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(btn, LV_OPA_80, LV_PART_MAIN);
+}
+
+// Dirty-checked setters: LVGL invalidates a widget on every set call, even when the
+// value is unchanged, so compare against what the widget already holds first.
+static void uiSetText(lv_obj_t *label, const char *text) {
+    const char *current = lv_label_get_text(label);
+    if (current && strcmp(current, text) == 0) {
+        return;
+    }
+    lv_label_set_text(label, text);
+}
+
+static void uiSetTextColor(lv_obj_t *obj, uint32_t colorHex) {
+    const lv_color_t color = lv_color_hex(colorHex);
+    if (lv_color_eq(lv_obj_get_style_text_color(obj, LV_PART_MAIN), color)) {
+        return;
+    }
+    lv_obj_set_style_text_color(obj, color, LV_PART_MAIN);
+}
+
+static void uiSetBgColor(lv_obj_t *obj, uint32_t colorHex) {
+    const lv_color_t color = lv_color_hex(colorHex);
+    if (lv_color_eq(lv_obj_get_style_bg_color(obj, LV_PART_MAIN), color)) {
+        return;
+    }
+    lv_obj_set_style_bg_color(obj, color, LV_PART_MAIN);
+}
+
+static void uiSetHidden(lv_obj_t *obj, bool hidden) {
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden) {
+        return;
+    }
+    if (hidden) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void uiSetBgOpa(lv_obj_t *obj, lv_opa_t opa) {
+    if (lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) == opa) {
+        return;
+    }
+    lv_obj_set_style_bg_opa(obj, opa, LV_PART_MAIN);
+}
+
+static void demoNotificationBtnCb(lv_event_t *) {
+    if (hooks.notificationDemo) {
+        hooks.notificationDemo();
+    }
+}
+
+static void demoDeadline45BtnCb(lv_event_t *) {
+    if (hooks.deadlineDemo) {
+        hooks.deadlineDemo(45 * 60);
+    }
+}
+
+static void demoDeadline7BtnCb(lv_event_t *) {
+    if (hooks.deadlineDemo) {
+        hooks.deadlineDemo(7 * 60);
+    }
+}
+
+static lv_obj_t *createListRow(lv_obj_t *list, int height) {
+    lv_obj_t *row = lv_obj_create(list);
+    lv_obj_set_size(row, lv_pct(100), height);
+    lv_obj_set_style_min_height(row, height, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
+    lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+    return row;
+}
+
+static void createEventsListPool() {
+    ui.eventsEmpty = createLabel(ui.eventsList, kFontCaption, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(ui.eventsEmpty, "No events yet");
+    lv_obj_center(ui.eventsEmpty);
+
+    for (UiEventRowWidgets &w : ui.eventRows) {
+        w.row = createListRow(ui.eventsList, 36);
+        lv_obj_set_style_border_side(w.row, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
+        lv_obj_set_style_border_width(w.row, 1, LV_PART_MAIN);
+        lv_obj_set_style_border_color(w.row, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
+
+        w.left = createLabel(w.row, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_LEFT);
+        lv_obj_align(w.left, LV_ALIGN_LEFT_MID, 6, 0);
+        w.right = createLabel(w.row, kFontBody, kColorAccentGreen, LV_TEXT_ALIGN_RIGHT);
+        lv_obj_align(w.right, LV_ALIGN_RIGHT_MID, -6, 0);
+    }
+}
+
+static void createSquadListPool() {
+    for (UiSquadRowWidgets &w : ui.squadRows) {
+        w.row = createListRow(ui.squadList, 34);
+        w.name = createLabel(w.row, &lv_font_montserrat_18, kColorTextPrimary, LV_TEXT_ALIGN_LEFT);
+        lv_obj_align(w.name, LV_ALIGN_LEFT_MID, 6, 0);
+        w.breakdown = createLabel(w.row, &lv_font_montserrat_16, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+        lv_obj_align(w.breakdown, LV_ALIGN_CENTER, 28, 0);
+        w.points = createLabel(w.row, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_RIGHT);
+        lv_obj_align(w.points, LV_ALIGN_RIGHT_MID, -8, 0);
+    }
+
+    lv_obj_t *footer = lv_obj_create(ui.squadList);
+    lv_obj_set_size(footer, lv_pct(100), 42);
+    lv_obj_set_style_bg_opa(footer, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(footer, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(footer, 0, LV_PART_MAIN);
+
+    static constexpr int kFooterBtnW = 100;
+    static constexpr int kFooterBtnH = 32;
+    static constexpr int kFooterGap = 6;
+
+    lv_obj_t *demoBtn1 = lv_button_create(footer);
+    lv_obj_set_size(demoBtn1, kFooterBtnW, kFooterBtnH);
+    lv_obj_align(demoBtn1, LV_ALIGN_LEFT_MID, 6, 0);
+    stylePurpleButton(demoBtn1);
+    lv_obj_set_style_border_width(demoBtn1, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(demoBtn1, demoNotificationBtnCb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_t *demoBtn1Label = createLabel(demoBtn1, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(demoBtn1Label, "Notify");
+    lv_obj_center(demoBtn1Label);
+
+    lv_obj_t *demoBtn2 = lv_button_create(footer);
+    lv_obj_set_size(demoBtn2, kFooterBtnW, kFooterBtnH);
+    lv_obj_align_to(demoBtn2, demoBtn1, LV_ALIGN_OUT_RIGHT_MID, kFooterGap, 0);
+    stylePurpleButton(demoBtn2);
+    lv_obj_set_style_border_width(demoBtn2, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(demoBtn2, demoDeadline45BtnCb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_t *demoBtn2Label = createLabel(demoBtn2, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(demoBtn2Label, "45m");
+    lv_obj_center(demoBtn2Label);
+
+    lv_obj_t *demoBtn3 = lv_button_create(footer);
+    lv_obj_set_size(demoBtn3, kFooterBtnW, kFooterBtnH);
+    lv_obj_align_to(demoBtn3, demoBtn2, LV_ALIGN_OUT_RIGHT_MID, kFooterGap, 0);
+    stylePurpleButton(demoBtn3);
+    lv_obj_set_style_border_width(demoBtn3, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(demoBtn3, demoDeadline7BtnCb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_t *demoBtn3Label = createLabel(demoBtn3, &lv_font_montserrat_14, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(demoBtn3Label, "7m");
+    lv_obj_center(demoBtn3Label);
+}
+
+// Refreshes only rebind the pooled rows (text, colour, visibility); nothing is
+// allocated and the list keeps its scroll position.
+static void refreshEventsList(const UiRuntimeState &runtime) {
+    if (!ui.eventsList) {
+        return;
+    }
+    const uint32_t startUs = micros();
+    uiSetHidden(ui.eventsEmpty, runtime.recentEventCount != 0);
+
+    for (size_t slot = 0; slot < kMaxUiEvents; ++slot) {
+        UiEventRowWidgets &w = ui.eventRows[slot];
+        if (slot >= runtime.recentEventCount) {
+            uiSetHidden(w.row, true);
+            continue;
+        }
+        // Newest first.
+        const UiEventItem &e = runtime.recentEvents[(runtime.recentEventCount - 1) - slot];
+        char leftBuf[48];
+        snprintf(leftBuf, sizeof(leftBuf), "%s %s", e.icon, e.player);
+        uiSetText(w.left, leftBuf);
+        char rightBuf[16];
+        snprintf(rightBuf, sizeof(rightBuf), "%+d", e.delta);
+        uiSetText(w.right, rightBuf);
+        uiSetTextColor(w.right, e.delta >= 0 ? kColorAccentGreen : kColorAccentRed);
+        uiSetHidden(w.row, false);
+    }
+    Serial.printf("[UI] events list rebind: %u rows in %luus\n", static_cast<unsigned>(runtime.recentEventCount),
+                  static_cast<unsigned long>(micros() - startUs));
+}
+
+static void refreshSquadList(const UiRuntimeState &runtime) {
+    if (!ui.squadList) {
+        return;
+    }
+    const uint32_t startUs = micros();
+    for (size_t slot = 0; slot < kMaxSquadRows; ++slot) {
+        UiSquadRowWidgets &w = ui.squadRows[slot];
+        if (slot >= runtime.squadCount) {
+            uiSetHidden(w.row, true);
+            continue;
+        }
+        const UiSquadRow &rowData = runtime.squadRows[slot];
+        char nameBuf[48];
+        snprintf(nameBuf, sizeof(nameBuf), "%s%s%s", rowData.player, rowData.isCaptain ? " C" : "",
+                 rowData.isViceCaptain ? " V" : "");
+        uiSetText(w.name, nameBuf);
+        uiSetTextColor(w.name, rowData.isBench ? kColorTextSecondary : kColorTextPrimary);
+        uiSetText(w.breakdown, rowData.breakdown);
+
+        char ptsBuf[12];
+        if (rowData.hasPlayed) {
+            snprintf(ptsBuf, sizeof(ptsBuf), "%d", rowData.points);
+        } else {
+            strlcpy(ptsBuf, "-", sizeof(ptsBuf));
+        }
+        uiSetText(w.points, ptsBuf);
+        uiSetHidden(w.row, false);
+    }
+    Serial.printf("[UI] squad list rebind: %u rows in %luus\n", static_cast<unsigned>(runtime.squadCount),
+                  static_cast<unsigned long>(micros() - startUs));
+}
+
+static void backFromEventsCb(lv_event_t *) {
+    loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+}
+
+static void backFromSquadCb(lv_event_t *) {
+    loadMode(UiMode::Live, LV_SCR_LOAD_ANIM_MOVE_TOP);
+}
+
+static void showEventsEventCb(lv_event_t *) {
+    loadMode(UiMode::EventsList, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+}
+
+static void showSquadFromHold(void) {
+    loadMode(UiMode::Squad, LV_SCR_LOAD_ANIM_MOVE_BOTTOM);
+    holdTriggered = true;
+    if (ui.liveHoldArc) {
+        lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
+        lv_arc_set_value(ui.liveHoldArc, 0);
+    }
+}
+
+static void livePressEventCb(lv_event_t *e) {
+    const lv_event_code_t code = lv_event_get_code(e);
+    if (ui.liveTickerBtn) {
+        lv_indev_t *indev = lv_indev_active();
+        if (indev) {
+            lv_point_t p;
+            lv_indev_get_point(indev, &p);
+            lv_area_t tickerArea;
+            lv_obj_get_coords(ui.liveTickerBtn, &tickerArea);
+            const bool inTicker = (p.x >= tickerArea.x1 && p.x <= tickerArea.x2 && p.y >= tickerArea.y1 && p.y <= tickerArea.y2);
+            if (inTicker) {
+                return;
+            }
+        }
+    }
+
+    if (code == LV_EVENT_PRESSED) {
+        holdStartMs = millis();
+        holdTriggered = false;
+        if (ui.liveHoldArc) {
+            lv_obj_remove_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
+            lv_arc_set_value(ui.liveHoldArc, 0);
+        }
+    } else if (code == LV_EVENT_PRESSING) {
+        if (holdStartMs == 0 || holdTriggered || !ui.liveHoldArc) {
+            return;
+        }
+        const uint32_t elapsed = millis() - holdStartMs;
+        int progress = static_cast<int>((elapsed * 100U) / 3000U);
+        if (progress > 100) {
+            progress = 100;
+        }
+        lv_arc_set_value(ui.liveHoldArc, progress);
+        if (elapsed >= 3000U) {
+            showSquadFromHold();
+        }
+    } else if (code == LV_EVENT_RELEASED || code == LV_EVENT_PRESS_LOST) {
+        holdStartMs = 0;
+        if (!holdTriggered && ui.liveHoldArc) {
+            lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
+            lv_arc_set_value(ui.liveHoldArc, 0);
+        }
+        holdTriggered = false;
+    }
+}
+
+static lv_obj_t *createOverlayListScreen(lv_obj_t *screen, const char *title, lv_event_cb_t backCb) {
+    static constexpr int kPanelX = 340;
+    static constexpr int kPanelY = 340;
+    static constexpr int kPanelTop = 22;
+    static constexpr int kListW = 324;
+    static constexpr int kListH = 286;
+    static constexpr int kChordY = (kPanelTop + kPanelY) - 1;
+
+    lv_obj_t *panel = lv_obj_create(screen);
+    lv_obj_set_size(panel, kPanelX, kPanelY);
+    lv_obj_align(panel, LV_ALIGN_TOP_MID, 0, kPanelTop);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(panel, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(panel, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
+    lv_obj_set_style_radius(panel, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(panel, 0, LV_PART_MAIN);
+
+    lv_obj_t *titleLabel = createLabel(panel, kFontCaption, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(titleLabel, title);
+    lv_obj_align(titleLabel, LV_ALIGN_TOP_MID, 0, 10);
+
+    lv_obj_t *list = lv_obj_create(panel);
+    lv_obj_set_size(list, kListW, kListH);
+    lv_obj_align(list, LV_ALIGN_TOP_MID, 0, 42);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_bg_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(list, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(list, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_row(list, 2, LV_PART_MAIN);
+
+    lv_obj_t *chordLine = lv_obj_create(screen);
+    lv_obj_set_size(chordLine, kPanelX, 2);
+    lv_obj_align(chordLine, LV_ALIGN_TOP_MID, 0, kChordY);
+    lv_obj_set_style_bg_color(chordLine, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(chordLine, LV_OPA_70, LV_PART_MAIN);
+    lv_obj_set_style_border_width(chordLine, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(chordLine, 0, LV_PART_MAIN);
+
+    lv_obj_t *back = lv_button_create(screen);
+    lv_obj_set_size(back, kPanelX, kUiScreenHeight - kChordY);
+    lv_obj_align(back, LV_ALIGN_TOP_MID, 0, kChordY);
+    lv_obj_set_style_radius(back, 0, LV_PART_MAIN);
+    stylePurpleButton(back);
+    lv_obj_set_style_border_width(back, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(back, backCb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_t *backLabel = createLabel(back, &lv_font_montserrat_32, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(backLabel, "<");
+    lv_obj_center(backLabel);
+
+    lv_obj_move_foreground(chordLine);
+    lv_obj_move_foreground(back);
+    return list;
+}
+
+void createUi(const UiScreenHooks &screenHooks) {
+    ui = UiWidgets();
+    hooks = screenHooks;
+    ui.screenIdle = lv_obj_create(nullptr);
+    ui.screenDeadline = lv_obj_create(nullptr);
+    ui.screenFinalHour = lv_obj_create(nullptr);
+    ui.screenLive = lv_obj_create(nullptr);
+    ui.screenPopup = lv_obj_create(nullptr);
+    ui.screenEvents = lv_obj_create(nullptr);
+    ui.screenSquad = lv_obj_create(nullptr);
+
+    styleScreen(ui.screenIdle, kColorBgDeep);
+    styleScreen(ui.screenDeadline, kColorBgDeep);
+    styleScreen(ui.screenFinalHour, 0x0C0B14);
+    styleScreen(ui.screenLive, kColorBgDeep);
+    styleScreen(ui.screenPopup, kColorBgDeep);
+    styleScreen(ui.screenEvents, kColorBgDeep);
+    styleScreen(ui.screenSquad, kColorBgDeep);
+
+    lv_obj_t *idleRing = lv_arc_create(ui.screenIdle);
+    lv_obj_set_size(idleRing, 340, 340);
+    lv_obj_center(idleRing);
+    lv_obj_set_style_arc_color(idleRing, lv_color_hex(kColorBgSurface), LV_PART_MAIN);
+    lv_obj_set_style_arc_opa(idleRing, LV_OPA_30, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(idleRing, 1, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(idleRing, 0, LV_PART_INDICATOR);
+    lv_obj_remove_style(idleRing, nullptr, LV_PART_KNOB);
+    lv_obj_remove_flag(idleRing, LV_OBJ_FLAG_CLICKABLE);
+
+    ui.idleRankArrow = createLabel(ui.screenIdle, kFontBody, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.idleRankArrow, LV_ALIGN_CENTER, -68, -48);
+    ui.idleRankValue = createLabel(ui.screenIdle, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.idleRankValue, LV_ALIGN_CENTER, 16, -48);
+    ui.idleGwPoints = createLabel(ui.screenIdle, &lv_font_montserrat_26, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.idleGwPoints, LV_ALIGN_CENTER, 0, 36);
+    ui.idleTotalPoints = createLabel(ui.screenIdle, kFontCaption, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.idleTotalPoints, LV_ALIGN_CENTER, 0, 78);
+    ui.statusLabel = createLabel(ui.screenIdle, kFontMicro, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.statusLabel, LV_ALIGN_BOTTOM_MID, 0, -22);
+
+    ui.deadlineLabel = createLabel(ui.screenDeadline, &lv_font_montserrat_28, kColorAccentAmber, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_text(ui.deadlineLabel, "DEADLINE");
+    lv_obj_align(ui.deadlineLabel, LV_ALIGN_CENTER, 0, -110);
+    ui.deadlineCountdown = createLabel(ui.screenDeadline, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.deadlineCountdown, LV_ALIGN_CENTER, 0, -20);
+    ui.deadlineMeta = createLabel(ui.screenDeadline, &lv_font_montserrat_22, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.deadlineMeta, LV_ALIGN_CENTER, 0, 84);
+
+    ui.finalCountdown = createLabel(ui.screenFinalHour, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_center(ui.finalCountdown);
+
+    ui.liveTitle = createLabel(ui.screenLive, &lv_font_montserrat_16, kColorAccentCyan, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.liveTitle, LV_ALIGN_TOP_MID, 0, 24);
+    ui.liveDot = lv_obj_create(ui.screenLive);
+    lv_obj_set_size(ui.liveDot, 8, 8);
+    lv_obj_align(ui.liveDot, LV_ALIGN_TOP_MID, 84, 30);
+    lv_obj_set_style_radius(ui.liveDot, LV_RADIUS_CIRCLE, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(ui.liveDot, lv_color_hex(kColorAccentCyan), LV_PART_MAIN);
+    lv_obj_set_style_border_width(ui.liveDot, 0, LV_PART_MAIN);
+    ui.livePoints = createLabel(ui.screenLive, kFontHero, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.livePoints, LV_ALIGN_CENTER, 0, -46);
+    ui.liveRank = createLabel(ui.screenLive, &lv_font_montserrat_26, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.liveRank, LV_ALIGN_CENTER, 0, 26);
+    static constexpr int kLiveEventsTopY = static_cast<int>(kUiScreenHeight) - 116;
+    lv_obj_t *liveEventsLine = lv_obj_create(ui.screenLive);
+    lv_obj_set_size(liveEventsLine, kUiScreenWidth, 2);
+    lv_obj_align(liveEventsLine, LV_ALIGN_TOP_MID, 0, kLiveEventsTopY);
+    lv_obj_set_style_bg_color(liveEventsLine, lv_color_hex(kColorButtonPurple), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(liveEventsLine, LV_OPA_70, LV_PART_MAIN);
+    lv_obj_set_style_border_width(liveEventsLine, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(liveEventsLine, 0, LV_PART_MAIN);
+
+    ui.liveTickerBtn = lv_button_create(ui.screenLive);
+    lv_obj_set_size(ui.liveTickerBtn, kUiScreenWidth, static_cast<int>(kUiScreenHeight) - kLiveEventsTopY);
+    lv_obj_align(ui.liveTickerBtn, LV_ALIGN_TOP_MID, 0, kLiveEventsTopY);
+    stylePurpleButton(ui.liveTickerBtn);
+    lv_obj_set_style_radius(ui.liveTickerBtn, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(ui.liveTickerBtn, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(ui.liveTickerBtn, showEventsEventCb, LV_EVENT_CLICKED, nullptr);
+    ui.liveTickerLabel = createLabel(ui.liveTickerBtn, kFontBody, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.liveTickerLabel, LV_ALIGN_TOP_MID, 0, 10);
+    ui.liveHoldArc = lv_arc_create(ui.screenLive);
+    lv_obj_set_size(ui.liveHoldArc, 360, 360);
+    lv_obj_center(ui.liveHoldArc);
+    lv_arc_set_range(ui.liveHoldArc, 0, 100);
+    lv_obj_set_style_arc_width(ui.liveHoldArc, 4, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(ui.liveHoldArc, lv_color_hex(kColorAccentCyan), LV_PART_INDICATOR);
+    lv_obj_set_style_arc_width(ui.liveHoldArc, 0, LV_PART_MAIN);
+    lv_obj_remove_style(ui.liveHoldArc, nullptr, LV_PART_KNOB);
+    lv_obj_remove_flag(ui.liveHoldArc, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(ui.liveHoldArc, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESSED, nullptr);
+    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESSING, nullptr);
+    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_RELEASED, nullptr);
+    lv_obj_add_event_cb(ui.screenLive, livePressEventCb, LV_EVENT_PRESS_LOST, nullptr);
+
+    ui.popupTitle = createLabel(ui.screenPopup, kFontLarge, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.popupTitle, LV_ALIGN_CENTER, 0, -140);
+    ui.popupKit = lv_image_create(ui.screenPopup);
+    lv_obj_set_size(ui.popupKit, kKitWidth, kKitHeight);
+    lv_obj_add_flag(ui.popupKit, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_align(ui.popupKit, LV_ALIGN_CENTER, 0, -24);
+    ui.popupPlayer = createLabel(ui.screenPopup, kFontLarge, kColorTextPrimary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.popupPlayer, LV_ALIGN_CENTER, 0, 68);
+    ui.popupDelta = createLabel(ui.screenPopup, &lv_font_montserrat_28, kColorAccentGreen, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.popupDelta, LV_ALIGN_CENTER, 0, 118);
+    ui.popupTotal = createLabel(ui.screenPopup, kFontBody, kColorTextSecondary, LV_TEXT_ALIGN_CENTER);
+    lv_obj_align(ui.popupTotal, LV_ALIGN_CENTER, 0, 154);
+
+    ui.eventsList = createOverlayListScreen(ui.screenEvents, "EVENTS", backFromEventsCb);
+    ui.squadList = createOverlayListScreen(ui.screenSquad, "MY SQUAD", backFromSquadCb);
+    createEventsListPool();
+    createSquadListPool();
+
+    lv_screen_load(ui.screenIdle);
+    currentMode = UiMode::Idle;
+}
+
+UiMode determineAutoMode(const SharedUiState &state) {
+    if (currentMode == UiMode::EventsList || currentMode == UiMode::Squad || currentMode == UiMode::EventPopup) {
+        return currentMode;
+    }
+    if (state.isLiveGw) {
+        return UiMode::Live;
+    }
+    if (!state.hasNextDeadline || state.nextDeadlineUtc <= 0) {
+        return UiMode::Idle;
+    }
+    const time_t now = time(nullptr);
+    if (now <= 100000) {
+        return UiMode::Idle;
+    }
+    const int64_t diff = static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now);
+    if (diff <= 3600) {
+        return UiMode::FinalHour;
+    }
+    if (diff <= 6 * 3600) {
+        return UiMode::Deadline;
+    }
+    return UiMode::Idle;
+}
+
+static int64_t secondsUntilDeadline(const SharedUiState &state) {
+    const time_t now = time(nullptr);
+    const int64_t sec = now > 100000 ? (static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now)) : 0;
+    return sec < 0 ? 0 : sec;
+}
+
+static void updateIdleScreen(const SharedUiState &state) {
+    char buf[96];
+
+    if (ui.statusLabel) {
+        if (state.isStale && state.hasGwPoints) {
+            snprintf(buf, sizeof(buf), "[stale] %s", state.statusText);
+            uiSetText(ui.statusLabel, buf);
+        } else {
+            uiSetText(ui.statusLabel, state.statusText);
+        }
+        uiSetTextColor(ui.statusLabel, state.statusColor);
+    }
+
+    if (ui.idleRankArrow && ui.idleRankValue) {
+        if (!state.hasRankData) {
+            uiSetText(ui.idleRankArrow, "-");
+            uiSetText(ui.idleRankValue, "--");
+            uiSetTextColor(ui.idleRankArrow, kColorTextSecondary);
+        } else {
+            uiSetText(ui.idleRankArrow, state.rankDiff > 0 ? "^" : (state.rankDiff < 0 ? "v" : "-"));
+            uiSetTextColor(ui.idleRankArrow, state.rankDiff > 0 ? kColorAccentGreen :
+                                             (state.rankDiff < 0 ? kColorAccentRed : kColorTextSecondary));
+            formatNumberWithCommas(state.overallRank, buf, sizeof(buf));
+            uiSetText(ui.idleRankValue, buf);
+        }
+    }
+
+    if (ui.idleGwPoints) {
+        snprintf(buf, sizeof(buf), "GW%d: %d pts", state.currentGw, state.gwPoints);
+        uiSetText(ui.idleGwPoints, buf);
+    }
+    if (ui.idleTotalPoints) {
+        if (state.hasTotalPoints) {
+            char totalBuf[24];
+            formatNumberWithCommas(state.totalPoints, totalBuf, sizeof(totalBuf));
+            snprintf(buf, sizeof(buf), "%s total pts", totalBuf);
+        } else {
+            strlcpy(buf, "-- total pts", sizeof(buf));
+        }
+        uiSetText(ui.idleTotalPoints, buf);
+    }
+}
+
+static void updateDeadlineScreen(const SharedUiState &state) {
+    static int64_t renderedSec = -1;
+    static bool renderedColon = false;
+    char buf[96];
+
+    if (!ui.deadlineCountdown || !state.hasNextDeadline) {
+        return;
+    }
+    if (millis() - lastDeadlineBlinkMs >= 500) {
+        deadlineColonVisible = !deadlineColonVisible;
+        lastDeadlineBlinkMs = millis();
+    }
+    // Reformat only on a second or blink boundary.
+    const int64_t sec = secondsUntilDeadline(state);
+    if (sec != renderedSec || deadlineColonVisible != renderedColon) {
+        renderedSec = sec;
+        renderedColon = deadlineColonVisible;
+        const int hours = static_cast<int>(sec / 3600);
+        const int mins = static_cast<int>((sec % 3600) / 60);
+        const int secs = static_cast<int>(sec % 60);
+        snprintf(buf, sizeof(buf), "%02d%c%02d%c%02d", hours, deadlineColonVisible ? ':' : ' ', mins,
+                 deadlineColonVisible ? ':' : ' ', secs);
+        uiSetText(ui.deadlineCountdown, buf);
+    }
+    snprintf(buf, sizeof(buf), "Gameweek %d", state.hasNextGw ? state.nextGw : 0);
+    uiSetText(ui.deadlineMeta, buf);
+}
+
+static void updateFinalHourScreen(const SharedUiState &state) {
+    static int64_t renderedSec = -1;
+
+    if (!ui.finalCountdown || !state.hasNextDeadline) {
+        return;
+    }
+    int64_t sec = secondsUntilDeadline(state);
+    if (sec > 3600) {
+        sec = 3600;
+    }
+    if (sec == renderedSec) {
+        return;
+    }
+    renderedSec = sec;
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%02d:%02d", static_cast<int>(sec / 60), static_cast<int>(sec % 60));
+    uiSetText(ui.finalCountdown, buf);
+}
+
+static void updateLiveScreen(const SharedUiState &state, const UiRuntimeState &runtime) {
+    char buf[96];
+
+    if (ui.liveTitle) {
+        snprintf(buf, sizeof(buf), "GW%d LIVE", state.currentGw);
+        uiSetText(ui.liveTitle, buf);
+    }
+    if (ui.livePoints) {
+        snprintf(buf, sizeof(buf), "%d\npoints", state.gwPoints);
+        uiSetText(ui.livePoints, buf);
+    }
+    if (ui.liveRank) {
+        if (state.hasRankData) {
+            char rankBuf[24];
+            formatNumberWithCommas(state.overallRank, rankBuf, sizeof(rankBuf));
+            snprintf(buf, sizeof(buf), "%s %s", state.rankDiff >= 0 ? "^" : "v", rankBuf);
+            uiSetText(ui.liveRank, buf);
+            uiSetTextColor(ui.liveRank, state.rankDiff >= 0 ? kColorAccentGreen : kColorAccentRed);
+        } else {
+            uiSetText(ui.liveRank, "live rank --");
+        }
+    }
+    if (ui.liveDot) {
+        const bool pulseOn = ((millis() / 750U) % 2U) == 0U;
+        uiSetBgColor(ui.liveDot, state.isStale ? kColorAccentAmber : kColorAccentCyan);
+        uiSetBgOpa(ui.liveDot, state.isStale ? LV_OPA_80 : (pulseOn ? LV_OPA_COVER : LV_OPA_30));
+    }
+
+    if (ui.liveTickerLabel) {
+        if (runtime.recentEventCount == 0) {
+            uiSetText(ui.liveTickerLabel, "No events yet");
+        } else {
+            if (millis() - lastTickerRotateMs > 3000U) {
+                tickerEventIndex = (tickerEventIndex + 1) % runtime.recentEventCount;
+                lastTickerRotateMs = millis();
+            }
+            const UiEventItem &e = runtime.recentEvents[(runtime.recentEventCount - 1) - tickerEventIndex];
+            snprintf(buf, sizeof(buf), "%s %s %+d", e.icon, e.player, e.delta);
+            uiSetText(ui.liveTickerLabel, buf);
+        }
+    }
+}
+
+void updateModeUi(const SharedUiState &state, const UiRuntimeState &runtime) {
+    switch (currentMode) {
+        case UiMode::Idle:
+            updateIdleScreen(state);
+            break;
+        case UiMode::Deadline:
+            updateDeadlineScreen(state);
+            break;
+        case UiMode::FinalHour:
+            updateFinalHourScreen(state);
+            break;
+        case UiMode::Live:
+            updateLiveScreen(state, runtime);
+            break;
+        case UiMode::EventsList:
+            if (renderedEventsVersion != runtime.eventVersion) {
+                refreshEventsList(runtime);
+                renderedEventsVersion = runtime.eventVersion;
+            }
+            break;
+        case UiMode::Squad:
+            if (renderedSquadVersion != runtime.squadVersion) {
+                refreshSquadList(runtime);
+                renderedSquadVersion = runtime.squadVersion;
+            }
+            break;
+        case UiMode::EventPopup:
+            break;
+    }
+}
+
+void bindPopupEvent(const UiEventItem &event) {
+    if (ui.popupTitle) {
+        lv_label_set_text(ui.popupTitle, event.label[0] ? event.label : "event");
+        lv_obj_set_style_text_color(ui.popupTitle, lv_color_hex(event.delta >= 0 ? kColorAccentGreen : kColorAccentRed), LV_PART_MAIN);
+    }
+    if (ui.popupPlayer) {
+        lv_label_set_text(ui.popupPlayer, event.player);
+    }
+    if (ui.popupDelta) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%+d pts", event.delta);
+        lv_label_set_text(ui.popupDelta, buf);
+        lv_obj_set_style_text_color(ui.popupDelta, lv_color_hex(event.delta >= 0 ? kColorAccentGreen : kColorAccentRed), LV_PART_MAIN);
+    }
+    if (ui.popupTotal) {
+        char buf[40];
+        snprintf(buf, sizeof(buf), "%d -> %d total", event.totalBefore, event.totalAfter);
+        lv_label_set_text(ui.popupTotal, buf);
+    }
+    if (ui.popupKit) {
+        const lv_image_dsc_t *kit = hooks.kitImage ? hooks.kitImage(event.team, event.isGk) : nullptr;
+        if (kit) {
+            lv_obj_clear_flag(ui.popupKit, LV_OBJ_FLAG_HIDDEN);
+            lv_image_set_src(ui.popupKit, kit);
+        } else {
+            lv_obj_add_flag(ui.popupKit, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+void fillUiShotEvent(UiEventItem &event, const char *icon, const char *label, const char *player,
+                     const char *team, int delta, int totalBefore) {
+    strlcpy(event.icon, icon, sizeof(event.icon));
+    strlcpy(event.label, label, sizeof(event.label));
+    strlcpy(event.player, player, sizeof(event.player));
+    strlcpy(event.team, team, sizeof(event.team));
+    event.delta = delta;
+    event.totalBefore = totalBefore;
+    event.totalAfter = totalBefore + delta;
+}
+
+// Only the clock still moves: countdowns are relative to now and the live dot pulses.
+void fillUiShotFixture(SharedUiState &state, UiRuntimeState &runtime) {
+    state = SharedUiState();
+    state.gwPoints = 57;
+    state.hasGwPoints = true;
+    state.overallRank = 123456;
+    state.rankDiff = 2345;
+    state.hasRankData = true;
+    state.statusColor = 0x38D39F;
+    strlcpy(state.statusText, "Updated", sizeof(state.statusText));
+    strlcpy(state.gwStateText, "GW live: 12 | next: 13", sizeof(state.gwStateText));
+    state.currentGw = 12;
+    state.nextGw = 13;
+    state.hasNextGw = true;
+    state.nextDeadlineUtc = time(nullptr) + 2 * 86400 + 5 * 3600;
+    state.hasNextDeadline = true;
+    state.isLiveGw = true;
+    state.totalPoints = 734;
+    state.hasTotalPoints = true;
+
+    runtime = UiRuntimeState();
+    fillUiShotEvent(runtime.recentEvents[0], "G", "GOAL!", "Saka", "arsenal", 5, 725);
+    fillUiShotEvent(runtime.recentEvents[1], "A", "ASSIST!", "Palmer", "chelsea", 3, 730);
+    fillUiShotEvent(runtime.recentEvents[2], "S", "SAVES", "Raya", "arsenal", 1, 733);
+    runtime.recentEvents[2].isGk = true;
+    runtime.recentEventCount = 3;
+    runtime.eventVersion = 1;
+
+    static const char *const kPlayers[] = {"Raya", "Gabriel", "Saliba", "Gvardiol", "Robinson", "Saka", "Palmer",
+                                           "Salah", "Mbeumo", "Haaland", "Isak", "Verbruggen", "Gusto", "Kerkez",
+                                           "Wissa"};
+    static const char *const kTeams[] = {"arsenal", "arsenal", "arsenal", "man_city", "fulham", "arsenal",
+                                         "chelsea", "liverpool", "brentford", "man_city", "newcastle", "brighton",
+                                         "chelsea", "bournemouth", "brentford"};
+    for (size_t i = 0; i < 15; ++i) {
+        UiSquadRow &row = runtime.squadRows[i];
+        strlcpy(row.player, kPlayers[i], sizeof(row.player));
+        strlcpy(row.team, kTeams[i], sizeof(row.team));
+        row.points = static_cast<int>((i * 7) % 13);
+        row.hasPlayed = i < 13;
+        row.isCaptain = i == 9;
+        row.isViceCaptain = i == 7;
+        row.isBench = i >= 11;
+        row.isGk = i == 0 || i == 11;
+        if (row.hasPlayed) {
+            snprintf(row.breakdown, sizeof(row.breakdown), "90' %+d", row.points - 2);
+        } else {
+            strlcpy(row.breakdown, "-", sizeof(row.breakdown));
+        }
+    }
+    runtime.squadCount = 15;
+    runtime.squadVersion = 1;
+}
+
+static uint32_t msUntilNextWallSecond() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return 1000U - static_cast<uint32_t>(tv.tv_usec / 1000) + 1U;
+}
+
+// Seconds until determineAutoMode() would switch idle -> deadline -> final hour.
+static uint32_t msUntilAutoModeChange(const SharedUiState &state) {
+    const time_t now = time(nullptr);
+    if (state.isLiveGw || !state.hasNextDeadline || state.nextDeadlineUtc <= 0 || now <= 100000) {
+        return UINT32_MAX;
+    }
+    const int64_t diff = static_cast<int64_t>(state.nextDeadlineUtc) - static_cast<int64_t>(now);
+    const int64_t untilSec = diff > 6 * 3600 ? diff - 6 * 3600 : (diff > 3600 ? diff - 3600 : -1);
+    if (untilSec < 0 || untilSec > static_cast<int64_t>(UINT32_MAX / 1000U)) {
+        return UINT32_MAX;
+    }
+    return static_cast<uint32_t>(untilSec) * 1000U;
+}
+
+uint32_t msUntilScreenChange(const SharedUiState &state, const UiRuntimeState &runtime, uint32_t nowMs) {
+    uint32_t waitMs = msUntilAutoModeChange(state);
+    auto wakeAt = [&](uint32_t dueMs) {
+        const int32_t dueIn = static_cast<int32_t>(dueMs - nowMs);
+        const uint32_t ms = dueIn > 0 ? static_cast<uint32_t>(dueIn) : 0U;
+        waitMs = ms < waitMs ? ms : waitMs;
+    };
+    auto wakeIn = [&](uint32_t ms) { waitMs = ms < waitMs ? ms : waitMs; };
+
+    switch (currentMode) {
+        case UiMode::Deadline:
+            wakeAt(lastDeadlineBlinkMs + 500U);
+            wakeIn(msUntilNextWallSecond());
+            break;
+        case UiMode::FinalHour:
+            wakeIn(msUntilNextWallSecond());
+            break;
+        case UiMode::Live:
+            wakeAt((nowMs / 750U + 1U) * 750U);  // status dot pulse
+            if (runtime.recentEventCount > 1) {
+                wakeAt(lastTickerRotateMs + 3001U);
+            }
+            break;
+        default:
+            break;
+    }
+    return waitMs;
+}
+
+void resetLiveTicker(uint32_t nowMs) {
+    tickerEventIndex = 0;
+    lastTickerRotateMs = nowMs;
+}
+
+void invalidateUiLists() {
+    renderedEventsVersion = 0;
+    renderedSquadVersion = 0;
+}
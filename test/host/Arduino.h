@@ -0,0 +1,110 @@
+#pragma once
+
+// Host stand-in for the Arduino core calls the hardware-free modules make.
+// millis()/micros() share the FreeRTOS stand-in's clock and the cycle counter
+// runs at a nominal 240 MHz. Serial writes to stdout, so `[SHOT]` and report
+// lines land in `pio test -e native -v` output, and keeps a copy tests can
+// inspect and clear. GPIO calls do nothing.
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+
+inline uint32_t millis() { return static_cast<uint32_t>(fpl_host::nowUs() / 1000U); }
+inline uint32_t micros() { return static_cast<uint32_t>(fpl_host::nowUs()); }
+inline void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define RISING 0x01
+#define FALLING 0x02
+#define digitalPinToInterrupt(pin) (pin)
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void attachInterrupt(uint8_t, void (*)(), int) {}
+inline void detachInterrupt(uint8_t) {}
+
+class EspClass {
+public:
+    uint32_t getCycleCount() { return static_cast<uint32_t>(fpl_host::nowUs() * getCpuFreqMHz()); }
+    uint32_t getCpuFreqMHz() { return 240; }
+};
+
+inline EspClass ESP;
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    const size_t len = strlen(src);
+    if (size) {
+        const size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t *data, size_t len) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        captured_.append(reinterpret_cast<const char *>(data), len);
+        if (echo) {
+            fwrite(data, 1, len, stdout);
+        }
+        return len;
+    }
+    size_t print(const char *text) { return write(reinterpret_cast<const uint8_t *>(text), strlen(text)); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t println(const char *text = "") { return print(text) + print("\n"); }
+    size_t println(long value) { return print(value) + print("\n"); }
+
+    __attribute__((format(printf, 2, 3))) size_t printf(const char *format, ...) {
+        char stackBuf[256];
+        va_list args;
+        va_start(args, format);
+        const int len = vsnprintf(stackBuf, sizeof(stackBuf), format, args);
+        va_end(args);
+        if (len < 0) {
+            return 0;
+        }
+        if (static_cast<size_t>(len) < sizeof(stackBuf)) {
+            return write(reinterpret_cast<const uint8_t *>(stackBuf), len);
+        }
+        std::string big(static_cast<size_t>(len) + 1, '\0');
+        va_start(args, format);
+        vsnprintf(&big[0], big.size(), format, args);
+        va_end(args);
+        return write(reinterpret_cast<const uint8_t *>(big.data()), static_cast<size_t>(len));
+    }
+
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush() { fflush(stdout); }
+
+    // Everything written since the last call.
+    std::string takeCaptured() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string out;
+        out.swap(captured_);
+        return out;
+    }
+
+    bool echo = true;
+
+private:
+    std::mutex mutex_;
+    std::string captured_;
+};
+
+inline HardwareSerial Serial;
@@ -0,0 +1,76 @@
+#pragma once
+
+// Host stand-in for ESP-IDF's capability allocator: every region is the C heap.
+// Tests can make allocations fail to exercise the out-of-memory paths.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MALLOC_CAP_8BIT (1U << 2)
+#define MALLOC_CAP_DMA (1U << 3)
+#define MALLOC_CAP_INTERNAL (1U << 11)
+#define MALLOC_CAP_SPIRAM (1U << 10)
+#define MALLOC_CAP_DEFAULT (1U << 12)
+
+namespace fpl_host {
+
+// Allocations left before heap_caps_malloc starts returning nullptr; negative = unlimited.
+inline long &heapAllocBudget() {
+    static long budget = -1;
+    return budget;
+}
+
+// What heap_caps_get_free_size / get_largest_free_block / get_minimum_free_size report.
+struct HeapReport {
+    size_t freeBytes = 4U * 1024U * 1024U;
+    size_t largestBlock = 2U * 1024U * 1024U;
+    size_t minimumFree = 4U * 1024U * 1024U;
+};
+
+inline HeapReport &heapReport(uint32_t caps) {
+    static HeapReport internal{256U * 1024U, 96U * 1024U, 200U * 1024U};
+    static HeapReport spiram;
+    return (caps & MALLOC_CAP_SPIRAM) ? spiram : internal;
+}
+
+inline bool takeHeapBudget() {
+    long &budget = heapAllocBudget();
+    if (budget == 0) {
+        return false;
+    }
+    if (budget > 0) {
+        budget--;
+    }
+    return true;
+}
+
+}  // namespace fpl_host
+
+inline void *heap_caps_malloc(size_t size, uint32_t) { return fpl_host::takeHeapBudget() ? malloc(size) : nullptr; }
+
+inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    void *p = heap_caps_malloc(n * size, caps);
+    if (p) {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+inline void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t) {
+    if (!fpl_host::takeHeapBudget()) {
+        return nullptr;
+    }
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void *heap_caps_realloc(void *p, size_t size, uint32_t) {
+    return fpl_host::takeHeapBudget() ? realloc(p, size) : nullptr;
+}
+
+inline void heap_caps_free(void *p) { free(p); }
+
+inline size_t heap_caps_get_free_size(uint32_t caps) { return fpl_host::heapReport(caps).freeBytes; }
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return fpl_host::heapReport(caps).largestBlock; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) { return fpl_host::heapReport(caps).minimumFree; }
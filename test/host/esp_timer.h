@@ -0,0 +1,116 @@
+#pragma once
+
+// Host stand-in for esp_timer: the clock is the FreeRTOS stand-in's, and each
+// timer runs its callback on its own thread (ESP_TIMER_TASK dispatch).
+
+#include "freertos/FreeRTOS.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_STATE 0x103
+
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+struct HostEspTimer {
+    esp_timer_cb_t callback = nullptr;
+    void *arg = nullptr;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    uint64_t periodUs = 0;
+    uint64_t generation = 0;  // bumped by every start/stop so a stale run exits
+    bool running = false;
+};
+typedef HostEspTimer *esp_timer_handle_t;
+
+inline int64_t esp_timer_get_time() { return static_cast<int64_t>(fpl_host::nowUs()); }
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    HostEspTimer *timer = new HostEspTimer();
+    timer->callback = args->callback;
+    timer->arg = args->arg;
+    *out = timer;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    std::thread old;
+    bool wasRunning;
+    {
+        std::lock_guard<std::mutex> lock(timer->mutex);
+        wasRunning = timer->running;
+        timer->running = false;
+        timer->generation++;
+        old.swap(timer->thread);
+    }
+    timer->cv.notify_all();
+    if (old.joinable()) {
+        if (old.get_id() == std::this_thread::get_id()) {
+            old.detach();  // stopped from its own callback
+        } else {
+            old.join();
+        }
+    }
+    return wasRunning ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+namespace fpl_host {
+
+inline esp_err_t startEspTimer(esp_timer_handle_t timer, uint64_t firstUs, uint64_t periodUs) {
+    esp_timer_stop(timer);
+    std::lock_guard<std::mutex> lock(timer->mutex);
+    timer->running = true;
+    timer->periodUs = periodUs;
+    const uint64_t generation = ++timer->generation;
+    timer->thread = std::thread([timer, firstUs, generation] {
+        auto due = std::chrono::steady_clock::now() + std::chrono::microseconds(firstUs);
+        std::unique_lock<std::mutex> lock(timer->mutex);
+        while (timer->generation == generation) {
+            if (timer->cv.wait_until(lock, due, [&] { return timer->generation != generation; })) {
+                break;
+            }
+            const uint64_t periodUs = timer->periodUs;
+            if (periodUs == 0) {
+                timer->running = false;
+            }
+            lock.unlock();
+            timer->callback(timer->arg);
+            lock.lock();
+            if (periodUs == 0) {
+                break;
+            }
+            due += std::chrono::microseconds(periodUs);
+        }
+    });
+    return ESP_OK;
+}
+
+}  // namespace fpl_host
+
+inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+    return fpl_host::startEspTimer(timer, periodUs, periodUs);
+}
+
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    return fpl_host::startEspTimer(timer, timeoutUs, 0);
+}
+
+inline esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    esp_timer_stop(timer);
+    delete timer;
+    return ESP_OK;
+}
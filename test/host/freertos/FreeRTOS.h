@@ -0,0 +1,90 @@
+#pragma once
+
+// Host stand-in for the slice of FreeRTOS the firmware uses, built on the C++
+// standard library so modules can run under `pio test -e native`. Ticks are
+// milliseconds; tasks are std::threads; an "ISR" is any thread that calls the
+// FromISR variants.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define errQUEUE_FULL 0
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define portYIELD_FROM_ISR(...) ((void)0)
+#define configGENERATE_RUN_TIME_STATS 0
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+namespace fpl_host {
+
+inline std::chrono::steady_clock::time_point bootTime() {
+    static const std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+    return t;
+}
+
+inline uint64_t nowUs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime()).count());
+}
+
+// Turns a tick timeout into an absolute deadline; portMAX_DELAY waits forever.
+struct Deadline {
+    explicit Deadline(TickType_t ticks)
+        : forever(ticks == portMAX_DELAY),
+          at(std::chrono::steady_clock::now() + std::chrono::milliseconds(forever ? 0 : ticks)) {}
+    template <typename Pred>
+    bool wait(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, Pred pred) const {
+        if (forever) {
+            cv.wait(lock, pred);
+            return true;
+        }
+        return cv.wait_until(lock, at, pred);
+    }
+    bool forever;
+    std::chrono::steady_clock::time_point at;
+};
+
+inline bool &inIsr() {
+    static thread_local bool flag = false;
+    return flag;
+}
+
+}  // namespace fpl_host
+
+inline TickType_t xTaskGetTickCount() { return static_cast<TickType_t>(fpl_host::nowUs() / 1000U); }
+inline TickType_t xTaskGetTickCountFromISR() { return xTaskGetTickCount(); }
+inline BaseType_t xPortInIsrContext() { return fpl_host::inIsr() ? pdTRUE : pdFALSE; }
+inline uint32_t xPortGetCoreID() { return 0; }
+
+// ESP-IDF spinlock critical sections; a mutex is close enough between threads.
+struct HostMux {
+    std::mutex mutex;
+};
+typedef HostMux portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL_SAFE(mux) ((mux)->mutex.lock())
+#define portEXIT_CRITICAL_SAFE(mux) ((mux)->mutex.unlock())
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Fixed-size items copied in and out of a bounded deque; senders and
+// receivers block on the same condition variable.
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::vector<uint8_t>> items;
+    UBaseType_t length = 0;
+    UBaseType_t itemSize = 0;
+};
+typedef HostQueue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    QueueHandle_t queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+inline void vQueueDelete(QueueHandle_t queue) { delete queue; }
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks) {
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (!fpl_host::Deadline(ticks).wait(queue->cv, lock, [queue] { return queue->items.size() < queue->length; })) {
+            return errQUEUE_FULL;
+        }
+        const uint8_t *bytes = static_cast<const uint8_t *>(item);
+        queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    }
+    queue->cv.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *out, TickType_t ticks) {
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (!fpl_host::Deadline(ticks).wait(queue->cv, lock, [queue] { return !queue->items.empty(); })) {
+            return pdFALSE;
+        }
+        memcpy(out, queue->items.front().data(), queue->itemSize);
+        queue->items.pop_front();
+    }
+    queue->cv.notify_all();
+    return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->items.size());
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Binary, counting and (non-recursive) mutex semaphores share one counter.
+struct HostSemaphore {
+    std::mutex mutex;
+    std::condition_variable cv;
+    UBaseType_t count = 0;
+    UBaseType_t max = 1;
+};
+typedef HostSemaphore *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+    SemaphoreHandle_t sem = new HostSemaphore();
+    sem->max = max;
+    sem->count = initial;
+    return sem;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return xSemaphoreCreateCounting(1, 0); }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return xSemaphoreCreateCounting(1, 1); }
+
+inline void vSemaphoreDelete(SemaphoreHandle_t sem) { delete sem; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sem->mutex);
+    if (!fpl_host::Deadline(ticks).wait(sem->cv, lock, [sem] { return sem->count > 0; })) {
+        return pdFALSE;
+    }
+    sem->count--;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    {
+        std::lock_guard<std::mutex> lock(sem->mutex);
+        if (sem->count >= sem->max) {
+            return pdFALSE;
+        }
+        sem->count++;
+    }
+    sem->cv.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken) {
+    const BaseType_t given = xSemaphoreGive(sem);
+    if (woken && given) {
+        *woken = pdTRUE;
+    }
+    return given;
+}
+
+inline BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t sem, BaseType_t *) { return xSemaphoreTake(sem, 0); }
+
+inline UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem) {
+    std::lock_guard<std::mutex> lock(sem->mutex);
+    return sem->count;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Tasks run as detached std::threads. Each handle carries a notification
+// counter; the calling thread gets a handle on first use so the test's main
+// thread can wait on notifications too.
+struct HostTask {
+    char name[16] = "";
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notifyCount = 0;
+    // Reported by uxTaskGetStackHighWaterMark; tests set it to simulate usage.
+    std::atomic<UBaseType_t> stackHighWater{0};
+    UBaseType_t stackDepth = 0;
+};
+typedef HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+namespace fpl_host {
+
+inline TaskHandle_t &currentTask() {
+    static thread_local TaskHandle_t task = nullptr;
+    return task;
+}
+
+}  // namespace fpl_host
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    TaskHandle_t &task = fpl_host::currentTask();
+    if (!task) {
+        task = new HostTask();
+        strncpy(task->name, "host", sizeof(task->name) - 1);
+    }
+    return task;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg,
+                                          UBaseType_t, TaskHandle_t *out, BaseType_t) {
+    TaskHandle_t task = new HostTask();
+    strncpy(task->name, name ? name : "", sizeof(task->name) - 1);
+    task->stackDepth = stackDepth;
+    task->stackHighWater = stackDepth;
+    if (out) {
+        *out = task;
+    }
+    std::thread([fn, arg, task]() {
+        fpl_host::currentTask() = task;
+        fn(arg);
+    }).detach();
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg,
+                              UBaseType_t prio, TaskHandle_t *out) {
+    return xTaskCreatePinnedToCore(fn, name, stackDepth, arg, prio, out, tskNO_AFFINITY);
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline void taskYIELD() { std::this_thread::yield(); }
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifyCount++;
+    }
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken) {
+    xTaskNotifyGive(task);
+    if (woken) {
+        *woken = pdTRUE;
+    }
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    fpl_host::Deadline(ticks).wait(task->cv, lock, [task] { return task->notifyCount > 0; });
+    const uint32_t value = task->notifyCount;
+    if (value > 0) {
+        task->notifyCount = clearOnExit ? 0 : value - 1;
+    }
+    return value;
+}
+
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return (task ? task : xTaskGetCurrentTaskHandle())->stackHighWater.load();
+}
+
+inline const char *pcTaskGetName(TaskHandle_t task) { return (task ? task : xTaskGetCurrentTaskHandle())->name; }
@@ -0,0 +1,223 @@
+#include <unity.h>
+
+#include <cstring>
+#include <new>
+
+#include "boot_snapshot.h"
+
+namespace {
+
+SharedUiState gState;
+UiRuntimeState gRuntime;
+
+void fillUiState(SharedUiState &state) {
+    state.gwPoints = 67;
+    state.hasGwPoints = true;
+    state.overallRank = 123456;
+    state.rankDiff = -2500;
+    state.hasRankData = true;
+    state.statusColor = 0x66FF99;
+    strncpy(state.statusText, "Updated 12:01", sizeof(state.statusText) - 1);
+    strncpy(state.gwStateText, "GW live: 12 | next: 13", sizeof(state.gwStateText) - 1);
+    state.nextGw = 13;
+    state.hasNextGw = true;
+    state.nextDeadlineUtc = 1760000000;
+    state.hasNextDeadline = true;
+    state.isLiveGw = true;
+    state.currentGw = 12;
+    state.totalPoints = 812;
+    state.hasTotalPoints = true;
+    state.isStale = true;
+    state.lastApiUpdateMs = 4242;
+    state.version = 17;
+}
+
+void fillSquadRow(size_t i, UiSquadRow &row) {
+    snprintf(row.player, sizeof(row.player), "Player %u", static_cast<unsigned>(i));
+    snprintf(row.team, sizeof(row.team), "T%u", static_cast<unsigned>(i % 5));
+    snprintf(row.breakdown, sizeof(row.breakdown), "G%u A%u", static_cast<unsigned>(i % 3),
+             static_cast<unsigned>(i % 2));
+    row.points = static_cast<int>(i * 3) - 2;
+    row.hasPlayed = (i % 4) != 0;
+    row.isCaptain = i == 3;
+    row.isViceCaptain = i == 4;
+    row.isBench = i >= 11;
+    row.isGk = i == 0;
+}
+
+void fillFixture() {
+    gState = SharedUiState{};
+    fillUiState(gState);
+    gRuntime = UiRuntimeState{};
+    gRuntime.squadCount = 15;
+    for (size_t i = 0; i < gRuntime.squadCount; ++i) {
+        fillSquadRow(i, gRuntime.squadRows[i]);
+    }
+}
+
+// Re-seals a hand-edited image so only the field under test is wrong.
+void reseal(BootSnapshot &snap) {
+    snap.crc = crc32Update(0, reinterpret_cast<const uint8_t *>(&snap), offsetof(BootSnapshot, crc));
+}
+
+}  // namespace
+
+void setUp() { fillFixture(); }
+void tearDown() {}
+
+void test_crc32_matches_ieee_check_value() {
+    const char *check = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32Update(0, reinterpret_cast<const uint8_t *>(check), 9));
+    // Continuing a running CRC gives the same result as one pass.
+    const uint32_t head = crc32Update(0, reinterpret_cast<const uint8_t *>(check), 4);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32Update(head, reinterpret_cast<const uint8_t *>(check + 4), 5));
+}
+
+void test_round_trip_keeps_content_and_drops_volatile_fields() {
+    BootSnapshot snap;
+    encodeBootSnapshot(gState, gRuntime, snap);
+
+    BootSnapshot back;
+    TEST_ASSERT_TRUE(decodeBootSnapshot(reinterpret_cast<const uint8_t *>(&snap), sizeof(snap), back));
+    TEST_ASSERT_EQUAL_HEX32(kBootSnapshotMagic, back.magic);
+    TEST_ASSERT_EQUAL_UINT16(kBootSnapshotVersion, back.version);
+    TEST_ASSERT_EQUAL_INT(67, back.ui.gwPoints);
+    TEST_ASSERT_EQUAL_INT(123456, back.ui.overallRank);
+    TEST_ASSERT_EQUAL_INT(-2500, back.ui.rankDiff);
+    TEST_ASSERT_EQUAL_INT(12, back.ui.currentGw);
+    TEST_ASSERT_EQUAL_INT(812, back.ui.totalPoints);
+    TEST_ASSERT_TRUE(back.ui.nextDeadlineUtc == gState.nextDeadlineUtc);
+    TEST_ASSERT_EQUAL_STRING(gState.gwStateText, back.ui.gwStateText);
+    TEST_ASSERT_EQUAL_STRING("", back.ui.statusText);
+    TEST_ASSERT_FALSE(back.ui.isStale);
+    TEST_ASSERT_EQUAL_UINT32(0, back.ui.lastApiUpdateMs);
+    TEST_ASSERT_EQUAL_UINT32(0, back.ui.version);
+
+    TEST_ASSERT_EQUAL_UINT32(15, back.squadCount);
+    for (size_t i = 0; i < back.squadCount; ++i) {
+        TEST_ASSERT_EQUAL_STRING(gRuntime.squadRows[i].player, back.squadRows[i].player);
+        TEST_ASSERT_EQUAL_STRING(gRuntime.squadRows[i].breakdown, back.squadRows[i].breakdown);
+        TEST_ASSERT_EQUAL_INT(gRuntime.squadRows[i].points, back.squadRows[i].points);
+        TEST_ASSERT_EQUAL(gRuntime.squadRows[i].isBench, back.squadRows[i].isBench);
+    }
+}
+
+void test_encode_is_deterministic_across_volatile_changes() {
+    BootSnapshot a;
+    BootSnapshot b;
+    encodeBootSnapshot(gState, gRuntime, a);
+    strncpy(gState.statusText, "Updating...", sizeof(gState.statusText) - 1);
+    gState.version = 99;
+    gState.lastApiUpdateMs = 1;
+    encodeBootSnapshot(gState, gRuntime, b);
+    // saveBootSnapshot skips the flash write when the CRC is unchanged.
+    TEST_ASSERT_EQUAL_HEX32(a.crc, b.crc);
+    TEST_ASSERT_EQUAL_MEMORY(&a, &b, sizeof(a));
+}
+
+// Same content, different garbage in padding and behind string terminators:
+// the flash image and its CRC must not change.
+void test_encode_ignores_padding_and_stale_text() {
+    BootSnapshot a;
+    encodeBootSnapshot(gState, gRuntime, a);
+
+    // Placement new sets the members but leaves the padding as it was.
+    alignas(SharedUiState) static unsigned char stateBytes[sizeof(SharedUiState)];
+    memset(stateBytes, 0xA5, sizeof(stateBytes));
+    SharedUiState *dirty = new (stateBytes) SharedUiState;
+    fillUiState(*dirty);
+    const size_t textLen = strlen(dirty->gwStateText);
+    memset(dirty->gwStateText + textLen + 1, 'x', sizeof(dirty->gwStateText) - textLen - 1);
+
+    alignas(UiRuntimeState) static unsigned char runtimeBytes[sizeof(UiRuntimeState)];
+    memset(runtimeBytes, 0x5A, sizeof(runtimeBytes));
+    UiRuntimeState *dirtyRuntime = new (runtimeBytes) UiRuntimeState;
+    dirtyRuntime->squadCount = gRuntime.squadCount;
+    for (size_t i = 0; i < gRuntime.squadCount; ++i) {
+        UiSquadRow &row = dirtyRuntime->squadRows[i];
+        memset(row.player, 'y', sizeof(row.player));
+        fillSquadRow(i, row);
+    }
+
+    BootSnapshot b;
+    encodeBootSnapshot(*dirty, *dirtyRuntime, b);
+    TEST_ASSERT_EQUAL_HEX32(a.crc, b.crc);
+    TEST_ASSERT_EQUAL_MEMORY(&a, &b, sizeof(a));
+}
+
+void test_crc_mismatch_is_rejected() {
+    BootSnapshot snap;
+    encodeBootSnapshot(gState, gRuntime, snap);
+    BootSnapshot back;
+
+    snap.squadRows[7].points ^= 1;
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+    TEST_ASSERT_FALSE(decodeBootSnapshot(reinterpret_cast<const uint8_t *>(&snap), sizeof(snap), back));
+
+    snap.squadRows[7].points ^= 1;
+    snap.crc ^= 0x80000000U;
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+}
+
+void test_version_and_layout_mismatch_are_rejected() {
+    BootSnapshot snap;
+    encodeBootSnapshot(gState, gRuntime, snap);
+
+    snap.version = kBootSnapshotVersion + 1;
+    reseal(snap);
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+
+    encodeBootSnapshot(gState, gRuntime, snap);
+    snap.size = static_cast<uint16_t>(sizeof(BootSnapshot) - 4);
+    reseal(snap);
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+
+    encodeBootSnapshot(gState, gRuntime, snap);
+    snap.magic = 0;
+    reseal(snap);
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+
+    encodeBootSnapshot(gState, gRuntime, snap);
+    snap.squadCount = kMaxSquadRows + 1;
+    reseal(snap);
+    TEST_ASSERT_FALSE(decodeBootSnapshot(snap));
+}
+
+void test_truncated_image_is_rejected() {
+    BootSnapshot snap;
+    encodeBootSnapshot(gState, gRuntime, snap);
+    const uint8_t *raw = reinterpret_cast<const uint8_t *>(&snap);
+    BootSnapshot back;
+
+    TEST_ASSERT_FALSE(decodeBootSnapshot(raw, 0, back));
+    TEST_ASSERT_FALSE(decodeBootSnapshot(raw, sizeof(snap) - 1, back));
+    TEST_ASSERT_FALSE(decodeBootSnapshot(raw, offsetof(BootSnapshot, crc), back));
+    TEST_ASSERT_FALSE(decodeBootSnapshot(nullptr, sizeof(snap), back));
+
+    // A torn write: the first half landed, the rest is still erased flash.
+    uint8_t torn[sizeof(BootSnapshot)];
+    memset(torn, 0xFF, sizeof(torn));
+    memcpy(torn, raw, sizeof(torn) / 2);
+    TEST_ASSERT_FALSE(decodeBootSnapshot(torn, sizeof(torn), back));
+}
+
+void test_empty_squad_round_trips() {
+    gRuntime.squadCount = 0;
+    BootSnapshot snap;
+    encodeBootSnapshot(gState, gRuntime, snap);
+    TEST_ASSERT_TRUE(decodeBootSnapshot(snap));
+    TEST_ASSERT_EQUAL_UINT32(0, snap.squadCount);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc32_matches_ieee_check_value);
+    RUN_TEST(test_round_trip_keeps_content_and_drops_volatile_fields);
+    RUN_TEST(test_encode_is_deterministic_across_volatile_changes);
+    RUN_TEST(test_encode_ignores_padding_and_stale_text);
+    RUN_TEST(test_crc_mismatch_is_rejected);
+    RUN_TEST(test_version_and_layout_mismatch_are_rejected);
+    RUN_TEST(test_truncated_image_is_rejected);
+    RUN_TEST(test_empty_squad_round_trips);
+    return UNITY_END();
+}
@@ -0,0 +1,301 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#include "fetch_pipeline.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// The download stage against a mock transport on FPL_FETCH_WORKERS real
+// threads. A job's URL scripts the mock: "ms=<n>" sleeps that long before
+// answering, "hold" blocks until the test releases it, "fail" answers with an
+// error; the body is the URL itself.
+
+namespace {
+
+std::atomic<int> gActive{0};
+std::atomic<int> gMaxActive{0};
+std::atomic<int> gCalls{0};
+
+std::mutex gMockMutex;
+std::condition_variable gReleased;
+int gReleases = 0;
+std::vector<std::string> gStarted;  // URLs in the order the mock saw them
+
+bool mockTransport(const FetchJob &job, char *&bodyOut, size_t &lengthOut) {
+    gCalls++;
+    const int active = ++gActive;
+    int seen = gMaxActive.load();
+    while (active > seen && !gMaxActive.compare_exchange_weak(seen, active)) {
+    }
+    {
+        std::unique_lock<std::mutex> lock(gMockMutex);
+        gStarted.push_back(job.url);
+        if (strstr(job.url, "hold")) {
+            gReleased.wait(lock, [] { return gReleases > 0; });
+            gReleases--;
+        }
+    }
+    const char *ms = strstr(job.url, "ms=");
+    delay(ms ? static_cast<uint32_t>(atoi(ms + 3)) : 0);
+    gActive--;
+    if (strstr(job.url, "fail")) {
+        return false;
+    }
+    lengthOut = strlen(job.url);
+    bodyOut = static_cast<char *>(heap_caps_malloc(lengthOut + 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    memcpy(bodyOut, job.url, lengthOut + 1);
+    return true;
+}
+
+FetchJob makeJob(FetchEndpoint endpoint, const char *url, uint32_t pollId = 1) {
+    FetchJob job = {};
+    job.endpoint = endpoint;
+    job.pollId = pollId;
+    job.maxBytes = 4096;
+    strlcpy(job.url, url, sizeof(job.url));
+    return job;
+}
+
+// Lets one held download finish.
+void releaseOne() {
+    std::lock_guard<std::mutex> lock(gMockMutex);
+    gReleases++;
+    gReleased.notify_all();
+}
+
+// Blocks until the mock has been called `calls` times since setUp.
+void waitForCalls(int calls) {
+    const uint32_t startMs = millis();
+    while (gCalls < calls && millis() - startMs < 1000) {
+        delay(1);
+    }
+    TEST_ASSERT_EQUAL_INT(calls, gCalls.load());
+}
+
+// Both workers parked on a held download, so everything submitted next queues.
+void occupyWorkers() {
+    char url[32];
+    for (int i = 0; i < FPL_FETCH_WORKERS; ++i) {
+        snprintf(url, sizeof(url), "https://mock/hold/%d", i);
+        TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Entry, url)));
+    }
+    waitForCalls(FPL_FETCH_WORKERS);
+}
+
+std::vector<FetchResult> takeResults(int count) {
+    std::vector<FetchResult> results;
+    for (int i = 0; i < count; ++i) {
+        FetchResult result;
+        TEST_ASSERT_TRUE(fetchWaitResult(result, 1000));
+        fetchRelease(result);
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<std::string> startedAfter(size_t first) {
+    std::lock_guard<std::mutex> lock(gMockMutex);
+    return std::vector<std::string>(gStarted.begin() + first, gStarted.end());
+}
+
+}  // namespace
+
+void setUp() {
+    gMaxActive = 0;
+    gCalls = 0;
+    std::lock_guard<std::mutex> lock(gMockMutex);
+    gStarted.clear();
+    gReleases = 0;
+}
+void tearDown() {}
+
+void test_result_carries_the_body_and_timings() {
+    const uint32_t submitMs = millis();
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Entry, "https://mock/entry?ms=20")));
+    FetchResult result;
+    TEST_ASSERT_TRUE(fetchWaitResult(result, 1000));
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::Entry), static_cast<int>(result.endpoint));
+    TEST_ASSERT_EQUAL_STRING("https://mock/entry?ms=20", result.body);
+    TEST_ASSERT_EQUAL_UINT32(strlen("https://mock/entry?ms=20"), result.length);
+    TEST_ASSERT_UINT32_WITHIN(5, submitMs, result.queuedMs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(5, result.startMs - result.queuedMs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(20, result.doneMs - result.startMs);
+    fetchRelease(result);
+    TEST_ASSERT_NULL(result.body);
+}
+
+void test_failed_download_is_reported_without_a_body() {
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::History, "https://mock/history?fail")));
+    FetchResult result;
+    TEST_ASSERT_TRUE(fetchWaitResult(result, 1000));
+    TEST_ASSERT_FALSE(result.ok);
+    TEST_ASSERT_NULL(result.body);
+}
+
+// Two downloads run side by side: the poll pays for the slower one, not the sum.
+void test_downloads_overlap() {
+    const uint32_t startMs = millis();
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Entry, "https://mock/entry?ms=100")));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Live, "https://mock/live?ms=100")));
+    FetchResult a;
+    FetchResult b;
+    TEST_ASSERT_TRUE(fetchWaitResult(a, 1000));
+    TEST_ASSERT_TRUE(fetchWaitResult(b, 1000));
+    const uint32_t totalMs = millis() - startMs;
+    fetchRelease(a);
+    fetchRelease(b);
+    TEST_ASSERT_EQUAL_INT(FPL_FETCH_WORKERS, gMaxActive.load());
+    TEST_ASSERT_LESS_THAN_UINT32(180, totalMs);
+    // Each ran while the other did.
+    TEST_ASSERT_TRUE(static_cast<int32_t>(a.startMs - b.doneMs) < 0 && static_cast<int32_t>(b.startMs - a.doneMs) < 0);
+}
+
+// A fast response is handed over as soon as it lands, while a slow one is
+// still downloading, so the poll can parse it meanwhile.
+void test_fast_response_is_ready_before_the_slow_one_finishes() {
+    const uint32_t startMs = millis();
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Bootstrap, "https://mock/bootstrap?ms=200")));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Live, "https://mock/live?ms=30")));
+    FetchResult first;
+    TEST_ASSERT_TRUE(fetchWaitResult(first, 1000));
+    const uint32_t firstMs = millis() - startMs;
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::Live), static_cast<int>(first.endpoint));
+    TEST_ASSERT_LESS_THAN_UINT32(120, firstMs);
+    fetchRelease(first);
+
+    FetchResult second;
+    TEST_ASSERT_TRUE(fetchWaitResult(second, 1000));
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::Bootstrap), static_cast<int>(second.endpoint));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(200, millis() - startMs);
+    fetchRelease(second);
+}
+
+// Queued work starts by class, then deadline, then age, whatever the submit order.
+void test_queued_jobs_start_most_urgent_first() {
+    occupyWorkers();
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::History, "https://mock/history")));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Bootstrap, "https://mock/bootstrap")));
+    FetchJob picks = makeJob(FetchEndpoint::Picks, "https://mock/picks");
+    picks.deadlineMs = 5000;
+    TEST_ASSERT_TRUE(fetchSubmit(picks));
+    FetchJob entry = makeJob(FetchEndpoint::Entry, "https://mock/entry");
+    entry.deadlineMs = 1000;
+    TEST_ASSERT_TRUE(fetchSubmit(entry));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Live, "https://mock/live")));
+
+    // One worker drains the queue alone, so the start order is the pick order.
+    releaseOne();
+    waitForCalls(FPL_FETCH_WORKERS + 5);
+    const std::vector<std::string> started = startedAfter(FPL_FETCH_WORKERS);
+    const char *const expected[] = {"https://mock/live", "https://mock/entry", "https://mock/picks",
+                                    "https://mock/history", "https://mock/bootstrap"};
+    TEST_ASSERT_EQUAL_UINT32(5, started.size());
+    for (size_t i = 0; i < started.size(); ++i) {
+        TEST_ASSERT_EQUAL_STRING(expected[i], started[i].c_str());
+    }
+    releaseOne();
+    takeResults(FPL_FETCH_WORKERS + 5);
+}
+
+// A bootstrap download may not take the last worker: a second metadata job
+// waits, and live points still start at once.
+void test_metadata_leaves_a_worker_for_live() {
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Bootstrap, "https://mock/bootstrap/hold")));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::History, "https://mock/history/hold")));
+    waitForCalls(1);
+    delay(30);
+    TEST_ASSERT_EQUAL_INT(1, gCalls.load());
+
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Live, "https://mock/live")));
+    FetchResult live;
+    TEST_ASSERT_TRUE(fetchWaitResult(live, 1000));
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::Live), static_cast<int>(live.endpoint));
+    fetchRelease(live);
+
+    releaseOne();
+    waitForCalls(3);
+    releaseOne();
+    const std::vector<FetchResult> rest = takeResults(2);
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::Bootstrap), static_cast<int>(rest[0].endpoint));
+    TEST_ASSERT_EQUAL(static_cast<int>(FetchEndpoint::History), static_cast<int>(rest[1].endpoint));
+}
+
+// A job still queued at its deadline fails without a download.
+void test_job_past_its_deadline_is_dropped() {
+    occupyWorkers();
+    FetchJob live = makeJob(FetchEndpoint::Live, "https://mock/live", 7);
+    live.deadlineMs = 20;
+    TEST_ASSERT_TRUE(fetchSubmit(live));
+    delay(40);
+
+    releaseOne();
+    releaseOne();
+    bool sawExpired = false;
+    for (const FetchResult &result : takeResults(FPL_FETCH_WORKERS + 1)) {
+        if (result.endpoint == FetchEndpoint::Live) {
+            sawExpired = true;
+            TEST_ASSERT_FALSE(result.ok);
+            TEST_ASSERT_NULL(result.body);
+            TEST_ASSERT_EQUAL_UINT32(7, result.pollId);
+            TEST_ASSERT_GREATER_OR_EQUAL_UINT32(20, result.startMs - result.queuedMs);
+            TEST_ASSERT_EQUAL_UINT32(result.startMs, result.doneMs);
+        }
+    }
+    TEST_ASSERT_TRUE(sawExpired);
+    TEST_ASSERT_EQUAL_INT(FPL_FETCH_WORKERS, gCalls.load());
+}
+
+// A URL submitted again while still queued is downloaded once, for the newest poll.
+void test_same_url_queued_twice_downloads_once() {
+    occupyWorkers();
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Picks, "https://mock/picks", 1)));
+    TEST_ASSERT_TRUE(fetchSubmit(makeJob(FetchEndpoint::Picks, "https://mock/picks", 2)));
+
+    releaseOne();
+    releaseOne();
+    int picks = 0;
+    for (const FetchResult &result : takeResults(FPL_FETCH_WORKERS + 1)) {
+        if (result.endpoint == FetchEndpoint::Picks) {
+            picks++;
+            TEST_ASSERT_TRUE(result.ok);
+            TEST_ASSERT_EQUAL_UINT32(2, result.pollId);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(1, picks);
+    FetchResult extra;
+    TEST_ASSERT_FALSE(fetchWaitResult(extra, 50));
+    TEST_ASSERT_EQUAL_INT(FPL_FETCH_WORKERS + 1, gCalls.load());
+}
+
+void test_stats_report_each_workers_stack() {
+    Serial.takeCaptured();
+    fetchPrintStats();
+    const std::string out = Serial.takeCaptured();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[FETCH] live "));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[FETCH] fetch0 stack: "));
+}
+
+int main(int, char **) {
+    fetchPipelineInit(mockTransport);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_result_carries_the_body_and_timings);
+    RUN_TEST(test_failed_download_is_reported_without_a_body);
+    RUN_TEST(test_downloads_overlap);
+    RUN_TEST(test_fast_response_is_ready_before_the_slow_one_finishes);
+    RUN_TEST(test_queued_jobs_start_most_urgent_first);
+    RUN_TEST(test_metadata_leaves_a_worker_for_live);
+    RUN_TEST(test_job_past_its_deadline_is_dropped);
+    RUN_TEST(test_same_url_queued_twice_downloads_once);
+    RUN_TEST(test_stats_report_each_workers_stack);
+    return UNITY_END();
+}
@@ -0,0 +1,202 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <freertos/task.h>
+#include <lvgl.h>
+
+#include "fpl_config.h"
+#include "frame_scheduler.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Drives the scheduler from a simulated tearing-effect signal: the test fires
+// "TE edges" itself (from an ISR-flagged thread where the wake-up matters) and
+// renders into a small in-memory display, counting presented frames.
+
+namespace {
+
+constexpr int32_t kWidth = 64;
+constexpr int32_t kHeight = 64;
+
+alignas(4) uint8_t gDrawBuf[kWidth * 16 * sizeof(uint16_t)];
+lv_display_t *gDisplay = nullptr;
+lv_obj_t *gBox = nullptr;
+uint32_t gFrames = 0;
+bool gEdgeDuringRender = false;
+
+std::atomic<int> gSimStarts{0};
+std::atomic<int> gSimStops{0};
+
+bool simStart() {
+    gSimStarts++;
+    return true;
+}
+void simStop() { gSimStops++; }
+
+const FrameVsyncSource kSimTe = {"sim", simStart, simStop};
+
+void flushCb(lv_display_t *disp, const lv_area_t *, uint8_t *) {
+    if (gEdgeDuringRender) {
+        gEdgeDuringRender = false;
+        frameSchedulerVsync();
+    }
+    if (lv_display_flush_is_last(disp)) {
+        gFrames++;
+        frameSchedulerFramePresented();
+    }
+    lv_display_flush_ready(disp);
+}
+
+void invalidateCb(lv_event_t *) { frameSchedulerRequestFrame(); }
+
+uint32_t tickCb() { return millis(); }
+
+// A TE edge as the panel interrupt would deliver it.
+void teEdgeFromIsr() {
+    std::thread([] {
+        fpl_host::inIsr() = true;
+        frameSchedulerVsync();
+    }).join();
+}
+
+}  // namespace
+
+void setUp() {
+    frameSchedulerInit(gDisplay, &kSimTe);
+    // Settle whatever an earlier test left pending.
+    frameSchedulerVsync();
+    frameSchedulerTick(millis());
+    ulTaskNotifyTake(pdTRUE, 0);
+    gFrames = 0;
+    Serial.takeCaptured();
+}
+void tearDown() {}
+
+void test_render_waits_for_the_next_edge() {
+    lv_obj_invalidate(gBox);
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(0, gFrames);
+
+    teEdgeFromIsr();
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(1, gFrames);
+}
+
+// An edge that came before the invalidation is not a start signal: the scan it
+// marks may already be past the dirty rows.
+void test_edge_before_the_request_does_not_start_a_frame() {
+    teEdgeFromIsr();
+    lv_obj_invalidate(gBox);
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(0, gFrames);
+
+    teEdgeFromIsr();
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(1, gFrames);
+}
+
+// A late service collapses every edge since into one render.
+void test_missed_edges_collapse_into_one_frame() {
+    lv_obj_invalidate(gBox);
+    for (int i = 0; i < 4; ++i) {
+        teEdgeFromIsr();
+    }
+    frameSchedulerTick(millis());
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(1, gFrames);
+}
+
+void test_nothing_pending_means_nothing_rendered() {
+    for (int i = 0; i < 3; ++i) {
+        teEdgeFromIsr();
+        frameSchedulerTick(millis());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, gFrames);
+}
+
+// Edges only wake the UI task while a frame is pending, so a static screen
+// sleeps through them.
+void test_edges_wake_the_task_only_with_a_frame_pending() {
+    std::atomic<bool> stop{false};
+    std::thread te([&stop] {
+        fpl_host::inIsr() = true;
+        while (!stop) {
+            frameSchedulerVsync();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    uint32_t startMs = millis();
+    frameSchedulerWait(pdMS_TO_TICKS(80));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(75, millis() - startMs);
+
+    lv_obj_invalidate(gBox);
+    startMs = millis();
+    frameSchedulerWait(pdMS_TO_TICKS(1000));
+    TEST_ASSERT_LESS_THAN_UINT32(100, millis() - startMs);
+    stop = true;
+    te.join();
+
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(1, gFrames);
+}
+
+// An edge that lands while a frame renders had work waiting but could not
+// start it; the report counts it as missed.
+void test_report_counts_edges_frames_and_misses() {
+    const uint32_t windowStartMs = millis();
+    for (int i = 0; i < 3; ++i) {
+        lv_obj_invalidate(gBox);
+        gEdgeDuringRender = i == 2;
+        teEdgeFromIsr();
+        frameSchedulerTick(millis());
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, gFrames);
+
+    frameSchedulerTick(windowStartMs + FPL_FRAME_SCHEDULER_REPORT_INTERVAL_MS);
+    const std::string out = Serial.takeCaptured();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[FRAME] src=sim "));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("fps=0.3 missed=1\n"));
+}
+
+// A panel whose TE line never toggles must not freeze the display: after the
+// timeout the timer source takes over and frames keep coming. Runs last, the
+// switch is permanent.
+void test_silent_te_falls_back_to_the_timer() {
+    const int stopsBefore = gSimStops;
+    lv_obj_invalidate(gBox);
+    const uint32_t startMs = millis();
+    frameSchedulerTick(startMs + FPL_FRAME_SCHEDULER_VSYNC_TIMEOUT_MS + 1);
+    TEST_ASSERT_EQUAL_INT(stopsBefore + 1, gSimStops.load());
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, Serial.takeCaptured().find("falling back to timer"));
+
+    // The timer's first edge wakes the task and the pending frame renders.
+    frameSchedulerWait(pdMS_TO_TICKS(1000));
+    TEST_ASSERT_LESS_THAN_UINT32(200, millis() - startMs);
+    frameSchedulerTick(millis());
+    TEST_ASSERT_EQUAL_UINT32(1, gFrames);
+}
+
+int main(int, char **) {
+    lv_init();
+    lv_tick_set_cb(tickCb);
+    gDisplay = lv_display_create(kWidth, kHeight);
+    lv_display_set_flush_cb(gDisplay, flushCb);
+    lv_display_set_buffers(gDisplay, gDrawBuf, nullptr, sizeof(gDrawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(gDisplay, invalidateCb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    gBox = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(gBox, 16, 16);
+    lv_refr_now(gDisplay);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_render_waits_for_the_next_edge);
+    RUN_TEST(test_edge_before_the_request_does_not_start_a_frame);
+    RUN_TEST(test_missed_edges_collapse_into_one_frame);
+    RUN_TEST(test_nothing_pending_means_nothing_rendered);
+    RUN_TEST(test_edges_wake_the_task_only_with_a_frame_pending);
+    RUN_TEST(test_report_counts_edges_frames_and_misses);
+    RUN_TEST(test_silent_te_falls_back_to_the_timer);
+    return UNITY_END();
+}
@@ -0,0 +1,193 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include "fpl_config.h"
+#include "json_slicer.h"
+
+#include <string>
+
+// Feeds a body shaped like event/<gw>/live (one element per player, each with
+// its stats and per-fixture explain rows) through deserializeJson() with the
+// firmware's live filter. A throttle in front of the reader burns time per
+// byte so the host parses at a device-like rate and the slicing shows.
+
+namespace {
+
+constexpr int kElements = 800;
+// Added host cost per parsed byte, so one parse spans many slices.
+constexpr uint32_t kThrottleBytes = 256;
+constexpr uint32_t kThrottleUs = 64;
+
+std::string gLiveBody;
+
+std::string buildLiveBody() {
+    std::string body = "{\"elements\":[";
+    char element[640];
+    for (int id = 1; id <= kElements; ++id) {
+        const int minutes = (id * 37) % 91;
+        const int points = minutes > 0 ? (id % 13) : 0;
+        snprintf(element, sizeof(element),
+                 "%s{\"id\":%d,\"stats\":{\"minutes\":%d,\"goals_scored\":%d,\"assists\":%d,\"clean_sheets\":%d,"
+                 "\"goals_conceded\":%d,\"own_goals\":0,\"penalties_saved\":0,\"penalties_missed\":0,"
+                 "\"yellow_cards\":%d,\"red_cards\":0,\"saves\":%d,\"bonus\":%d,\"bps\":%d,\"influence\":\"%d.4\","
+                 "\"creativity\":\"%d.1\",\"threat\":\"%d.0\",\"ict_index\":\"%d.3\",\"starts\":%d,"
+                 "\"expected_goals\":\"0.%02d\",\"expected_assists\":\"0.%02d\",\"total_points\":%d,"
+                 "\"in_dreamteam\":false},\"explain\":[{\"fixture\":%d,\"stats\":[{\"identifier\":\"minutes\","
+                 "\"points\":%d,\"value\":%d,\"points_modification\":0}]}]}",
+                 id > 1 ? "," : "", id, minutes, id % 7 == 0, id % 5 == 0, minutes >= 60 && id % 3 == 0, id % 4,
+                 id % 9 == 0, id % 6, id % 4, (id * 11) % 60, id % 80, id % 50, id % 70, id % 20, minutes > 0,
+                 id % 100, (id * 3) % 100, points, 1 + id % 10, minutes >= 60 ? 2 : minutes > 0, minutes);
+        body += element;
+    }
+    body += "]}";
+    return body;
+}
+
+// The live filter parseLive() hands deserializeJson().
+void buildLiveFilter(JsonDocument &filter) {
+    JsonArray elementsFilter = filter.createNestedArray("elements");
+    JsonObject elementFilter = elementsFilter.createNestedObject();
+    elementFilter["id"] = true;
+    elementFilter["stats"]["total_points"] = true;
+    elementFilter["stats"]["minutes"] = true;
+    elementFilter["stats"]["goals_scored"] = true;
+    elementFilter["stats"]["assists"] = true;
+}
+
+class ThrottledReader {
+   public:
+    explicit ThrottledReader(JsonSliceReader &inner) : inner_(inner) {}
+
+    int read() {
+        if (++count_ % kThrottleBytes == 0) {
+            delayMicroseconds(kThrottleUs);
+        }
+        return inner_.read();
+    }
+    size_t readBytes(char *buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            const int c = read();
+            if (c < 0) {
+                break;
+            }
+            buffer[n++] = static_cast<char>(c);
+        }
+        return n;
+    }
+
+   private:
+    JsonSliceReader &inner_;
+    uint32_t count_ = 0;
+};
+
+struct ParseRun {
+    DeserializationError err;
+    size_t elements;
+    int lastTotalPoints;
+    uint32_t yields;
+    uint32_t maxSliceUs;
+    uint32_t elapsedUs;
+};
+
+ParseRun parseLive(uint32_t budgetUs) {
+    DynamicJsonDocument filter(512);
+    buildLiveFilter(filter);
+    DynamicJsonDocument doc(256 * 1024);
+    JsonSliceReader reader(gLiveBody.data(), gLiveBody.size(), budgetUs);
+    ThrottledReader throttled(reader);
+    const DeserializationError err = deserializeJson(doc, throttled, DeserializationOption::Filter(filter));
+    reader.finish();
+    JsonArray elements = doc["elements"];
+    return {err,
+            elements.size(),
+            elements.size() > 0 ? elements[elements.size() - 1]["stats"]["total_points"].as<int>() : -1,
+            reader.yields(),
+            reader.maxSliceUs(),
+            reader.elapsedUs()};
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_sliced_parse_keeps_every_element() {
+    const ParseRun run = parseLive(2000);
+    TEST_ASSERT_TRUE_MESSAGE(run.err == DeserializationError::Ok, run.err.c_str());
+    TEST_ASSERT_EQUAL_UINT32(kElements, run.elements);
+    TEST_ASSERT_EQUAL_INT(kElements % 13, run.lastTotalPoints);
+}
+
+// No stretch between yields runs much past the budget: one check interval of
+// FPL_JSON_SLICE_BYTES on top, plus scheduler noise.
+void test_longest_slice_stays_near_the_budget() {
+    const uint32_t budgetUs = 5000;
+    const ParseRun run = parseLive(budgetUs);
+    TEST_ASSERT_GREATER_THAN_UINT32(run.elapsedUs / budgetUs / 2, run.yields);
+    TEST_ASSERT_LESS_THAN_UINT32(budgetUs + 3000, run.maxSliceUs);
+    // Every yield sleeps a tick.
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(run.yields * 1000U, run.elapsedUs);
+}
+
+void test_zero_budget_never_yields() {
+    const ParseRun run = parseLive(0);
+    TEST_ASSERT_TRUE(run.err == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_UINT32(0, run.yields);
+    TEST_ASSERT_EQUAL_UINT32(run.elapsedUs, run.maxSliceUs);
+}
+
+// read() and readBytes() hand out the same bytes, whatever the chunk size
+// against the slice checkpoints.
+void test_read_and_read_bytes_agree() {
+    const std::string &body = gLiveBody;
+    JsonSliceReader byByte(body.data(), body.size(), 0);
+    std::string viaRead;
+    for (int c = byByte.read(); c >= 0; c = byByte.read()) {
+        viaRead.push_back(static_cast<char>(c));
+    }
+    TEST_ASSERT_TRUE(viaRead == body);
+
+    const size_t chunks[] = {1, 7, FPL_JSON_SLICE_BYTES - 1, FPL_JSON_SLICE_BYTES, FPL_JSON_SLICE_BYTES * 3 + 5};
+    for (size_t chunk : chunks) {
+        JsonSliceReader reader(body.data(), body.size(), 0);
+        std::string viaBytes;
+        std::string buf(chunk, '\0');
+        size_t n;
+        while ((n = reader.readBytes(&buf[0], chunk)) > 0) {
+            viaBytes.append(buf, 0, n);
+        }
+        TEST_ASSERT_TRUE(viaBytes == body);
+        TEST_ASSERT_EQUAL_INT(-1, reader.read());
+    }
+}
+
+// What the slicing costs at the shipped budget, against an unsliced parse.
+void test_benchmark_live_parse_latency() {
+    const ParseRun unsliced = parseLive(0);
+    const ParseRun sliced = parseLive(FPL_JSON_SLICE_BUDGET_US);
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "[BENCH] live %u bytes: unsliced %lu ms in one slice; sliced %lu ms, %lu yields, longest slice %lu us",
+             static_cast<unsigned>(gLiveBody.size()), static_cast<unsigned long>(unsliced.elapsedUs / 1000U),
+             static_cast<unsigned long>(sliced.elapsedUs / 1000U), static_cast<unsigned long>(sliced.yields),
+             static_cast<unsigned long>(sliced.maxSliceUs));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, sliced.yields);
+    TEST_ASSERT_LESS_THAN_UINT32(unsliced.maxSliceUs, sliced.maxSliceUs);
+    TEST_ASSERT_LESS_THAN_UINT32(FPL_JSON_SLICE_BUDGET_US + 3000, sliced.maxSliceUs);
+}
+
+int main(int, char **) {
+    gLiveBody = buildLiveBody();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sliced_parse_keeps_every_element);
+    RUN_TEST(test_longest_slice_stays_near_the_budget);
+    RUN_TEST(test_zero_budget_never_yields);
+    RUN_TEST(test_read_and_read_bytes_agree);
+    RUN_TEST(test_benchmark_live_parse_latency);
+    return UNITY_END();
+}
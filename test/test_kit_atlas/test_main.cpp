@@ -0,0 +1,180 @@
+#include <unity.h>
+
+#include "kit_atlas_index.h"
+#include "kit_file.h"
+
+#include <dirent.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Checks the C++ index against an atlas packed from data/kits by
+// tools/pio_native_kit_atlas.py: every kit is found with the layout the
+// firmware draws from, absent slugs miss, and a damaged blob is rejected.
+
+namespace {
+
+std::vector<uint8_t> gAtlas;
+
+struct Kit {
+    std::string slug;
+    uint16_t width;
+    uint16_t height;
+    uint8_t bpp;
+};
+
+std::vector<Kit> gKits;
+
+uint16_t readU16(const std::string &blob, size_t off) {
+    return static_cast<uint16_t>(static_cast<uint8_t>(blob[off]) | (static_cast<uint8_t>(blob[off + 1]) << 8));
+}
+
+// Same rule as tools/kit_atlas.py: the file stem without its "_WxH" suffix.
+void loadKits() {
+    DIR *dir = opendir(FPL_TEST_KIT_DIR);
+    if (!dir) {
+        return;
+    }
+    while (dirent *ent = readdir(dir)) {
+        const std::string name = ent->d_name;
+        const size_t suffix = name.rfind('_');
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".kit") != 0 || suffix == std::string::npos) {
+            continue;
+        }
+        std::ifstream in(std::string(FPL_TEST_KIT_DIR) + "/" + name, std::ios::binary);
+        const std::string blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (blob.size() < 16) {
+            continue;
+        }
+        gKits.push_back({name.substr(0, suffix), readU16(blob, 4), readU16(blob, 6), static_cast<uint8_t>(blob[8])});
+    }
+    closedir(dir);
+}
+
+KitAtlasHeader &header(std::vector<uint8_t> &blob) { return *reinterpret_cast<KitAtlasHeader *>(blob.data()); }
+
+KitAtlasEntry &entry(std::vector<uint8_t> &blob, int i) {
+    return reinterpret_cast<KitAtlasEntry *>(blob.data() + header(blob).indexOffset)[i];
+}
+
+int validate(const std::vector<uint8_t> &blob) {
+    return kitAtlasValidate(blob.data(), blob.size(), kKitWidth, kKitHeight);
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_atlas_holds_every_kit() {
+    TEST_ASSERT_GREATER_THAN(0, gKits.size());
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(gKits.size()), validate(gAtlas));
+}
+
+void test_every_kit_is_found_with_its_layout() {
+    for (const Kit &kit : gKits) {
+        const int i = kitAtlasIndexOf(gAtlas.data(), kit.slug.c_str());
+        TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(0, i, kit.slug.c_str());
+        const KitAtlasEntry &e = kitAtlasEntry(gAtlas.data(), i);
+        TEST_ASSERT_EQUAL_STRING(kit.slug.c_str(), e.slug);
+        TEST_ASSERT_EQUAL_UINT16(kit.width, e.width);
+        TEST_ASSERT_EQUAL_UINT16(kit.height, e.height);
+        TEST_ASSERT_EQUAL_UINT8(kit.bpp, e.bpp);
+        // Palette padded to 16/256 ARGB8888 slots, then the index rows.
+        const size_t rowBytes = kit.bpp == 4 ? (kit.width + 1U) / 2U : kit.width;
+        TEST_ASSERT_EQUAL_UINT32((kit.bpp == 4 ? 16U : 256U) * 4U + rowBytes * kit.height, e.size);
+        TEST_ASSERT_EQUAL_UINT32(0, e.offset & 3U);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(gAtlas.size(), e.offset + e.size);
+    }
+}
+
+void test_absent_slugs_miss() {
+    const char *const misses[] = {"", "aaa_not_a_team", "zz_not_a_team", "arsenal", "arsenal_gk_", "arsenal_GK"};
+    for (const char *slug : misses) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(-1, kitAtlasIndexOf(gAtlas.data(), slug), slug);
+    }
+    TEST_ASSERT_EQUAL_INT(-1, kitAtlasIndexOf(gAtlas.data(), nullptr));
+}
+
+void test_damaged_header_is_rejected() {
+    std::vector<uint8_t> blob = gAtlas;
+    header(blob).magic ^= 1;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    header(blob).version++;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    header(blob).totalBytes = static_cast<uint32_t>(blob.size() + 1);
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    header(blob).count = 0xFFFF;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    header(blob).indexOffset = 0xFFFFFFF0U;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    header(blob).indexOffset += 2;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    // A short read: the header promises more than is there.
+    TEST_ASSERT_EQUAL_INT(-1, kitAtlasValidate(gAtlas.data(), gAtlas.size() - 1, kKitWidth, kKitHeight));
+    TEST_ASSERT_EQUAL_INT(-1, kitAtlasValidate(gAtlas.data(), sizeof(KitAtlasHeader) - 1, kKitWidth, kKitHeight));
+    TEST_ASSERT_EQUAL_INT(-1, kitAtlasValidate(nullptr, 0, kKitWidth, kKitHeight));
+}
+
+void test_damaged_entry_is_rejected() {
+    const int last = static_cast<int>(gKits.size()) - 1;
+    std::vector<uint8_t> blob = gAtlas;
+    entry(blob, last).offset = header(blob).totalBytes;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    entry(blob, 0).offset += 2;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    entry(blob, 0).size += 4;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    entry(blob, 0).width = kKitWidth + 1;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    entry(blob, 0).bpp = 2;
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    blob = gAtlas;
+    memset(entry(blob, 0).slug, 'a', kKitAtlasSlugBytes);
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    // Out of order, the binary search would miss kits that are there.
+    blob = gAtlas;
+    std::swap(entry(blob, 0), entry(blob, 1));
+    TEST_ASSERT_EQUAL_INT(-1, validate(blob));
+
+    // Checks the kit size the firmware expects, not just self-consistency.
+    TEST_ASSERT_EQUAL_INT(-1, kitAtlasValidate(gAtlas.data(), gAtlas.size(), kKitWidth, kKitHeight + 1));
+}
+
+int main(int, char **) {
+    std::ifstream in(FPL_TEST_KIT_ATLAS, std::ios::binary);
+    gAtlas.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    loadKits();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_atlas_holds_every_kit);
+    RUN_TEST(test_every_kit_is_found_with_its_layout);
+    RUN_TEST(test_absent_slugs_miss);
+    RUN_TEST(test_damaged_header_is_rejected);
+    RUN_TEST(test_damaged_entry_is_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+#include <unity.h>
+
+#include "kit_atlas_index.h"
+#include "kit_file.h"
+
+#include <dirent.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Decodes every committed data/kits/*.kit with the firmware's parser and RLE
+// decoder and compares the result byte for byte with what tools/kit_encode.py
+// decodes: tools/pio_native_kit_atlas.py packs its output into the atlas blob.
+
+namespace {
+
+std::vector<uint8_t> gAtlas;
+
+struct Kit {
+    std::string slug;
+    std::vector<uint8_t> file;
+};
+
+std::vector<Kit> gKits;
+
+// Same rule as tools/kit_atlas.py: the file stem without its "_WxH" suffix.
+void loadKits() {
+    DIR *dir = opendir(FPL_TEST_KIT_DIR);
+    if (!dir) {
+        return;
+    }
+    while (dirent *ent = readdir(dir)) {
+        const std::string name = ent->d_name;
+        const size_t suffix = name.rfind('_');
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".kit") != 0 || suffix == std::string::npos) {
+            continue;
+        }
+        std::ifstream in(std::string(FPL_TEST_KIT_DIR) + "/" + name, std::ios::binary);
+        gKits.push_back({name.substr(0, suffix),
+                         std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>())});
+    }
+    closedir(dir);
+}
+
+// What kit_cache.cpp does after reading the file: padded palette, then the index rows.
+bool decodeKit(const std::vector<uint8_t> &file, std::vector<uint8_t> &out, KitFileHeader &header) {
+    if (file.size() < kKitHeaderBytes || !kitParseHeader(file.data(), kKitWidth, kKitHeight, header)) {
+        return false;
+    }
+    const size_t usedPaletteBytes = header.paletteEntries * 4U;
+    if (file.size() != kKitHeaderBytes + usedPaletteBytes + header.payloadBytes) {
+        return false;
+    }
+    out.assign(header.paletteBytes + header.indexBytes, 0xEE);
+    memset(out.data(), 0, header.paletteBytes);
+    memcpy(out.data(), file.data() + kKitHeaderBytes, usedPaletteBytes);
+    return kitDecodeIndices(header, file.data() + kKitHeaderBytes + usedPaletteBytes,
+                            out.data() + header.paletteBytes);
+}
+
+std::vector<uint8_t> header(uint8_t bpp, uint8_t flags, uint16_t entries, uint32_t payloadBytes) {
+    std::vector<uint8_t> raw = {'K', 'I', 'T', '1', kKitWidth & 0xFF, kKitWidth >> 8, kKitHeight & 0xFF, kKitHeight >> 8,
+                                bpp, flags, static_cast<uint8_t>(entries), static_cast<uint8_t>(entries >> 8)};
+    for (int i = 0; i < 4; ++i) {
+        raw.push_back(static_cast<uint8_t>(payloadBytes >> (8 * i)));
+    }
+    return raw;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_every_kit_decodes_like_the_encoder() {
+    TEST_ASSERT_GREATER_THAN(0, gKits.size());
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(gKits.size()), kitAtlasValidate(gAtlas.data(), gAtlas.size(), kKitWidth,
+                                                                           kKitHeight));
+    size_t rleKits = 0;
+    for (const Kit &kit : gKits) {
+        std::vector<uint8_t> decoded;
+        KitFileHeader h;
+        TEST_ASSERT_TRUE_MESSAGE(decodeKit(kit.file, decoded, h), kit.slug.c_str());
+        rleKits += (h.flags & kKitFlagRle) ? 1 : 0;
+
+        const int i = kitAtlasIndexOf(gAtlas.data(), kit.slug.c_str());
+        TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(0, i, kit.slug.c_str());
+        const KitAtlasEntry &e = kitAtlasEntry(gAtlas.data(), i);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(e.bpp, h.bpp, kit.slug.c_str());
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(e.size, decoded.size(), kit.slug.c_str());
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(gAtlas.data() + e.offset, decoded.data(), decoded.size(), kit.slug.c_str());
+    }
+    // The committed kits all compress; make sure the RLE path is what got checked.
+    TEST_ASSERT_GREATER_THAN(0, rleKits);
+}
+
+void test_rle_runs_and_literals() {
+    // 3 x 0x07, then the two literals 0x01 0x02, then 129 x 0xAB (the longest run).
+    const uint8_t stream[] = {0x81, 0x07, 0x01, 0x01, 0x02, 0xFF, 0xAB};
+    uint8_t out[134];
+    TEST_ASSERT_TRUE(kitRleDecode(stream, sizeof(stream), out, sizeof(out)));
+    const uint8_t head[] = {0x07, 0x07, 0x07, 0x01, 0x02};
+    TEST_ASSERT_EQUAL_MEMORY(head, out, sizeof(head));
+    for (size_t i = sizeof(head); i < sizeof(out); ++i) {
+        TEST_ASSERT_EQUAL_HEX8(0xAB, out[i]);
+    }
+}
+
+void test_damaged_rle_is_rejected() {
+    uint8_t out[8];
+    const uint8_t shortLiteral[] = {0x03, 0x01, 0x02};
+    TEST_ASSERT_FALSE(kitRleDecode(shortLiteral, sizeof(shortLiteral), out, 4));
+    const uint8_t missingRunByte[] = {0x00, 0x01, 0x82};
+    TEST_ASSERT_FALSE(kitRleDecode(missingRunByte, sizeof(missingRunByte), out, 5));
+    // Runs past the output, or stops short of it.
+    const uint8_t run[] = {0x84, 0x55};
+    TEST_ASSERT_FALSE(kitRleDecode(run, sizeof(run), out, 5));
+    TEST_ASSERT_FALSE(kitRleDecode(run, sizeof(run), out, 7));
+    TEST_ASSERT_TRUE(kitRleDecode(run, sizeof(run), out, 6));
+
+    // A real kit with its last payload byte dropped.
+    const Kit &kit = gKits.front();
+    KitFileHeader h;
+    TEST_ASSERT_TRUE(kitParseHeader(kit.file.data(), kKitWidth, kKitHeight, h));
+    h.payloadBytes--;
+    std::vector<uint8_t> indices(h.indexBytes);
+    TEST_ASSERT_FALSE(kitDecodeIndices(h, kit.file.data() + kKitHeaderBytes + h.paletteEntries * 4U, indices.data()));
+}
+
+void test_header_is_checked() {
+    KitFileHeader h;
+    TEST_ASSERT_TRUE(kitParseHeader(header(4, kKitFlagRle, 16, 100).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_EQUAL_UINT32(16U * 4U, h.paletteBytes);
+    TEST_ASSERT_EQUAL_UINT32((kKitWidth + 1U) / 2U * kKitHeight, h.indexBytes);
+    TEST_ASSERT_TRUE(kitParseHeader(header(8, 0, 256, kKitMaxIndexBytes).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_EQUAL_UINT32(256U * 4U, h.paletteBytes);
+    TEST_ASSERT_EQUAL_UINT32(kKitMaxIndexBytes, h.indexBytes);
+
+    TEST_ASSERT_FALSE(kitParseHeader(header(2, 0, 4, 100).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitParseHeader(header(4, 0, 17, 100).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitParseHeader(header(8, 0, 257, 100).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitParseHeader(header(8, 0, 16, kKitMaxIndexBytes + 1).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitParseHeader(header(8, 0, 16, 100).data(), kKitWidth, kKitHeight + 1, h));
+    std::vector<uint8_t> raw = header(8, 0, 16, 100);
+    raw[3] = '2';
+    TEST_ASSERT_FALSE(kitParseHeader(raw.data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitParseHeader(nullptr, kKitWidth, kKitHeight, h));
+
+    // Uncompressed payloads must be exactly the index rows.
+    const std::vector<uint8_t> payload(kKitMaxIndexBytes, 3);
+    std::vector<uint8_t> indices(kKitMaxIndexBytes);
+    TEST_ASSERT_TRUE(kitParseHeader(header(8, 0, 16, kKitMaxIndexBytes - 1).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_FALSE(kitDecodeIndices(h, payload.data(), indices.data()));
+    TEST_ASSERT_TRUE(kitParseHeader(header(8, 0, 16, kKitMaxIndexBytes).data(), kKitWidth, kKitHeight, h));
+    TEST_ASSERT_TRUE(kitDecodeIndices(h, payload.data(), indices.data()));
+    TEST_ASSERT_EQUAL_MEMORY(payload.data(), indices.data(), indices.size());
+}
+
+int main(int, char **) {
+    std::ifstream in(FPL_TEST_KIT_ATLAS, std::ios::binary);
+    gAtlas.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    loadKits();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_every_kit_decodes_like_the_encoder);
+    RUN_TEST(test_rle_runs_and_literals);
+    RUN_TEST(test_damaged_rle_is_rejected);
+    RUN_TEST(test_header_is_checked);
+    return UNITY_END();
+}
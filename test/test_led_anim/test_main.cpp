@@ -0,0 +1,333 @@
+#include <unity.h>
+
+#include "led_anim.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Renders LED scenes on the host: frames depend only on the scene and the
+// time passed in, so expected pixels can be written down exactly.
+
+namespace {
+
+constexpr uint16_t kLeds = 24;
+constexpr LedPixel kGreen = {0, 200, 0};
+constexpr LedPixel kPurple = {128, 0, 255};
+
+LedPixel gFrame[kLeds];
+LedPixel gBaseFrame[kLeds];
+
+void setBase(LedScene &scene, LedEffectId effect) {
+    LedLayerState &base = ledAnimLayer(scene, LedLayer::Base);
+    base.effect = effect;
+    base.color = kGreen;
+    base.periodMs = 1000;
+    base.stepMs = 50;
+}
+
+void setDeadline(LedScene &scene, uint8_t progress) {
+    LedLayerState &overlay = ledAnimLayer(scene, LedLayer::Overlay);
+    overlay.effect = LedEffectId::DeadlineProgress;
+    overlay.color = kPurple;
+    overlay.periodMs = 1000;
+    overlay.progress = progress;
+}
+
+void setFlash(LedScene &scene) {
+    LedLayerState &flash = ledAnimLayer(scene, LedLayer::Transient);
+    flash.effect = LedEffectId::NotificationFlash;
+    flash.color = kPurple;
+    flash.periodMs = 2000;
+}
+
+// The frame the base layer alone renders at nowMs.
+void renderBaseOnly(const LedScene &scene, uint32_t nowMs) {
+    LedScene base;
+    ledAnimLayer(base, LedLayer::Base) = scene.layers[static_cast<size_t>(LedLayer::Base)];
+    ledAnimRender(base, nowMs, gBaseFrame, kLeds);
+}
+
+bool samePixel(LedPixel a, LedPixel b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+
+// Deadline segment k sits k LEDs anticlockwise of 12 o'clock (index kLeds / 4).
+uint16_t segmentLed(uint16_t segment) { return static_cast<uint16_t>((kLeds / 4 + kLeds - segment) % kLeds); }
+
+// The answer may be early but never late: no frame before nowMs + wait differs
+// from the one at nowMs. Checked over the first `spanMs` of the scene.
+void assertNeverLate(const LedScene &scene, uint32_t spanMs) {
+    LedPixel later[kLeds];
+    for (uint32_t t = 0; t < spanMs; t += 7) {
+        const uint32_t waitMs = ledAnimMsUntilChange(scene, t);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, waitMs);
+        ledAnimRender(scene, t, gFrame, kLeds);
+        const uint32_t checkMs = waitMs < 2000 ? waitMs : 2000;
+        for (uint32_t dt = 1; dt < checkMs; ++dt) {
+            ledAnimRender(scene, t + dt, later, kLeds);
+            TEST_ASSERT_EQUAL_MEMORY(gFrame, later, sizeof(gFrame));
+        }
+    }
+}
+
+// The ring's renderer before the Q8 tables, in single precision as it ran on
+// the device: channel * pulse * tail, truncated.
+uint8_t floatPixel(uint8_t channel, uint32_t nowMs, uint32_t periodMs, float tail) {
+    const float phase = static_cast<float>(nowMs % periodMs) / static_cast<float>(periodMs);
+    const float pulse = 0.08f + (0.92f * (0.5f + (0.5f * sinf(6.283185307f * phase))));
+    const int scaled = static_cast<int>(static_cast<float>(channel) * (pulse * tail));
+    return static_cast<uint8_t>(scaled < 0 ? 0 : (scaled > 255 ? 255 : scaled));
+}
+
+// Tail factor of LED i under the old comet / dim-notch / breathing renderers.
+float floatTail(LedEffectId effect, uint16_t i, uint16_t head) {
+    const uint16_t distance = static_cast<uint16_t>((i + kLeds - head) % kLeds);
+    switch (effect) {
+        case LedEffectId::RankComet: {
+            static const float kTail[] = {1.00f, 0.45f, 0.18f, 0.08f};
+            return distance < 4 ? kTail[distance] : 0.0f;
+        }
+        case LedEffectId::RankDimNotch:
+            return distance == 0 ? 0.22f : 1.0f;
+        default:
+            return 1.0f;
+    }
+}
+
+// Largest channel difference between ledAnimRender and the float renderer for
+// the rank effects, over five pulse periods sampled every msStep.
+int maxLutError(const LedPixel *colors, size_t colorCount, uint32_t msStep) {
+    const LedEffectId effects[] = {LedEffectId::RankBreathing, LedEffectId::RankDimNotch, LedEffectId::RankComet};
+    const uint32_t periods[] = {50, 700, 1400, 2000, 5000};
+    int worst = 0;
+    for (LedEffectId effect : effects) {
+        for (uint32_t periodMs : periods) {
+            for (size_t c = 0; c < colorCount; ++c) {
+                LedScene scene;
+                LedLayerState &base = ledAnimLayer(scene, LedLayer::Base);
+                base.effect = effect;
+                base.color = colors[c];
+                base.periodMs = periodMs;
+                base.stepMs = 50;
+                for (uint32_t ms = 0; ms < periodMs; ms += msStep) {
+                    ledAnimRender(scene, ms, gFrame, kLeds);
+                    const uint16_t head = static_cast<uint16_t>((ms / base.stepMs) % kLeds);
+                    for (uint16_t i = 0; i < kLeds; ++i) {
+                        const float tail = floatTail(effect, i, head);
+                        const int err[] = {
+                            abs(gFrame[i].r - floatPixel(base.color.r, ms, periodMs, tail)),
+                            abs(gFrame[i].g - floatPixel(base.color.g, ms, periodMs, tail)),
+                            abs(gFrame[i].b - floatPixel(base.color.b, ms, periodMs, tail)),
+                        };
+                        for (int e : err) {
+                            worst = e > worst ? e : worst;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return worst;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_empty_scene_is_dark() {
+    LedScene scene;
+    memset(gFrame, 0xFF, sizeof(gFrame));
+    ledAnimRender(scene, 1234, gFrame, kLeds);
+    for (const LedPixel &px : gFrame) {
+        TEST_ASSERT_TRUE(samePixel(px, {0, 0, 0}));
+    }
+}
+
+void test_frames_depend_only_on_scene_and_time() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankComet);
+    setDeadline(scene, 5);
+    setFlash(scene);
+    LedPixel again[kLeds];
+    for (uint32_t t = 0; t < 3000; t += 37) {
+        ledAnimRender(scene, t, gFrame, kLeds);
+        ledAnimRender(scene, t, again, kLeds);
+        TEST_ASSERT_EQUAL_MEMORY(gFrame, again, sizeof(gFrame));
+    }
+}
+
+// Breathing starts the period at the pulse curve's 138/255.
+void test_breathing_follows_the_pulse_curve() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankBreathing);
+    ledAnimRender(scene, 0, gFrame, kLeds);
+    for (const LedPixel &px : gFrame) {
+        TEST_ASSERT_TRUE(samePixel(px, {0, 200 * 138 / 255, 0}));
+    }
+    // Full level a quarter of the way in.
+    ledAnimRender(scene, 250, gFrame, kLeds);
+    TEST_ASSERT_EQUAL_UINT8(200, gFrame[0].g);
+}
+
+void test_comet_lights_head_and_tail_only() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankComet);
+    ledAnimRender(scene, 250, gFrame, kLeds);  // head at LED 5, full level
+    TEST_ASSERT_EQUAL_UINT8(200, gFrame[5].g);
+    TEST_ASSERT_EQUAL_UINT8(200 * 115 / 255, gFrame[6].g);
+    TEST_ASSERT_EQUAL_UINT8(200 * 20 / 255, gFrame[8].g);
+    TEST_ASSERT_EQUAL_UINT8(0, gFrame[4].g);
+    TEST_ASSERT_EQUAL_UINT8(0, gFrame[9].g);
+}
+
+// The integer tables against the float maths they replaced, for every rank
+// effect over whole pulse periods. Exact within 1 LSB for the ring's own
+// colours (channels 0, 180, 255); other channel values can be 2 LSB off, from
+// the Q8 level and the two truncations.
+void test_lut_renderer_matches_the_float_formula() {
+    const LedPixel ringColors[] = {{180, 0, 180}, {255, 0, 0}, {0, 255, 0}};
+    TEST_ASSERT_LESS_OR_EQUAL_INT(1, maxLutError(ringColors, 3, 1));
+
+    LedPixel sweep[18];
+    for (int k = 0; k < 18; ++k) {
+        const int c = k * 15;
+        sweep[k] = {static_cast<uint8_t>(c), static_cast<uint8_t>(255 - c), static_cast<uint8_t>((c * 7) % 256)};
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_INT(2, maxLutError(sweep, 18, 3));
+}
+
+// Lit segments are opaque; the rank trend stays visible, dimmed, under the rest.
+void test_deadline_overlay_dims_the_trend_under_unlit_segments() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankBreathing);
+    setDeadline(scene, 3);
+    ledAnimRender(scene, 0, gFrame, kLeds);
+    renderBaseOnly(scene, 0);
+    for (uint16_t i = 0; i < kLeds; ++i) {
+        const bool lit = i == segmentLed(0) || i == segmentLed(1) || i == segmentLed(2);
+        if (lit) {
+            TEST_ASSERT_TRUE(samePixel(gFrame[i], kPurple));
+        } else {
+            TEST_ASSERT_GREATER_THAN_UINT8(0, gFrame[i].g);
+            TEST_ASSERT_EQUAL_UINT8(gBaseFrame[i].g * 64 / 255, gFrame[i].g);
+        }
+    }
+
+    // The leading segment blinks off to the undimmed trend.
+    ledAnimRender(scene, 600, gFrame, kLeds);
+    renderBaseOnly(scene, 600);
+    TEST_ASSERT_TRUE(samePixel(gBaseFrame[segmentLed(2)], gFrame[segmentLed(2)]));
+    TEST_ASSERT_TRUE(samePixel(kPurple, gFrame[segmentLed(1)]));
+}
+
+// The flash tints the ring at its alpha while on and leaves it alone while off.
+void test_flash_blends_over_the_layers_below() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankBreathing);
+    setFlash(scene);
+    ledAnimRender(scene, 250, gFrame, kLeds);
+    for (const LedPixel &px : gFrame) {
+        TEST_ASSERT_EQUAL_UINT8(128 * 224 / 255, px.r);
+        TEST_ASSERT_EQUAL_UINT8(200 * (255 - 224) / 255, px.g);
+        TEST_ASSERT_EQUAL_UINT8(255 * 224 / 255, px.b);
+    }
+
+    ledAnimRender(scene, 1250, gFrame, kLeds);
+    renderBaseOnly(scene, 1250);
+    TEST_ASSERT_EQUAL_MEMORY(gBaseFrame, gFrame, sizeof(gFrame));
+}
+
+void test_static_scene_sleeps_until_the_cap() {
+    LedScene scene;
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimStatic, ledAnimMsUntilChange(scene, 500));
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimMaxSleepMs, ledAnimSleepMs(scene, 500, kLedAnimStatic));
+    // Something outside the scene (a segment dropping, the flash ending) wakes it sooner.
+    TEST_ASSERT_EQUAL_UINT32(3000, ledAnimSleepMs(scene, 500, 3000));
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimMinFrameMs, ledAnimSleepMs(scene, 500, 0));
+
+    // A countdown with every segment gone has nothing left to blink.
+    setDeadline(scene, 0);
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimStatic, ledAnimMsUntilChange(scene, 500));
+}
+
+// Stepped envelopes and moving heads give the exact time of the next change.
+void test_stepped_and_moving_effects_wake_exactly_on_time() {
+    LedScene scene;
+    setDeadline(scene, 3);
+    TEST_ASSERT_EQUAL_UINT32(500, ledAnimMsUntilChange(scene, 0));
+    TEST_ASSERT_EQUAL_UINT32(400, ledAnimMsUntilChange(scene, 100));
+    TEST_ASSERT_EQUAL_UINT32(400, ledAnimMsUntilChange(scene, 600));
+    assertNeverLate(scene, 2000);
+
+    LedScene comet;
+    setBase(comet, LedEffectId::RankComet);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(30, ledAnimMsUntilChange(comet, 20));
+    assertNeverLate(comet, 1000);
+}
+
+// A slow curve reports the probe horizon on its flat top, never the 60 s cap.
+void test_smooth_envelope_answers_within_the_probe_horizon() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankBreathing);
+    LedLayerState &base = ledAnimLayer(scene, LedLayer::Base);
+    base.periodMs = 600000;
+    const uint32_t flatTopMs = base.periodMs * 62 / 256;
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimEnvelopeProbeMs, ledAnimMsUntilChange(scene, flatTopMs));
+    TEST_ASSERT_EQUAL_UINT32(kLedAnimEnvelopeProbeMs, ledAnimSleepMs(scene, flatTopMs, kLedAnimStatic));
+
+    base.periodMs = 1000;
+    for (uint32_t t = 0; t < 1000; t += 13) {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(kLedAnimEnvelopeProbeMs, ledAnimMsUntilChange(scene, t));
+    }
+    assertNeverLate(scene, 1000);
+}
+
+// The overlay and flash let the trend through, so its changes still count.
+void test_layers_below_a_blend_still_wake_the_ring() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankBreathing);
+    setDeadline(scene, 3);
+    setFlash(scene);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(kLedAnimEnvelopeProbeMs, ledAnimMsUntilChange(scene, 250));
+    assertNeverLate(scene, 2500);
+}
+
+// Headless benchmark: all three layers on a full ring, one render per tick.
+void test_benchmark_render_per_tick() {
+    LedScene scene;
+    setBase(scene, LedEffectId::RankComet);
+    setDeadline(scene, 9);
+    setFlash(scene);
+    constexpr uint32_t kTicks = 20000;
+    uint32_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < kTicks; ++t) {
+        ledAnimRender(scene, t * 10U, gFrame, kLeds);
+        checksum += gFrame[t % kLeds].r + gFrame[t % kLeds].g + gFrame[t % kLeds].b;
+    }
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kTicks;
+    char line[96];
+    snprintf(line, sizeof(line), "[BENCH] led anim: %.0f ns/tick for %u LEDs, 3 layers (checksum %lu)", ns,
+             static_cast<unsigned>(kLeds), static_cast<unsigned long>(checksum));
+    TEST_MESSAGE(line);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_scene_is_dark);
+    RUN_TEST(test_frames_depend_only_on_scene_and_time);
+    RUN_TEST(test_breathing_follows_the_pulse_curve);
+    RUN_TEST(test_comet_lights_head_and_tail_only);
+    RUN_TEST(test_lut_renderer_matches_the_float_formula);
+    RUN_TEST(test_deadline_overlay_dims_the_trend_under_unlit_segments);
+    RUN_TEST(test_flash_blends_over_the_layers_below);
+    RUN_TEST(test_static_scene_sleeps_until_the_cap);
+    RUN_TEST(test_stepped_and_moving_effects_wake_exactly_on_time);
+    RUN_TEST(test_smooth_envelope_answers_within_the_probe_horizon);
+    RUN_TEST(test_layers_below_a_blend_still_wake_the_ring);
+    RUN_TEST(test_benchmark_render_per_tick);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <freertos/task.h>
+
+#include "msg_bus.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Publishers and consumers on real threads. The bus is global and holds at
+// most kBusMaxSubscribers, so each test subscribes once to a topic no other
+// test publishes.
+
+namespace {
+
+uint32_t elapsedMs(uint32_t startMs) { return millis() - startMs; }
+
+bool receiveU32(BusSubscriber *sub, uint32_t &value) {
+    BusMessage msg;
+    U32Msg payload;
+    if (!busReceive(sub, msg) || !busRead(msg, payload)) {
+        return false;
+    }
+    value = payload.value;
+    return true;
+}
+
+}  // namespace
+
+void setUp() { Serial.takeCaptured(); }
+void tearDown() {}
+
+// A burst far larger than the queue never blocks the publisher. What gets
+// through arrives in order, and every message is either received or counted.
+void test_burst_never_blocks_the_publisher() {
+    BusSubscriber *sub = busSubscribe("burst", busTopicBit(BusTopic::UiEvent), 4);
+    TEST_ASSERT_NOT_NULL(sub);
+    busSetNotifyTask(sub, xTaskGetCurrentTaskHandle());
+
+    constexpr uint32_t kCount = 200;
+    std::atomic<uint32_t> publishMs{0};
+    std::thread publisher([&publishMs] {
+        const uint32_t startMs = millis();
+        for (uint32_t i = 0; i < kCount; ++i) {
+            busPublish(BusTopic::UiEvent, U32Msg{i});
+        }
+        publishMs = elapsedMs(startMs);
+    });
+    uint32_t received = 0;
+    uint32_t last = 0;
+    const uint32_t startMs = millis();
+    while (received + busDropped(sub) < kCount && elapsedMs(startMs) < 5000) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        uint32_t value;
+        while (receiveU32(sub, value)) {
+            if (received > 0) {
+                TEST_ASSERT_GREATER_THAN_UINT32(last, value);
+            }
+            last = value;
+            received++;
+        }
+    }
+    publisher.join();
+    TEST_ASSERT_LESS_THAN_UINT32(50, publishMs.load());
+    TEST_ASSERT_EQUAL_UINT32(kCount, received + busDropped(sub));
+}
+
+// Parked messages keep their place: later publishes queue up behind them even
+// once the queue has room, and a newer state value replaces a parked one.
+void test_overflow_slots_keep_publish_order() {
+    BusSubscriber *sub =
+        busSubscribe("order", busTopicBit(BusTopic::UiSquadRow) | busTopicBit(BusTopic::UiStatus), 2);
+    TEST_ASSERT_NOT_NULL(sub);
+    TEST_ASSERT_TRUE(busPublish(BusTopic::UiSquadRow, U32Msg{1}));
+    TEST_ASSERT_TRUE(busPublish(BusTopic::UiSquadRow, U32Msg{2}));
+    TEST_ASSERT_TRUE(busPublish(BusTopic::UiStatus, U32Msg{100}));
+    TEST_ASSERT_TRUE(busPublish(BusTopic::UiSquadRow, U32Msg{3}));
+    TEST_ASSERT_TRUE(busPublish(BusTopic::UiStatus, U32Msg{101}));
+
+    const BusTopic topics[] = {BusTopic::UiSquadRow, BusTopic::UiSquadRow, BusTopic::UiSquadRow,
+                               BusTopic::UiStatus, BusTopic::UiSquadRow};
+    const uint32_t values[] = {1, 2, 3, 101, 4};
+    for (size_t i = 0; i < 5; ++i) {
+        if (i == 1) {
+            TEST_ASSERT_TRUE(busPublish(BusTopic::UiSquadRow, U32Msg{4}));
+        }
+        BusMessage msg;
+        U32Msg payload;
+        TEST_ASSERT_TRUE(busReceive(sub, msg));
+        TEST_ASSERT_TRUE(busRead(msg, payload));
+        TEST_ASSERT_EQUAL_INT(static_cast<int>(topics[i]), static_cast<int>(msg.topic));
+        TEST_ASSERT_EQUAL_UINT32(values[i], payload.value);
+    }
+    uint32_t value;
+    TEST_ASSERT_FALSE(receiveU32(sub, value));
+    TEST_ASSERT_EQUAL_UINT32(0, busDropped(sub));
+}
+
+// A state topic coalesces in its overflow slot: nothing waits, nothing is lost
+// but values that were already stale.
+void test_full_state_queue_keeps_the_newest_value() {
+    BusSubscriber *sub = busSubscribe("state", busTopicBit(BusTopic::UiGwPoints), 2);
+    TEST_ASSERT_NOT_NULL(sub);
+    const uint32_t startMs = millis();
+    for (uint32_t i = 1; i <= 5; ++i) {
+        TEST_ASSERT_TRUE(busPublish(BusTopic::UiGwPoints, U32Msg{i}));
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(20, elapsedMs(startMs));
+    TEST_ASSERT_EQUAL_UINT32(0, busDropped(sub));
+
+    const uint32_t expected[] = {1, 2, 5};
+    uint32_t value = 0;
+    for (uint32_t want : expected) {
+        TEST_ASSERT_TRUE(receiveU32(sub, value));
+        TEST_ASSERT_EQUAL_UINT32(want, value);
+    }
+    TEST_ASSERT_FALSE(receiveU32(sub, value));
+}
+
+// Events each take a slot; once they run out the event is dropped at once,
+// counted and logged, and everything parked before it still arrives.
+void test_full_event_overflow_drops_loudly_without_waiting() {
+    BusSubscriber *sub = busSubscribe("stuck", busTopicBit(BusTopic::LedFlash), 1);
+    TEST_ASSERT_NOT_NULL(sub);
+    const uint32_t startMs = millis();
+    for (uint32_t i = 1; i <= 1 + kBusOverflowSlots; ++i) {
+        TEST_ASSERT_TRUE(busPublish(BusTopic::LedFlash, U32Msg{i}));
+    }
+    TEST_ASSERT_FALSE(busPublish(BusTopic::LedFlash, U32Msg{99}));
+    TEST_ASSERT_LESS_THAN_UINT32(20, elapsedMs(startMs));
+    TEST_ASSERT_EQUAL_UINT32(1, busDropped(sub));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, Serial.takeCaptured().find("[BUS] stuck queue full, dropped led_flash"));
+
+    uint32_t value = 0;
+    for (uint32_t i = 1; i <= 1 + kBusOverflowSlots; ++i) {
+        TEST_ASSERT_TRUE(receiveU32(sub, value));
+        TEST_ASSERT_EQUAL_UINT32(i, value);
+    }
+    TEST_ASSERT_FALSE(receiveU32(sub, value));
+}
+
+// A publish wakes the subscriber's task; it does not wait for a poll.
+void test_publish_wakes_the_notify_task() {
+    BusSubscriber *sub = busSubscribe("wake", busTopicBit(BusTopic::UiRank), 4);
+    TEST_ASSERT_NOT_NULL(sub);
+    busSetNotifyTask(sub, xTaskGetCurrentTaskHandle());
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    std::thread publisher([] {
+        delay(30);
+        busPublish(BusTopic::UiRank, U32Msg{42});
+    });
+    const uint32_t startMs = millis();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)));
+    const uint32_t wokeMs = elapsedMs(startMs);
+    publisher.join();
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(25, wokeMs);
+    TEST_ASSERT_LESS_THAN_UINT32(200, wokeMs);
+
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(receiveU32(sub, value));
+    TEST_ASSERT_EQUAL_UINT32(42, value);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_burst_never_blocks_the_publisher);
+    RUN_TEST(test_overflow_slots_keep_publish_order);
+    RUN_TEST(test_full_state_queue_keeps_the_newest_value);
+    RUN_TEST(test_full_event_overflow_drops_loudly_without_waiting);
+    RUN_TEST(test_publish_wakes_the_notify_task);
+    return UNITY_END();
+}
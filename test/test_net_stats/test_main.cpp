@@ -0,0 +1,135 @@
+#include <unity.h>
+
+#include <Arduino.h>
+
+#include "net_stats.h"
+
+#include <string>
+
+// Records attempts through the public API and reads the histograms back from
+// the `netstats` table: count, avg, p50, p95 and max per metric. Percentiles
+// report the upper edge of their bucket, capped at the largest value seen.
+
+namespace {
+
+NetSample okSample(uint32_t dnsUs, uint32_t bodyUs = 100000, size_t bytes = 16 * 1024) {
+    NetSample sample;
+    sample.endpoint = FetchEndpoint::Live;
+    sample.ok = true;
+    sample.httpCode = 200;
+    sample.dnsUs = dnsUs;
+    sample.connectUs = 200000;
+    sample.ttfbUs = 80000;
+    sample.bodyUs = bodyUs;
+    sample.bytes = bytes;
+    sample.maxBytes = 64 * 1024;
+    return sample;
+}
+
+std::string printed() {
+    netStatsPrint();
+    return Serial.takeCaptured();
+}
+
+// The table row for one metric, as netStatsPrint() formats it.
+std::string row(const char *metric, unsigned long count, unsigned long avg, unsigned long p50, unsigned long p95,
+                unsigned long max, const char *unit) {
+    char line[96];
+    snprintf(line, sizeof(line), "[NET]   %-7s %7lu %7lu %7lu %7lu %7lu %s\n", metric, count, avg, p50, p95, max, unit);
+    return line;
+}
+
+void assertRow(const std::string &out, const std::string &expected) {
+    TEST_ASSERT_TRUE_MESSAGE(out.find(expected) != std::string::npos, expected.c_str());
+}
+
+}  // namespace
+
+void setUp() {
+    netStatsReset();
+    Serial.takeCaptured();
+}
+void tearDown() {}
+
+// A value on an edge belongs to that edge's bucket; one past it to the next.
+void test_values_on_an_edge_stay_in_its_bucket() {
+    netStatsRecord(okSample(5000));
+    assertRow(printed(), row("dns", 1, 5, 5, 5, 5, "ms"));
+
+    netStatsRecord(okSample(6000));
+    // p50 is the first sample's bucket (<= 5); p95 the second's (<= 10), capped at the 6 ms seen.
+    assertRow(printed(), row("dns", 2, 5, 5, 6, 6, "ms"));
+}
+
+// Microseconds round to the nearest millisecond before bucketing.
+void test_microseconds_round_to_the_nearest_ms() {
+    netStatsRecord(okSample(5499));
+    assertRow(printed(), row("dns", 1, 5, 5, 5, 5, "ms"));
+    netStatsRecord(okSample(5500));
+    assertRow(printed(), row("dns", 2, 5, 5, 6, 6, "ms"));
+}
+
+// 1..200 ms once each: the 100th value closes the 100 ms bucket and the 190th
+// falls in the 250 ms one, capped at 200.
+void test_percentiles_over_a_spread() {
+    for (uint32_t ms = 1; ms <= 200; ++ms) {
+        netStatsRecord(okSample(ms * 1000));
+    }
+    assertRow(printed(), row("dns", 200, 100, 100, 200, 200, "ms"));
+}
+
+// Past the last edge there is one open bucket; its percentile is the max.
+void test_open_bucket_reports_the_max() {
+    for (int i = 0; i < 19; ++i) {
+        netStatsRecord(okSample(1000));
+    }
+    netStatsRecord(okSample(30000000));
+    // One of twenty above 10 s: p95 is still the 5 ms bucket.
+    assertRow(printed(), row("dns", 20, 1500, 5, 5, 30000, "ms"));
+    netStatsRecord(okSample(30000000));
+    assertRow(printed(), row("dns", 21, 2858, 5, 30000, 30000, "ms"));
+}
+
+// Throughput is bucketed on its own edges, in KB/s.
+void test_throughput_uses_kbps_edges() {
+    netStatsRecord(okSample(1000, 1000000, 100 * 1024));  // 100 KB/s, in the <= 128 bucket
+    netStatsRecord(okSample(1000, 1000000, 20 * 1024));   // 20 KB/s, in the <= 32 bucket
+    assertRow(printed(), row("rate", 2, 60, 32, 100, 100, "KB/s"));
+}
+
+// A failed attempt only feeds the phases it got through.
+void test_failures_skip_the_phases_not_reached() {
+    NetSample dns = okSample(40000);
+    dns.ok = false;
+    dns.failure = NetFailure::Dns;
+    dns.httpCode = 0;
+    netStatsRecord(dns);
+    NetSample http = okSample(3000);
+    http.ok = false;
+    http.failure = NetFailure::Http;
+    http.httpCode = 503;
+    netStatsRecord(http);
+
+    const std::string out = printed();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos,
+                          out.find("[NET] live: 2 req, 0 ok, 0 retry | failed: dns x1, http 503 x1\n"));
+    assertRow(out, row("dns", 1, 3, 3, 3, 3, "ms"));
+    assertRow(out, row("connect", 1, 200, 200, 200, 200, "ms"));
+    assertRow(out, row("ttfb", 1, 80, 80, 80, 80, "ms"));
+    assertRow(out, row("body", 0, 0, 0, 0, 0, "ms"));
+    assertRow(out, row("rate", 0, 0, 0, 0, 0, "KB/s"));
+}
+
+int main(int, char **) {
+    Serial.echo = false;
+    netStatsInit();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_values_on_an_edge_stay_in_its_bucket);
+    RUN_TEST(test_microseconds_round_to_the_nearest_ms);
+    RUN_TEST(test_percentiles_over_a_spread);
+    RUN_TEST(test_open_bucket_reports_the_max);
+    RUN_TEST(test_throughput_uses_kbps_edges);
+    RUN_TEST(test_failures_skip_the_phases_not_reached);
+    return UNITY_END();
+}
@@ -0,0 +1,292 @@
+#include <unity.h>
+
+#include <SPD2010Flush.h>
+
+#include <chrono>
+
+// Stands in for the QSPI panel IO: submitted windows go out one at a time on a
+// "DMA" thread that takes `transferUs` each and then raises the transfer-done
+// "interrupt". Each buffer is checksummed at submit and again at completion,
+// so a chunk rewritten while still on the wire shows up as a corruption.
+class MockPanelIo {
+public:
+    explicit MockPanelIo(SPD2010ChunkPipeline &pipeline) : pipeline_(pipeline), thread_([this] { run(); }) {}
+
+    ~MockPanelIo() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    static bool submit(void *target, int x1, int y1, int x2, int y2, const void *pixels) {
+        return static_cast<MockPanelIo *>(target)->enqueue(x1, y1, x2, y2, pixels);
+    }
+
+    bool enqueue(int x1, int y1, int x2, int y2, const void *pixels) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failNextSubmit) {
+            failNextSubmit = false;
+            return false;
+        }
+        Transfer t;
+        t.pixels = static_cast<const uint16_t *>(pixels);
+        t.count = static_cast<size_t>(x2 - x1) * static_cast<size_t>(y2 - y1);
+        t.checksum = checksum(t.pixels, t.count);
+        pending_.push_back(t);
+        submitted++;
+        const size_t inFlight = pending_.size();
+        if (inFlight > maxInFlight) {
+            maxInFlight = inFlight;
+        }
+        cv_.notify_all();
+        return true;
+    }
+
+    void waitDrained() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_.empty() && !busy_; });
+    }
+
+    uint32_t transferUs = 2000;
+    // The completion interrupt for the next finished transfer is swallowed.
+    std::atomic<bool> loseNextCompletion{false};
+    bool failNextSubmit = false;
+
+    std::atomic<uint32_t> submitted{0};
+    std::atomic<uint32_t> completed{0};
+    std::atomic<uint32_t> corrupted{0};
+    size_t maxInFlight = 0;
+
+private:
+    struct Transfer {
+        const uint16_t *pixels = nullptr;
+        size_t count = 0;
+        uint32_t checksum = 0;
+    };
+
+    static uint32_t checksum(const uint16_t *px, size_t n) {
+        uint32_t sum = 2166136261U;
+        for (size_t i = 0; i < n; ++i) {
+            sum = (sum ^ px[i]) * 16777619U;
+        }
+        return sum;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+            if (stop_) {
+                return;
+            }
+            const Transfer t = pending_.front();
+            busy_ = true;
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(transferUs));
+            if (checksum(t.pixels, t.count) != t.checksum) {
+                corrupted++;
+            }
+            completed++;
+            lock.lock();
+            pending_.pop_front();
+            busy_ = false;
+            lock.unlock();
+            if (!loseNextCompletion.exchange(false)) {
+                fpl_host::inIsr() = true;
+                pipeline_.onTransferDone();
+                fpl_host::inIsr() = false;
+            }
+            lock.lock();
+            cv_.notify_all();
+        }
+    }
+
+    SPD2010ChunkPipeline &pipeline_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Transfer> pending_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+namespace {
+
+constexpr int kWidth = 412;
+constexpr int kChunkRows = 16;
+constexpr size_t kChunkPixels = static_cast<size_t>(kWidth) * kChunkRows;
+constexpr uint32_t kTimeoutMs = 100;
+
+uint16_t gChunkBuf[SPD2010ChunkPipeline::kSlots][kChunkPixels];
+std::atomic<int> gDoneCalls{0};
+std::atomic<uint32_t> gDoneAtCompleted{0};
+
+void onFlushDone(void *ctx) {
+    gDoneCalls++;
+    gDoneAtCompleted = static_cast<MockPanelIo *>(ctx)->completed.load();
+}
+
+// Same loop as SPD2010Display::drawBitmapAsync: fill a slot, queue it, move on.
+bool flushStrip(SPD2010ChunkPipeline &pipeline, MockPanelIo &io, int chunks, uint16_t seed) {
+    for (int c = 0; c < chunks; ++c) {
+        const int slot = pipeline.acquireSlot(kTimeoutMs);
+        if (slot < 0) {
+            return false;
+        }
+        uint16_t *buf = gChunkBuf[slot];
+        for (size_t i = 0; i < kChunkPixels; ++i) {
+            buf[i] = static_cast<uint16_t>(seed + c * 31 + i);
+        }
+        const bool last = (c == chunks - 1);
+        if (!pipeline.queue(0, c * kChunkRows, kWidth, (c + 1) * kChunkRows, buf, slot, last, onFlushDone, &io)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t elapsedMs(std::chrono::steady_clock::time_point since) {
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - since).count());
+}
+
+}  // namespace
+
+void setUp() { gDoneCalls = 0; }
+void tearDown() {}
+
+void test_ping_pong_never_rewrites_a_buffer_in_flight() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    const int kChunks = 26;  // a full 412-row frame
+    TEST_ASSERT_TRUE(flushStrip(pipeline, io, kChunks, 7));
+    TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+    io.waitDrained();
+
+    TEST_ASSERT_EQUAL_UINT32(kChunks, io.completed.load());
+    TEST_ASSERT_EQUAL_UINT32(0, io.corrupted.load());
+    TEST_ASSERT_EQUAL_UINT32(pipeline.queued(), pipeline.done());
+    // The CPU filled one buffer while the other was on the wire, never more.
+    TEST_ASSERT_EQUAL(2, static_cast<int>(io.maxInFlight));
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline.timeouts());
+}
+
+void test_done_fires_once_after_the_last_chunk() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    for (int frame = 0; frame < 5; ++frame) {
+        gDoneCalls = 0;
+        const uint32_t completedBefore = io.completed.load();
+        TEST_ASSERT_TRUE(flushStrip(pipeline, io, 3, static_cast<uint16_t>(frame)));
+        TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+        io.waitDrained();
+        TEST_ASSERT_EQUAL_INT(1, gDoneCalls.load());
+        TEST_ASSERT_EQUAL_UINT32(completedBefore + 3, gDoneAtCompleted.load());
+    }
+}
+
+void test_failed_submit_is_not_counted_and_leaves_done_unarmed() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    io.failNextSubmit = true;
+    TEST_ASSERT_FALSE(pipeline.queue(0, 0, 4, 1, gChunkBuf[0], -1, true, onFlushDone, &io));
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline.queued());
+    // Nothing is outstanding, so this must not wait for a completion that never comes.
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+    TEST_ASSERT_LESS_THAN_UINT32(20, elapsedMs(start));
+
+    TEST_ASSERT_TRUE(flushStrip(pipeline, io, 2, 1));
+    TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+    io.waitDrained();
+    TEST_ASSERT_EQUAL_INT(1, gDoneCalls.load());
+}
+
+void test_waiter_wakes_on_completion_instead_of_polling() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    io.transferUs = 3000;
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(flushStrip(pipeline, io, 4, 3));
+    TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+    const uint32_t ms = elapsedMs(start);
+    // Four 3 ms transfers back to back; a waiter that slept in whole timeouts would take far longer.
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(12, ms);
+    TEST_ASSERT_LESS_THAN_UINT32(40, ms);
+}
+
+void test_lost_completion_times_out_and_reset_recovers() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    io.loseNextCompletion = true;
+    TEST_ASSERT_TRUE(pipeline.queue(0, 0, kWidth, kChunkRows, gChunkBuf[0], -1, true, onFlushDone, &io));
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_FALSE(pipeline.waitIdle(kTimeoutMs));
+    const uint32_t ms = elapsedMs(start);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(kTimeoutMs, ms);
+    TEST_ASSERT_LESS_THAN_UINT32(kTimeoutMs + 50, ms);
+    TEST_ASSERT_EQUAL_UINT32(1, pipeline.timeouts());
+    // The done counter belongs to the ISR until the driver has torn the IO down.
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline.done());
+    TEST_ASSERT_EQUAL_INT(0, gDoneCalls.load());
+
+    io.waitDrained();
+    pipeline.reset();
+    TEST_ASSERT_EQUAL_UINT32(pipeline.queued(), pipeline.done());
+    // LVGL is still waiting for that flush; reset() releases it exactly once.
+    TEST_ASSERT_EQUAL_INT(1, gDoneCalls.load());
+
+    gDoneCalls = 0;
+    TEST_ASSERT_TRUE(flushStrip(pipeline, io, 6, 9));
+    TEST_ASSERT_TRUE(pipeline.waitIdle(kTimeoutMs));
+    io.waitDrained();
+    TEST_ASSERT_EQUAL_INT(1, gDoneCalls.load());
+    TEST_ASSERT_EQUAL_UINT32(0, io.corrupted.load());
+}
+
+void test_acquire_slot_times_out_on_a_stuck_buffer() {
+    SPD2010ChunkPipeline pipeline;
+    MockPanelIo io(pipeline);
+    TEST_ASSERT_TRUE(pipeline.begin(MockPanelIo::submit, &io));
+
+    io.loseNextCompletion = true;
+    // Slot 0 goes out and never reports back; slot 1 is free; slot 0 again must time out.
+    TEST_ASSERT_EQUAL_INT(0, pipeline.acquireSlot(kTimeoutMs));
+    TEST_ASSERT_TRUE(pipeline.queue(0, 0, 4, 1, gChunkBuf[0], 0, false, nullptr, nullptr));
+    TEST_ASSERT_EQUAL_INT(1, pipeline.acquireSlot(kTimeoutMs));
+    TEST_ASSERT_EQUAL_INT(-1, pipeline.acquireSlot(kTimeoutMs));
+    io.waitDrained();
+    pipeline.reset();
+    TEST_ASSERT_EQUAL_INT(0, pipeline.acquireSlot(kTimeoutMs));
+}
+
+void test_sequence_numbers_survive_wraparound() {
+    TEST_ASSERT_TRUE(spd2010SeqBefore(0xFFFFFFF0U, 0x00000010U));
+    TEST_ASSERT_FALSE(spd2010SeqBefore(0x00000010U, 0xFFFFFFF0U));
+    TEST_ASSERT_FALSE(spd2010SeqBefore(5, 5));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ping_pong_never_rewrites_a_buffer_in_flight);
+    RUN_TEST(test_done_fires_once_after_the_last_chunk);
+    RUN_TEST(test_failed_submit_is_not_counted_and_leaves_done_unarmed);
+    RUN_TEST(test_waiter_wakes_on_completion_instead_of_polling);
+    RUN_TEST(test_lost_completion_times_out_and_reset_recovers);
+    RUN_TEST(test_acquire_slot_times_out_on_a_stuck_buffer);
+    RUN_TEST(test_sequence_numbers_survive_wraparound);
+    return UNITY_END();
+}
@@ -0,0 +1,279 @@
+#include <unity.h>
+
+#include <SPD2010Flush.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+SPD2010ChordTable gChords;
+
+uint16_t pattern(int i) {
+    return static_cast<uint16_t>(0x1234 + i * 0x0101);
+}
+
+// True if the unit square of pixel (x, y) touches the panel's inscribed circle.
+bool pixelTouchesCircle(int x, int y) {
+    const double cx = SPD2010_WIDTH * 0.5;
+    const double cy = SPD2010_HEIGHT * 0.5;
+    const double r = (SPD2010_WIDTH < SPD2010_HEIGHT ? SPD2010_WIDTH : SPD2010_HEIGHT) * 0.5;
+    const double nx = cx < x ? x : (cx > x + 1 ? x + 1 : cx);
+    const double ny = cy < y ? y : (cy > y + 1 ? y + 1 : cy);
+    return (nx - cx) * (nx - cx) + (ny - cy) * (ny - cy) < r * r;
+}
+
+bool rowHasVisiblePixel(int y, int x1, int x2) {
+    return x1 <= gChords.right[y] && x2 >= gChords.left[y];
+}
+
+}  // namespace
+
+void setUp() { spd2010BuildChordTable(gChords); }
+void tearDown() {}
+
+// Every dirty span LVGL can hand the rounder must come back on the controller's
+// 4-pixel grid, cover the original span, and grow by at most 3 pixels per side.
+void test_align_window_x_covers_every_span() {
+    for (int32_t x1 = 0; x1 < SPD2010_WIDTH; ++x1) {
+        for (int32_t x2 = x1; x2 < SPD2010_WIDTH; ++x2) {
+            int32_t a1 = x1;
+            int32_t a2 = x2;
+            spd2010AlignWindowX(a1, a2);
+            if (a1 > x1 || x1 - a1 > 3 || a2 < x2 || a2 - x2 > 3 || a2 >= SPD2010_WIDTH ||
+                !spd2010WindowXAligned(a1, a2 - a1 + 1)) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "[%ld, %ld] -> [%ld, %ld]", static_cast<long>(x1), static_cast<long>(x2),
+                         static_cast<long>(a1), static_cast<long>(a2));
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+void test_align_window_x_is_idempotent() {
+    for (int32_t x1 = 0; x1 < SPD2010_WIDTH; x1 += 3) {
+        int32_t a1 = x1;
+        int32_t a2 = x1 + 5 < SPD2010_WIDTH ? x1 + 5 : SPD2010_WIDTH - 1;
+        spd2010AlignWindowX(a1, a2);
+        int32_t b1 = a1;
+        int32_t b2 = a2;
+        spd2010AlignWindowX(b1, b2);
+        TEST_ASSERT_EQUAL_INT32(a1, b1);
+        TEST_ASSERT_EQUAL_INT32(a2, b2);
+    }
+}
+
+void test_window_x_aligned_predicate() {
+    TEST_ASSERT_TRUE(spd2010WindowXAligned(0, 4));
+    TEST_ASSERT_TRUE(spd2010WindowXAligned(408, 4));
+    TEST_ASSERT_FALSE(spd2010WindowXAligned(1, 4));
+    TEST_ASSERT_FALSE(spd2010WindowXAligned(0, 6));
+}
+
+// The padded copy path: an area that bypassed the rounder is widened in the
+// driver, and the extra columns repeat the nearest edge pixel.
+void test_fallback_pads_misaligned_rows_with_edge_pixels() {
+    std::vector<uint16_t> src(64);
+    std::vector<uint16_t> out(80);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = pattern(static_cast<int>(i));
+    }
+
+    for (int x = 0; x < 16; ++x) {
+        for (int w = 1; w <= 48; ++w) {
+            int32_t a1 = x;
+            int32_t a2 = x + w - 1;
+            spd2010AlignWindowX(a1, a2);
+            const int out_w = a2 - a1 + 1;
+            const int left_pad = x - a1;
+            TEST_ASSERT_TRUE(spd2010WindowXAligned(a1, out_w));
+
+            std::fill(out.begin(), out.end(), 0xDEAD);
+            spd2010ExtractRow(out.data(), src.data(), w, left_pad, out_w);
+            for (int i = 0; i < out_w; ++i) {
+                int s = i - left_pad;
+                s = s < 0 ? 0 : (s >= w ? w - 1 : s);
+                TEST_ASSERT_EQUAL_HEX16(spd2010Swap16(src[s]), out[i]);
+            }
+            // Nothing past the widened row is touched.
+            TEST_ASSERT_EQUAL_HEX16(0xDEAD, out[out_w]);
+        }
+    }
+}
+
+// drawBitmapAsync walks the source in rows of `w`, so with an odd width every
+// other row starts off a word boundary.
+void test_fallback_strip_with_odd_width_rows() {
+    const int x = 101;
+    const int w = 37;
+    const int h = 9;
+    int32_t a1 = x;
+    int32_t a2 = x + w - 1;
+    spd2010AlignWindowX(a1, a2);
+    const int out_w = a2 - a1 + 1;
+    const int left_pad = x - a1;
+
+    std::vector<uint16_t> src(static_cast<size_t>(w) * h);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = pattern(static_cast<int>(i));
+    }
+    std::vector<uint16_t> strip(static_cast<size_t>(out_w) * h);
+    for (int row = 0; row < h; ++row) {
+        spd2010ExtractRow(strip.data() + row * out_w, src.data() + row * w, w, left_pad, out_w);
+    }
+    for (int row = 0; row < h; ++row) {
+        for (int i = 0; i < out_w; ++i) {
+            int s = i - left_pad;
+            s = s < 0 ? 0 : (s >= w ? w - 1 : s);
+            TEST_ASSERT_EQUAL_HEX16(spd2010Swap16(src[row * w + s]), strip[row * out_w + i]);
+        }
+    }
+}
+
+void test_aligned_area_needs_no_padding() {
+    int32_t a1 = 8;
+    int32_t a2 = 8 + 64 - 1;
+    spd2010AlignWindowX(a1, a2);
+    TEST_ASSERT_EQUAL_INT32(8, a1);
+    TEST_ASSERT_EQUAL_INT32(71, a2);
+
+    std::vector<uint16_t> src(64);
+    std::vector<uint16_t> out(64);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = pattern(static_cast<int>(i));
+    }
+    spd2010ExtractRow(out.data(), src.data(), 64, 0, 64);
+    for (size_t i = 0; i < src.size(); ++i) {
+        TEST_ASSERT_EQUAL_HEX16(spd2010Swap16(src[i]), out[i]);
+    }
+}
+
+void test_chords_cover_every_pixel_the_circle_touches() {
+    for (int y = 0; y < SPD2010_HEIGHT; ++y) {
+        for (int x = 0; x < SPD2010_WIDTH; ++x) {
+            if (pixelTouchesCircle(x, y) && (x < gChords.left[y] || x > gChords.right[y])) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "visible pixel (%d, %d) outside chord", x, y);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+void test_chords_are_aligned_symmetric_and_tight() {
+    for (int y = 0; y < SPD2010_HEIGHT; ++y) {
+        const int left = gChords.left[y];
+        const int right = gChords.right[y];
+        TEST_ASSERT_TRUE(spd2010WindowXAligned(left, right - left + 1));
+        TEST_ASSERT_EQUAL_INT(gChords.left[SPD2010_HEIGHT - 1 - y], left);
+        TEST_ASSERT_EQUAL_INT(gChords.right[SPD2010_HEIGHT - 1 - y], right);
+        TEST_ASSERT_EQUAL_INT(SPD2010_WIDTH - 1, left + right);
+        // Alignment may add at most three hidden columns per side.
+        int firstVisible = left;
+        while (firstVisible < right && !pixelTouchesCircle(firstVisible, y)) {
+            ++firstVisible;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(3, firstVisible - left);
+    }
+    TEST_ASSERT_EQUAL_INT(0, gChords.left[SPD2010_HEIGHT / 2]);
+    TEST_ASSERT_EQUAL_INT(SPD2010_WIDTH - 1, gChords.right[SPD2010_HEIGHT / 2]);
+}
+
+void test_masked_frame_bytes_match_the_table() {
+    uint32_t bytes = 0;
+    for (int y = 0; y < SPD2010_HEIGHT; ++y) {
+        bytes += static_cast<uint32_t>(gChords.right[y] - gChords.left[y] + 1) * 2U;
+    }
+    TEST_ASSERT_EQUAL_UINT32(bytes, gChords.maskedFrameBytes);
+    const uint32_t fullFrame = SPD2010_WIDTH * SPD2010_HEIGHT * 2U;
+    // Between the circle's own area (pi/4 of the square) and 85% of the frame.
+    TEST_ASSERT_GREATER_THAN_UINT32(fullFrame * 785U / 1000U, gChords.maskedFrameBytes);
+    TEST_ASSERT_LESS_THAN_UINT32(fullFrame * 85U / 100U, gChords.maskedFrameBytes);
+    char line[96];
+    snprintf(line, sizeof(line), "[BENCH] full-frame QSPI payload %lu B unmasked, %lu B masked",
+             static_cast<unsigned long>(fullFrame), static_cast<unsigned long>(gChords.maskedFrameBytes));
+    TEST_MESSAGE(line);
+}
+
+// Clamp and then align, as lvglRounderCb does: the result must stay on the
+// 4-pixel grid, inside the original area (up to alignment), and keep every
+// visible pixel of it.
+void test_rounder_clamp_keeps_every_visible_pixel() {
+    uint32_t rng = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        rng = rng * 1664525U + 1013904223U;
+        const int32_t y1 = static_cast<int32_t>((rng >> 8) % SPD2010_HEIGHT);
+        rng = rng * 1664525U + 1013904223U;
+        const int32_t y2 = y1 + static_cast<int32_t>((rng >> 8) % (SPD2010_HEIGHT - y1));
+        rng = rng * 1664525U + 1013904223U;
+        const int32_t ox1 = static_cast<int32_t>((rng >> 8) % SPD2010_WIDTH);
+        rng = rng * 1664525U + 1013904223U;
+        const int32_t ox2 = ox1 + static_cast<int32_t>((rng >> 8) % (SPD2010_WIDTH - ox1));
+
+        int32_t x1 = ox1;
+        int32_t x2 = ox2;
+        spd2010ClampWindowToVisible(gChords, y1, y2, x1, x2);
+        spd2010AlignWindowX(x1, x2);
+        TEST_ASSERT_TRUE(spd2010WindowXAligned(x1, x2 - x1 + 1));
+        TEST_ASSERT_GREATER_OR_EQUAL(ox1 & ~3, x1);
+        TEST_ASSERT_LESS_OR_EQUAL(ox2 | 3, x2);
+        for (int32_t y = y1; y <= y2; ++y) {
+            const int32_t vis1 = ox1 > gChords.left[y] ? ox1 : gChords.left[y];
+            const int32_t vis2 = ox2 < gChords.right[y] ? ox2 : gChords.right[y];
+            if (vis1 <= vis2 && (vis1 < x1 || vis2 > x2)) {
+                TEST_FAIL_MESSAGE("clamp dropped a visible pixel");
+            }
+        }
+    }
+}
+
+void test_clamp_shrinks_a_full_width_corner_band() {
+    // The top 16 rows: only the middle of the row is ever visible.
+    int32_t x1 = 0;
+    int32_t x2 = SPD2010_WIDTH - 1;
+    spd2010ClampWindowToVisible(gChords, 0, 15, x1, x2);
+    TEST_ASSERT_EQUAL_INT32(gChords.left[15], x1);
+    TEST_ASSERT_EQUAL_INT32(gChords.right[15], x2);
+    TEST_ASSERT_GREATER_THAN(100, x1);
+}
+
+void test_clamp_leaves_corner_only_and_offscreen_areas_alone() {
+    int32_t x1 = 0;
+    int32_t x2 = 7;
+    TEST_ASSERT_FALSE(rowHasVisiblePixel(0, x1, x2));
+    spd2010ClampWindowToVisible(gChords, 0, 7, x1, x2);
+    TEST_ASSERT_EQUAL_INT32(0, x1);
+    TEST_ASSERT_EQUAL_INT32(7, x2);
+
+    x1 = 10;
+    x2 = 20;
+    spd2010ClampWindowToVisible(gChords, SPD2010_HEIGHT + 5, SPD2010_HEIGHT + 9, x1, x2);
+    TEST_ASSERT_EQUAL_INT32(10, x1);
+    TEST_ASSERT_EQUAL_INT32(20, x2);
+
+    // Rows above the screen are ignored, not read out of bounds.
+    x1 = 0;
+    x2 = SPD2010_WIDTH - 1;
+    spd2010ClampWindowToVisible(gChords, -20, 0, x1, x2);
+    TEST_ASSERT_EQUAL_INT32(gChords.left[0], x1);
+    TEST_ASSERT_EQUAL_INT32(gChords.right[0], x2);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_align_window_x_covers_every_span);
+    RUN_TEST(test_align_window_x_is_idempotent);
+    RUN_TEST(test_window_x_aligned_predicate);
+    RUN_TEST(test_fallback_pads_misaligned_rows_with_edge_pixels);
+    RUN_TEST(test_fallback_strip_with_odd_width_rows);
+    RUN_TEST(test_aligned_area_needs_no_padding);
+    RUN_TEST(test_chords_cover_every_pixel_the_circle_touches);
+    RUN_TEST(test_chords_are_aligned_symmetric_and_tight);
+    RUN_TEST(test_masked_frame_bytes_match_the_table);
+    RUN_TEST(test_rounder_clamp_keeps_every_visible_pixel);
+    RUN_TEST(test_clamp_shrinks_a_full_width_corner_band);
+    RUN_TEST(test_clamp_leaves_corner_only_and_offscreen_areas_alone);
+    return UNITY_END();
+}
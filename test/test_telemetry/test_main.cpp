@@ -0,0 +1,158 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <freertos/task.h>
+
+#include "fpl_config.h"
+#include "telemetry.h"
+
+#include <string>
+
+// Samples heap and stack figures the stand-ins report, on a clock the test
+// advances itself. Telemetry keeps its ring across tests, so each test that
+// reads series fills the whole ring first.
+
+namespace {
+
+uint32_t gNowMs = 1000;
+HostTask gTask;
+
+fpl_host::HeapReport &internalHeap() { return fpl_host::heapReport(MALLOC_CAP_INTERNAL); }
+fpl_host::HeapReport &psramHeap() { return fpl_host::heapReport(MALLOC_CAP_SPIRAM); }
+
+// A heap and stack with nothing to warn about.
+void healthy() {
+    internalHeap() = {200U * 1024U, 96U * 1024U, 180U * 1024U};
+    psramHeap() = {4U * 1024U * 1024U, 2U * 1024U * 1024U, 4U * 1024U * 1024U};
+    gTask.stackHighWater = 4096;
+}
+
+// One sample, one interval after the last.
+std::string sample() {
+    gNowMs += FPL_TELEMETRY_INTERVAL_MS;
+    telemetryTick(gNowMs);
+    return Serial.takeCaptured();
+}
+
+std::string stats() {
+    telemetryPrintStats();
+    return Serial.takeCaptured();
+}
+
+size_t count(const std::string &text, const std::string &needle) {
+    size_t n = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        n++;
+    }
+    return n;
+}
+
+}  // namespace
+
+void setUp() {
+    healthy();
+    Serial.takeCaptured();
+}
+void tearDown() {}
+
+void test_no_samples_before_the_first_tick() {
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, stats().find("[STATS] no samples yet"));
+}
+
+void test_tick_samples_once_per_interval() {
+    telemetryTick(gNowMs);
+    telemetryTick(gNowMs + FPL_TELEMETRY_INTERVAL_MS - 1);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, stats().find("[STATS] 1 samples every "));
+    sample();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, stats().find("[STATS] 2 samples every "));
+}
+
+// A heap losing 512 bytes per 10 s sample: 3 KB a minute over the ring.
+void test_series_report_now_min_max_and_trend() {
+    const uint32_t startFree = 200U * 1024U;
+    for (uint32_t i = 0; i < FPL_TELEMETRY_SAMPLES; ++i) {
+        internalHeap().freeBytes = startFree - i * 512U;
+        gTask.stackHighWater = 3000 - i;
+        sample();
+    }
+    const std::string out = stats();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[STATS] 64 samples every 10000 ms"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos,
+                          out.find("[STATS] internal free    now    168  min    168  max    200  trend -3/min KB\n"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos,
+                          out.find("[STATS] internal largest now     96  min     96  max     96  trend +0/min KB\n"));
+    // 63 bytes of stack lost over 630 s.
+    TEST_ASSERT_NOT_EQUAL(
+        std::string::npos,
+        out.find("[STATS] probe stack      now   2937  min   2937  max   3000  trend -6/min bytes unused\n"));
+    // No run-time stats on the host: load is unknown rather than zero.
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[STATS] cpu0 load        n/a\n"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[STATS] probe cpu        n/a\n"));
+}
+
+// Once the ring wraps, the series only cover the newest FPL_TELEMETRY_SAMPLES.
+void test_ring_keeps_the_newest_samples() {
+    internalHeap().freeBytes = 300U * 1024U;
+    sample();
+    internalHeap().freeBytes = 150U * 1024U;
+    for (uint32_t i = 0; i < FPL_TELEMETRY_SAMPLES; ++i) {
+        sample();
+    }
+    const std::string out = stats();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find("[STATS] 64 samples every "));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos,
+                          out.find("[STATS] internal free    now    150  min    150  max    150  trend +0/min KB\n"));
+}
+
+// Each condition logs when it appears, stays quiet while it lasts, and logs
+// again only after it cleared.
+void test_warnings_fire_on_the_rising_edge() {
+    internalHeap().largestBlock = 40U * 1024U;  // 20% of 200 KB free
+    std::string out = sample();
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: internal heap fragmented, largest block 40960 of"));
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: "));
+    TEST_ASSERT_EQUAL_UINT32(0, count(sample(), "[STATS] warning: "));
+
+    internalHeap().largestBlock = 96U * 1024U;
+    TEST_ASSERT_EQUAL_UINT32(0, count(sample(), "[STATS] warning: "));
+    internalHeap().largestBlock = 40U * 1024U;
+    TEST_ASSERT_EQUAL_UINT32(1, count(sample(), "internal heap fragmented"));
+
+    // A second condition raised alongside one already active logs only itself.
+    internalHeap().freeBytes = 20U * 1024U;
+    internalHeap().largestBlock = 16U * 1024U;
+    out = sample();
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: "));
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: internal heap low, 20480 bytes free\n"));
+}
+
+void test_psram_and_stack_warnings() {
+    psramHeap().largestBlock = 512U * 1024U;  // 12.5% of 4 MB
+    gTask.stackHighWater = 400;
+    const std::string out = sample();
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: PSRAM fragmented, largest block 524288 of 4194304"));
+    TEST_ASSERT_EQUAL_UINT32(1, count(out, "[STATS] warning: probe has only 400 bytes of stack left unused\n"));
+    TEST_ASSERT_EQUAL_UINT32(0, count(sample(), "[STATS] warning: "));
+
+    // No PSRAM at all is not fragmentation.
+    psramHeap() = {0, 0, 0};
+    gTask.stackHighWater = 4096;
+    sample();
+    TEST_ASSERT_EQUAL_UINT32(0, count(sample(), "[STATS] warning: "));
+}
+
+int main(int, char **) {
+    Serial.echo = false;
+    strncpy(gTask.name, "probe", sizeof(gTask.name) - 1);
+    telemetryRegisterTask("probe", &gTask);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_no_samples_before_the_first_tick);
+    RUN_TEST(test_tick_samples_once_per_interval);
+    RUN_TEST(test_series_report_now_min_max_and_trend);
+    RUN_TEST(test_ring_keeps_the_newest_samples);
+    RUN_TEST(test_warnings_fire_on_the_rising_edge);
+    RUN_TEST(test_psram_and_stack_warnings);
+    return UNITY_END();
+}
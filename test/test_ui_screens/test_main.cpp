@@ -0,0 +1,387 @@
+#include <unity.h>
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#include "ui_capture.h"
+#include "ui_screens.h"
+
+#include <cstring>
+#include <string>
+
+// Renders the real screens into an in-memory 412x412 RGB565 framebuffer. Each
+// full frame is also streamed as "[SHOT]" lines, so
+//   pio test -e native -f test_ui_screens -v > shots.log
+//   python3 tools/ui_shots.py shots.log out/ [--golden golden/]
+// gives the same PNGs and golden diff as `shots` on the device.
+
+namespace {
+
+constexpr size_t kBufLines = 40;
+
+uint16_t gFrame[kUiScreenWidth * kUiScreenHeight];
+alignas(4) uint8_t gDrawBuf[kUiScreenWidth * kBufLines * sizeof(uint16_t)];
+lv_display_t *gDisplay = nullptr;
+uint32_t gFlushedPixels = 0;
+
+void flushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *pxMap) {
+    const int w = lv_area_get_width(area);
+    const int h = lv_area_get_height(area);
+    const uint16_t *src = reinterpret_cast<const uint16_t *>(pxMap);
+    for (int row = 0; row < h; ++row) {
+        memcpy(&gFrame[(area->y1 + row) * kUiScreenWidth + area->x1], src + row * w, w * sizeof(uint16_t));
+    }
+    uiCaptureArea(area->x1, area->y1, w, h, pxMap);
+    gFlushedPixels += static_cast<uint32_t>(w * h);
+    lv_display_flush_ready(disp);
+}
+
+uint32_t tickCb() { return millis(); }
+
+// 4x4 opaque RGB565 stand-in for the flash kit atlas.
+const uint16_t kKitPixels[16] = {0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xF800,
+                                 0xF800, 0xFFFF, 0xFFFF, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800};
+lv_image_dsc_t gKit;
+int gKitLookups = 0;
+
+int gNotificationDemos = 0;
+int32_t gLastDeadlineDemoSec = 0;
+
+void notificationDemo() { gNotificationDemos++; }
+void deadlineDemo(int32_t secondsToDeadline) { gLastDeadlineDemoSec = secondsToDeadline; }
+
+SharedUiState gState;
+UiRuntimeState gRuntime;
+
+// Puts `mode` on display with the shot fixture and draws a full frame.
+void showFixture(UiMode mode) {
+    fillUiShotFixture(gState, gRuntime);
+    if (mode == UiMode::FinalHour) {
+        gState.nextDeadlineUtc = time(nullptr) + 45 * 60;
+    }
+    resetLiveTicker(millis());
+    loadMode(mode, LV_SCR_LOAD_ANIM_NONE);
+    if (mode == UiMode::EventPopup) {
+        bindPopupEvent(gRuntime.recentEvents[0]);
+    }
+    updateModeUi(gState, gRuntime);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(gDisplay);
+}
+
+lv_obj_t *findLabel(lv_obj_t *root, const char *text) {
+    if (lv_obj_check_type(root, &lv_label_class) && strcmp(lv_label_get_text(root), text) == 0) {
+        return root;
+    }
+    for (uint32_t i = 0; i < lv_obj_get_child_count(root); ++i) {
+        lv_obj_t *found = findLabel(lv_obj_get_child(root, static_cast<int32_t>(i)), text);
+        if (found) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+size_t countPixelsNot(uint16_t color) {
+    size_t n = 0;
+    for (uint16_t px : gFrame) {
+        n += px != color ? 1 : 0;
+    }
+    return n;
+}
+
+// What an update cost before the setters were dirty-checked: every label on
+// the screen was set again, and each set invalidated it.
+void invalidateEveryLabel(lv_obj_t *root) {
+    if (lv_obj_check_type(root, &lv_label_class)) {
+        lv_obj_invalidate(root);
+    }
+    for (uint32_t i = 0; i < lv_obj_get_child_count(root); ++i) {
+        invalidateEveryLabel(lv_obj_get_child(root, static_cast<int32_t>(i)));
+    }
+}
+
+// Runs uiTask's 10 ms update loop for a second and returns the pixels flushed.
+uint32_t flushedPixelsPerSecond(bool invalidateAll) {
+    gFlushedPixels = 0;
+    const uint32_t startMs = millis();
+    while (millis() - startMs < 1000) {
+        updateModeUi(gState, gRuntime);
+        if (invalidateAll) {
+            invalidateEveryLabel(lv_screen_active());
+        }
+        lv_refr_now(gDisplay);
+        delay(10);
+    }
+    return static_cast<uint32_t>(static_cast<uint64_t>(gFlushedPixels) * 1000U / (millis() - startMs));
+}
+
+uint32_t lvglAllocations() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.used_cnt;
+}
+
+// The rebuild the pools replaced: clean the list, then a row object and its
+// labels per entry.
+void rebuildRows(lv_obj_t *list, size_t rows, size_t labelsPerRow) {
+    lv_obj_clean(list);
+    for (size_t i = 0; i < rows; ++i) {
+        lv_obj_t *row = lv_obj_create(list);
+        lv_obj_set_size(row, lv_pct(100), 34);
+        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
+        lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
+        for (size_t j = 0; j < labelsPerRow; ++j) {
+            lv_obj_t *label = lv_label_create(row);
+            lv_label_set_text_fmt(label, "row %u", static_cast<unsigned>(i));
+            lv_obj_align(label, LV_ALIGN_LEFT_MID, static_cast<int32_t>(j * 100), 0);
+        }
+    }
+}
+
+// Stands in for the PSRAM kit cache: only Arsenal has a kit.
+const lv_image_dsc_t *kitImage(const char *team, bool) {
+    gKitLookups++;
+    return strcmp(team, "arsenal") == 0 ? &gKit : nullptr;
+}
+
+}  // namespace
+
+void setUp() {
+    gFlushedPixels = 0;
+    gKitLookups = 0;
+    invalidateUiLists();
+}
+void tearDown() {}
+
+// Every screen draws something besides its background, and the full frame
+// streams as a well-formed "[SHOT]" block for tools/ui_shots.py.
+void test_every_screen_renders_and_streams_a_shot() {
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        const UiMode mode = static_cast<UiMode>(i);
+        memset(gFrame, 0, sizeof(gFrame));
+        showFixture(mode);
+        TEST_ASSERT_EQUAL(static_cast<int>(mode), static_cast<int>(currentUiMode()));
+
+        TEST_ASSERT_TRUE(uiCaptureBegin(kUiScreenWidth, kUiScreenHeight));
+        Serial.takeCaptured();
+        lv_obj_invalidate(lv_screen_active());
+        gFlushedPixels = 0;
+        const uint32_t startUs = micros();
+        lv_refr_now(gDisplay);
+        const uint32_t renderUs = micros() - startUs;
+        uiCaptureDump(kUiModeNames[i]);
+        Serial.printf("[SHOT] frame %s full render_us=%lu invalidated_px=%lu flushed_bytes=%lu\n", kUiModeNames[i],
+                      static_cast<unsigned long>(renderUs), static_cast<unsigned long>(gFlushedPixels),
+                      static_cast<unsigned long>(gFlushedPixels * sizeof(uint16_t)));
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(kUiScreenWidth) * kUiScreenHeight, gFlushedPixels);
+
+        // Left of every widget on the middle row is plain screen background.
+        const uint16_t background = gFrame[(kUiScreenHeight / 2) * kUiScreenWidth + 16];
+        TEST_ASSERT_GREATER_THAN_MESSAGE(500, countPixelsNot(background), kUiModeNames[i]);
+
+        const std::string out = Serial.takeCaptured();
+        char begin[64];
+        snprintf(begin, sizeof(begin), "[SHOT] begin %s 412 412 rle16\n", kUiModeNames[i]);
+        TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find(begin));
+        TEST_ASSERT_NOT_EQUAL(std::string::npos, out.find(std::string("[SHOT] end ") + kUiModeNames[i] + " "));
+    }
+}
+
+// Dirty-checked setters: an update with unchanged data must not invalidate
+// anything on the screens that do not follow the clock.
+void test_unchanged_update_redraws_nothing() {
+    const UiMode still[] = {UiMode::Idle, UiMode::EventPopup, UiMode::EventsList, UiMode::Squad};
+    for (UiMode mode : still) {
+        showFixture(mode);
+        gFlushedPixels = 0;
+        updateModeUi(gState, gRuntime);
+        lv_refr_now(gDisplay);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, gFlushedPixels, kUiModeNames[static_cast<size_t>(mode)]);
+    }
+}
+
+// A changed value redraws its label, not the whole screen.
+void test_changed_value_redraws_part_of_the_screen() {
+    showFixture(UiMode::Idle);
+    gFlushedPixels = 0;
+    gState.gwPoints += 4;
+    updateModeUi(gState, gRuntime);
+    lv_refr_now(gDisplay);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, gFlushedPixels);
+    TEST_ASSERT_LESS_THAN_UINT32(static_cast<uint32_t>(kUiScreenWidth) * kUiScreenHeight / 4, gFlushedPixels);
+}
+
+// Headless benchmark: invalidated pixels per second on each screen, with
+// every label re-set on each update (before) and with the dirty-checked
+// setters (after).
+void test_benchmark_invalidated_pixels_per_second() {
+    Serial.echo = false;
+    for (size_t i = 0; i < kUiModeCount; ++i) {
+        const UiMode mode = static_cast<UiMode>(i);
+        showFixture(mode);
+        const uint32_t before = flushedPixelsPerSecond(true);
+        const uint32_t after = flushedPixelsPerSecond(false);
+        char line[128];
+        snprintf(line, sizeof(line), "[BENCH] ui %-11s invalidated px/s: before %7lu after %7lu", kUiModeNames[i],
+                 static_cast<unsigned long>(before), static_cast<unsigned long>(after));
+        TEST_MESSAGE(line);
+        TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(before, after, kUiModeNames[i]);
+    }
+    Serial.echo = true;
+}
+
+// Headless benchmark: a list refresh rebinds the pooled rows, so it allocates
+// no LVGL objects and keeps the scroll position, where the old rebuild
+// allocated every row again.
+void test_benchmark_list_refresh_allocations() {
+    Serial.echo = false;
+    showFixture(UiMode::Squad);
+    lv_obj_t *squadList = lv_obj_get_parent(lv_obj_get_parent(findLabel(lv_screen_active(), "Raya")));
+    lv_obj_scroll_to_y(squadList, 120, LV_ANIM_OFF);
+    const int32_t scrollY = lv_obj_get_scroll_y(squadList);
+
+    constexpr int kRefreshes = 20;
+    const uint32_t allocsBefore = lvglAllocations();
+    uint32_t updateUs = 0;
+    uint32_t renderUs = 0;
+    for (int n = 0; n < kRefreshes; ++n) {
+        for (size_t r = 0; r < gRuntime.squadCount; ++r) {
+            gRuntime.squadRows[r].points = static_cast<int>((r + n) % 17);
+        }
+        gRuntime.squadVersion++;
+        uint32_t startUs = micros();
+        updateModeUi(gState, gRuntime);
+        updateUs += micros() - startUs;
+        startUs = micros();
+        lv_refr_now(gDisplay);
+        renderUs += micros() - startUs;
+    }
+    TEST_ASSERT_EQUAL_UINT32(allocsBefore, lvglAllocations());
+    TEST_ASSERT_EQUAL_INT32(scrollY, lv_obj_get_scroll_y(squadList));
+
+    // The same shape rebuilt the old way, on a scratch screen.
+    lv_obj_t *scratch = lv_obj_create(nullptr);
+    lv_obj_t *scratchList = lv_obj_create(scratch);
+    uint32_t rebuildUs = 0;
+    uint32_t rebuildAllocs = 0;
+    for (int n = 0; n < kRefreshes; ++n) {
+        const uint32_t allocs = lvglAllocations();
+        const uint32_t startUs = micros();
+        rebuildRows(scratchList, gRuntime.squadCount, 3);
+        rebuildUs += micros() - startUs;
+        if (n == 0) {
+            rebuildAllocs = lvglAllocations() - allocs;
+        }
+    }
+    lv_obj_delete(scratch);
+
+    char line[160];
+    snprintf(line, sizeof(line),
+             "[BENCH] squad refresh: rebind %lu us + render %lu us, 0 allocs; rebuild %lu us, %lu allocs",
+             static_cast<unsigned long>(updateUs / kRefreshes), static_cast<unsigned long>(renderUs / kRefreshes),
+             static_cast<unsigned long>(rebuildUs / kRefreshes), static_cast<unsigned long>(rebuildAllocs));
+    TEST_MESSAGE(line);
+    Serial.echo = true;
+}
+
+void test_popup_binds_kit_only_for_known_teams() {
+    UiEventItem event;
+    fillUiShotEvent(event, "G", "GOAL!", "Saka", "arsenal", 5, 725);
+    showFixture(UiMode::EventPopup);
+    gKitLookups = 0;
+    bindPopupEvent(event);
+    lv_refr_now(gDisplay);
+    TEST_ASSERT_EQUAL_INT(1, gKitLookups);
+    // The stub kit's red border is on screen somewhere.
+    TEST_ASSERT_GREATER_THAN(0, kUiScreenWidth * kUiScreenHeight - countPixelsNot(0xF800));
+
+    fillUiShotEvent(event, "G", "GOAL!", "Isak", "newcastle", 5, 725);
+    bindPopupEvent(event);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(gDisplay);
+    TEST_ASSERT_EQUAL_INT(2, gKitLookups);
+    TEST_ASSERT_EQUAL(kUiScreenWidth * kUiScreenHeight, countPixelsNot(0xF800));
+}
+
+// The squad screen's demo buttons go through the hooks given to createUi().
+void test_squad_demo_buttons_call_the_hooks() {
+    showFixture(UiMode::Squad);
+    lv_obj_t *notify = findLabel(lv_screen_active(), "Notify");
+    lv_obj_t *deadline7 = findLabel(lv_screen_active(), "7m");
+    TEST_ASSERT_NOT_NULL(notify);
+    TEST_ASSERT_NOT_NULL(deadline7);
+
+    lv_obj_send_event(lv_obj_get_parent(notify), LV_EVENT_CLICKED, nullptr);
+    lv_obj_send_event(lv_obj_get_parent(deadline7), LV_EVENT_CLICKED, nullptr);
+    TEST_ASSERT_EQUAL_INT(1, gNotificationDemos);
+    TEST_ASSERT_EQUAL_INT32(7 * 60, gLastDeadlineDemoSec);
+}
+
+void test_auto_mode_follows_the_deadline() {
+    SharedUiState state;
+    loadMode(UiMode::Idle, LV_SCR_LOAD_ANIM_NONE);
+    TEST_ASSERT_EQUAL(static_cast<int>(UiMode::Idle), static_cast<int>(determineAutoMode(state)));
+
+    state.hasNextDeadline = true;
+    state.nextDeadlineUtc = time(nullptr) + 3 * 3600;
+    TEST_ASSERT_EQUAL(static_cast<int>(UiMode::Deadline), static_cast<int>(determineAutoMode(state)));
+    state.nextDeadlineUtc = time(nullptr) + 30 * 60;
+    TEST_ASSERT_EQUAL(static_cast<int>(UiMode::FinalHour), static_cast<int>(determineAutoMode(state)));
+    state.isLiveGw = true;
+    TEST_ASSERT_EQUAL(static_cast<int>(UiMode::Live), static_cast<int>(determineAutoMode(state)));
+
+    // Overlays stay until the user leaves them.
+    loadMode(UiMode::Squad, LV_SCR_LOAD_ANIM_NONE);
+    TEST_ASSERT_EQUAL(static_cast<int>(UiMode::Squad), static_cast<int>(determineAutoMode(state)));
+}
+
+void test_idle_sleeps_until_the_deadline_screen_is_due() {
+    SharedUiState state;
+    loadMode(UiMode::Idle, LV_SCR_LOAD_ANIM_NONE);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, msUntilScreenChange(state, gRuntime, millis()));
+
+    state.hasNextDeadline = true;
+    state.nextDeadlineUtc = time(nullptr) + 6 * 3600 + 20;
+    const uint32_t waitMs = msUntilScreenChange(state, gRuntime, millis());
+    TEST_ASSERT_UINT32_WITHIN(1000, 20000, waitMs);
+
+    // The live screen wakes for its status-dot pulse at the latest.
+    showFixture(UiMode::Live);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(750, msUntilScreenChange(gState, gRuntime, millis()));
+}
+
+int main(int, char **) {
+    lv_init();
+    lv_tick_set_cb(tickCb);
+    gDisplay = lv_display_create(kUiScreenWidth, kUiScreenHeight);
+    lv_display_set_flush_cb(gDisplay, flushCb);
+    lv_display_set_buffers(gDisplay, gDrawBuf, nullptr, sizeof(gDrawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    gKit.header.magic = LV_IMAGE_HEADER_MAGIC;
+    gKit.header.cf = LV_COLOR_FORMAT_RGB565;
+    gKit.header.w = 4;
+    gKit.header.h = 4;
+    gKit.header.stride = 4 * sizeof(uint16_t);
+    gKit.data_size = sizeof(kKitPixels);
+    gKit.data = reinterpret_cast<const uint8_t *>(kKitPixels);
+
+    UiScreenHooks hooks;
+    hooks.kitImage = kitImage;
+    hooks.notificationDemo = notificationDemo;
+    hooks.deadlineDemo = deadlineDemo;
+    createUi(hooks);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_every_screen_renders_and_streams_a_shot);
+    RUN_TEST(test_unchanged_update_redraws_nothing);
+    RUN_TEST(test_changed_value_redraws_part_of_the_screen);
+    RUN_TEST(test_benchmark_invalidated_pixels_per_second);
+    RUN_TEST(test_benchmark_list_refresh_allocations);
+    RUN_TEST(test_popup_binds_kit_only_for_known_teams);
+    RUN_TEST(test_squad_demo_buttons_call_the_hooks);
+    RUN_TEST(test_auto_mode_follows_the_deadline);
+    RUN_TEST(test_idle_sleeps_until_the_deadline_screen_is_due);
+    return UNITY_END();
+}
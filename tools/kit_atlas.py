@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Pack every `.kit` into one atlas blob for the `kits` flash partition.
+
+    python3 tools/kit_atlas.py data/kits kits_atlas.bin            # pack
+    python3 tools/kit_atlas.py data/kits kits_atlas.bin --verify   # look up every kit and compare
+
+The firmware memory-maps the partition and points each lv_image_dsc_t straight
+at its entry, so kits are stored already decoded (the LVGL I4/I8 layout that
+src/kit_cache.cpp would otherwise build in PSRAM):
+
+    header:  magic "KATL" | u16 version | u16 count | u32 total bytes | u32 index offset
+    index:   count x (char slug[32] | u32 offset | u32 size | u16 width | u16 height | u8 bpp | 3 pad)
+             sorted by slug (strcmp order) so the device can binary-search it
+    data:    per kit, palette padded to 16/256 ARGB8888 entries then index rows,
+             each starting on a 4-byte boundary
+
+A slug is the file stem without its size suffix, e.g. "arsenal_gk".
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import kit_encode  # noqa: E402
+
+MAGIC = b"KATL"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<32sIIHHB3x")
+SLUG_MAX = 31
+ALIGN = 4
+SIZE_SUFFIX_RE = re.compile(r"_\d+x\d+\.kit$")
+
+
+def decoded_image(blob):
+    """Expand a .kit file into the LVGL indexed buffer the device draws from."""
+    magic, width, height, bpp, flags, entries, payload_len = kit_encode.HEADER.unpack_from(blob)
+    if magic != kit_encode.MAGIC:
+        raise ValueError("bad magic")
+    off = kit_encode.HEADER.size
+    slots = 16 if bpp == 4 else 256
+    palette = bytearray(slots * 4)
+    palette[:entries * 4] = blob[off:off + entries * 4]
+    off += entries * 4
+    payload = blob[off:off + payload_len]
+    packed_len = ((width + 1) // 2 if bpp == 4 else width) * height
+    packed = kit_encode.rle_decode(payload, packed_len) if flags & kit_encode.FLAG_RLE else bytes(payload)
+    if len(packed) != packed_len:
+        raise ValueError("index stream is %d bytes, expected %d" % (len(packed), packed_len))
+    return width, height, bpp, bytes(palette) + packed
+
+
+def slug_for(name):
+    return SIZE_SUFFIX_RE.sub("", name)
+
+
+def pack(kits):
+    """kits: {slug: .kit bytes}. Returns the atlas blob."""
+    ordered = sorted(kits, key=lambda s: s.encode())
+    index_offset = HEADER.size
+    data_offset = index_offset + ENTRY.size * len(ordered)
+    entries = bytearray()
+    data = bytearray()
+    for slug in ordered:
+        if len(slug.encode()) > SLUG_MAX:
+            raise ValueError("slug too long: %s" % slug)
+        width, height, bpp, image = decoded_image(kits[slug])
+        while (data_offset + len(data)) % ALIGN:
+            data.append(0)
+        entries += ENTRY.pack(slug.encode(), data_offset + len(data), len(image), width, height, bpp)
+        data += image
+    total = data_offset + len(data)
+    return HEADER.pack(MAGIC, VERSION, len(ordered), total, index_offset) + bytes(entries) + bytes(data)
+
+
+def find(atlas, slug):
+    """Binary search mirroring kitAtlasFind(); returns (width, height, bpp, bytes) or None."""
+    magic, version, count, total, index_offset = HEADER.unpack_from(atlas)
+    if magic != MAGIC or version != VERSION or total > len(atlas):
+        raise ValueError("bad atlas header")
+    key = slug.encode()
+    lo, hi = 0, count
+    while lo < hi:
+        mid = (lo + hi) // 2
+        name, offset, size, width, height, bpp = ENTRY.unpack_from(atlas, index_offset + mid * ENTRY.size)
+        name = name.rstrip(b"\0")
+        if name == key:
+            return width, height, bpp, atlas[offset:offset + size]
+        if name < key:
+            lo = mid + 1
+        else:
+            hi = mid
+    return None
+
+
+def load_kits(source):
+    kits = {}
+    for name in sorted(os.listdir(source)):
+        if name.endswith(".kit"):
+            with open(os.path.join(source, name), "rb") as f:
+                kits[slug_for(name)] = f.read()
+    return kits
+
+
+def verify(kits, atlas):
+    failed = False
+    for slug, blob in sorted(kits.items()):
+        found = find(atlas, slug)
+        if found is None or found != decoded_image(blob):
+            print("%s: FAIL" % slug, file=sys.stderr)
+            failed = True
+    for missing in ("", "zz_not_a_team", "aaa_not_a_team"):
+        if find(atlas, missing) is not None:
+            print("lookup of %r should miss" % missing, file=sys.stderr)
+            failed = True
+    return not failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="directory of .kit files")
+    parser.add_argument("output", help="atlas blob to write (or check with --verify)")
+    parser.add_argument("--verify", action="store_true", help="look up every kit in an existing atlas")
+    args = parser.parse_args()
+
+    kits = load_kits(args.source)
+    if not args.verify:
+        atlas = pack(kits)
+        with open(args.output, "wb") as f:
+            f.write(atlas)
+    with open(args.output, "rb") as f:
+        atlas = f.read()
+    ok = verify(kits, atlas)
+    print("%d kits, %d bytes%s" % (len(kits), len(atlas), "" if ok else " (verify FAILED)"))
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""Convert raw RGB565 kit images into the palette-indexed `.kit` format.
+
+    python3 tools/kit_encode.py assets/kits data/kits            # encode every *.rgb565
+    python3 tools/kit_encode.py assets/kits data/kits --verify   # decode each .kit and compare
+
+Raw sources live in assets/kits (not uploaded); data/kits is the LittleFS image.
+
+A `.kit` file is a 16-byte header, an ARGB8888 palette and an RLE index stream:
+
+    magic "KIT1" | u16 width | u16 height | u8 bpp (4|8) | u8 flags (bit0 RLE)
+    u16 palette entries | u32 payload bytes
+    palette: entries x (B, G, R, A)      -- lv_color32_t order
+    payload: PackBits-style runs of index bytes (LVGL I4/I8 row layout)
+
+The decoded buffer (palette padded to 16/256 entries, then indices) is exactly
+the data of an LVGL LV_COLOR_FORMAT_I4/I8 image. The flat background colour
+becomes palette entry 0 with alpha 0, so kits draw without a rectangle.
+Kits with more than 255 foreground colours (anti-aliased edges) are reduced
+with a median cut; the per-file worst channel error is reported.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b"KIT1"
+HEADER = struct.Struct("<4sHHBBHI")
+FLAG_RLE = 0x01
+NAME_RE = re.compile(r"_(\d+)x(\d+)\.rgb565$")
+
+
+def rgb565_to_rgb888(px):
+    r = (px >> 11) & 0x1F
+    g = (px >> 5) & 0x3F
+    b = px & 0x1F
+    return ((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2))
+
+
+def median_cut(counts, max_colors):
+    """counts: {rgb888: pixel count}. Returns a list of at most max_colors rgb888 tuples."""
+    def spans(box):
+        return [max(rgb[i] for rgb, _ in box) - min(rgb[i] for rgb, _ in box) for i in range(3)]
+
+    boxes = [list(counts.items())]
+    while len(boxes) < max_colors:
+        # Split the box with the widest channel range at its pixel-weighted median.
+        # Choosing by range rather than population bounds the worst-case error of
+        # rare edge colours, which a count-driven split leaves far off.
+        boxes.sort(key=lambda bx: max(spans(bx)) if len(bx) > 1 else -1)
+        box = boxes.pop()
+        if len(box) < 2:
+            boxes.append(box)
+            break
+        box_spans = spans(box)
+        ch = box_spans.index(max(box_spans))
+        box.sort(key=lambda item: item[0][ch])
+        half = sum(c for _, c in box) / 2
+        acc = 0
+        cut = 1
+        for i, (_, c) in enumerate(box):
+            acc += c
+            if acc >= half:
+                cut = max(1, min(len(box) - 1, i + 1))
+                break
+        boxes.append(box[:cut])
+        boxes.append(box[cut:])
+
+    palette = []
+    for box in boxes:
+        total = sum(c for _, c in box)
+        palette.append(tuple(int(round(sum(rgb[i] * c for rgb, c in box) / total)) for i in range(3)))
+    return palette
+
+
+def nearest(palette, rgb):
+    best = 0
+    best_d = None
+    for i, p in enumerate(palette):
+        d = (p[0] - rgb[0]) ** 2 + (p[1] - rgb[1]) ** 2 + (p[2] - rgb[2]) ** 2
+        if best_d is None or d < best_d:
+            best, best_d = i, d
+    return best
+
+
+def rle_encode(data):
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out.append(126 + run)  # 128..255 -> repeat next byte (run) times
+            out.append(data[i])
+            i += run
+            continue
+        start = i
+        while i < n and i - start < 128:
+            if i + 1 < n and data[i + 1] == data[i]:
+                break
+            i += 1
+        out.append(i - start - 1)  # 0..127 -> (n + 1) literal bytes follow
+        out.extend(data[start:i])
+    return bytes(out)
+
+
+def rle_decode(payload, expected):
+    out = bytearray()
+    i = 0
+    while i < len(payload):
+        ctrl = payload[i]
+        i += 1
+        if ctrl < 128:
+            out.extend(payload[i:i + ctrl + 1])
+            i += ctrl + 1
+        else:
+            out.extend(bytes([payload[i]]) * (ctrl - 126))
+            i += 1
+    if len(out) != expected:
+        raise ValueError("RLE stream decodes to %d bytes, expected %d" % (len(out), expected))
+    return bytes(out)
+
+
+def pack_indices(indices, width, height, bpp):
+    if bpp == 8:
+        return bytes(indices)
+    stride = (width + 1) // 2
+    out = bytearray(stride * height)
+    for y in range(height):
+        for x in range(width):
+            # LVGL indexed formats are MSB-first.
+            out[y * stride + x // 2] |= indices[y * width + x] << (4 if (x & 1) == 0 else 0)
+    return bytes(out)
+
+
+def unpack_indices(packed, width, height, bpp):
+    if bpp == 8:
+        return list(packed)
+    stride = (width + 1) // 2
+    return [(packed[y * stride + x // 2] >> (4 if (x & 1) == 0 else 0)) & 0x0F
+            for y in range(height) for x in range(width)]
+
+
+def encode(pixels, width, height):
+    background = pixels[0]
+    counts = {}
+    for px in pixels:
+        if px != background:
+            rgb = rgb565_to_rgb888(px)
+            counts[rgb] = counts.get(rgb, 0) + 1
+
+    if len(counts) <= 255:
+        colors = sorted(counts)
+    else:
+        colors = median_cut(counts, 255)
+    lookup = {rgb: (colors.index(rgb) if rgb in colors else nearest(colors, rgb)) + 1 for rgb in counts}
+
+    palette = [(0, 0, 0, 0)] + [(rgb[0], rgb[1], rgb[2], 255) for rgb in colors]
+    bpp = 4 if len(palette) <= 16 else 8
+    indices = [0 if px == background else lookup[rgb565_to_rgb888(px)] for px in pixels]
+
+    packed = pack_indices(indices, width, height, bpp)
+    payload = rle_encode(packed)
+    flags = FLAG_RLE
+    if len(payload) >= len(packed):
+        payload, flags = packed, 0
+
+    blob = bytearray(HEADER.pack(MAGIC, width, height, bpp, flags, len(palette), len(payload)))
+    for r, g, b, a in palette:
+        blob.extend((b, g, r, a))
+    blob.extend(payload)
+    return bytes(blob), len(counts)
+
+
+def decode(blob):
+    magic, width, height, bpp, flags, entries, payload_len = HEADER.unpack_from(blob)
+    if magic != MAGIC:
+        raise ValueError("bad magic")
+    off = HEADER.size
+    palette = [(blob[off + i * 4 + 2], blob[off + i * 4 + 1], blob[off + i * 4], blob[off + i * 4 + 3])
+               for i in range(entries)]
+    off += entries * 4
+    payload = blob[off:off + payload_len]
+    packed_len = ((width + 1) // 2 if bpp == 4 else width) * height
+    packed = rle_decode(payload, packed_len) if flags & FLAG_RLE else bytes(payload)
+    return width, height, palette, unpack_indices(packed, width, height, bpp)
+
+
+def verify(raw_path, kit_path):
+    """Round trip: decode the .kit and compare every pixel with the source image."""
+    raw = open(raw_path, "rb").read()
+    pixels = struct.unpack("<%dH" % (len(raw) // 2), raw)
+    width, height, palette, indices = decode(open(kit_path, "rb").read())
+    if width * height != len(pixels):
+        return False, "size mismatch"
+    background = pixels[0]
+    max_err = 0
+    for px, idx in zip(pixels, indices):
+        r, g, b, a = palette[idx]
+        if px == background:
+            if a != 0:
+                return False, "background pixel not transparent"
+            continue
+        if a == 0:
+            return False, "foreground pixel decoded as transparent"
+        src = rgb565_to_rgb888(px)
+        max_err = max(max_err, abs(src[0] - r), abs(src[1] - g), abs(src[2] - b))
+    return True, "max channel error %d" % max_err
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="directory of <team>_<type>_<w>x<h>.rgb565 files")
+    parser.add_argument("output", help="directory for the .kit files")
+    parser.add_argument("--verify", action="store_true", help="decode existing .kit files and compare")
+    args = parser.parse_args()
+    os.makedirs(args.output, exist_ok=True)
+
+    raw_total = 0
+    kit_total = 0
+    failed = False
+    for name in sorted(os.listdir(args.source)):
+        m = NAME_RE.search(name)
+        if not m:
+            continue
+        width, height = int(m.group(1)), int(m.group(2))
+        raw_path = os.path.join(args.source, name)
+        kit_path = os.path.join(args.output, name[:-len(".rgb565")] + ".kit")
+
+        if not args.verify:
+            raw = open(raw_path, "rb").read()
+            if len(raw) != width * height * 2:
+                print("%s: unexpected size %d" % (name, len(raw)), file=sys.stderr)
+                failed = True
+                continue
+            pixels = struct.unpack("<%dH" % (width * height), raw)
+            blob, colors = encode(pixels, width, height)
+            with open(kit_path, "wb") as f:
+                f.write(blob)
+
+        ok, detail = verify(raw_path, kit_path)
+        raw_size = os.path.getsize(raw_path)
+        kit_size = os.path.getsize(kit_path)
+        raw_total += raw_size
+        kit_total += kit_size
+        print("%-44s %6d -> %6d bytes  %s%s" % (name, raw_size, kit_size, "ok, " if ok else "FAIL: ", detail))
+        failed |= not ok
+
+    if raw_total:
+        print("total %d -> %d bytes (%.1f%%)" % (raw_total, kit_total, 100.0 * kit_total / raw_total))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
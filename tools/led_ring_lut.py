@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Generate the LED ring lookup tables and check them against the float maths.
+
+    python3 tools/led_ring_lut.py            # compare integer and float renderers
+    python3 tools/led_ring_lut.py --emit     # print the C tables for src/led_anim.cpp
+
+The LED ring used to compute every pixel as
+    int(channel * (0.08 + 0.92 * (0.5 + 0.5 * sinf(2*pi*phase))) * tail)
+in single precision. It now reads the pulse from a 257-entry Q8 table
+(interpolated between entries) and the comet/notch factors from Q8 constants,
+and scales with integer multiplies and a divide by 255. The check below runs
+both versions over every millisecond of a pulse period, every tail factor and
+every channel value the ring uses, and fails if any pixel differs by more
+than the allowed tolerance.
+"""
+
+import argparse
+import math
+import struct
+import sys
+
+PULSE_STEPS = 256
+PULSE_MIN = 0.08
+# Tail factors by distance from the comet head, then the dim-notch factor.
+COMET_TAIL = (1.00, 0.45, 0.18, 0.08)
+DIM_NOTCH = 0.22
+CHANNELS = (0, 180, 255)  # purple, red/green components in use
+PERIODS = (50, 700, 1400, 2000, 5000)
+TOLERANCE = 1
+
+
+def f32(x):
+    return struct.unpack("<f", struct.pack("<f", x))[0]
+
+
+def q8(x):
+    return int(round(255 * x))
+
+
+def pulse_table():
+    return [q8(PULSE_MIN + (1 - PULSE_MIN) * (0.5 + 0.5 * math.sin(2 * math.pi * i / PULSE_STEPS)))
+            for i in range(PULSE_STEPS + 1)]
+
+
+def float_pixel(channel, ms, period, tail):
+    phase = f32(f32(ms % period) / f32(period))
+    pulse = f32(f32(PULSE_MIN) + f32(f32(0.92) * f32(0.5 + f32(0.5 * f32(math.sin(f32(6.283185307 * phase)))))))
+    scale = f32(pulse * f32(tail))
+    return max(0, min(255, int(f32(channel * scale))))
+
+
+def int_pulse(table, ms, period):
+    phase = ((ms % period) << 16) // period
+    idx, frac = phase >> 8, phase & 0xFF
+    a, b = table[idx], table[idx + 1]
+    return a + (((b - a) * frac) >> 8)
+
+
+def int_pixel(table, channel, ms, period, tail_q8):
+    scale = int_pulse(table, ms, period) * tail_q8 // 255
+    return channel * scale // 255
+
+
+def check():
+    table = pulse_table()
+    tails = COMET_TAIL + (DIM_NOTCH,)
+    worst = 0
+    diffs = 0
+    total = 0
+    for period in PERIODS:
+        for ms in range(period):
+            for tail in tails:
+                tail_q8 = q8(tail)
+                for channel in CHANNELS:
+                    err = abs(float_pixel(channel, ms, period, tail) - int_pixel(table, channel, ms, period, tail_q8))
+                    worst = max(worst, err)
+                    diffs += err != 0
+                    total += 1
+    print("%d pixels, %d differ, max error %d LSB (tolerance %d)" % (total, diffs, worst, TOLERANCE))
+    return worst <= TOLERANCE
+
+
+def emit():
+    table = pulse_table()
+    print("// Generated by tools/led_ring_lut.py: Q8 pulse scale over one period.")
+    print("static const uint8_t kPulseLut[%d] = {" % (PULSE_STEPS + 1))
+    for i in range(0, len(table), 16):
+        print("    " + ", ".join("%3d" % v for v in table[i:i + 16]) + ",")
+    print("};")
+    print("static const uint8_t kCometTailQ8[] = {%s};" % ", ".join(str(q8(t)) for t in COMET_TAIL))
+    print("static constexpr uint8_t kDimNotchQ8 = %d;" % q8(DIM_NOTCH))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--emit", action="store_true", help="print the C tables instead of checking")
+    args = parser.parse_args()
+    if args.emit:
+        emit()
+        return 0
+    return 0 if check() else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,58 @@
+"""PlatformIO hook: pack data/kits into the kit atlas and flash it.
+
+    pio run -t uploadkits
+
+The atlas is rebuilt on every invocation (it takes well under a second) and
+written to the `kits` partition listed in the board's partition table.
+"""
+
+import csv
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))  # noqa: F821
+import kit_atlas  # noqa: E402
+
+ATLAS_PARTITION = "kits"
+
+
+def atlas_path():
+    return os.path.join(env.subst("$BUILD_DIR"), "kits_atlas.bin")  # noqa: F821
+
+
+def partition_offset(name):
+    table = os.path.join(env.subst("$PROJECT_DIR"), env.GetProjectOption("board_build.partitions"))  # noqa: F821
+    with open(table) as f:
+        for row in csv.reader(line for line in f if not line.lstrip().startswith("#")):
+            cells = [c.strip() for c in row]
+            if len(cells) >= 5 and cells[0] == name:
+                return cells[3], int(cells[4], 0)
+    raise ValueError("partition %s not found in %s" % (name, table))
+
+
+def build_atlas(*_args, **_kwargs):
+    kits = kit_atlas.load_kits(os.path.join(env.subst("$PROJECT_DIR"), "data", "kits"))  # noqa: F821
+    atlas = kit_atlas.pack(kits)
+    offset, size = partition_offset(ATLAS_PARTITION)
+    if len(atlas) > size:
+        sys.stderr.write("kit atlas is %d bytes, partition holds %d\n" % (len(atlas), size))
+        env.Exit(1)  # noqa: F821
+    os.makedirs(os.path.dirname(atlas_path()), exist_ok=True)
+    with open(atlas_path(), "wb") as f:
+        f.write(atlas)
+    print("kit atlas: %d kits, %d bytes -> %s @ %s" % (len(kits), len(atlas), ATLAS_PARTITION, offset))
+
+
+env.AddCustomTarget(  # noqa: F821
+    name="uploadkits",
+    dependencies=None,
+    actions=[
+        build_atlas,
+        '"$PYTHONEXE" "$UPLOADER" --chip $BOARD_MCU --port "$UPLOAD_PORT" --baud $UPLOAD_SPEED '
+        "write_flash %s %s" % (partition_offset(ATLAS_PARTITION)[0], atlas_path()),
+    ],
+    title="Upload kit atlas",
+    description="Pack data/kits and flash it to the kits partition",
+)
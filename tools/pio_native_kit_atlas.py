@@ -0,0 +1,30 @@
+"""PlatformIO pre-script for the native env: pack data/kits into the build
+directory so test_kit_atlas checks the C++ index against a real atlas and
+test_kit_file checks the C++ decoder against the kits tools/kit_encode.py
+decoded into it.
+
+The test finds the blob and the source kits through FPL_TEST_KIT_ATLAS and
+FPL_TEST_KIT_DIR.
+"""
+
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))  # noqa: F821
+import kit_atlas  # noqa: E402
+
+kit_dir = os.path.join(env.subst("$PROJECT_DIR"), "data", "kits")  # noqa: F821
+atlas_path = os.path.join(env.subst("$BUILD_DIR"), "kits_atlas.bin")  # noqa: F821
+
+os.makedirs(os.path.dirname(atlas_path), exist_ok=True)
+with open(atlas_path, "wb") as f:
+    f.write(kit_atlas.pack(kit_atlas.load_kits(kit_dir)))
+
+env.Append(  # noqa: F821
+    CPPDEFINES=[
+        ("FPL_TEST_KIT_ATLAS", env.StringifyMacro(atlas_path)),  # noqa: F821
+        ("FPL_TEST_KIT_DIR", env.StringifyMacro(kit_dir)),  # noqa: F821
+    ]
+)
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Turn a `trace` serial dump into Chrome Trace Event JSON for Perfetto.
+
+    pio device monitor | tee trace.log      # then type `trace` and wait for "[TRACE] end"
+    python3 tools/trace_to_chrome.py trace.log trace.json
+    # open trace.json in https://ui.perfetto.dev (or chrome://tracing)
+
+Each core is a process and each recording task a thread; spans nest within a
+task. Fetch and parse slices carry the endpoint, popups the time the event
+waited in the queue. With several dumps in one log the last is used unless
+--dump picks another (0 = first). A summary of span durations is printed.
+"""
+
+import argparse
+import base64
+import json
+import re
+import struct
+import sys
+import zlib
+
+BEGIN_RE = re.compile(r"\[TRACE\] begin v(\d+) (\d+) (\d+) (\d+)")
+TASK_RE = re.compile(r"\[TRACE\] task (\d+) (\S+)")
+END_RE = re.compile(r"\[TRACE\] end ([0-9a-f]{8})")
+
+# Must match TraceSpan and FetchEndpoint in the firmware.
+SPANS = ["poll", "fetch", "http_get", "body", "parse", "diff", "publish", "popup", "render", "flush"]
+ENDPOINT_SPANS = {"fetch", "parse"}
+ENDPOINTS = ["bootstrap", "entry", "history", "picks", "live"]
+SHARED_TASK_SLOT = 15
+
+
+def parse_log(lines):
+    dumps = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        m = BEGIN_RE.search(line)
+        if m:
+            if int(m.group(1)) != 1:
+                raise ValueError("unsupported trace dump version %s" % m.group(1))
+            current = {"count": int(m.group(2)), "dropped": int(m.group(3)), "tasks": {}, "chunks": []}
+            continue
+        if not current:
+            continue
+        m = TASK_RE.search(line)
+        if m:
+            current["tasks"][int(m.group(1))] = m.group(2)
+            continue
+        m = END_RE.search(line)
+        if m:
+            payload = base64.b64decode("".join(current["chunks"]))
+            if zlib.crc32(payload) & 0xFFFFFFFF != int(m.group(1), 16):
+                raise ValueError("trace dump %d: CRC mismatch, dump is corrupt" % len(dumps))
+            current["payload"] = payload
+            dumps.append(current)
+            current = None
+            continue
+        if line and not line.startswith("["):
+            current["chunks"].append(line)
+    return dumps
+
+
+def decode_records(payload):
+    """Yields (ts_us, span, is_end, core, task, arg) with timestamps unwrapped."""
+    base = 0
+    last = None
+    for off in range(0, len(payload) - 7, 8):
+        ts, span, flags, arg = struct.unpack_from("<IBBH", payload, off)
+        if last is not None and ts < last and last - ts > 0x80000000:
+            base += 1 << 32
+        last = ts
+        yield base + ts, span, bool(flags & 1), (flags >> 1) & 1, flags >> 2, arg
+
+
+def span_args(name, arg):
+    if name in ENDPOINT_SPANS:
+        return {"endpoint": ENDPOINTS[arg] if arg < len(ENDPOINTS) else str(arg)}
+    if name == "popup":
+        return {"queued_ms": arg}
+    return {}
+
+
+def build_events(dump):
+    records = list(decode_records(dump["payload"]))
+    if not records:
+        return [], {}
+    t0 = records[0][0]
+    t_last = records[-1][0]
+    events = []
+    durations = {}
+    stacks = {}
+    seen = set()
+    unmatched = 0
+    for ts, span, is_end, core, task, arg in records:
+        name = SPANS[span] if span < len(SPANS) else "span%d" % span
+        seen.add((core, task))
+        stack = stacks.setdefault((core, task), [])
+        if not is_end:
+            stack.append((name, arg, ts))
+            continue
+        # Pop to the matching begin; anything above it never ended (ring cut or early return).
+        for depth in range(len(stack) - 1, -1, -1):
+            if stack[depth][0] == name and stack[depth][1] == arg:
+                _, _, start = stack[depth]
+                del stack[depth:]
+                events.append({"name": name, "ph": "X", "ts": start - t0, "dur": ts - start, "pid": core,
+                               "tid": task, "args": span_args(name, arg)})
+                durations.setdefault(name, []).append(ts - start)
+                break
+        else:
+            unmatched += 1  # begin was overwritten before the dump
+    for (core, task), stack in stacks.items():
+        for name, arg, start in stack:
+            args = span_args(name, arg)
+            args["unfinished"] = True
+            events.append({"name": name, "ph": "X", "ts": start - t0, "dur": t_last - start, "pid": core,
+                           "tid": task, "args": args})
+    if unmatched:
+        print("%d end event(s) without a begin (ring wrapped)" % unmatched, file=sys.stderr)
+
+    for core in sorted({c for c, _ in seen}):
+        events.append({"name": "process_name", "ph": "M", "pid": core, "args": {"name": "core %d" % core}})
+    for core, task in sorted(seen):
+        name = dump["tasks"].get(task, "other" if task == SHARED_TASK_SLOT else "task%d" % task)
+        events.append({"name": "thread_name", "ph": "M", "pid": core, "tid": task, "args": {"name": name}})
+    return events, durations
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", help="serial log containing a `trace` dump")
+    parser.add_argument("output", help="Chrome Trace Event JSON file to write")
+    parser.add_argument("--dump", type=int, default=-1, help="which dump in the log to convert (default: last)")
+    args = parser.parse_args()
+
+    with open(args.log, errors="replace") as f:
+        dumps = parse_log(f)
+    if not dumps:
+        print("no [TRACE] dump found in %s" % args.log, file=sys.stderr)
+        return 1
+    dump = dumps[args.dump]
+    events, durations = build_events(dump)
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+
+    print("%d events, %d dropped on device (ring full)" % (dump["count"], dump["dropped"]))
+    print("%-9s %7s %10s %10s %10s" % ("span", "count", "avg_us", "p95_us", "max_us"))
+    for name in SPANS:
+        d = sorted(durations.get(name, []))
+        if d:
+            p95 = d[min(len(d) - 1, len(d) * 95 // 100)]
+            print("%-9s %7d %10d %10d %10d" % (name, len(d), sum(d) // len(d), p95, d[-1]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Turn a `shots` serial capture into PNGs, a metrics table and a golden diff.
+
+    pio device monitor | tee shots.log      # then type `shots` and wait for "script done"
+    pio test -e native -f test_ui_screens -v > shots.log   # or render on the host
+    python3 tools/ui_shots.py shots.log out/
+    python3 tools/ui_shots.py shots.log out/ --golden golden/ [--tolerance 0.5]
+
+For every screen this writes out/<screen>.png and out/metrics.csv (render time,
+invalidated pixels and flushed bytes for the full and incremental frames).
+With --golden each PNG is compared against golden/<screen>.png; the exit code is
+non-zero if more than --tolerance percent of pixels differ. Countdowns and the
+live pulse follow the device clock, so a small tolerance is expected there.
+Copy a reviewed out/ over golden/ to accept a UI change.
+"""
+
+import argparse
+import base64
+import csv
+import os
+import re
+import struct
+import sys
+import zlib
+
+BEGIN_RE = re.compile(r"\[SHOT\] begin (\S+) (\d+) (\d+) rle16")
+END_RE = re.compile(r"\[SHOT\] end (\S+) ([0-9a-f]{8})")
+FRAME_RE = re.compile(r"\[SHOT\] frame (\S+) (\S+) render_us=(\d+) invalidated_px=(\d+) flushed_bytes=(\d+)")
+
+
+def rle16_decode(payload, width, height):
+    pixels = []
+    for off in range(0, len(payload) - 3, 4):
+        run, pixel = struct.unpack_from("<HH", payload, off)
+        pixels.extend([pixel] * run)
+    if len(pixels) != width * height:
+        raise ValueError("frame decodes to %d pixels, expected %d" % (len(pixels), width * height))
+    return pixels
+
+
+def rgb565_to_rgb888(px):
+    r = (px >> 11) & 0x1F
+    g = (px >> 5) & 0x3F
+    b = px & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def png_chunk(tag, data):
+    return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF)
+
+
+def write_png(path, width, height, rgb_rows):
+    raw = b"".join(b"\x00" + row for row in rgb_rows)
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(png_chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(png_chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(png_chunk(b"IEND", b""))
+
+
+def read_png(path):
+    """Reads the 8-bit RGB, unfiltered PNGs written by write_png."""
+    data = open(path, "rb").read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    off = 8
+    idat = b""
+    width = height = 0
+    while off < len(data):
+        length, tag = struct.unpack_from(">I4s", data, off)
+        body = data[off + 8:off + 8 + length]
+        if tag == b"IHDR":
+            width, height, depth, color = struct.unpack_from(">IIBB", body)
+            if depth != 8 or color != 2:
+                raise ValueError("%s: only 8-bit RGB golden images are supported" % path)
+        elif tag == b"IDAT":
+            idat += body
+        off += 12 + length
+    raw = zlib.decompress(idat)
+    stride = width * 3 + 1
+    rows = []
+    for y in range(height):
+        if raw[y * stride] != 0:
+            raise ValueError("%s: filtered rows are not supported" % path)
+        rows.append(raw[y * stride + 1:(y + 1) * stride])
+    return width, height, rows
+
+
+def parse_log(lines):
+    shots = {}
+    frames = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        m = FRAME_RE.search(line)
+        if m:
+            frames.append((m.group(1), m.group(2), int(m.group(3)), int(m.group(4)), int(m.group(5))))
+            continue
+        m = BEGIN_RE.search(line)
+        if m:
+            current = (m.group(1), int(m.group(2)), int(m.group(3)), [])
+            continue
+        m = END_RE.search(line)
+        if m and current and m.group(1) == current[0]:
+            name, width, height, chunks = current
+            payload = base64.b64decode("".join(chunks))
+            if zlib.crc32(payload) & 0xFFFFFFFF != int(m.group(2), 16):
+                raise ValueError("%s: CRC mismatch, capture is corrupt" % name)
+            shots[name] = (width, height, rle16_decode(payload, width, height))
+            current = None
+            continue
+        if current and line and not line.startswith("["):
+            current[3].append(line)
+    return shots, frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", help="serial log containing a `shots` run")
+    parser.add_argument("output", help="directory for PNGs and metrics.csv")
+    parser.add_argument("--golden", help="directory of reference PNGs to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.0, help="allowed differing pixels, percent")
+    args = parser.parse_args()
+
+    with open(args.log, errors="replace") as f:
+        shots, frames = parse_log(f)
+    if not shots:
+        print("no [SHOT] frames found in %s" % args.log, file=sys.stderr)
+        return 1
+    os.makedirs(args.output, exist_ok=True)
+
+    with open(os.path.join(args.output, "metrics.csv"), "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["screen", "step", "render_us", "invalidated_px", "flushed_bytes"])
+        writer.writerows(frames)
+    print("%-10s %-7s %10s %14s %14s" % ("screen", "step", "render_us", "invalidated_px", "flushed_bytes"))
+    for frame in frames:
+        print("%-10s %-7s %10d %14d %14d" % frame)
+
+    failed = False
+    for name, (width, height, pixels) in sorted(shots.items()):
+        rows = []
+        for y in range(height):
+            row = bytearray()
+            for px in pixels[y * width:(y + 1) * width]:
+                row.extend(rgb565_to_rgb888(px))
+            rows.append(bytes(row))
+        write_png(os.path.join(args.output, name + ".png"), width, height, rows)
+
+        if not args.golden:
+            continue
+        golden_path = os.path.join(args.golden, name + ".png")
+        if not os.path.exists(golden_path):
+            print("%s: no golden image" % name)
+            failed = True
+            continue
+        g_width, g_height, g_rows = read_png(golden_path)
+        if (g_width, g_height) != (width, height):
+            print("%s: size %dx%d, golden %dx%d" % (name, width, height, g_width, g_height))
+            failed = True
+            continue
+        diff = 0
+        for row, g_row in zip(rows, g_rows):
+            diff += sum(1 for x in range(0, len(row), 3) if row[x:x + 3] != g_row[x:x + 3])
+        percent = 100.0 * diff / (width * height)
+        ok = percent <= args.tolerance
+        print("%s: %d pixels differ (%.3f%%) %s" % (name, diff, percent, "ok" if ok else "FAIL"))
+        failed |= not ok
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())